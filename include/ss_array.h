@@ -12,6 +12,15 @@
  * initial data. On later resizes, extra memory is allocated under the
  * assumption that an array that grows will probably continue to grow.
  *
+ * A slice is a non-owning view of a range of an array's elements. Partition,
+ * sort, find, and reduce work on slices as well as whole arrays, so a range can
+ * be handed to another function (or thread) without copying it.
+ *
+ * DECLARE_ARRAY provides the declarations for an array type, so it can be
+ * declared in a header and generated in one source file with GENERATE_ARRAY.
+ * To expose slices from a header as well, add DECLARE_ARRAY_SLICE there and
+ * use DEFINE_ARRAY, which provides only the definitions, in the source file.
+ *
  * Requres: ss_math.h
  */
 
@@ -62,12 +71,46 @@ struct ss_array_##LBL *ss_array_##LBL##_create_with_size(size_t num_elems);    \
  */                                                                            \
 struct ss_array_##LBL *ss_array_##LBL##_create_from(T *data, size_t len);      \
                                                                                \
-/* Clear the array's data without invalidating the buffer.                     \
+/* Create an array that takes ownership of an existing buffer without copying  \
+ * it.                                                                         \
+ *                                                                             \
+ * `data` must have been allocated by malloc, calloc, or realloc, and have     \
+ * room for `cap` elements, the first `len` of which are initialized. A buffer \
+ * returned by [ss_array_##LBL##_dissolve] can be adopted with `cap` equal to  \
+ * `len`.                                                                      \
+ *                                                                             \
+ * If `data` is NULL, `len` and `cap` must be 0.                               \
+ *                                                                             \
+ * Returns NULL if `len` is greater than `cap` or on failure to allocate; the  \
+ * caller then still owns the buffer.                                          \
+ */                                                                            \
+struct ss_array_##LBL *ss_array_##LBL##_create_adopt(                          \
+    T *data,                                                                   \
+    size_t len,                                                                \
+    size_t cap                                                                 \
+);                                                                             \
                                                                                \
- * The optimizer may optimize this call away.                                  \
+/* Remove all elements from the array, keeping its buffer for reuse.           \
+ *                                                                             \
+ * This only resets the length; the old elements remain in memory. See         \
+ * [ss_array_##LBL##_secure_clear] to erase them.                              \
  */                                                                            \
 void ss_array_##LBL##_clear(struct ss_array_##LBL *array);                     \
                                                                                \
+/* Remove all elements from the array and overwrite its entire buffer with     \
+ * zeroes, keeping the buffer for reuse.                                       \
+ *                                                                             \
+ * Unlike a plain memset, the writes are not optimized away, so use this to    \
+ * erase sensitive data. It takes time proportional to the capacity.           \
+ */                                                                            \
+void ss_array_##LBL##_secure_clear(struct ss_array_##LBL *array);              \
+                                                                               \
+/* Ensure that `num_elems` more elements can be appended without reallocating. \
+ *                                                                             \
+ * On failure to allocate, leaves `array` unchanged and returns `false`.       \
+ */                                                                            \
+bool ss_array_##LBL##_reserve(struct ss_array_##LBL *array, size_t num_elems); \
+                                                                               \
 /* Append the provided data to an array.                                       \
  *                                                                             \
  * If `data` is NULL or `num_elems` is 0, does nothing and returns `false`.    \
@@ -129,18 +172,121 @@ const T* ss_array_##LBL##_ptr(struct ss_array_##LBL *array);                   \
  * array, and returns the array's length.                                      \
  *                                                                             \
  * The pointer to the array will be set to NULL. Managing the data becomes     \
- * the caller's responsibility.                                                \
+ * the caller's responsibility. The data can be handed back to an array with   \
+ * [ss_array_##LBL##_create_adopt].                                            \
 */                                                                             \
 size_t ss_array_##LBL##_dissolve(struct ss_array_##LBL **array, T **out);      \
                                                                                \
 /* Returns `true` if the array is empty; otherwise, returns `false`. */        \
-bool ss_array_##LBL##_is_empty(struct ss_array_##LBL *array);
+bool ss_array_##LBL##_is_empty(struct ss_array_##LBL *array);                  \
+                                                                               \
+/* Sort the array's elements in ascending order as determined by `cmp`.        \
+ *                                                                             \
+ * `cmp` returns a negative number, zero, or a positive number if its first    \
+ * argument is less than, equal to, or greater than its second. The sort is not\
+ * stable.                                                                     \
+ */                                                                            \
+void ss_array_##LBL##_sort(                                                    \
+    struct ss_array_##LBL *array,                                              \
+    int (*cmp)(const T *a, const T *b)                                         \
+);                                                                             \
+                                                                               \
+/* Get a reference to the first element for which `f` returns `true`.          \
+ *                                                                             \
+ * Returns NULL if there is no such element.                                   \
+ */                                                                            \
+T *ss_array_##LBL##_find(                                                      \
+    struct ss_array_##LBL *array,                                              \
+    bool (*f)(const T *elem)                                                   \
+);                                                                             \
+                                                                               \
+/* Combine the array's elements into a single value.                           \
+ *                                                                             \
+ * Calls `f` on each element in order, passing the value returned for the      \
+ * previous element (or `init` for the first), and returns the last result.    \
+ */                                                                            \
+T ss_array_##LBL##_reduce(                                                     \
+    struct ss_array_##LBL *array,                                              \
+    T init,                                                                    \
+    T (*f)(T acc, const T *elem)                                               \
+);
 
 
-#define GENERATE_ARRAY(T) GENERATE_ARRAY2(T, T)
+#define DECLARE_ARRAY_SLICE(T) DECLARE_ARRAY_SLICE2(T, T)
+
+// Declare the slice type of an array and the functions that use it. These are
+// part of GENERATE_ARRAY2; in a header that uses DECLARE_ARRAY2, add this too
+// to expose slices, and pair the two with DEFINE_ARRAY2 in the source file.
+#define DECLARE_ARRAY_SLICE2(T, LBL)                                           \
+struct ss_array_##LBL;                                                         \
+                                                                               \
+/* A non-owning view of a contiguous range of elements.                        \
+ *                                                                             \
+ * A slice is invalidated by any change that reallocates the array it views.   \
+ */                                                                            \
+struct ss_slice_##LBL {                                                        \
+    T *data;                                                                   \
+    size_t len;                                                                \
+};                                                                             \
+                                                                               \
+/* Get a slice of the elements in the range [`begin`, `end`).                  \
+ *                                                                             \
+ * If `begin` is greater than `end` or `end` is greater than the array's       \
+ * length, returns an empty slice.                                             \
+ */                                                                            \
+struct ss_slice_##LBL ss_array_##LBL##_slice(                                  \
+    struct ss_array_##LBL *array,                                              \
+    size_t begin,                                                              \
+    size_t end                                                                 \
+);                                                                             \
+                                                                               \
+/* Get a slice of all of the array's elements. */                              \
+struct ss_slice_##LBL ss_array_##LBL##_as_slice(struct ss_array_##LBL *array); \
+                                                                               \
+/* Get a slice of the elements of `slice` in the range [`begin`, `end`).       \
+ *                                                                             \
+ * If `begin` is greater than `end` or `end` is greater than the slice's       \
+ * length, returns an empty slice.                                             \
+ */                                                                            \
+struct ss_slice_##LBL ss_slice_##LBL##_subslice(                               \
+    struct ss_slice_##LBL slice,                                               \
+    size_t begin,                                                              \
+    size_t end                                                                 \
+);                                                                             \
+                                                                               \
+/* Partition the slice; see [ss_array_##LBL##_partition].                      \
+ *                                                                             \
+ * If the slice is empty, returns its data pointer.                            \
+ */                                                                            \
+T *ss_slice_##LBL##_partition(                                                 \
+    struct ss_slice_##LBL slice,                                               \
+    bool (*f)(T* elem)                                                         \
+);                                                                             \
+                                                                               \
+/* Sort the slice; see [ss_array_##LBL##_sort]. */                             \
+void ss_slice_##LBL##_sort(                                                    \
+    struct ss_slice_##LBL slice,                                               \
+    int (*cmp)(const T *a, const T *b)                                         \
+);                                                                             \
+                                                                               \
+/* Find an element in the slice; see [ss_array_##LBL##_find]. */               \
+T *ss_slice_##LBL##_find(                                                      \
+    struct ss_slice_##LBL slice,                                               \
+    bool (*f)(const T *elem)                                                   \
+);                                                                             \
+                                                                               \
+/* Reduce the slice; see [ss_array_##LBL##_reduce]. */                         \
+T ss_slice_##LBL##_reduce(                                                     \
+    struct ss_slice_##LBL slice,                                               \
+    T init,                                                                    \
+    T (*f)(T acc, const T *elem)                                               \
+);
+
+
+#define DEFINE_ARRAY(T) DEFINE_ARRAY2(T, T)
 
 // Use label for cases when type spans multiple words, is a pointer, etc.
-#define GENERATE_ARRAY2(T, LBL)                                                \
+#define DEFINE_ARRAY2(T, LBL)                                                  \
 struct ss_array_##LBL {                                                        \
     T *data;                                                                   \
     /* len is elements */                                                      \
@@ -197,27 +343,59 @@ struct ss_array_##LBL *ss_array_##LBL##_create_from(T *data, size_t len) {     \
     struct ss_array_##LBL *array = ss_array_##LBL##_create_with_size(len);     \
     if (array == NULL) return NULL;                                            \
                                                                                \
-    size_t len_bytes = len * sizeof(T);                                        \
-    T *buf = malloc(len_bytes);                                                \
-    if (buf == NULL) {                                                         \
-        ss_array_##LBL##_free(&array, NULL);                                   \
-        return NULL;                                                           \
-    }                                                                          \
+    if (len > 0) { memcpy(array->data, data, len * sizeof(T)); }               \
                                                                                \
-    memcpy(buf, data, len_bytes);                                              \
+    array->len = len;                                                          \
+    return array;                                                              \
+}                                                                              \
                                                                                \
-    array->data = buf;                                                         \
+struct ss_array_##LBL *ss_array_##LBL##_create_adopt(                          \
+    T *data,                                                                   \
+    size_t len,                                                                \
+    size_t cap                                                                 \
+) {                                                                            \
+    if (len > cap || (data == NULL && cap > 0)) return NULL;                   \
+                                                                               \
+    struct ss_array_##LBL *array = ss_array_##LBL##_create();                  \
+    if (array == NULL) return NULL;                                            \
+                                                                               \
+    array->data = data;                                                        \
     array->len = len;                                                          \
+    array->capacity = cap * sizeof(T);                                         \
     return array;                                                              \
 }                                                                              \
                                                                                \
 void ss_array_##LBL##_clear(struct ss_array_##LBL *array) {                    \
     if (array == NULL) return;                                                 \
+    array->len = 0;                                                            \
+}                                                                              \
                                                                                \
-    memset(array->data, '\0', array->len * sizeof(T));                         \
+void ss_array_##LBL##_secure_clear(struct ss_array_##LBL *array) {             \
+    if (array == NULL) return;                                                 \
+                                                                               \
+    if (array->data != NULL) {                                                 \
+        ss_secure_zero(array->data, array->capacity);                          \
+    }                                                                          \
     array->len = 0;                                                            \
 }                                                                              \
                                                                                \
+bool ss_array_##LBL##_reserve(struct ss_array_##LBL *array, size_t num_elems) \
+{                                                                              \
+    if (array == NULL) return false;                                           \
+                                                                               \
+    size_t new_len_bytes = (array->len + num_elems) * sizeof(T);               \
+    if (new_len_bytes > array->capacity) {                                     \
+        size_t new_cap = next_pow_of_two(new_len_bytes);                       \
+        T *buf = (T*) realloc(array->data, new_cap);                           \
+        if (buf == NULL) return false;                                         \
+                                                                               \
+        array->data = buf;                                                     \
+        array->capacity = new_cap;                                             \
+    }                                                                          \
+                                                                               \
+    return true;                                                               \
+}                                                                              \
+                                                                               \
 bool ss_array_##LBL##_append_data(                                             \
     struct ss_array_##LBL *array,                                              \
     T *data,                                                                   \
@@ -274,14 +452,15 @@ bool ss_array_##LBL##_insert(struct ss_array_##LBL *array, T *elem, size_t pos)\
     return true;                                                               \
 }                                                                              \
                                                                                \
-T *ss_array_##LBL##_partition(                                                 \
-    struct ss_array_##LBL *array,                                              \
+T *ss_slice_##LBL##_partition(                                                 \
+    struct ss_slice_##LBL slice,                                               \
     bool (*f)(T* elem)                                                         \
 ) {                                                                            \
-    if (array == NULL || f == NULL) return NULL;                               \
+    if (f == NULL) return NULL;                                                \
+    if (slice.len == 0) return slice.data;                                     \
     /* Hoare's partition algorithm */                                          \
-    T *low = array->data;                                                      \
-    T *high = &array->data[array->len-1];                                      \
+    T *low = slice.data;                                                       \
+    T *high = &slice.data[slice.len-1];                                        \
                                                                                \
     while (true) {                                                             \
         while (low < high && f(low)) {                                         \
@@ -320,7 +499,9 @@ const T* ss_array_##LBL##_ptr(struct ss_array_##LBL *array) {                  \
 }                                                                              \
                                                                                \
 size_t ss_array_##LBL##_dissolve(struct ss_array_##LBL **array, T **out) {     \
-    if (array == NULL || *out != NULL) return 0;                               \
+    if (array == NULL || *array == NULL || out == NULL || *out != NULL) {      \
+        return 0;                                                              \
+    }                                                                          \
     size_t len = (*array)->len;                                                \
                                                                                \
     T *buf = NULL;                                                             \
@@ -335,11 +516,226 @@ size_t ss_array_##LBL##_dissolve(struct ss_array_##LBL **array, T **out) {     \
     }                                                                          \
                                                                                \
     *out = buf;                                                                \
+    free(*array);                                                              \
+    *array = NULL;                                                             \
     return len;                                                                \
 }                                                                              \
                                                                                \
 bool ss_array_##LBL##_is_empty(struct ss_array_##LBL *array) {                 \
     return array == NULL || array->data == NULL || array->len == 0;            \
+}                                                                              \
+                                                                               \
+struct ss_slice_##LBL ss_array_##LBL##_slice(                                  \
+    struct ss_array_##LBL *array,                                              \
+    size_t begin,                                                              \
+    size_t end                                                                 \
+) {                                                                            \
+    struct ss_slice_##LBL slice = { .data = NULL, .len = 0 };                  \
+    if (array == NULL || begin > end || end > array->len) return slice;        \
+                                                                               \
+    slice.data = array->data + begin;                                          \
+    slice.len = end - begin;                                                   \
+    return slice;                                                              \
+}                                                                              \
+                                                                               \
+struct ss_slice_##LBL ss_array_##LBL##_as_slice(struct ss_array_##LBL *array) {\
+    return ss_array_##LBL##_slice(array, 0, ss_array_##LBL##_len(array));      \
+}                                                                              \
+                                                                               \
+struct ss_slice_##LBL ss_slice_##LBL##_subslice(                               \
+    struct ss_slice_##LBL slice,                                               \
+    size_t begin,                                                              \
+    size_t end                                                                 \
+) {                                                                            \
+    struct ss_slice_##LBL sub = { .data = NULL, .len = 0 };                    \
+    if (begin > end || end > slice.len) return sub;                            \
+                                                                               \
+    sub.data = slice.data + begin;                                             \
+    sub.len = end - begin;                                                     \
+    return sub;                                                                \
+}                                                                              \
+                                                                               \
+T *ss_array_##LBL##_partition(                                                 \
+    struct ss_array_##LBL *array,                                              \
+    bool (*f)(T* elem)                                                         \
+) {                                                                            \
+    if (array == NULL) return NULL;                                            \
+    return ss_slice_##LBL##_partition(ss_array_##LBL##_as_slice(array), f);    \
+}                                                                              \
+                                                                               \
+void ss_insertion_sort_##LBL##_(                                               \
+    T *data,                                                                   \
+    size_t len,                                                                \
+    int (*cmp)(const T *a, const T *b)                                         \
+) {                                                                            \
+    for (size_t i = 1; i < len; ++i) {                                         \
+        T tmp = data[i];                                                       \
+        size_t j = i;                                                          \
+                                                                               \
+        while (j > 0 && cmp(&tmp, &data[j - 1]) < 0) {                         \
+            data[j] = data[j - 1];                                             \
+            j -= 1;                                                            \
+        }                                                                      \
+        data[j] = tmp;                                                         \
+    }                                                                          \
+}                                                                              \
+                                                                               \
+void ss_sift_down_##LBL##_(                                                    \
+    T *data,                                                                   \
+    size_t root,                                                               \
+    size_t len,                                                                \
+    int (*cmp)(const T *a, const T *b)                                         \
+) {                                                                            \
+    while (true) {                                                             \
+        size_t child = 2 * root + 1;                                           \
+        if (child >= len) return;                                              \
+                                                                               \
+        if (child + 1 < len && cmp(&data[child], &data[child + 1]) < 0) {      \
+            child += 1;                                                        \
+        }                                                                      \
+        if (cmp(&data[root], &data[child]) >= 0) return;                       \
+                                                                               \
+        ss_swap_##LBL##_(&data[root], &data[child]);                           \
+        root = child;                                                          \
+    }                                                                          \
+}                                                                              \
+                                                                               \
+void ss_heap_sort_##LBL##_(                                                    \
+    T *data,                                                                   \
+    size_t len,                                                                \
+    int (*cmp)(const T *a, const T *b)                                         \
+) {                                                                            \
+    for (size_t i = len / 2; i > 0; --i) {                                     \
+        ss_sift_down_##LBL##_(data, i - 1, len, cmp);                          \
+    }                                                                          \
+    for (size_t end = len - 1; end > 0; --end) {                               \
+        ss_swap_##LBL##_(&data[0], &data[end]);                                \
+        ss_sift_down_##LBL##_(data, 0, end, cmp);                              \
+    }                                                                          \
+}                                                                              \
+                                                                               \
+/* Introsort: quicksort that switches to heapsort if recursion gets too deep,  \
+ * and to insertion sort for short ranges. */                                  \
+void ss_introsort_##LBL##_(                                                    \
+    T *data,                                                                   \
+    size_t len,                                                                \
+    size_t depth,                                                              \
+    int (*cmp)(const T *a, const T *b)                                         \
+) {                                                                            \
+    while (len > 16) {                                                         \
+        if (depth == 0) {                                                      \
+            ss_heap_sort_##LBL##_(data, len, cmp);                             \
+            return;                                                            \
+        }                                                                      \
+        depth -= 1;                                                            \
+                                                                               \
+        /* Move the median of three to the front as the pivot. This also       \
+         * leaves an element no greater than the pivot in the middle and one   \
+         * no less than it at the end, bounding the scans below. */            \
+        size_t mid = len / 2;                                                  \
+        if (cmp(&data[mid], &data[0]) < 0) {                                   \
+            ss_swap_##LBL##_(&data[mid], &data[0]);                            \
+        }                                                                      \
+        if (cmp(&data[len - 1], &data[0]) < 0) {                               \
+            ss_swap_##LBL##_(&data[len - 1], &data[0]);                        \
+        }                                                                      \
+        if (cmp(&data[len - 1], &data[mid]) < 0) {                             \
+            ss_swap_##LBL##_(&data[len - 1], &data[mid]);                      \
+        }                                                                      \
+        ss_swap_##LBL##_(&data[0], &data[mid]);                                \
+                                                                               \
+        size_t i = 0;                                                          \
+        size_t j = len;                                                        \
+        while (true) {                                                         \
+            do { i += 1; } while (cmp(&data[i], &data[0]) < 0);                \
+            do { j -= 1; } while (cmp(&data[0], &data[j]) < 0);                \
+            if (i >= j) break;                                                 \
+            ss_swap_##LBL##_(&data[i], &data[j]);                              \
+        }                                                                      \
+        ss_swap_##LBL##_(&data[0], &data[j]);                                  \
+                                                                               \
+        /* Recurse into the smaller side to bound the stack depth. */          \
+        if (j < len - j - 1) {                                                 \
+            ss_introsort_##LBL##_(data, j, depth, cmp);                        \
+            data += j + 1;                                                     \
+            len -= j + 1;                                                      \
+        } else {                                                               \
+            ss_introsort_##LBL##_(data + j + 1, len - j - 1, depth, cmp);      \
+            len = j;                                                           \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    ss_insertion_sort_##LBL##_(data, len, cmp);                                \
+}                                                                              \
+                                                                               \
+void ss_slice_##LBL##_sort(                                                    \
+    struct ss_slice_##LBL slice,                                               \
+    int (*cmp)(const T *a, const T *b)                                         \
+) {                                                                            \
+    if (cmp == NULL || slice.len < 2) return;                                  \
+                                                                               \
+    size_t depth = 0;                                                          \
+    for (size_t n = slice.len; n > 1; n >>= 1) { depth += 2; }                 \
+                                                                               \
+    ss_introsort_##LBL##_(slice.data, slice.len, depth, cmp);                  \
+}                                                                              \
+                                                                               \
+void ss_array_##LBL##_sort(                                                    \
+    struct ss_array_##LBL *array,                                              \
+    int (*cmp)(const T *a, const T *b)                                         \
+) {                                                                            \
+    ss_slice_##LBL##_sort(ss_array_##LBL##_as_slice(array), cmp);              \
+}                                                                              \
+                                                                               \
+T *ss_slice_##LBL##_find(                                                      \
+    struct ss_slice_##LBL slice,                                               \
+    bool (*f)(const T *elem)                                                   \
+) {                                                                            \
+    if (f == NULL) return NULL;                                                \
+                                                                               \
+    for (size_t i = 0; i < slice.len; ++i) {                                   \
+        if (f(&slice.data[i])) return &slice.data[i];                          \
+    }                                                                          \
+    return NULL;                                                               \
+}                                                                              \
+                                                                               \
+T *ss_array_##LBL##_find(                                                      \
+    struct ss_array_##LBL *array,                                              \
+    bool (*f)(const T *elem)                                                   \
+) {                                                                            \
+    return ss_slice_##LBL##_find(ss_array_##LBL##_as_slice(array), f);         \
+}                                                                              \
+                                                                               \
+T ss_slice_##LBL##_reduce(                                                     \
+    struct ss_slice_##LBL slice,                                               \
+    T init,                                                                    \
+    T (*f)(T acc, const T *elem)                                               \
+) {                                                                            \
+    if (f == NULL) return init;                                                \
+                                                                               \
+    T acc = init;                                                              \
+    for (size_t i = 0; i < slice.len; ++i) {                                   \
+        acc = f(acc, &slice.data[i]);                                          \
+    }                                                                          \
+    return acc;                                                                \
+}                                                                              \
+                                                                               \
+T ss_array_##LBL##_reduce(                                                     \
+    struct ss_array_##LBL *array,                                              \
+    T init,                                                                    \
+    T (*f)(T acc, const T *elem)                                               \
+) {                                                                            \
+    return ss_slice_##LBL##_reduce(ss_array_##LBL##_as_slice(array), init, f); \
 }
 
+#define GENERATE_ARRAY(T) GENERATE_ARRAY2(T, T)
+
+// Declare and define an array type and its slices in one step. This may follow
+// DECLARE_ARRAY2 for the same type, but not DECLARE_ARRAY_SLICE2; use
+// DEFINE_ARRAY2 after that instead.
+#define GENERATE_ARRAY2(T, LBL)                                                \
+    DECLARE_ARRAY2(T, LBL)                                                     \
+    DECLARE_ARRAY_SLICE2(T, LBL)                                               \
+    DEFINE_ARRAY2(T, LBL)
+
 #endif
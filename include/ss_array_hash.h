@@ -0,0 +1,425 @@
+#ifndef SS_ARRAY_HASH_H
+#define SS_ARRAY_HASH_H
+
+/* This Source Code Form is subject to the terms of the Mozilla Public License,
+ * v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ * obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/* Hash-based deduplication and grouping for arrays.
+ *
+ * dedup removes repeated elements while keeping the first of each in place,
+ * and group_by collects the positions of equal elements, each in a single pass
+ * with a hash table rather than a sort. To remove runs of equal elements from
+ * an array that is already sorted, use ss_array_##LBL##_unique from
+ * ss_array_sorted.h, which needs no extra memory.
+ *
+ * Equality is given by HASH and EQ, functions or function-like macros called
+ * as `HASH(const T *elem)`, returning a uint64_t, and
+ * `EQ(const T *a, const T *b)`, returning true if the elements are equal.
+ * Equal elements must have equal hashes. The hash is mixed before use, so a
+ * weak hash such as the value of an integer is fine.
+ *
+ * SS_ARRAY_HASH_SCALAR and SS_ARRAY_EQ_SCALAR work for integer element types;
+ * SS_ARRAY_HASH_STRING and SS_ARRAY_EQ_STRING for `struct ss_string*`
+ * elements (through a typedef, as for any pointer element type), compared by
+ * contents.
+ *
+ * Use DECLARE_ARRAY_HASH in a header and DEFINE_ARRAY_HASH in a source file, or
+ * GENERATE_ARRAY_HASH, as with ss_array.h. The array type must be declared
+ * first, and defined in the same source file.
+ *
+ * Requires: ss_array.h, ss_math.h, ss_string.h
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ss_array.h"
+#include "ss_math.h"
+#include "ss_string.h"
+
+#define SS_ARRAY_HASH_SCALAR(E) ((uint64_t) *(E))
+#define SS_ARRAY_EQ_SCALAR(A, B) (*(A) == *(B))
+
+#define SS_ARRAY_HASH_STRING(E) ss_string_hash(*(E))
+#define SS_ARRAY_EQ_STRING(A, B) (ss_string_cmp(*(A), *(B)) == 0)
+
+// The number of slots a table starts with.
+#define SS_ARRAY_HASH_MIN_SLOTS 16
+
+struct ss_array_hash_slot_ {
+    uint64_t hash;
+    // One more than the position of the slot's element; 0 marks an empty slot.
+    size_t pos;
+};
+
+// An open-addressing table of element positions, with linear probing.
+struct ss_array_hash_table_ {
+    struct ss_array_hash_slot_ *slots;
+    size_t mask;
+    size_t len;
+};
+
+static inline bool ss_array_hash_table_init_(
+    struct ss_array_hash_table_ *table
+) {
+    table->slots = (struct ss_array_hash_slot_*)
+        calloc(SS_ARRAY_HASH_MIN_SLOTS, sizeof(struct ss_array_hash_slot_));
+    table->mask = SS_ARRAY_HASH_MIN_SLOTS - 1;
+    table->len = 0;
+    return table->slots != NULL;
+}
+
+static inline void ss_array_hash_table_free_(
+    struct ss_array_hash_table_ *table
+) {
+    free(table->slots);
+    table->slots = NULL;
+}
+
+// Make room for one more element, doubling the table when it would be more
+// than half full.
+static inline bool ss_array_hash_table_reserve_(
+    struct ss_array_hash_table_ *table
+) {
+    size_t num_slots = table->mask + 1;
+    if ((table->len + 1) * 2 <= num_slots) return true;
+
+    struct ss_array_hash_slot_ *slots = (struct ss_array_hash_slot_*)
+        calloc(num_slots * 2, sizeof(struct ss_array_hash_slot_));
+    if (slots == NULL) return false;
+
+    size_t mask = num_slots * 2 - 1;
+    for (size_t i = 0; i < num_slots; ++i) {
+        if (table->slots[i].pos == 0) continue;
+
+        size_t j = (size_t) ss_hash_mix(table->slots[i].hash) & mask;
+        while (slots[j].pos != 0) { j = (j + 1) & mask; }
+        slots[j] = table->slots[i];
+    }
+
+    free(table->slots);
+    table->slots = slots;
+    table->mask = mask;
+    return true;
+}
+
+#define DECLARE_ARRAY_HASH(T) DECLARE_ARRAY_HASH2(T, T)
+
+#define DECLARE_ARRAY_HASH2(T, LBL)                                            \
+/* The elements of a slice grouped by equality.                                \
+ *                                                                             \
+ * See [ss_slice_##LBL##_group_by].                                            \
+ */                                                                            \
+struct ss_array_groups_##LBL;                                                  \
+                                                                               \
+/* Remove every element equal to an earlier one, keeping the order of the rest.\
+ *                                                                             \
+ * Elements need not be sorted; equal elements are found by hashing. Calls a   \
+ * free function on each removed element if one is provided.                   \
+ *                                                                             \
+ * Returns the array's new length.                                             \
+ *                                                                             \
+ * On failure to allocate, returns SIZE_MAX; the duplicates found up to that   \
+ * point have been removed, and the rest of the array is unchanged.            \
+ */                                                                            \
+size_t ss_array_##LBL##_dedup(                                                 \
+    struct ss_array_##LBL *array,                                              \
+    void (*f)(T** elem)                                                        \
+);                                                                             \
+                                                                               \
+/* Group the elements of a slice by equality, in one hashing pass.             \
+ *                                                                             \
+ * Groups are numbered in the order their first element appears. For each, the \
+ * result holds a copy of its first element as the key, the number of elements \
+ * in the group, and their positions in the slice.                             \
+ *                                                                             \
+ * Keys are shallow copies, so keys that point to other data are only valid as \
+ * long as that data is.                                                       \
+ *                                                                             \
+ * The returned pointer will be NULL on failure to allocate.                   \
+ */                                                                            \
+struct ss_array_groups_##LBL *ss_slice_##LBL##_group_by(                       \
+    struct ss_slice_##LBL slice                                                \
+);                                                                             \
+                                                                               \
+/* Group the elements of an array; see [ss_slice_##LBL##_group_by]. */         \
+struct ss_array_groups_##LBL *ss_array_##LBL##_group_by(                       \
+    struct ss_array_##LBL *array                                               \
+);                                                                             \
+                                                                               \
+/* Free the provided groups and set their pointer to NULL. */                  \
+void ss_array_groups_##LBL##_free(struct ss_array_groups_##LBL **groups);      \
+                                                                               \
+/* Get the number of groups. */                                                \
+size_t ss_array_groups_##LBL##_len(const struct ss_array_groups_##LBL *groups);\
+                                                                               \
+/* Get the key of group `g`.                                                   \
+ *                                                                             \
+ * Returns NULL if `g` is out of range.                                        \
+ */                                                                            \
+const T *ss_array_groups_##LBL##_key(                                          \
+    const struct ss_array_groups_##LBL *groups,                                \
+    size_t g                                                                   \
+);                                                                             \
+                                                                               \
+/* Get the number of elements in group `g`.                                    \
+ *                                                                             \
+ * Returns 0 if `g` is out of range.                                           \
+ */                                                                            \
+size_t ss_array_groups_##LBL##_count(                                          \
+    const struct ss_array_groups_##LBL *groups,                                \
+    size_t g                                                                   \
+);                                                                             \
+                                                                               \
+/* Get the positions in the grouped slice of the elements of group `g`, in     \
+ * ascending order.                                                            \
+ *                                                                             \
+ * `len` is set to the number of positions. Returns NULL if `g` is out of      \
+ * range.                                                                      \
+ */                                                                            \
+const size_t *ss_array_groups_##LBL##_positions(                               \
+    const struct ss_array_groups_##LBL *groups,                                \
+    size_t g,                                                                  \
+    size_t *len                                                                \
+);
+
+#define DEFINE_ARRAY_HASH(T, HASH, EQ) DEFINE_ARRAY_HASH2(T, T, HASH, EQ)
+
+#define DEFINE_ARRAY_HASH2(T, LBL, HASH, EQ)                                   \
+struct ss_array_groups_##LBL {                                                 \
+    /* The first element of each group */                                      \
+    T *keys;                                                                   \
+    size_t *counts;                                                            \
+    /* Group `g` has the positions from offsets[g] up to offsets[g + 1]. */    \
+    size_t *offsets;                                                           \
+    size_t *positions;                                                         \
+    size_t len;                                                                \
+};                                                                             \
+                                                                               \
+/* Find the slot of the element of `data` equal to `elem`, or the empty slot   \
+ * where it belongs.                                                           \
+ */                                                                            \
+struct ss_array_hash_slot_ *ss_array_##LBL##_hash_find_(                       \
+    const struct ss_array_hash_table_ *table,                                  \
+    const T *data,                                                             \
+    const T *elem,                                                             \
+    uint64_t hash                                                              \
+) {                                                                            \
+    size_t i = (size_t) ss_hash_mix(hash) & table->mask;                       \
+    for (;; i = (i + 1) & table->mask) {                                       \
+        struct ss_array_hash_slot_ *slot = &table->slots[i];                   \
+        if (slot->pos == 0) return slot;                                       \
+        if (slot->hash == hash && (EQ(&data[slot->pos - 1], elem))) {          \
+            return slot;                                                       \
+        }                                                                      \
+    }                                                                          \
+}                                                                              \
+                                                                               \
+size_t ss_array_##LBL##_dedup(                                                 \
+    struct ss_array_##LBL *array,                                              \
+    void (*f)(T** elem)                                                        \
+) {                                                                            \
+    if (array == NULL) return 0;                                               \
+    if (array->len < 2) return array->len;                                     \
+                                                                               \
+    struct ss_array_hash_table_ table;                                         \
+    if (! ss_array_hash_table_init_(&table)) return SIZE_MAX;                  \
+                                                                               \
+    size_t kept = 0;                                                           \
+    size_t i = 0;                                                              \
+    for (; i < array->len; ++i) {                                              \
+        if (! ss_array_hash_table_reserve_(&table)) break;                     \
+                                                                               \
+        T *elem = &array->data[i];                                             \
+        uint64_t hash = HASH(elem);                                            \
+        struct ss_array_hash_slot_ *slot =                                     \
+            ss_array_##LBL##_hash_find_(&table, array->data, elem, hash);      \
+                                                                               \
+        if (slot->pos != 0) {                                                  \
+            if (f != NULL) { f(&elem); }                                       \
+            continue;                                                          \
+        }                                                                      \
+                                                                               \
+        if (kept != i) { array->data[kept] = array->data[i]; }                 \
+        slot->hash = hash;                                                     \
+        slot->pos = kept + 1;                                                  \
+        table.len += 1;                                                        \
+        kept += 1;                                                             \
+    }                                                                          \
+    ss_array_hash_table_free_(&table);                                         \
+                                                                               \
+    if (i < array->len) {                                                      \
+        memmove(&array->data[kept], &array->data[i],                           \
+            (array->len - i) * sizeof(T));                                     \
+        array->len = kept + (array->len - i);                                  \
+        return SIZE_MAX;                                                       \
+    }                                                                          \
+                                                                               \
+    array->len = kept;                                                         \
+    return kept;                                                               \
+}                                                                              \
+                                                                               \
+void ss_array_groups_##LBL##_free(struct ss_array_groups_##LBL **groups) {     \
+    if (groups == NULL || *groups == NULL) return;                             \
+                                                                               \
+    free((*groups)->keys);                                                     \
+    free((*groups)->counts);                                                   \
+    free((*groups)->offsets);                                                  \
+    free((*groups)->positions);                                                \
+    free(*groups);                                                             \
+    *groups = NULL;                                                            \
+}                                                                              \
+                                                                               \
+/* Assign each element of `slice` to a group, storing its group in `group_of`  \
+ * and filling in the keys and counts of `groups`.                             \
+ */                                                                            \
+bool ss_array_##LBL##_group_pass_(                                             \
+    struct ss_slice_##LBL slice,                                               \
+    struct ss_array_groups_##LBL *groups,                                      \
+    size_t *group_of                                                           \
+) {                                                                            \
+    struct ss_array_hash_table_ table;                                         \
+    if (! ss_array_hash_table_init_(&table)) return false;                     \
+                                                                               \
+    size_t cap = 0;                                                            \
+    bool ok = true;                                                            \
+                                                                               \
+    for (size_t i = 0; i < slice.len; ++i) {                                   \
+        if (! ss_array_hash_table_reserve_(&table)) {                          \
+            ok = false;                                                        \
+            break;                                                             \
+        }                                                                      \
+                                                                               \
+        const T *elem = &slice.data[i];                                        \
+        uint64_t hash = HASH(elem);                                            \
+        struct ss_array_hash_slot_ *slot =                                     \
+            ss_array_##LBL##_hash_find_(&table, groups->keys, elem, hash);     \
+                                                                               \
+        if (slot->pos == 0) {                                                  \
+            if (groups->len == cap) {                                          \
+                cap = cap == 0 ? 16 : cap * 2;                                 \
+                T *keys = (T*) realloc(groups->keys, cap * sizeof(T));         \
+                if (keys != NULL) { groups->keys = keys; }                     \
+                size_t *counts =                                               \
+                    (size_t*) realloc(groups->counts, cap * sizeof(size_t));   \
+                if (counts != NULL) { groups->counts = counts; }               \
+                                                                               \
+                if (keys == NULL || counts == NULL) {                          \
+                    ok = false;                                                \
+                    break;                                                     \
+                }                                                              \
+            }                                                                  \
+                                                                               \
+            groups->keys[groups->len] = *elem;                                 \
+            groups->counts[groups->len] = 0;                                   \
+            slot->hash = hash;                                                 \
+            slot->pos = groups->len + 1;                                       \
+            table.len += 1;                                                    \
+            groups->len += 1;                                                  \
+        }                                                                      \
+                                                                               \
+        group_of[i] = slot->pos - 1;                                           \
+        groups->counts[slot->pos - 1] += 1;                                    \
+    }                                                                          \
+                                                                               \
+    ss_array_hash_table_free_(&table);                                         \
+    return ok;                                                                 \
+}                                                                              \
+                                                                               \
+struct ss_array_groups_##LBL *ss_slice_##LBL##_group_by(                       \
+    struct ss_slice_##LBL slice                                                \
+) {                                                                            \
+    struct ss_array_groups_##LBL *groups = (struct ss_array_groups_##LBL*)     \
+        calloc(1, sizeof(struct ss_array_groups_##LBL));                       \
+    if (groups == NULL) return NULL;                                           \
+                                                                               \
+    size_t n = slice.len > 0 ? slice.len : 1;                                  \
+    size_t *group_of = (size_t*) malloc(n * sizeof(size_t));                   \
+    groups->positions = (size_t*) malloc(n * sizeof(size_t));                  \
+                                                                               \
+    if (group_of == NULL || groups->positions == NULL                          \
+        || ! ss_array_##LBL##_group_pass_(slice, groups, group_of)             \
+    ) {                                                                        \
+        free(group_of);                                                        \
+        ss_array_groups_##LBL##_free(&groups);                                 \
+        return NULL;                                                           \
+    }                                                                          \
+                                                                               \
+    groups->offsets = (size_t*) malloc((groups->len + 1) * sizeof(size_t));    \
+    if (groups->offsets == NULL) {                                             \
+        free(group_of);                                                        \
+        ss_array_groups_##LBL##_free(&groups);                                 \
+        return NULL;                                                           \
+    }                                                                          \
+                                                                               \
+    groups->offsets[0] = 0;                                                    \
+    for (size_t g = 0; g < groups->len; ++g) {                                 \
+        groups->offsets[g + 1] = groups->offsets[g] + groups->counts[g];       \
+    }                                                                          \
+                                                                               \
+    /* Place each position at the next free spot of its group, which leaves    \
+     * each offset at the end of its group; then shift them back. */           \
+    for (size_t i = 0; i < slice.len; ++i) {                                   \
+        groups->positions[groups->offsets[group_of[i]]++] = i;                 \
+    }                                                                          \
+    for (size_t g = groups->len; g > 0; --g) {                                 \
+        groups->offsets[g] = groups->offsets[g - 1];                           \
+    }                                                                          \
+    groups->offsets[0] = 0;                                                    \
+                                                                               \
+    free(group_of);                                                            \
+    return groups;                                                             \
+}                                                                              \
+                                                                               \
+struct ss_array_groups_##LBL *ss_array_##LBL##_group_by(                       \
+    struct ss_array_##LBL *array                                               \
+) {                                                                            \
+    return ss_slice_##LBL##_group_by(ss_array_##LBL##_as_slice(array));        \
+}                                                                              \
+                                                                               \
+size_t ss_array_groups_##LBL##_len(const struct ss_array_groups_##LBL *groups) \
+{                                                                              \
+    if (groups == NULL) return 0;                                              \
+    return groups->len;                                                        \
+}                                                                              \
+                                                                               \
+const T *ss_array_groups_##LBL##_key(                                          \
+    const struct ss_array_groups_##LBL *groups,                                \
+    size_t g                                                                   \
+) {                                                                            \
+    if (groups == NULL || g >= groups->len) return NULL;                       \
+    return &groups->keys[g];                                                   \
+}                                                                              \
+                                                                               \
+size_t ss_array_groups_##LBL##_count(                                          \
+    const struct ss_array_groups_##LBL *groups,                                \
+    size_t g                                                                   \
+) {                                                                            \
+    if (groups == NULL || g >= groups->len) return 0;                          \
+    return groups->counts[g];                                                  \
+}                                                                              \
+                                                                               \
+const size_t *ss_array_groups_##LBL##_positions(                               \
+    const struct ss_array_groups_##LBL *groups,                                \
+    size_t g,                                                                  \
+    size_t *len                                                                \
+) {                                                                            \
+    if (groups == NULL || g >= groups->len) return NULL;                       \
+                                                                               \
+    if (len != NULL) { *len = groups->counts[g]; }                             \
+    return &groups->positions[groups->offsets[g]];                             \
+}
+
+#define GENERATE_ARRAY_HASH(T, HASH, EQ) GENERATE_ARRAY_HASH2(T, T, HASH, EQ)
+
+// Declare and define the hashing functions for an array type in one step.
+#define GENERATE_ARRAY_HASH2(T, LBL, HASH, EQ)                                 \
+    DECLARE_ARRAY_HASH2(T, LBL)                                                \
+    DEFINE_ARRAY_HASH2(T, LBL, HASH, EQ)
+
+#endif
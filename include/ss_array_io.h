@@ -0,0 +1,344 @@
+#ifndef SS_ARRAY_IO_H
+#define SS_ARRAY_IO_H
+
+/* This Source Code Form is subject to the terms of the Mozilla Public License,
+ * v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ * obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/* Saving arrays to files, and loading or mapping them back.
+ *
+ * A file holds a 64-byte header followed by the array's elements exactly as
+ * they are in memory. The header records a version, the byte order and element
+ * size of the machine that saved it, the number of elements, and a checksum of
+ * the elements (see [ss_string_hash_data]); a file that does not match the
+ * array type loading it is rejected.
+ *
+ * Because elements are stored as raw bytes, this is only for element types
+ * without pointers, and files are only portable between builds with the same
+ * layout for the element type.
+ *
+ * `load` reads the elements into a new array. `ss_array_view_##LBL##_open`
+ * instead maps the file read-only and uses the elements in place, so opening
+ * a large file costs nothing up front; the operating system reads pages as they
+ * are touched.
+ *
+ * Use GENERATE_ARRAY_IO after the array type is declared, or the DECLARE and
+ * DEFINE variants as with ss_array.h. Only available on POSIX systems.
+ *
+ * Requires: ss_array.h, ss_string.h, ss_string_io.h
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ss_array.h"
+#include "ss_string.h"
+#include "ss_string_io.h"
+
+#define SS_ARRAY_FILE_VERSION 1
+
+// Elements start this far into the file, so mapped elements are aligned to it.
+#define SS_ARRAY_FILE_HEADER_SIZE 64
+
+// Written as a native integer; read back differently on a machine of the other
+// byte order.
+#define SS_ARRAY_FILE_BYTE_ORDER 0x01020304u
+
+struct ss_array_file_header_ {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint64_t elem_size;
+    uint64_t count;
+    uint64_t checksum;
+    char reserved[24];
+};
+
+_Static_assert(
+    sizeof(struct ss_array_file_header_) == SS_ARRAY_FILE_HEADER_SIZE,
+    "The array file header must fill the space before the elements"
+);
+
+static const char ss_array_file_magic_[8] = "SSARRAY";
+
+static inline uint64_t ss_array_file_checksum_(const void *data, size_t len) {
+    return ss_string_hash_data(len == 0 ? NULL : (const char*) data, len);
+}
+
+static inline void ss_array_file_header_init_(
+    struct ss_array_file_header_ *header,
+    size_t elem_size,
+    size_t count,
+    uint64_t checksum
+) {
+    memset(header, 0, sizeof(*header));
+    memcpy(header->magic, ss_array_file_magic_, sizeof(header->magic));
+    header->version = SS_ARRAY_FILE_VERSION;
+    header->byte_order = SS_ARRAY_FILE_BYTE_ORDER;
+    header->elem_size = elem_size;
+    header->count = count;
+    header->checksum = checksum;
+}
+
+// Check that a header was written for elements of `elem_size` bytes on a
+// machine of this byte order, and that `data_len` bytes follow it.
+static inline bool ss_array_file_header_check_(
+    const struct ss_array_file_header_ *header,
+    size_t elem_size,
+    size_t data_len
+) {
+    return memcmp(header->magic, ss_array_file_magic_, sizeof(header->magic))
+            == 0
+        && header->version == SS_ARRAY_FILE_VERSION
+        && header->byte_order == SS_ARRAY_FILE_BYTE_ORDER
+        && header->elem_size == elem_size
+        && header->count == data_len / elem_size
+        && data_len % elem_size == 0;
+}
+
+static inline bool ss_array_file_write_(
+    const char *path,
+    const struct ss_array_file_header_ *header,
+    const void *data,
+    size_t len
+) {
+    FILE *file = fopen(path, "wb");
+    if (file == NULL) return false;
+
+    bool ok = fwrite(header, sizeof(*header), 1, file) == 1
+        && (len == 0 || fwrite(data, 1, len, file) == len);
+
+    return fclose(file) == 0 && ok;
+}
+
+// Read and check the header of an open file, leaving the file positioned at
+// the first element.
+static inline bool ss_array_file_read_header_(
+    FILE *file,
+    struct ss_array_file_header_ *header,
+    size_t elem_size
+) {
+    if (fseek(file, 0, SEEK_END) != 0) return false;
+    long file_len = ftell(file);
+    if (file_len < SS_ARRAY_FILE_HEADER_SIZE || fseek(file, 0, SEEK_SET) != 0) {
+        return false;
+    }
+
+    return fread(header, sizeof(*header), 1, file) == 1
+        && ss_array_file_header_check_(header, elem_size,
+            (size_t) file_len - SS_ARRAY_FILE_HEADER_SIZE);
+}
+
+#define DECLARE_ARRAY_IO(T) DECLARE_ARRAY_IO2(T, T)
+
+#define DECLARE_ARRAY_IO2(T, LBL)                                              \
+/* A read-only array mapped from a file saved by [ss_array_##LBL##_save]. */   \
+struct ss_array_view_##LBL;                                                    \
+                                                                               \
+/* Save the array's elements to the file at `path`, replacing its contents.    \
+ *                                                                             \
+ * Returns `false` if `array` or `path` is NULL or if the file cannot be       \
+ * written, in which case the file may be left partially written.              \
+ */                                                                            \
+bool ss_array_##LBL##_save(struct ss_array_##LBL *array, const char *path);    \
+                                                                               \
+/* Load an array saved by [ss_array_##LBL##_save].                             \
+ *                                                                             \
+ * The elements are read directly into an array allocated to the saved length, \
+ * and the checksum is verified.                                               \
+ *                                                                             \
+ * The returned pointer will be NULL if the file cannot be read, was not saved \
+ * from an array of the same element size and byte order, is truncated or      \
+ * fails its checksum, or on failure to allocate.                              \
+ */                                                                            \
+struct ss_array_##LBL *ss_array_##LBL##_load(const char *path);                \
+                                                                               \
+/* Map a file saved by [ss_array_##LBL##_save] into memory, read-only.         \
+ *                                                                             \
+ * Nothing is read or copied until the elements are used, so even a very large \
+ * file opens at once. Only the header is checked; see                         \
+ * [ss_array_view_##LBL##_verify].                                             \
+ *                                                                             \
+ * The returned pointer will be NULL if the file cannot be mapped, was not     \
+ * saved from an array of the same element size and byte order, is truncated,  \
+ * or on failure to allocate.                                                  \
+ */                                                                            \
+struct ss_array_view_##LBL *ss_array_view_##LBL##_open(const char *path);      \
+                                                                               \
+/* Unmap the file and set the view's pointer to NULL. */                       \
+void ss_array_view_##LBL##_close(struct ss_array_view_##LBL **view);           \
+                                                                               \
+/* Get the number of elements in the view. */                                  \
+size_t ss_array_view_##LBL##_len(const struct ss_array_view_##LBL *view);      \
+                                                                               \
+/* Get a constant reference to the mapped elements. */                         \
+const T *ss_array_view_##LBL##_data(const struct ss_array_view_##LBL *view);   \
+                                                                               \
+/* Get a constant reference to the element at the specified position.          \
+ *                                                                             \
+ * If `pos` is outside the view's bounds, returns NULL.                        \
+ */                                                                            \
+const T *ss_array_view_##LBL##_get(                                            \
+    const struct ss_array_view_##LBL *view,                                    \
+    size_t pos                                                                 \
+);                                                                             \
+                                                                               \
+/* Get a slice of all of the mapped elements, to use with the slice functions. \
+ *                                                                             \
+ * The memory is read-only: writing through the slice, including sorting or    \
+ * partitioning it, crashes the program.                                       \
+ */                                                                            \
+struct ss_slice_##LBL ss_array_view_##LBL##_as_slice(                          \
+    const struct ss_array_view_##LBL *view                                     \
+);                                                                             \
+                                                                               \
+/* Check the mapped elements against the checksum saved with them.             \
+ *                                                                             \
+ * This reads the whole file.                                                  \
+ */                                                                            \
+bool ss_array_view_##LBL##_verify(const struct ss_array_view_##LBL *view);
+
+#define DEFINE_ARRAY_IO(T) DEFINE_ARRAY_IO2(T, T)
+
+#define DEFINE_ARRAY_IO2(T, LBL)                                               \
+_Static_assert(_Alignof(T) <= SS_ARRAY_FILE_HEADER_SIZE,                       \
+    "Elements are too strictly aligned to be mapped from a file");             \
+                                                                               \
+struct ss_array_view_##LBL {                                                   \
+    struct ss_file_view *file;                                                 \
+    const T *data;                                                             \
+    size_t len;                                                                \
+    uint64_t checksum;                                                         \
+};                                                                             \
+                                                                               \
+bool ss_array_##LBL##_save(struct ss_array_##LBL *array, const char *path) {   \
+    if (array == NULL || path == NULL) return false;                           \
+                                                                               \
+    struct ss_array_file_header_ header;                                       \
+    ss_array_file_header_init_(&header, sizeof(T), array->len,                 \
+        ss_array_file_checksum_(array->data, array->len * sizeof(T)));         \
+                                                                               \
+    return ss_array_file_write_(path, &header, array->data,                    \
+        array->len * sizeof(T));                                               \
+}                                                                              \
+                                                                               \
+struct ss_array_##LBL *ss_array_##LBL##_load(const char *path) {               \
+    if (path == NULL) return NULL;                                             \
+                                                                               \
+    FILE *file = fopen(path, "rb");                                            \
+    if (file == NULL) return NULL;                                             \
+                                                                               \
+    struct ss_array_file_header_ header;                                       \
+    struct ss_array_##LBL *array = NULL;                                       \
+                                                                               \
+    if (ss_array_file_read_header_(file, &header, sizeof(T))) {                \
+        size_t len = (size_t) header.count;                                    \
+        array = ss_array_##LBL##_create_with_size(len);                        \
+                                                                               \
+        if (array != NULL && len > 0) {                                        \
+            if (fread(array->data, sizeof(T), len, file) == len                \
+                && ss_array_file_checksum_(array->data, len * sizeof(T))       \
+                    == header.checksum                                         \
+            ) {                                                                \
+                array->len = len;                                              \
+            } else {                                                           \
+                ss_array_##LBL##_free(&array, NULL);                           \
+            }                                                                  \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    fclose(file);                                                              \
+    return array;                                                              \
+}                                                                              \
+                                                                               \
+struct ss_array_view_##LBL *ss_array_view_##LBL##_open(const char *path) {     \
+    struct ss_file_view *file = ss_file_view_open(path);                       \
+    if (file == NULL) return NULL;                                             \
+                                                                               \
+    const struct ss_array_file_header_ *header =                               \
+        (const struct ss_array_file_header_*) (const void*)                    \
+            ss_file_view_data(file);                                           \
+    size_t file_len = ss_file_view_len(file);                                  \
+                                                                               \
+    if (file_len < SS_ARRAY_FILE_HEADER_SIZE                                   \
+        || ! ss_array_file_header_check_(header, sizeof(T),                    \
+            file_len - SS_ARRAY_FILE_HEADER_SIZE)                              \
+    ) {                                                                        \
+        ss_file_view_close(&file);                                             \
+        return NULL;                                                           \
+    }                                                                          \
+                                                                               \
+    struct ss_array_view_##LBL *view = (struct ss_array_view_##LBL*)           \
+        malloc(sizeof(struct ss_array_view_##LBL));                            \
+    if (view == NULL) {                                                        \
+        ss_file_view_close(&file);                                             \
+        return NULL;                                                           \
+    }                                                                          \
+                                                                               \
+    view->file = file;                                                         \
+    view->data = (const T*) (const void*)                                      \
+        (ss_file_view_data(file) + SS_ARRAY_FILE_HEADER_SIZE);                 \
+    view->len = (size_t) header->count;                                        \
+    view->checksum = header->checksum;                                         \
+                                                                               \
+    return view;                                                               \
+}                                                                              \
+                                                                               \
+void ss_array_view_##LBL##_close(struct ss_array_view_##LBL **view) {          \
+    if (view == NULL || *view == NULL) return;                                 \
+                                                                               \
+    ss_file_view_close(&(*view)->file);                                        \
+    free(*view);                                                               \
+    *view = NULL;                                                              \
+}                                                                              \
+                                                                               \
+size_t ss_array_view_##LBL##_len(const struct ss_array_view_##LBL *view) {     \
+    if (view == NULL) return 0;                                                \
+    return view->len;                                                          \
+}                                                                              \
+                                                                               \
+const T *ss_array_view_##LBL##_data(const struct ss_array_view_##LBL *view) {  \
+    if (view == NULL) return NULL;                                             \
+    return view->data;                                                         \
+}                                                                              \
+                                                                               \
+const T *ss_array_view_##LBL##_get(                                            \
+    const struct ss_array_view_##LBL *view,                                    \
+    size_t pos                                                                 \
+) {                                                                            \
+    if (view == NULL || pos >= view->len) return NULL;                         \
+    return &view->data[pos];                                                   \
+}                                                                              \
+                                                                               \
+struct ss_slice_##LBL ss_array_view_##LBL##_as_slice(                          \
+    const struct ss_array_view_##LBL *view                                     \
+) {                                                                            \
+    struct ss_slice_##LBL slice = { .data = NULL, .len = 0 };                  \
+    if (view == NULL || view->len == 0) return slice;                          \
+                                                                               \
+    /* Slices are not const; the caller is trusted not to write. */            \
+    slice.data = (T*) (uintptr_t) view->data;                                  \
+    slice.len = view->len;                                                     \
+    return slice;                                                              \
+}                                                                              \
+                                                                               \
+bool ss_array_view_##LBL##_verify(const struct ss_array_view_##LBL *view) {    \
+    if (view == NULL) return false;                                            \
+                                                                               \
+    return ss_array_file_checksum_(view->data, view->len * sizeof(T))          \
+        == view->checksum;                                                     \
+}
+
+#define GENERATE_ARRAY_IO(T) GENERATE_ARRAY_IO2(T, T)
+
+// Declare and define the file functions for an array type in one step.
+#define GENERATE_ARRAY_IO2(T, LBL)                                             \
+    DECLARE_ARRAY_IO2(T, LBL)                                                  \
+    DEFINE_ARRAY_IO2(T, LBL)
+
+#endif
@@ -0,0 +1,242 @@
+#ifndef SS_ARRAY_NUMERIC_H
+#define SS_ARRAY_NUMERIC_H
+
+/* This Source Code Form is subject to the terms of the Mozilla Public License,
+ * v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ * obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/* Numeric reductions and searches for arrays of numbers.
+ *
+ * sum, min, max, argmin, find_value, count_value, and dot are generated for
+ * slices and whole arrays. For arrays of 32- and 64-bit signed integers, float,
+ * and double, they call the vectorized kernels of ss_numeric.h, which choose
+ * SSE2, AVX2, or AVX-512 at runtime; other number types use scalar loops.
+ *
+ * argmin finds the minimum, then the first element equal to it, so it reads
+ * the elements up to that point twice.
+ *
+ * Use DECLARE_ARRAY_NUMERIC in a header and DEFINE_ARRAY_NUMERIC in a source
+ * file, or GENERATE_ARRAY_NUMERIC, as with ss_array.h. The array type must be
+ * declared first, and defined in the same source file.
+ *
+ * Requires: ss_array.h, ss_cpu.h, ss_numeric.h
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ss_array.h"
+#include "ss_numeric.h"
+
+// Select the kernel from ss_numeric.h for OP on T, or FALLBACK if T has none.
+#define SS_ARRAY_NUMERIC_KERNEL_(T, OP, FALLBACK)                              \
+    _Generic((T) 0,                                                            \
+        int32_t: ss_numeric_##OP##_i32,                                        \
+        int64_t: ss_numeric_##OP##_i64,                                        \
+        float: ss_numeric_##OP##_f32,                                          \
+        double: ss_numeric_##OP##_f64,                                         \
+        default: FALLBACK)
+
+#define DECLARE_ARRAY_NUMERIC(T) DECLARE_ARRAY_NUMERIC2(T, T)
+
+#define DECLARE_ARRAY_NUMERIC2(T, LBL)                                         \
+/* Sum the elements of the slice.                                              \
+ *                                                                             \
+ * The sum is kept in T; see ss_numeric.h for how overflow and rounding behave \
+ * for the vectorized types. For other integer types it must not overflow.     \
+ *                                                                             \
+ * Returns 0 if the slice is empty.                                            \
+ */                                                                            \
+T ss_slice_##LBL##_sum(struct ss_slice_##LBL slice);                           \
+                                                                               \
+/* Sum the elements of the array; see [ss_slice_##LBL##_sum]. */               \
+T ss_array_##LBL##_sum(struct ss_array_##LBL *array);                          \
+                                                                               \
+/* Find the smallest element of the slice, storing it in `out`.                \
+ *                                                                             \
+ * Returns false if the slice is empty.                                        \
+ */                                                                            \
+bool ss_slice_##LBL##_min(struct ss_slice_##LBL slice, T *out);                \
+                                                                               \
+/* Find the smallest element of the array; see [ss_slice_##LBL##_min]. */      \
+bool ss_array_##LBL##_min(struct ss_array_##LBL *array, T *out);               \
+                                                                               \
+/* Find the largest element of the slice, storing it in `out`.                 \
+ *                                                                             \
+ * Returns false if the slice is empty.                                        \
+ */                                                                            \
+bool ss_slice_##LBL##_max(struct ss_slice_##LBL slice, T *out);                \
+                                                                               \
+/* Find the largest element of the array; see [ss_slice_##LBL##_max]. */       \
+bool ss_array_##LBL##_max(struct ss_array_##LBL *array, T *out);               \
+                                                                               \
+/* Get the position of the first smallest element of the slice.                \
+ *                                                                             \
+ * Returns SIZE_MAX if the slice is empty.                                     \
+ */                                                                            \
+size_t ss_slice_##LBL##_argmin(struct ss_slice_##LBL slice);                   \
+                                                                               \
+/* Get the position of the first smallest element of the array; see            \
+ * [ss_slice_##LBL##_argmin].                                                  \
+ */                                                                            \
+size_t ss_array_##LBL##_argmin(struct ss_array_##LBL *array);                  \
+                                                                               \
+/* Get the position of the first element of the slice equal to `value`.        \
+ *                                                                             \
+ * Returns SIZE_MAX if no element is equal.                                    \
+ */                                                                            \
+size_t ss_slice_##LBL##_find_value(struct ss_slice_##LBL slice, T value);      \
+                                                                               \
+/* Find a value in the array; see [ss_slice_##LBL##_find_value]. */            \
+size_t ss_array_##LBL##_find_value(struct ss_array_##LBL *array, T value);     \
+                                                                               \
+/* Count the elements of the slice equal to `value`. */                        \
+size_t ss_slice_##LBL##_count_value(struct ss_slice_##LBL slice, T value);     \
+                                                                               \
+/* Count the elements of the array equal to `value`. */                        \
+size_t ss_array_##LBL##_count_value(struct ss_array_##LBL *array, T value);    \
+                                                                               \
+/* Sum the products of the elements of `a` and `b` at each position.           \
+ *                                                                             \
+ * If the slices differ in length, the extra elements of the longer one are    \
+ * ignored. The sum is kept in T, as for [ss_slice_##LBL##_sum].               \
+ */                                                                            \
+T ss_slice_##LBL##_dot(struct ss_slice_##LBL a, struct ss_slice_##LBL b);      \
+                                                                               \
+/* Get the dot product of two arrays; see [ss_slice_##LBL##_dot]. */           \
+T ss_array_##LBL##_dot(struct ss_array_##LBL *a, struct ss_array_##LBL *b);
+
+#define DEFINE_ARRAY_NUMERIC(T) DEFINE_ARRAY_NUMERIC2(T, T)
+
+#define DEFINE_ARRAY_NUMERIC2(T, LBL)                                          \
+/* Scalar versions, for types without a kernel in ss_numeric.h. */             \
+T ss_array_##LBL##_sum_scalar_(const T *data, size_t len) {                    \
+    T sum = 0;                                                                 \
+    for (size_t i = 0; i < len; ++i) { sum = (T) (sum + data[i]); }            \
+    return sum;                                                                \
+}                                                                              \
+                                                                               \
+bool ss_array_##LBL##_min_scalar_(const T *data, size_t len, T *out) {         \
+    if (len == 0 || out == NULL) return false;                                 \
+                                                                               \
+    T min = data[0];                                                           \
+    for (size_t i = 1; i < len; ++i) {                                         \
+        if (data[i] < min) { min = data[i]; }                                  \
+    }                                                                          \
+                                                                               \
+    *out = min;                                                                \
+    return true;                                                               \
+}                                                                              \
+                                                                               \
+bool ss_array_##LBL##_max_scalar_(const T *data, size_t len, T *out) {         \
+    if (len == 0 || out == NULL) return false;                                 \
+                                                                               \
+    T max = data[0];                                                           \
+    for (size_t i = 1; i < len; ++i) {                                         \
+        if (data[i] > max) { max = data[i]; }                                  \
+    }                                                                          \
+                                                                               \
+    *out = max;                                                                \
+    return true;                                                               \
+}                                                                              \
+                                                                               \
+size_t ss_array_##LBL##_find_scalar_(const T *data, size_t len, T value) {     \
+    for (size_t i = 0; i < len; ++i) {                                         \
+        if (data[i] == value) return i;                                        \
+    }                                                                          \
+    return SIZE_MAX;                                                           \
+}                                                                              \
+                                                                               \
+size_t ss_array_##LBL##_count_scalar_(const T *data, size_t len, T value) {    \
+    size_t count = 0;                                                          \
+    for (size_t i = 0; i < len; ++i) {                                         \
+        if (data[i] == value) { count += 1; }                                  \
+    }                                                                          \
+    return count;                                                              \
+}                                                                              \
+                                                                               \
+T ss_array_##LBL##_dot_scalar_(const T *a, const T *b, size_t len) {           \
+    T sum = 0;                                                                 \
+    for (size_t i = 0; i < len; ++i) { sum = (T) (sum + a[i] * b[i]); }        \
+    return sum;                                                                \
+}                                                                              \
+                                                                               \
+T ss_slice_##LBL##_sum(struct ss_slice_##LBL slice) {                          \
+    return SS_ARRAY_NUMERIC_KERNEL_(T, sum, ss_array_##LBL##_sum_scalar_)      \
+        (slice.data, slice.len);                                               \
+}                                                                              \
+                                                                               \
+T ss_array_##LBL##_sum(struct ss_array_##LBL *array) {                         \
+    return ss_slice_##LBL##_sum(ss_array_##LBL##_as_slice(array));             \
+}                                                                              \
+                                                                               \
+bool ss_slice_##LBL##_min(struct ss_slice_##LBL slice, T *out) {               \
+    return SS_ARRAY_NUMERIC_KERNEL_(T, min, ss_array_##LBL##_min_scalar_)      \
+        (slice.data, slice.len, out);                                          \
+}                                                                              \
+                                                                               \
+bool ss_array_##LBL##_min(struct ss_array_##LBL *array, T *out) {              \
+    return ss_slice_##LBL##_min(ss_array_##LBL##_as_slice(array), out);        \
+}                                                                              \
+                                                                               \
+bool ss_slice_##LBL##_max(struct ss_slice_##LBL slice, T *out) {               \
+    return SS_ARRAY_NUMERIC_KERNEL_(T, max, ss_array_##LBL##_max_scalar_)      \
+        (slice.data, slice.len, out);                                          \
+}                                                                              \
+                                                                               \
+bool ss_array_##LBL##_max(struct ss_array_##LBL *array, T *out) {              \
+    return ss_slice_##LBL##_max(ss_array_##LBL##_as_slice(array), out);        \
+}                                                                              \
+                                                                               \
+size_t ss_slice_##LBL##_argmin(struct ss_slice_##LBL slice) {                  \
+    /* Both passes are vectorized; the second stops at the minimum. */         \
+    T min;                                                                     \
+    if (! ss_slice_##LBL##_min(slice, &min)) return SIZE_MAX;                  \
+    return ss_slice_##LBL##_find_value(slice, min);                            \
+}                                                                              \
+                                                                               \
+size_t ss_array_##LBL##_argmin(struct ss_array_##LBL *array) {                 \
+    return ss_slice_##LBL##_argmin(ss_array_##LBL##_as_slice(array));          \
+}                                                                              \
+                                                                               \
+size_t ss_slice_##LBL##_find_value(struct ss_slice_##LBL slice, T value) {     \
+    return SS_ARRAY_NUMERIC_KERNEL_(T, find, ss_array_##LBL##_find_scalar_)    \
+        (slice.data, slice.len, value);                                        \
+}                                                                              \
+                                                                               \
+size_t ss_array_##LBL##_find_value(struct ss_array_##LBL *array, T value) {    \
+    return ss_slice_##LBL##_find_value(ss_array_##LBL##_as_slice(array),       \
+        value);                                                                \
+}                                                                              \
+                                                                               \
+size_t ss_slice_##LBL##_count_value(struct ss_slice_##LBL slice, T value) {    \
+    return SS_ARRAY_NUMERIC_KERNEL_(T, count, ss_array_##LBL##_count_scalar_)  \
+        (slice.data, slice.len, value);                                        \
+}                                                                              \
+                                                                               \
+size_t ss_array_##LBL##_count_value(struct ss_array_##LBL *array, T value) {   \
+    return ss_slice_##LBL##_count_value(ss_array_##LBL##_as_slice(array),      \
+        value);                                                                \
+}                                                                              \
+                                                                               \
+T ss_slice_##LBL##_dot(struct ss_slice_##LBL a, struct ss_slice_##LBL b) {     \
+    size_t len = a.len < b.len ? a.len : b.len;                                \
+    return SS_ARRAY_NUMERIC_KERNEL_(T, dot, ss_array_##LBL##_dot_scalar_)      \
+        (a.data, b.data, len);                                                 \
+}                                                                              \
+                                                                               \
+T ss_array_##LBL##_dot(struct ss_array_##LBL *a, struct ss_array_##LBL *b) {   \
+    return ss_slice_##LBL##_dot(ss_array_##LBL##_as_slice(a),                  \
+        ss_array_##LBL##_as_slice(b));                                         \
+}
+
+#define GENERATE_ARRAY_NUMERIC(T) GENERATE_ARRAY_NUMERIC2(T, T)
+
+// Declare and define the numeric functions for an array type in one step.
+#define GENERATE_ARRAY_NUMERIC2(T, LBL)                                        \
+    DECLARE_ARRAY_NUMERIC2(T, LBL)                                             \
+    DEFINE_ARRAY_NUMERIC2(T, LBL)
+
+#endif
@@ -0,0 +1,703 @@
+#ifndef SS_ARRAY_PARALLEL_H
+#define SS_ARRAY_PARALLEL_H
+
+/* This Source Code Form is subject to the terms of the Mozilla Public License,
+ * v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ * obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/* Multithreaded algorithms for arrays and slices.
+ *
+ * The sort and partition run on the calling thread plus up to `num_threads - 1`
+ * additional threads, started for each call. `num_threads` is limited to the
+ * number of online CPUs (or SS_ARRAY_PARALLEL_MAX_THREADS, if defined as
+ * nonzero) and to one thread per SS_ARRAY_PARALLEL_GRAIN elements. Arrays and
+ * slices shorter than SS_ARRAY_PARALLEL_THRESHOLD elements, or calls left with
+ * fewer than two threads, use the serial algorithms from ss_array.h. If a
+ * thread cannot be started, its share of the work runs on the calling thread
+ * instead.
+ *
+ * The sort sorts one chunk per thread, then merges pairs of sorted runs, with
+ * each round of merging split evenly between the threads. It needs a temporary
+ * buffer the size of the input; if that cannot be allocated, the serial sort is
+ * used.
+ *
+ * The partition partitions one chunk per thread, then swaps the misplaced
+ * blocks between the two sides in parallel.
+ *
+ * parallel_for_each and parallel_reduce run on an ss_threadpool instead, and
+ * split the work into subranges that idle workers steal from each other, so
+ * they suit work that varies in cost from element to element.
+ *
+ * The comparison, predicate, and element functions are called from several
+ * threads at once, so must be thread-safe.
+ *
+ * Use GENERATE_ARRAY_PARALLEL after the array type is declared, or the
+ * DECLARE and DEFINE variants as with ss_array.h. Requires POSIX threads.
+ *
+ * Requires: ss_array.h, ss_threadpool.h
+ */
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ss_array.h"
+#include "ss_threadpool.h"
+
+// Arrays shorter than this are always sorted and partitioned serially.
+#ifndef SS_ARRAY_PARALLEL_THRESHOLD
+    #define SS_ARRAY_PARALLEL_THRESHOLD 16384
+#endif
+
+// Sorts and partitions give each thread at least this many elements.
+#ifndef SS_ARRAY_PARALLEL_GRAIN
+    #define SS_ARRAY_PARALLEL_GRAIN 4096
+#endif
+
+// Sorts and partitions use at most this many threads; 0 means one per online
+// CPU.
+#ifndef SS_ARRAY_PARALLEL_MAX_THREADS
+    #define SS_ARRAY_PARALLEL_MAX_THREADS 0
+#endif
+
+// Limit the threads used for `len` elements, so that a large `num_threads`
+// does not start more threads than there are CPUs or useful work.
+static inline size_t ss_array_parallel_threads_(
+    size_t num_threads,
+    size_t len
+) {
+    size_t max = SS_ARRAY_PARALLEL_MAX_THREADS;
+    if (max == 0) { max = ss_threadpool_num_cpus(); }
+    if (num_threads > max) { num_threads = max; }
+
+    size_t per_grain = len / SS_ARRAY_PARALLEL_GRAIN;
+    if (num_threads > per_grain) { num_threads = per_grain; }
+
+    return num_threads;
+}
+
+// A range of element positions.
+struct ss_array_parallel_range_ {
+    size_t begin;
+    size_t end;
+};
+
+// Run `fn` on each of `num_jobs` jobs of `job_size` bytes, one per thread.
+//
+// The first job runs on the calling thread, as does any job whose thread cannot
+// be started.
+static inline void ss_array_parallel_run_(
+    void *(*fn)(void *job),
+    void *jobs,
+    size_t job_size,
+    size_t num_jobs
+) {
+    pthread_t *threads = (pthread_t*) malloc(num_jobs * sizeof(pthread_t));
+    bool *started = (bool*) calloc(num_jobs, sizeof(bool));
+
+    if (threads != NULL && started != NULL) {
+        for (size_t i = 1; i < num_jobs; ++i) {
+            started[i] = pthread_create(&threads[i], NULL, fn,
+                (char*) jobs + i * job_size) == 0;
+        }
+    }
+
+    fn(jobs);
+
+    for (size_t i = 1; i < num_jobs; ++i) {
+        if (started != NULL && started[i]) {
+            pthread_join(threads[i], NULL);
+        } else {
+            fn((char*) jobs + i * job_size);
+        }
+    }
+
+    free(threads);
+    free(started);
+}
+
+// Find the position of the `k`th element of `ranges` when concatenated.
+//
+// Sets `*range` to the index of the range containing it and returns its
+// position.
+static inline size_t ss_array_parallel_locate_(
+    const struct ss_array_parallel_range_ *ranges,
+    size_t k,
+    size_t *range
+) {
+    size_t i = 0;
+    while (k >= ranges[i].end - ranges[i].begin) {
+        k -= ranges[i].end - ranges[i].begin;
+        i += 1;
+    }
+
+    *range = i;
+    return ranges[i].begin + k;
+}
+
+#define DECLARE_ARRAY_PARALLEL(T) DECLARE_ARRAY_PARALLEL2(T, T)
+
+#define DECLARE_ARRAY_PARALLEL2(T, LBL)                                        \
+/* Sort the slice using up to `num_threads` threads.                           \
+ *                                                                             \
+ * See [ss_array_##LBL##_sort]. The sort is not stable.                        \
+ */                                                                            \
+void ss_slice_##LBL##_parallel_sort(                                           \
+    struct ss_slice_##LBL slice,                                               \
+    int (*cmp)(const T *a, const T *b),                                        \
+    size_t num_threads                                                         \
+);                                                                             \
+                                                                               \
+/* Sort the array using up to `num_threads` threads.                           \
+ *                                                                             \
+ * See [ss_array_##LBL##_sort]. The sort is not stable.                        \
+ */                                                                            \
+void ss_array_##LBL##_parallel_sort(                                           \
+    struct ss_array_##LBL *array,                                              \
+    int (*cmp)(const T *a, const T *b),                                        \
+    size_t num_threads                                                         \
+);                                                                             \
+                                                                               \
+/* Partition the slice using up to `num_threads` threads.                      \
+ *                                                                             \
+ * See [ss_array_##LBL##_partition]. The order of elements within each group   \
+ * is unspecified, and may differ from that of the serial partition.           \
+ */                                                                            \
+T *ss_slice_##LBL##_parallel_partition(                                        \
+    struct ss_slice_##LBL slice,                                               \
+    bool (*f)(T* elem),                                                        \
+    size_t num_threads                                                         \
+);                                                                             \
+                                                                               \
+/* Partition the array using up to `num_threads` threads.                      \
+ *                                                                             \
+ * See [ss_slice_##LBL##_parallel_partition].                                  \
+ */                                                                            \
+T *ss_array_##LBL##_parallel_partition(                                        \
+    struct ss_array_##LBL *array,                                              \
+    bool (*f)(T* elem),                                                        \
+    size_t num_threads                                                         \
+);                                                                             \
+/* Call `f` on each element of the slice, spread across the pool's threads.    \
+ *                                                                             \
+ * `ctx` is passed to each call. The slice is split into subranges of at most  \
+ * `grain` elements, which idle threads steal; see [ss_parallel_for]. If pool  \
+ * is NULL, runs on the calling thread.                                        \
+ */                                                                            \
+void ss_slice_##LBL##_parallel_for_each(                                       \
+    struct ss_slice_##LBL slice,                                               \
+    struct ss_threadpool *pool,                                                \
+    void (*f)(T *elem, void *ctx),                                             \
+    void *ctx,                                                                 \
+    size_t grain                                                               \
+);                                                                             \
+                                                                               \
+/* Call `f` on each element of the array, spread across the pool's threads.    \
+ *                                                                             \
+ * See [ss_slice_##LBL##_parallel_for_each].                                   \
+ */                                                                            \
+void ss_array_##LBL##_parallel_for_each(                                       \
+    struct ss_array_##LBL *array,                                              \
+    struct ss_threadpool *pool,                                                \
+    void (*f)(T *elem, void *ctx),                                             \
+    void *ctx,                                                                 \
+    size_t grain                                                               \
+);                                                                             \
+                                                                               \
+/* Combine the slice's elements into a single value, using the pool's threads. \
+ *                                                                             \
+ * Each subrange of at most `grain` elements is reduced with `f`, starting     \
+ * from `init`, as by [ss_slice_##LBL##_reduce]. The partial results are then  \
+ * combined in order with `combine`. `init` must be an identity value for      \
+ * `combine`, and the result must not depend on how the slice is split.        \
+ *                                                                             \
+ * If `f` or `combine` is NULL, returns `init`. If pool is NULL or the partial \
+ * results cannot be allocated, reduces the slice on the calling thread.       \
+ */                                                                            \
+T ss_slice_##LBL##_parallel_reduce(                                            \
+    struct ss_slice_##LBL slice,                                               \
+    struct ss_threadpool *pool,                                                \
+    T init,                                                                    \
+    T (*f)(T acc, const T *elem),                                              \
+    T (*combine)(T a, T b),                                                    \
+    size_t grain                                                               \
+);                                                                             \
+                                                                               \
+/* Combine the array's elements into a single value, using the pool's threads. \
+ *                                                                             \
+ * See [ss_slice_##LBL##_parallel_reduce].                                     \
+ */                                                                            \
+T ss_array_##LBL##_parallel_reduce(                                            \
+    struct ss_array_##LBL *array,                                              \
+    struct ss_threadpool *pool,                                                \
+    T init,                                                                    \
+    T (*f)(T acc, const T *elem),                                              \
+    T (*combine)(T a, T b),                                                    \
+    size_t grain                                                               \
+);
+
+#define DEFINE_ARRAY_PARALLEL(T) DEFINE_ARRAY_PARALLEL2(T, T)
+
+#define DEFINE_ARRAY_PARALLEL2(T, LBL)                                         \
+struct ss_array_parallel_##LBL##_job_ {                                        \
+    T *src;                                                                    \
+    T *dst;                                                                    \
+    size_t len;                                                                \
+    /* The range of positions this job is responsible for */                   \
+    size_t begin;                                                              \
+    size_t end;                                                                \
+    /* The length of the sorted runs being merged */                           \
+    size_t width;                                                              \
+    int (*cmp)(const T *a, const T *b);                                        \
+    bool (*f)(T* elem);                                                        \
+    /* The number of elements placed in the first group by a partition */      \
+    size_t count;                                                              \
+    /* The misplaced blocks to swap */                                         \
+    const struct ss_array_parallel_range_ *left;                               \
+    const struct ss_array_parallel_range_ *right;                              \
+};                                                                             \
+                                                                               \
+void *ss_array_parallel_##LBL##_sort_chunk_(void *arg) {                       \
+    struct ss_array_parallel_##LBL##_job_ *job =                               \
+        (struct ss_array_parallel_##LBL##_job_*) arg;                          \
+                                                                               \
+    struct ss_slice_##LBL chunk = {                                            \
+        .data = job->src + job->begin,                                         \
+        .len = job->end - job->begin                                           \
+    };                                                                         \
+    ss_slice_##LBL##_sort(chunk, job->cmp);                                    \
+    return NULL;                                                               \
+}                                                                              \
+                                                                               \
+/* Find how many of the first `k` elements of the merge of `a` and `b` come    \
+ * from `a`. Ties are taken from `a` first. */                                 \
+size_t ss_array_parallel_##LBL##_corank_(                                      \
+    const T *a,                                                                \
+    size_t a_len,                                                              \
+    const T *b,                                                                \
+    size_t b_len,                                                              \
+    size_t k,                                                                  \
+    int (*cmp)(const T *a, const T *b)                                         \
+) {                                                                            \
+    size_t low = k > b_len ? k - b_len : 0;                                    \
+    size_t high = k < a_len ? k : a_len;                                       \
+                                                                               \
+    while (low < high) {                                                       \
+        size_t mid = low + (high - low) / 2;                                   \
+        if (cmp(&a[mid], &b[k - mid - 1]) <= 0) {                              \
+            low = mid + 1;                                                     \
+        } else {                                                               \
+            high = mid;                                                        \
+        }                                                                      \
+    }                                                                          \
+    return low;                                                                \
+}                                                                              \
+                                                                               \
+/* Merge the part of each pair of runs that lands in [begin, end) of dst. */   \
+void *ss_array_parallel_##LBL##_merge_(void *arg) {                            \
+    struct ss_array_parallel_##LBL##_job_ *job =                               \
+        (struct ss_array_parallel_##LBL##_job_*) arg;                          \
+    size_t width = job->width;                                                 \
+    size_t pos = job->begin;                                                   \
+                                                                               \
+    while (pos < job->end) {                                                   \
+        size_t pair = pos / (2 * width) * (2 * width);                         \
+        const T *a = job->src + pair;                                          \
+        size_t a_len = job->len - pair < width ? job->len - pair : width;      \
+        const T *b = a + a_len;                                                \
+        size_t b_len = job->len - pair - a_len < width                         \
+            ? job->len - pair - a_len                                          \
+            : width;                                                           \
+                                                                               \
+        size_t pair_end = pair + a_len + b_len;                                \
+        size_t k0 = pos - pair;                                                \
+        size_t k1 = (job->end < pair_end ? job->end : pair_end) - pair;        \
+                                                                               \
+        size_t i = ss_array_parallel_##LBL##_corank_(                          \
+            a, a_len, b, b_len, k0, job->cmp);                                 \
+        size_t j = k0 - i;                                                     \
+        size_t i_end = ss_array_parallel_##LBL##_corank_(                      \
+            a, a_len, b, b_len, k1, job->cmp);                                 \
+        size_t j_end = k1 - i_end;                                             \
+        T *out = job->dst + pos;                                               \
+                                                                               \
+        while (i < i_end && j < j_end) {                                       \
+            if (job->cmp(&b[j], &a[i]) < 0) {                                  \
+                *out++ = b[j++];                                               \
+            } else {                                                           \
+                *out++ = a[i++];                                               \
+            }                                                                  \
+        }                                                                      \
+        memcpy(out, &a[i], (i_end - i) * sizeof(T));                           \
+        out += i_end - i;                                                      \
+        memcpy(out, &b[j], (j_end - j) * sizeof(T));                           \
+                                                                               \
+        pos = pair + k1;                                                       \
+    }                                                                          \
+    return NULL;                                                               \
+}                                                                              \
+                                                                               \
+void *ss_array_parallel_##LBL##_copy_(void *arg) {                             \
+    struct ss_array_parallel_##LBL##_job_ *job =                               \
+        (struct ss_array_parallel_##LBL##_job_*) arg;                          \
+                                                                               \
+    memcpy(job->dst + job->begin, job->src + job->begin,                       \
+        (job->end - job->begin) * sizeof(T));                                  \
+    return NULL;                                                               \
+}                                                                              \
+                                                                               \
+void ss_slice_##LBL##_parallel_sort(                                           \
+    struct ss_slice_##LBL slice,                                               \
+    int (*cmp)(const T *a, const T *b),                                        \
+    size_t num_threads                                                         \
+) {                                                                            \
+    if (cmp == NULL || slice.len < 2) return;                                  \
+                                                                               \
+    num_threads = ss_array_parallel_threads_(num_threads, slice.len);          \
+    if (num_threads < 2 || slice.len < SS_ARRAY_PARALLEL_THRESHOLD) {          \
+        ss_slice_##LBL##_sort(slice, cmp);                                     \
+        return;                                                                \
+    }                                                                          \
+                                                                               \
+    size_t n = slice.len;                                                      \
+    T *buf = (T*) malloc(n * sizeof(T));                                       \
+    struct ss_array_parallel_##LBL##_job_ *jobs =                              \
+        (struct ss_array_parallel_##LBL##_job_*) calloc(num_threads,           \
+            sizeof(struct ss_array_parallel_##LBL##_job_));                    \
+                                                                               \
+    if (buf == NULL || jobs == NULL) {                                         \
+        free(buf);                                                             \
+        free(jobs);                                                            \
+        ss_slice_##LBL##_sort(slice, cmp);                                     \
+        return;                                                                \
+    }                                                                          \
+                                                                               \
+    /* Sort one run per thread. */                                             \
+    size_t width = (n + num_threads - 1) / num_threads;                        \
+    for (size_t t = 0; t < num_threads; ++t) {                                 \
+        jobs[t].src = slice.data;                                              \
+        jobs[t].len = n;                                                       \
+        jobs[t].begin = t * width < n ? t * width : n;                         \
+        jobs[t].end = (t + 1) * width < n ? (t + 1) * width : n;               \
+        jobs[t].cmp = cmp;                                                     \
+    }                                                                          \
+    ss_array_parallel_run_(ss_array_parallel_##LBL##_sort_chunk_, jobs,        \
+        sizeof(*jobs), num_threads);                                           \
+                                                                               \
+    /* Merge pairs of runs, alternating between the slice and buffer. Each     \
+     * round splits the output evenly between the threads. */                  \
+    T *src = slice.data;                                                       \
+    T *dst = buf;                                                              \
+                                                                               \
+    for (; width < n; width *= 2) {                                            \
+        for (size_t t = 0; t < num_threads; ++t) {                             \
+            jobs[t].src = src;                                                 \
+            jobs[t].dst = dst;                                                 \
+            jobs[t].begin = n / num_threads * t;                               \
+            jobs[t].end = t + 1 == num_threads ? n : n / num_threads * (t + 1);\
+            jobs[t].width = width;                                             \
+        }                                                                      \
+        ss_array_parallel_run_(ss_array_parallel_##LBL##_merge_, jobs,         \
+            sizeof(*jobs), num_threads);                                       \
+                                                                               \
+        T *tmp = src;                                                          \
+        src = dst;                                                             \
+        dst = tmp;                                                             \
+    }                                                                          \
+                                                                               \
+    if (src != slice.data) {                                                   \
+        for (size_t t = 0; t < num_threads; ++t) {                             \
+            jobs[t].src = src;                                                 \
+            jobs[t].dst = slice.data;                                          \
+        }                                                                      \
+        ss_array_parallel_run_(ss_array_parallel_##LBL##_copy_, jobs,          \
+            sizeof(*jobs), num_threads);                                       \
+    }                                                                          \
+                                                                               \
+    free(buf);                                                                 \
+    free(jobs);                                                                \
+}                                                                              \
+                                                                               \
+void ss_array_##LBL##_parallel_sort(                                           \
+    struct ss_array_##LBL *array,                                              \
+    int (*cmp)(const T *a, const T *b),                                        \
+    size_t num_threads                                                         \
+) {                                                                            \
+    ss_slice_##LBL##_parallel_sort(ss_array_##LBL##_as_slice(array), cmp,      \
+        num_threads);                                                          \
+}                                                                              \
+                                                                               \
+void *ss_array_parallel_##LBL##_partition_chunk_(void *arg) {                  \
+    struct ss_array_parallel_##LBL##_job_ *job =                               \
+        (struct ss_array_parallel_##LBL##_job_*) arg;                          \
+                                                                               \
+    struct ss_slice_##LBL chunk = {                                            \
+        .data = job->src + job->begin,                                         \
+        .len = job->end - job->begin                                           \
+    };                                                                         \
+    job->count = (size_t) (ss_slice_##LBL##_partition(chunk, job->f)           \
+        - chunk.data);                                                         \
+    return NULL;                                                               \
+}                                                                              \
+                                                                               \
+/* Swap the `begin`th through `end`th misplaced elements of each side. */      \
+void *ss_array_parallel_##LBL##_swap_blocks_(void *arg) {                      \
+    struct ss_array_parallel_##LBL##_job_ *job =                               \
+        (struct ss_array_parallel_##LBL##_job_*) arg;                          \
+    if (job->begin == job->end) return NULL;                                   \
+                                                                               \
+    size_t l = 0;                                                              \
+    size_t r = 0;                                                              \
+    size_t left = ss_array_parallel_locate_(job->left, job->begin, &l);        \
+    size_t right = ss_array_parallel_locate_(job->right, job->begin, &r);      \
+                                                                               \
+    for (size_t k = job->begin; k < job->end; ++k) {                           \
+        if (left == job->left[l].end) { left = job->left[++l].begin; }         \
+        if (right == job->right[r].end) { right = job->right[++r].begin; }     \
+                                                                               \
+        T tmp = job->src[left];                                                \
+        job->src[left++] = job->src[right];                                    \
+        job->src[right++] = tmp;                                               \
+    }                                                                          \
+    return NULL;                                                               \
+}                                                                              \
+                                                                               \
+T *ss_slice_##LBL##_parallel_partition(                                        \
+    struct ss_slice_##LBL slice,                                               \
+    bool (*f)(T* elem),                                                        \
+    size_t num_threads                                                         \
+) {                                                                            \
+    num_threads = ss_array_parallel_threads_(num_threads, slice.len);          \
+    if (num_threads < 2 || slice.len < SS_ARRAY_PARALLEL_THRESHOLD) {          \
+        return ss_slice_##LBL##_partition(slice, f);                           \
+    }                                                                          \
+    if (f == NULL) return NULL;                                                \
+                                                                               \
+    size_t n = slice.len;                                                      \
+    struct ss_array_parallel_##LBL##_job_ *jobs =                              \
+        (struct ss_array_parallel_##LBL##_job_*) calloc(num_threads,           \
+            sizeof(struct ss_array_parallel_##LBL##_job_));                    \
+    struct ss_array_parallel_range_ *ranges =                                  \
+        (struct ss_array_parallel_range_*) malloc(                             \
+            2 * num_threads * sizeof(struct ss_array_parallel_range_));        \
+                                                                               \
+    if (jobs == NULL || ranges == NULL) {                                      \
+        free(jobs);                                                            \
+        free(ranges);                                                          \
+        return ss_slice_##LBL##_partition(slice, f);                           \
+    }                                                                          \
+                                                                               \
+    /* Partition one chunk per thread. */                                      \
+    for (size_t t = 0; t < num_threads; ++t) {                                 \
+        jobs[t].src = slice.data;                                              \
+        jobs[t].begin = n / num_threads * t;                                   \
+        jobs[t].end = t + 1 == num_threads ? n : n / num_threads * (t + 1);    \
+        jobs[t].f = f;                                                         \
+    }                                                                          \
+    ss_array_parallel_run_(ss_array_parallel_##LBL##_partition_chunk_, jobs,   \
+        sizeof(*jobs), num_threads);                                           \
+                                                                               \
+    size_t split = 0;                                                          \
+    for (size_t t = 0; t < num_threads; ++t) { split += jobs[t].count; }       \
+                                                                               \
+    /* Every chunk is now [first group][second group]. Collect the blocks of   \
+     * the second group before the split and of the first group after it;      \
+     * both hold the same number of elements. */                               \
+    struct ss_array_parallel_range_ *left = ranges;                            \
+    struct ss_array_parallel_range_ *right = ranges + num_threads;             \
+    size_t num_left = 0;                                                       \
+    size_t num_right = 0;                                                      \
+    size_t misplaced = 0;                                                      \
+                                                                               \
+    for (size_t t = 0; t < num_threads; ++t) {                                 \
+        size_t mid = jobs[t].begin + jobs[t].count;                            \
+                                                                               \
+        if (mid < split && jobs[t].end > mid) {                                \
+            size_t end = jobs[t].end < split ? jobs[t].end : split;            \
+            left[num_left].begin = mid;                                        \
+            left[num_left].end = end;                                          \
+            num_left += 1;                                                     \
+            misplaced += end - mid;                                            \
+        }                                                                      \
+        if (mid > split && mid > jobs[t].begin) {                              \
+            right[num_right].begin = jobs[t].begin > split                     \
+                ? jobs[t].begin                                                \
+                : split;                                                       \
+            right[num_right].end = mid;                                        \
+            num_right += 1;                                                    \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    /* Swap the misplaced elements, split evenly between the threads. */       \
+    for (size_t t = 0; t < num_threads; ++t) {                                 \
+        jobs[t].begin = misplaced / num_threads * t;                           \
+        jobs[t].end = t + 1 == num_threads                                     \
+            ? misplaced                                                        \
+            : misplaced / num_threads * (t + 1);                               \
+        jobs[t].left = left;                                                   \
+        jobs[t].right = right;                                                 \
+    }                                                                          \
+    if (misplaced > 0) {                                                       \
+        ss_array_parallel_run_(ss_array_parallel_##LBL##_swap_blocks_, jobs,   \
+            sizeof(*jobs), num_threads);                                       \
+    }                                                                          \
+                                                                               \
+    free(jobs);                                                                \
+    free(ranges);                                                              \
+    return slice.data + split;                                                 \
+}                                                                              \
+                                                                               \
+T *ss_array_##LBL##_parallel_partition(                                        \
+    struct ss_array_##LBL *array,                                              \
+    bool (*f)(T* elem),                                                        \
+    size_t num_threads                                                         \
+) {                                                                            \
+    if (array == NULL) return NULL;                                            \
+    return ss_slice_##LBL##_parallel_partition(                                \
+        ss_array_##LBL##_as_slice(array), f, num_threads);                     \
+}                                                                              \
+struct ss_array_parallel_##LBL##_each_ {                                       \
+    T *data;                                                                   \
+    void (*f)(T *elem, void *ctx);                                             \
+    void *ctx;                                                                 \
+};                                                                             \
+                                                                               \
+void ss_array_parallel_##LBL##_each_range_(                                    \
+    size_t begin,                                                              \
+    size_t end,                                                                \
+    void *arg                                                                  \
+) {                                                                            \
+    struct ss_array_parallel_##LBL##_each_ *each =                             \
+        (struct ss_array_parallel_##LBL##_each_*) arg;                         \
+                                                                               \
+    for (size_t i = begin; i < end; ++i) {                                     \
+        each->f(&each->data[i], each->ctx);                                    \
+    }                                                                          \
+}                                                                              \
+                                                                               \
+void ss_slice_##LBL##_parallel_for_each(                                       \
+    struct ss_slice_##LBL slice,                                               \
+    struct ss_threadpool *pool,                                                \
+    void (*f)(T *elem, void *ctx),                                             \
+    void *ctx,                                                                 \
+    size_t grain                                                               \
+) {                                                                            \
+    if (f == NULL || slice.len == 0) return;                                   \
+                                                                               \
+    struct ss_array_parallel_##LBL##_each_ each = {                            \
+        .data = slice.data,                                                    \
+        .f = f,                                                                \
+        .ctx = ctx                                                             \
+    };                                                                         \
+    ss_parallel_for(pool, 0, slice.len, grain,                                 \
+        ss_array_parallel_##LBL##_each_range_, &each);                         \
+}                                                                              \
+                                                                               \
+void ss_array_##LBL##_parallel_for_each(                                       \
+    struct ss_array_##LBL *array,                                              \
+    struct ss_threadpool *pool,                                                \
+    void (*f)(T *elem, void *ctx),                                             \
+    void *ctx,                                                                 \
+    size_t grain                                                               \
+) {                                                                            \
+    ss_slice_##LBL##_parallel_for_each(ss_array_##LBL##_as_slice(array),       \
+        pool, f, ctx, grain);                                                  \
+}                                                                              \
+                                                                               \
+struct ss_array_parallel_##LBL##_reduce_ {                                     \
+    struct ss_slice_##LBL slice;                                               \
+    size_t grain;                                                              \
+    T init;                                                                    \
+    T (*f)(T acc, const T *elem);                                              \
+    /* One result per subrange of `grain` elements */                          \
+    T *partials;                                                               \
+};                                                                             \
+                                                                               \
+/* Reduce the `begin`th through `end`th subranges of the slice. */             \
+void ss_array_parallel_##LBL##_reduce_range_(                                  \
+    size_t begin,                                                              \
+    size_t end,                                                                \
+    void *arg                                                                  \
+) {                                                                            \
+    struct ss_array_parallel_##LBL##_reduce_ *reduce =                         \
+        (struct ss_array_parallel_##LBL##_reduce_*) arg;                       \
+                                                                               \
+    for (size_t i = begin; i < end; ++i) {                                     \
+        size_t first = i * reduce->grain;                                      \
+        size_t len = reduce->slice.len - first < reduce->grain                 \
+            ? reduce->slice.len - first                                        \
+            : reduce->grain;                                                   \
+                                                                               \
+        struct ss_slice_##LBL chunk = {                                        \
+            .data = reduce->slice.data + first,                                \
+            .len = len                                                         \
+        };                                                                     \
+        reduce->partials[i] =                                                  \
+            ss_slice_##LBL##_reduce(chunk, reduce->init, reduce->f);           \
+    }                                                                          \
+}                                                                              \
+                                                                               \
+T ss_slice_##LBL##_parallel_reduce(                                            \
+    struct ss_slice_##LBL slice,                                               \
+    struct ss_threadpool *pool,                                                \
+    T init,                                                                    \
+    T (*f)(T acc, const T *elem),                                              \
+    T (*combine)(T a, T b),                                                    \
+    size_t grain                                                               \
+) {                                                                            \
+    if (f == NULL || combine == NULL || slice.len == 0) return init;           \
+    if (pool == NULL) return ss_slice_##LBL##_reduce(slice, init, f);          \
+                                                                               \
+    if (grain == 0) {                                                          \
+        grain = slice.len / (ss_threadpool_num_threads(pool) * 8);             \
+        if (grain == 0) { grain = 1; }                                         \
+    }                                                                          \
+                                                                               \
+    /* Reduce each subrange into its own slot, then combine the slots in       \
+     * order, so the result does not depend on which thread ran what. */       \
+    size_t num_chunks = (slice.len + grain - 1) / grain;                       \
+    T *partials = (T*) malloc(num_chunks * sizeof(T));                         \
+    if (partials == NULL) return ss_slice_##LBL##_reduce(slice, init, f);      \
+                                                                               \
+    struct ss_array_parallel_##LBL##_reduce_ reduce = {                        \
+        .slice = slice,                                                        \
+        .grain = grain,                                                        \
+        .init = init,                                                          \
+        .f = f,                                                                \
+        .partials = partials                                                   \
+    };                                                                         \
+    ss_parallel_for(pool, 0, num_chunks, 1,                                    \
+        ss_array_parallel_##LBL##_reduce_range_, &reduce);                     \
+                                                                               \
+    T acc = init;                                                              \
+    for (size_t i = 0; i < num_chunks; ++i) {                                  \
+        acc = combine(acc, partials[i]);                                       \
+    }                                                                          \
+                                                                               \
+    free(partials);                                                            \
+    return acc;                                                                \
+}                                                                              \
+                                                                               \
+T ss_array_##LBL##_parallel_reduce(                                            \
+    struct ss_array_##LBL *array,                                              \
+    struct ss_threadpool *pool,                                                \
+    T init,                                                                    \
+    T (*f)(T acc, const T *elem),                                              \
+    T (*combine)(T a, T b),                                                    \
+    size_t grain                                                               \
+) {                                                                            \
+    return ss_slice_##LBL##_parallel_reduce(ss_array_##LBL##_as_slice(array),  \
+        pool, init, f, combine, grain);                                        \
+}
+
+#define GENERATE_ARRAY_PARALLEL(T) GENERATE_ARRAY_PARALLEL2(T, T)
+
+// Declare and define the parallel functions for an array type in one step.
+#define GENERATE_ARRAY_PARALLEL2(T, LBL)                                       \
+    DECLARE_ARRAY_PARALLEL2(T, LBL)                                            \
+    DEFINE_ARRAY_PARALLEL2(T, LBL)
+
+#endif
@@ -0,0 +1,135 @@
+#ifndef SS_ARRAY_PIPELINE_H
+#define SS_ARRAY_PIPELINE_H
+
+/* This Source Code Form is subject to the terms of the Mozilla Public License,
+ * v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ * obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/* Fused filter/map pipelines over slices.
+ *
+ * A pipeline filters the elements of a slice of T, maps those that pass to
+ * values of type U, and then counts, reduces, or collects them into an array
+ * of U, all in a single loop over the slice. No intermediate array is built
+ * between the steps.
+ *
+ * FILTER and MAP are functions or function-like macros, called as
+ * `FILTER(const T *elem)`, returning true to keep an element, and
+ * `MAP(const T *elem)`, returning the U that a kept element becomes. MAP is
+ * only called for kept elements. They are expanded into the loop rather than
+ * called through pointers, so the compiler can inline and vectorize them.
+ * SS_PIPELINE_KEEP_ALL and SS_PIPELINE_IDENTITY skip either step.
+ *
+ * Each pipeline is named by NAME and provides ss_pipeline_##NAME##_count,
+ * _reduce, and _collect:
+ *
+ * ```c
+ * #define IS_EVEN(E) (*(E) % 2 == 0)
+ * #define SQUARE(E) ((long) *(E) * *(E))
+ *
+ * GENERATE_ARRAY_PIPELINE(even_squares, int, int, long, long, IS_EVEN, SQUARE)
+ *
+ * struct ss_array_long *squares = ss_array_long_create();
+ * ss_pipeline_even_squares_collect(ss_array_int_as_slice(numbers), squares);
+ * ```
+ *
+ * Use DECLARE_ARRAY_PIPELINE in a header and DEFINE_ARRAY_PIPELINE in a source
+ * file, or GENERATE_ARRAY_PIPELINE, as with ss_array.h. The array types for
+ * both LBL and ULBL must be declared first, and defined in the same source file
+ * as the pipeline.
+ *
+ * Requires: ss_array.h
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "ss_array.h"
+
+// A FILTER that keeps every element.
+#define SS_PIPELINE_KEEP_ALL(E) true
+
+// A MAP that passes each element through unchanged.
+#define SS_PIPELINE_IDENTITY(E) (*(E))
+
+#define DECLARE_ARRAY_PIPELINE(NAME, T, LBL, U, ULBL)                          \
+/* Count the elements of `src` that pass the filter. */                        \
+size_t ss_pipeline_##NAME##_count(struct ss_slice_##LBL src);                  \
+                                                                               \
+/* Combine the mapped values of the elements that pass the filter.             \
+ *                                                                             \
+ * Calls `f` on each mapped value in order, passing the value returned for the \
+ * previous one (or `init` for the first), and returns the last result.        \
+ */                                                                            \
+U ss_pipeline_##NAME##_reduce(                                                 \
+    struct ss_slice_##LBL src,                                                 \
+    U init,                                                                    \
+    U (*f)(U acc, const U *elem)                                               \
+);                                                                             \
+                                                                               \
+/* Append the mapped values of the elements that pass the filter to `dest`.    \
+ *                                                                             \
+ * Room for every element of `src` is reserved once up front, so if `dest`     \
+ * already has that much spare capacity nothing is allocated.                  \
+ *                                                                             \
+ * Returns `false` if `dest` is NULL, or on failure to allocate, in which case \
+ * `dest` is unchanged.                                                        \
+ */                                                                            \
+bool ss_pipeline_##NAME##_collect(                                             \
+    struct ss_slice_##LBL src,                                                 \
+    struct ss_array_##ULBL *dest                                               \
+);
+
+#define DEFINE_ARRAY_PIPELINE(NAME, T, LBL, U, ULBL, FILTER, MAP)              \
+size_t ss_pipeline_##NAME##_count(struct ss_slice_##LBL src) {                 \
+    size_t count = 0;                                                          \
+    for (size_t i = 0; i < src.len; ++i) {                                     \
+        count += (FILTER(&src.data[i])) ? 1 : 0;                               \
+    }                                                                          \
+    return count;                                                              \
+}                                                                              \
+                                                                               \
+U ss_pipeline_##NAME##_reduce(                                                 \
+    struct ss_slice_##LBL src,                                                 \
+    U init,                                                                    \
+    U (*f)(U acc, const U *elem)                                               \
+) {                                                                            \
+    if (f == NULL) return init;                                                \
+                                                                               \
+    U acc = init;                                                              \
+    for (size_t i = 0; i < src.len; ++i) {                                     \
+        if (FILTER(&src.data[i])) {                                            \
+            U mapped = MAP(&src.data[i]);                                      \
+            acc = f(acc, &mapped);                                             \
+        }                                                                      \
+    }                                                                          \
+    return acc;                                                                \
+}                                                                              \
+                                                                               \
+bool ss_pipeline_##NAME##_collect(                                             \
+    struct ss_slice_##LBL src,                                                 \
+    struct ss_array_##ULBL *dest                                               \
+) {                                                                            \
+    if (dest == NULL) return false;                                            \
+    if (src.len == 0) return true;                                             \
+    if (! ss_array_##ULBL##_reserve(dest, src.len)) return false;              \
+                                                                               \
+    U *out = dest->data + dest->len;                                           \
+    size_t n = 0;                                                              \
+    for (size_t i = 0; i < src.len; ++i) {                                     \
+        if (FILTER(&src.data[i])) { out[n++] = MAP(&src.data[i]); }            \
+    }                                                                          \
+    dest->len += n;                                                            \
+    return true;                                                               \
+}
+
+// Declare and define a pipeline in one step.
+#define GENERATE_ARRAY_PIPELINE(NAME, T, LBL, U, ULBL, FILTER, MAP)            \
+    DECLARE_ARRAY_PIPELINE(NAME, T, LBL, U, ULBL)                              \
+    DEFINE_ARRAY_PIPELINE(NAME, T, LBL, U, ULBL, FILTER, MAP)
+
+// Declare and define a pipeline that only filters, keeping the element type.
+#define GENERATE_ARRAY_FILTER(NAME, T, LBL, FILTER)                            \
+    GENERATE_ARRAY_PIPELINE(NAME, T, LBL, T, LBL, FILTER, SS_PIPELINE_IDENTITY)
+
+#endif
@@ -0,0 +1,505 @@
+#ifndef SS_ARRAY_SORTED_H
+#define SS_ARRAY_SORTED_H
+
+/* This Source Code Form is subject to the terms of the Mozilla Public License,
+ * v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ * obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/* Searches and set operations for sorted arrays and slices.
+ *
+ * The binary searches narrow the range by half on every step whatever the
+ * outcome of each comparison, so the CPU does not mispredict branches, at the
+ * cost of never stopping early on a match.
+ *
+ * For large arrays searched often, an index stores a copy of the elements in
+ * Eytzinger order: the layout of a binary heap, where the nodes visited early
+ * in every search are together at the front and a node's descendants a few
+ * levels down share a cache line, which is fetched ahead of time.
+ *
+ * merge, set_union, and set_intersection append to a destination array in one
+ * pass over both inputs.
+ *
+ * Every function takes a comparison function like the one given to the array's
+ * sort, and expects its input to be sorted by it.
+ *
+ * Use GENERATE_ARRAY_SORTED after the array type is declared, or the DECLARE
+ * and DEFINE variants as with ss_array.h.
+ *
+ * Requires: ss_array.h
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ss_array.h"
+
+// The size of a cache line, used to decide how far ahead an index search
+// fetches.
+#ifndef SS_ARRAY_INDEX_CACHE_LINE
+    #define SS_ARRAY_INDEX_CACHE_LINE 64
+#endif
+
+#ifdef __GNUC__
+    #define SS_ARRAY_INDEX_PREFETCH_(P) __builtin_prefetch(P)
+#else
+    #define SS_ARRAY_INDEX_PREFETCH_(P) ((void) (P))
+#endif
+
+// Given the position an index search ended at, strip the trailing right turns
+// and the left turn before them, leaving the last node that was not less than
+// the key (or 0 if there was none).
+static inline size_t ss_array_index_drop_right_turns_(size_t k) {
+#ifdef __GNUC__
+    return k >> ((size_t) __builtin_ctzll(~(unsigned long long) k) + 1);
+#else
+    while (k & 1) { k >>= 1; }
+    return k >> 1;
+#endif
+}
+
+#define DECLARE_ARRAY_SORTED(T) DECLARE_ARRAY_SORTED2(T, T)
+
+#define DECLARE_ARRAY_SORTED2(T, LBL)                                          \
+/* Find the position of the first element of the sorted slice that is not less \
+ * than `key`, as determined by `cmp`.                                         \
+ *                                                                             \
+ * The slice must be sorted in ascending order by the same comparison; see     \
+ * [ss_array_##LBL##_sort].                                                    \
+ *                                                                             \
+ * Returns the slice's length if every element is less than `key`, or if `key` \
+ * or `cmp` is NULL.                                                           \
+ */                                                                            \
+size_t ss_slice_##LBL##_lower_bound(                                           \
+    struct ss_slice_##LBL slice,                                               \
+    const T *key,                                                              \
+    int (*cmp)(const T *a, const T *b)                                         \
+);                                                                             \
+                                                                               \
+/* Find the position of the first element of the sorted slice that is greater  \
+ * than `key`.                                                                 \
+ *                                                                             \
+ * See [ss_slice_##LBL##_lower_bound].                                         \
+ */                                                                            \
+size_t ss_slice_##LBL##_upper_bound(                                           \
+    struct ss_slice_##LBL slice,                                               \
+    const T *key,                                                              \
+    int (*cmp)(const T *a, const T *b)                                         \
+);                                                                             \
+                                                                               \
+/* Get a reference to an element of the sorted slice equal to `key`.           \
+ *                                                                             \
+ * If several elements are equal to `key`, returns the first.                  \
+ *                                                                             \
+ * Returns NULL if there is no such element.                                   \
+ */                                                                            \
+T *ss_slice_##LBL##_binary_search(                                             \
+    struct ss_slice_##LBL slice,                                               \
+    const T *key,                                                              \
+    int (*cmp)(const T *a, const T *b)                                         \
+);                                                                             \
+                                                                               \
+/* Find the position of the first element of the sorted array that is not less \
+ * than `key`; see [ss_slice_##LBL##_lower_bound].                             \
+ */                                                                            \
+size_t ss_array_##LBL##_lower_bound(                                           \
+    struct ss_array_##LBL *array,                                              \
+    const T *key,                                                              \
+    int (*cmp)(const T *a, const T *b)                                         \
+);                                                                             \
+                                                                               \
+/* Find the position of the first element of the sorted array that is greater  \
+ * than `key`; see [ss_slice_##LBL##_upper_bound].                             \
+ */                                                                            \
+size_t ss_array_##LBL##_upper_bound(                                           \
+    struct ss_array_##LBL *array,                                              \
+    const T *key,                                                              \
+    int (*cmp)(const T *a, const T *b)                                         \
+);                                                                             \
+                                                                               \
+/* Get a reference to an element of the sorted array equal to `key`; see       \
+ * [ss_slice_##LBL##_binary_search].                                           \
+ */                                                                            \
+T *ss_array_##LBL##_binary_search(                                             \
+    struct ss_array_##LBL *array,                                              \
+    const T *key,                                                              \
+    int (*cmp)(const T *a, const T *b)                                         \
+);                                                                             \
+                                                                               \
+/* Remove all but the first of each run of consecutive equal elements.         \
+ *                                                                             \
+ * On a sorted array, this leaves one of each distinct element. Calls a free   \
+ * function on each removed element if one is provided.                        \
+ *                                                                             \
+ * Returns the array's new length.                                             \
+ */                                                                            \
+size_t ss_array_##LBL##_unique(                                                \
+    struct ss_array_##LBL *array,                                              \
+    int (*cmp)(const T *a, const T *b),                                        \
+    void (*f)(T** elem)                                                        \
+);                                                                             \
+                                                                               \
+/* Append the elements of the sorted slices `a` and `b` to `dest`, in sorted   \
+ * order.                                                                      \
+ *                                                                             \
+ * Equal elements from `a` come before those from `b`. `dest` must not overlap \
+ * either slice.                                                               \
+ *                                                                             \
+ * Returns false if `dest` or `cmp` is NULL, or on failure to allocate, in     \
+ * which case `dest` is left unchanged.                                        \
+ */                                                                            \
+bool ss_array_##LBL##_merge(                                                   \
+    struct ss_array_##LBL *dest,                                               \
+    struct ss_slice_##LBL a,                                                   \
+    struct ss_slice_##LBL b,                                                   \
+    int (*cmp)(const T *a, const T *b)                                         \
+);                                                                             \
+                                                                               \
+/* Append the elements found in either of the sorted slices `a` and `b` to     \
+ * `dest`, in sorted order.                                                    \
+ *                                                                             \
+ * An element found in both is appended once, from `a`. If an element occurs   \
+ * `m` times in `a` and `n` times in `b`, it is appended the greater of `m` and\
+ * `n` times.                                                                  \
+ *                                                                             \
+ * See [ss_array_##LBL##_merge].                                               \
+ */                                                                            \
+bool ss_array_##LBL##_set_union(                                               \
+    struct ss_array_##LBL *dest,                                               \
+    struct ss_slice_##LBL a,                                                   \
+    struct ss_slice_##LBL b,                                                   \
+    int (*cmp)(const T *a, const T *b)                                         \
+);                                                                             \
+                                                                               \
+/* Append the elements found in both of the sorted slices `a` and `b` to       \
+ * `dest`, in sorted order, taking them from `a`.                              \
+ *                                                                             \
+ * If an element occurs `m` times in `a` and `n` times in `b`, it is appended  \
+ * the lesser of `m` and `n` times.                                            \
+ *                                                                             \
+ * See [ss_array_##LBL##_merge].                                               \
+ */                                                                            \
+bool ss_array_##LBL##_set_intersection(                                        \
+    struct ss_array_##LBL *dest,                                               \
+    struct ss_slice_##LBL a,                                                   \
+    struct ss_slice_##LBL b,                                                   \
+    int (*cmp)(const T *a, const T *b)                                         \
+);                                                                             \
+                                                                               \
+/* A copy of a sorted array in Eytzinger (breadth-first) order, for faster     \
+ * searching of large arrays.                                                  \
+ */                                                                            \
+struct ss_array_index_##LBL;                                                   \
+                                                                               \
+/* Create a search index of the sorted slice.                                  \
+ *                                                                             \
+ * The elements are copied, so the index is unaffected by later changes to the \
+ * slice. `cmp` is kept for searching the index.                               \
+ *                                                                             \
+ * Returns NULL if `cmp` is NULL or on failure to allocate memory.             \
+ */                                                                            \
+struct ss_array_index_##LBL *ss_array_index_##LBL##_create(                    \
+    struct ss_slice_##LBL sorted,                                              \
+    int (*cmp)(const T *a, const T *b)                                         \
+);                                                                             \
+                                                                               \
+/* Free the provided index and set its pointer to NULL. */                     \
+void ss_array_index_##LBL##_free(struct ss_array_index_##LBL **index);         \
+                                                                               \
+/* Get a reference to the index's copy of the first element not less than      \
+ * `key`.                                                                      \
+ *                                                                             \
+ * Returns NULL if every element is less than `key`.                           \
+ */                                                                            \
+const T *ss_array_index_##LBL##_lower_bound(                                   \
+    const struct ss_array_index_##LBL *index,                                  \
+    const T *key                                                               \
+);                                                                             \
+                                                                               \
+/* Check whether the index contains an element equal to `key`. */              \
+bool ss_array_index_##LBL##_contains(                                          \
+    const struct ss_array_index_##LBL *index,                                  \
+    const T *key                                                               \
+);
+
+#define DEFINE_ARRAY_SORTED(T) DEFINE_ARRAY_SORTED2(T, T)
+
+#define DEFINE_ARRAY_SORTED2(T, LBL)                                           \
+size_t ss_slice_##LBL##_lower_bound(                                           \
+    struct ss_slice_##LBL slice,                                               \
+    const T *key,                                                              \
+    int (*cmp)(const T *a, const T *b)                                         \
+) {                                                                            \
+    if (key == NULL || cmp == NULL || slice.len == 0) return slice.len;        \
+                                                                               \
+    /* Halve the range on every step, whatever the comparison, so the loop     \
+     * has no unpredictable branch. */                                         \
+    const T *base = slice.data;                                                \
+    size_t n = slice.len;                                                      \
+                                                                               \
+    while (n > 1) {                                                            \
+        size_t half = n / 2;                                                   \
+        base = cmp(&base[half], key) < 0 ? base + half : base;                 \
+        n -= half;                                                             \
+    }                                                                          \
+    base += cmp(base, key) < 0;                                                \
+                                                                               \
+    return (size_t) (base - slice.data);                                       \
+}                                                                              \
+                                                                               \
+size_t ss_slice_##LBL##_upper_bound(                                           \
+    struct ss_slice_##LBL slice,                                               \
+    const T *key,                                                              \
+    int (*cmp)(const T *a, const T *b)                                         \
+) {                                                                            \
+    if (key == NULL || cmp == NULL || slice.len == 0) return slice.len;        \
+                                                                               \
+    const T *base = slice.data;                                                \
+    size_t n = slice.len;                                                      \
+                                                                               \
+    while (n > 1) {                                                            \
+        size_t half = n / 2;                                                   \
+        base = cmp(&base[half], key) <= 0 ? base + half : base;                \
+        n -= half;                                                             \
+    }                                                                          \
+    base += cmp(base, key) <= 0;                                               \
+                                                                               \
+    return (size_t) (base - slice.data);                                       \
+}                                                                              \
+                                                                               \
+T *ss_slice_##LBL##_binary_search(                                             \
+    struct ss_slice_##LBL slice,                                               \
+    const T *key,                                                              \
+    int (*cmp)(const T *a, const T *b)                                         \
+) {                                                                            \
+    size_t pos = ss_slice_##LBL##_lower_bound(slice, key, cmp);                \
+    if (pos == slice.len || cmp(&slice.data[pos], key) != 0) return NULL;      \
+                                                                               \
+    return &slice.data[pos];                                                   \
+}                                                                              \
+                                                                               \
+size_t ss_array_##LBL##_lower_bound(                                           \
+    struct ss_array_##LBL *array,                                              \
+    const T *key,                                                              \
+    int (*cmp)(const T *a, const T *b)                                         \
+) {                                                                            \
+    return ss_slice_##LBL##_lower_bound(ss_array_##LBL##_as_slice(array),      \
+        key, cmp);                                                             \
+}                                                                              \
+                                                                               \
+size_t ss_array_##LBL##_upper_bound(                                           \
+    struct ss_array_##LBL *array,                                              \
+    const T *key,                                                              \
+    int (*cmp)(const T *a, const T *b)                                         \
+) {                                                                            \
+    return ss_slice_##LBL##_upper_bound(ss_array_##LBL##_as_slice(array),      \
+        key, cmp);                                                             \
+}                                                                              \
+                                                                               \
+T *ss_array_##LBL##_binary_search(                                             \
+    struct ss_array_##LBL *array,                                              \
+    const T *key,                                                              \
+    int (*cmp)(const T *a, const T *b)                                         \
+) {                                                                            \
+    return ss_slice_##LBL##_binary_search(ss_array_##LBL##_as_slice(array),    \
+        key, cmp);                                                             \
+}                                                                              \
+                                                                               \
+size_t ss_array_##LBL##_unique(                                                \
+    struct ss_array_##LBL *array,                                              \
+    int (*cmp)(const T *a, const T *b),                                        \
+    void (*f)(T** elem)                                                        \
+) {                                                                            \
+    if (array == NULL) return 0;                                               \
+    if (cmp == NULL || array->len < 2) return array->len;                      \
+                                                                               \
+    size_t kept = 1;                                                           \
+    for (size_t i = 1; i < array->len; ++i) {                                  \
+        if (cmp(&array->data[kept - 1], &array->data[i]) == 0) {               \
+            if (f != NULL) {                                                   \
+                T *tmp = &array->data[i];                                      \
+                f(&tmp);                                                       \
+            }                                                                  \
+        } else {                                                               \
+            array->data[kept++] = array->data[i];                              \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    array->len = kept;                                                         \
+    return kept;                                                               \
+}                                                                              \
+                                                                               \
+/* Merge `a` and `b` into `dest`. `mode` is 0 to keep every element, 1 for the \
+ * union, and 2 for the intersection. */                                       \
+bool ss_array_##LBL##_merge_(                                                  \
+    struct ss_array_##LBL *dest,                                               \
+    struct ss_slice_##LBL a,                                                   \
+    struct ss_slice_##LBL b,                                                   \
+    int (*cmp)(const T *a, const T *b),                                        \
+    int mode                                                                   \
+) {                                                                            \
+    if (dest == NULL || cmp == NULL) return false;                             \
+                                                                               \
+    size_t max_len = mode == 2 ? (a.len < b.len ? a.len : b.len)               \
+        : a.len + b.len;                                                       \
+    if (max_len == 0) return true;                                             \
+    if (! ss_array_##LBL##_reserve(dest, max_len)) return false;               \
+                                                                               \
+    T *out = dest->data + dest->len;                                           \
+    size_t i = 0;                                                              \
+    size_t j = 0;                                                              \
+                                                                               \
+    while (i < a.len && j < b.len) {                                           \
+        int order = cmp(&a.data[i], &b.data[j]);                               \
+                                                                               \
+        if (order < 0) {                                                       \
+            if (mode == 2) { ++i; } else { *out++ = a.data[i++]; }             \
+        } else if (order > 0) {                                                \
+            if (mode == 2) { ++j; } else { *out++ = b.data[j++]; }             \
+        } else if (mode == 0) {                                                \
+            *out++ = a.data[i++];                                              \
+        } else {                                                               \
+            *out++ = a.data[i++];                                              \
+            ++j;                                                               \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    if (mode != 2 && i < a.len) {                                              \
+        memcpy(out, a.data + i, (a.len - i) * sizeof(T));                      \
+        out += a.len - i;                                                      \
+    }                                                                          \
+    if (mode != 2 && j < b.len) {                                              \
+        memcpy(out, b.data + j, (b.len - j) * sizeof(T));                      \
+        out += b.len - j;                                                      \
+    }                                                                          \
+                                                                               \
+    dest->len = (size_t) (out - dest->data);                                   \
+    return true;                                                               \
+}                                                                              \
+                                                                               \
+bool ss_array_##LBL##_merge(                                                   \
+    struct ss_array_##LBL *dest,                                               \
+    struct ss_slice_##LBL a,                                                   \
+    struct ss_slice_##LBL b,                                                   \
+    int (*cmp)(const T *a, const T *b)                                         \
+) {                                                                            \
+    return ss_array_##LBL##_merge_(dest, a, b, cmp, 0);                        \
+}                                                                              \
+                                                                               \
+bool ss_array_##LBL##_set_union(                                               \
+    struct ss_array_##LBL *dest,                                               \
+    struct ss_slice_##LBL a,                                                   \
+    struct ss_slice_##LBL b,                                                   \
+    int (*cmp)(const T *a, const T *b)                                         \
+) {                                                                            \
+    return ss_array_##LBL##_merge_(dest, a, b, cmp, 1);                        \
+}                                                                              \
+                                                                               \
+bool ss_array_##LBL##_set_intersection(                                        \
+    struct ss_array_##LBL *dest,                                               \
+    struct ss_slice_##LBL a,                                                   \
+    struct ss_slice_##LBL b,                                                   \
+    int (*cmp)(const T *a, const T *b)                                         \
+) {                                                                            \
+    return ss_array_##LBL##_merge_(dest, a, b, cmp, 2);                        \
+}                                                                              \
+                                                                               \
+struct ss_array_index_##LBL {                                                  \
+    /* The elements in breadth-first order of a complete binary search tree,   \
+     * starting at position 1: the children of position k are at 2k and        \
+     * 2k + 1. */                                                              \
+    T *data;                                                                   \
+    size_t len;                                                                \
+    int (*cmp)(const T *a, const T *b);                                        \
+};                                                                             \
+                                                                               \
+/* Copy sorted elements from position `i` into the subtree rooted at `k`.      \
+ * Returns the position of the next element to copy. */                        \
+size_t ss_array_index_##LBL##_fill_(                                           \
+    T *data,                                                                   \
+    size_t len,                                                                \
+    const T *sorted,                                                           \
+    size_t i,                                                                  \
+    size_t k                                                                   \
+) {                                                                            \
+    if (k > len) return i;                                                     \
+                                                                               \
+    i = ss_array_index_##LBL##_fill_(data, len, sorted, i, 2 * k);             \
+    data[k] = sorted[i++];                                                     \
+    return ss_array_index_##LBL##_fill_(data, len, sorted, i, 2 * k + 1);      \
+}                                                                              \
+                                                                               \
+struct ss_array_index_##LBL *ss_array_index_##LBL##_create(                    \
+    struct ss_slice_##LBL sorted,                                              \
+    int (*cmp)(const T *a, const T *b)                                         \
+) {                                                                            \
+    if (cmp == NULL) return NULL;                                              \
+                                                                               \
+    struct ss_array_index_##LBL *index = (struct ss_array_index_##LBL*)        \
+        malloc(sizeof(struct ss_array_index_##LBL));                           \
+    if (index == NULL) return NULL;                                            \
+                                                                               \
+    index->data = (T*) malloc((sorted.len + 1) * sizeof(T));                   \
+    if (index->data == NULL) {                                                 \
+        free(index);                                                           \
+        return NULL;                                                           \
+    }                                                                          \
+                                                                               \
+    index->len = sorted.len;                                                   \
+    index->cmp = cmp;                                                          \
+    ss_array_index_##LBL##_fill_(index->data, sorted.len, sorted.data, 0, 1);  \
+                                                                               \
+    return index;                                                              \
+}                                                                              \
+                                                                               \
+void ss_array_index_##LBL##_free(struct ss_array_index_##LBL **index) {        \
+    if (index == NULL || *index == NULL) return;                               \
+                                                                               \
+    free((*index)->data);                                                      \
+    free(*index);                                                              \
+    *index = NULL;                                                             \
+}                                                                              \
+                                                                               \
+const T *ss_array_index_##LBL##_lower_bound(                                   \
+    const struct ss_array_index_##LBL *index,                                  \
+    const T *key                                                               \
+) {                                                                            \
+    if (index == NULL || key == NULL) return NULL;                             \
+                                                                               \
+    /* Walk down the tree, going right when the node is less than the key.     \
+     * The nodes a few levels down share a cache line, so fetch it early. */   \
+    size_t ahead = SS_ARRAY_INDEX_CACHE_LINE / sizeof(T);                      \
+    if (ahead == 0) { ahead = 1; }                                             \
+                                                                               \
+    size_t k = 1;                                                              \
+    while (k <= index->len) {                                                  \
+        if (k * ahead <= index->len) {                                         \
+            SS_ARRAY_INDEX_PREFETCH_(&index->data[k * ahead]);                 \
+        }                                                                      \
+        k = 2 * k + (index->cmp(&index->data[k], key) < 0);                    \
+    }                                                                          \
+                                                                               \
+    /* The answer is the last node where the walk went left: drop the right    \
+     * turns taken since, then that left turn. */                              \
+    k = ss_array_index_drop_right_turns_(k);                                   \
+    return k == 0 ? NULL : &index->data[k];                                    \
+}                                                                              \
+                                                                               \
+bool ss_array_index_##LBL##_contains(                                          \
+    const struct ss_array_index_##LBL *index,                                  \
+    const T *key                                                               \
+) {                                                                            \
+    const T *elem = ss_array_index_##LBL##_lower_bound(index, key);            \
+    return elem != NULL && index->cmp(elem, key) == 0;                         \
+}
+
+#define GENERATE_ARRAY_SORTED(T) GENERATE_ARRAY_SORTED2(T, T)
+
+// Declare and define the sorted array functions for an array type in one step.
+#define GENERATE_ARRAY_SORTED2(T, LBL)                                         \
+    DECLARE_ARRAY_SORTED2(T, LBL)                                              \
+    DEFINE_ARRAY_SORTED2(T, LBL)
+
+#endif
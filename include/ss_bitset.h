@@ -0,0 +1,120 @@
+#ifndef SS_LIB_BITSET_H
+#define SS_LIB_BITSET_H
+
+/* This Source Code Form is subject to the terms of the Mozilla Public License,
+ * v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ * obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/* Packed, growable set of bits.
+ *
+ * Bits are stored 64 to a word, so a bitset takes an eighth of the memory of
+ * an array of bools, and counting, searching, and combining bitsets work a
+ * word at a time. Combining loops are simple enough for the compiler to
+ * vectorize.
+ *
+ * Setting a bit past the end grows the bitset; the new bits are clear.
+ *
+ *  Requires:
+ *
+ *  ss_math.h
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// A set of bits.
+struct ss_bitset;
+
+// Create a new, empty bitset.
+//
+// The returned pointer will be NULL on failure to allocate.
+struct ss_bitset *ss_bitset_create();
+
+// Create a bitset of `num_bits` clear bits.
+//
+// The returned pointer will be NULL on failure to allocate.
+struct ss_bitset *ss_bitset_create_with_size(size_t num_bits);
+
+// Free the provided bitset and set its pointer to NULL.
+void ss_bitset_free(struct ss_bitset **bits);
+
+// Get the number of bits in the bitset.
+size_t ss_bitset_len(const struct ss_bitset *bits);
+
+// Change the number of bits in the bitset.
+//
+// Bits added are clear; bits removed are discarded.
+//
+// Returns false if bits is NULL, or on failure to allocate, in which case the
+// bitset is unchanged.
+bool ss_bitset_resize(struct ss_bitset *bits, size_t num_bits);
+
+// Set the bit at `pos`, growing the bitset if `pos` is past the end.
+//
+// Returns false if bits is NULL, if `pos` is SIZE_MAX, or on failure to
+// allocate.
+bool ss_bitset_set(struct ss_bitset *bits, size_t pos);
+
+// Clear the bit at `pos`. Does nothing if `pos` is past the end.
+void ss_bitset_clear(struct ss_bitset *bits, size_t pos);
+
+// Check whether the bit at `pos` is set.
+//
+// Returns false if `pos` is past the end.
+bool ss_bitset_test(const struct ss_bitset *bits, size_t pos);
+
+// Set every bit.
+void ss_bitset_set_all(struct ss_bitset *bits);
+
+// Clear every bit, keeping the length.
+void ss_bitset_clear_all(struct ss_bitset *bits);
+
+// Count the set bits.
+size_t ss_bitset_count(const struct ss_bitset *bits);
+
+// Find the first set bit at or after `pos`.
+//
+// To visit every set bit:
+//
+// ```c
+// for (size_t i = ss_bitset_next_set(bits, 0); i != SIZE_MAX;
+//     i = ss_bitset_next_set(bits, i + 1)
+// ) { ... }
+// ```
+//
+// Returns SIZE_MAX if there is none.
+size_t ss_bitset_next_set(const struct ss_bitset *bits, size_t pos);
+
+// Find the first set bit.
+//
+// Returns SIZE_MAX if no bit is set.
+size_t ss_bitset_find_first(const struct ss_bitset *bits);
+
+// Set `dest` to the bitwise AND of `dest` and `src`.
+//
+// Bits of `dest` past the end of `src` are cleared.
+//
+// Returns false if either bitset is NULL.
+bool ss_bitset_and(struct ss_bitset *dest, const struct ss_bitset *src);
+
+// Set `dest` to the bitwise OR of `dest` and `src`.
+//
+// `dest` grows to the length of `src` if it is shorter.
+//
+// Returns false if either bitset is NULL, or on failure to allocate.
+bool ss_bitset_or(struct ss_bitset *dest, const struct ss_bitset *src);
+
+// Set `dest` to the bitwise XOR of `dest` and `src`.
+//
+// `dest` grows to the length of `src` if it is shorter.
+//
+// Returns false if either bitset is NULL, or on failure to allocate.
+bool ss_bitset_xor(struct ss_bitset *dest, const struct ss_bitset *src);
+
+// Clear the bits of `dest` that are set in `src`.
+//
+// Returns false if either bitset is NULL.
+bool ss_bitset_andnot(struct ss_bitset *dest, const struct ss_bitset *src);
+
+#endif
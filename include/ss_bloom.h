@@ -0,0 +1,128 @@
+#ifndef SS_LIB_BLOOM_H
+#define SS_LIB_BLOOM_H
+
+/* This Source Code Form is subject to the terms of the Mozilla Public License,
+ * v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ * obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/* Bloom filter.
+ *
+ * A Bloom filter answers whether a key may have been added: a negative answer
+ * is always right, and a positive answer is wrong at about the false-positive
+ * rate the filter was sized for. It is meant to reject absent keys before a
+ * more expensive lookup.
+ *
+ * Each key is hashed once to 64 bits (see [ss_string_hash]); the filter's bit
+ * positions are all derived from that hash. Keys may also be
+ * added by a hash computed elsewhere.
+ *
+ * A blocked filter keeps all of a key's bits in one 64-byte cache line, so a
+ * lookup touches one line of memory instead of one per bit. It needs somewhat
+ * more memory for the same false-positive rate; the size is adjusted to make
+ * up for it.
+ *
+ *  Requires:
+ *
+ *  ss_string.h
+ *
+ *  Link with the math library (-lm).
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ss_string.h"
+
+// A Bloom filter.
+struct ss_bloom;
+
+// Create a filter sized to hold `expected` keys with a false-positive rate of
+// about `fp_rate`.
+//
+// The returned pointer will be NULL if `expected` is 0, if `fp_rate` is not
+// between 0 and 1, or on failure to allocate.
+struct ss_bloom *ss_bloom_create(size_t expected, double fp_rate);
+
+// Create a blocked filter sized to hold `expected` keys with a false-positive
+// rate of about `fp_rate`.
+//
+// This behaves like [ss_bloom_create].
+struct ss_bloom *ss_bloom_create_blocked(size_t expected, double fp_rate);
+
+// Free the provided filter and set its pointer to NULL.
+void ss_bloom_free(struct ss_bloom **bloom);
+
+// Get the number of bits in the filter.
+size_t ss_bloom_num_bits(const struct ss_bloom *bloom);
+
+// Get the number of bits set for each key.
+size_t ss_bloom_num_hashes(const struct ss_bloom *bloom);
+
+// Remove all keys from the filter.
+void ss_bloom_clear(struct ss_bloom *bloom);
+
+// Add a key by its hash.
+void ss_bloom_add_hash(struct ss_bloom *bloom, uint64_t hash);
+
+// Check whether a key may have been added, by its hash.
+//
+// Returns false if bloom is NULL.
+bool ss_bloom_contains_hash(const struct ss_bloom *bloom, uint64_t hash);
+
+// Add the contents of a string.
+void ss_bloom_add(struct ss_bloom *bloom, const struct ss_string *key);
+
+// Check whether the contents of a string may have been added.
+//
+// Returns false if bloom is NULL.
+bool ss_bloom_contains(
+    const struct ss_bloom *bloom,
+    const struct ss_string *key
+);
+
+// Add `len` chars of data.
+void ss_bloom_add_data(struct ss_bloom *bloom, const char *data, size_t len);
+
+// Check whether `len` chars of data may have been added.
+//
+// Returns false if bloom is NULL.
+bool ss_bloom_contains_data(
+    const struct ss_bloom *bloom,
+    const char *data,
+    size_t len
+);
+
+// Add `n` strings.
+//
+// The keys are hashed and their memory prefetched in groups before any bits are
+// set, so the cache misses of a group overlap.
+void ss_bloom_add_batch(
+    struct ss_bloom *bloom,
+    const struct ss_string **keys,
+    size_t n
+);
+
+// Check whether each of `n` strings may have been added, storing the answers
+// in `out`.
+//
+// Like [ss_bloom_add_batch], the cache misses of a group of keys overlap.
+//
+// Returns the number of keys that may have been added.
+size_t ss_bloom_contains_batch(
+    const struct ss_bloom *bloom,
+    const struct ss_string **keys,
+    size_t n,
+    bool *out
+);
+
+// Add all keys of `src` to `dest`.
+//
+// Both filters must have been created the same way, with the same arguments.
+//
+// Returns false if either filter is NULL or if they differ in size, number of
+// hashes, or layout, in which case `dest` is unchanged.
+bool ss_bloom_union(struct ss_bloom *dest, const struct ss_bloom *src);
+
+#endif
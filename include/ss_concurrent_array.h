@@ -0,0 +1,390 @@
+#ifndef SS_CONCURRENT_ARRAY_H
+#define SS_CONCURRENT_ARRAY_H
+
+/* This Source Code Form is subject to the terms of the Mozilla Public License,
+ * v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ * obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/* Typesafe append-only array that many threads can append to at once.
+ *
+ * Elements are stored in segments that double in size, which are allocated as
+ * needed and never moved, so pointers to elements stay valid while the array
+ * grows and readers never see a buffer being reallocated.
+ *
+ * A writer reserves a range of positions with a single atomic add, fills in
+ * its slots, and then commits the range. Ranges are committed in the order
+ * they were reserved, so the committed elements always form a prefix of the
+ * array, which readers may scan without locking.
+ *
+ * Elements cannot be removed or reordered; use an ss_array for that, once
+ * writing is finished.
+ *
+ * Use GENERATE_CONCURRENT_ARRAY, or the DECLARE and DEFINE variants as with
+ * ss_array.h. Requires a C11 compiler with stdatomic.h.
+ */
+
+#include <limits.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// The number of elements in the first segment. Each later segment is twice the
+// size of the one before it.
+#ifndef SS_CONCURRENT_ARRAY_FIRST_SEGMENT
+    #define SS_CONCURRENT_ARRAY_FIRST_SEGMENT 64
+#endif
+
+// Enough segments to hold SIZE_MAX elements.
+#define SS_CONCURRENT_ARRAY_NUM_SEGMENTS (sizeof(size_t) * CHAR_BIT)
+
+// Find the segment holding position `pos`, and set `*offset` to the position
+// within that segment.
+static inline size_t ss_concurrent_array_segment_(size_t pos, size_t *offset) {
+    size_t n = pos / SS_CONCURRENT_ARRAY_FIRST_SEGMENT + 1;
+    size_t k = 0;
+
+#ifdef __GNUC__
+    k = sizeof(unsigned long long) * CHAR_BIT - 1
+        - (size_t) __builtin_clzll((unsigned long long) n);
+#else
+    while (n >>= 1) { k += 1; }
+#endif
+
+    *offset = pos - SS_CONCURRENT_ARRAY_FIRST_SEGMENT * (((size_t) 1 << k) - 1);
+    return k;
+}
+
+// Get the number of elements in segment `k`.
+static inline size_t ss_concurrent_array_segment_len_(size_t k) {
+    return (size_t) SS_CONCURRENT_ARRAY_FIRST_SEGMENT << k;
+}
+
+// Record that the reservation starting at `pos` failed, if no earlier one has.
+static inline void ss_concurrent_array_fail_(
+    atomic_size_t *failed,
+    size_t pos
+) {
+    size_t current = atomic_load(failed);
+    while (pos < current
+        && ! atomic_compare_exchange_weak(failed, &current, pos)
+    ) {}
+}
+
+#define DECLARE_CONCURRENT_ARRAY(T) DECLARE_CONCURRENT_ARRAY2(T, T)
+
+#define DECLARE_CONCURRENT_ARRAY2(T, LBL)                                      \
+struct ss_concurrent_array_##LBL;                                              \
+                                                                               \
+/* Create a new, empty concurrent array.                                       \
+ *                                                                             \
+ * Returns NULL on failure to allocate memory.                                 \
+ */                                                                            \
+struct ss_concurrent_array_##LBL *ss_concurrent_array_##LBL##_create();        \
+                                                                               \
+/* Free the provided array and set its pointer to NULL.                        \
+ *                                                                             \
+ * Calls a free function on each committed element if one is provided. No other\
+ * thread may be using the array.                                              \
+ */                                                                            \
+void ss_concurrent_array_##LBL##_free(                                         \
+    struct ss_concurrent_array_##LBL **array,                                  \
+    void (*f)(T** elem)                                                        \
+);                                                                             \
+                                                                               \
+/* Append `num_elems` elements to the array as one contiguous range of         \
+ * positions.                                                                  \
+ *                                                                             \
+ * May be called from any number of threads at once. The elements are visible  \
+ * to readers once every range reserved before them has been committed as well.\
+ *                                                                             \
+ * Returns false if `array` or `data` is NULL, `num_elems` is 0, or on failure \
+ * to allocate memory.                                                         \
+ */                                                                            \
+bool ss_concurrent_array_##LBL##_append_data(                                  \
+    struct ss_concurrent_array_##LBL *array,                                   \
+    T *data,                                                                   \
+    size_t num_elems                                                           \
+);                                                                             \
+                                                                               \
+/* Reserve `num_elems` positions at the end of the array, to be filled in with \
+ * [ss_concurrent_array_##LBL##_slot] and published with                       \
+ * [ss_concurrent_array_##LBL##_commit].                                       \
+ *                                                                             \
+ * May be called from any number of threads at once. Every reservation must be \
+ * committed, or later ones will never become visible.                         \
+ *                                                                             \
+ * Returns the first reserved position, or SIZE_MAX if `array` is NULL,        \
+ * `num_elems` is 0, or on failure to allocate memory.                         \
+ */                                                                            \
+size_t ss_concurrent_array_##LBL##_reserve(                                    \
+    struct ss_concurrent_array_##LBL *array,                                   \
+    size_t num_elems                                                           \
+);                                                                             \
+                                                                               \
+/* Get a pointer to the reserved slot at position `pos` for writing.           \
+ *                                                                             \
+ * A range of reserved slots may span several segments; get each slot's        \
+ * pointer separately, or use [ss_concurrent_array_##LBL##_chunk] once it is   \
+ * committed.                                                                  \
+ *                                                                             \
+ * Returns NULL if `pos` has not been reserved.                                \
+ */                                                                            \
+T *ss_concurrent_array_##LBL##_slot(                                           \
+    struct ss_concurrent_array_##LBL *array,                                   \
+    size_t pos                                                                 \
+);                                                                             \
+                                                                               \
+/* Publish the `num_elems` positions reserved starting at `begin`.             \
+ *                                                                             \
+ * Ranges become visible in the order they were reserved, so this waits until  \
+ * all earlier reservations have been committed.                               \
+ *                                                                             \
+ * Returns false if an earlier reservation failed to allocate, in which case   \
+ * the range will never become visible.                                        \
+ */                                                                            \
+bool ss_concurrent_array_##LBL##_commit(                                       \
+    struct ss_concurrent_array_##LBL *array,                                   \
+    size_t begin,                                                              \
+    size_t num_elems                                                           \
+);                                                                             \
+                                                                               \
+/* Get the number of committed elements.                                       \
+ *                                                                             \
+ * Positions below the returned length may be read without locking while other \
+ * threads append.                                                             \
+ */                                                                            \
+size_t ss_concurrent_array_##LBL##_len(                                        \
+    const struct ss_concurrent_array_##LBL *array                              \
+);                                                                             \
+                                                                               \
+/* Get a pointer to the committed element at position `pos`.                   \
+ *                                                                             \
+ * Elements never move, so the pointer is valid until the array is freed.      \
+ *                                                                             \
+ * Returns NULL if `pos` has not been committed.                               \
+ */                                                                            \
+T *ss_concurrent_array_##LBL##_get(                                            \
+    struct ss_concurrent_array_##LBL *array,                                   \
+    size_t pos                                                                 \
+);                                                                             \
+                                                                               \
+/* Get the run of committed elements stored contiguously starting at `pos`,    \
+ * and set `*len` to its length.                                               \
+ *                                                                             \
+ * Scanning with this reads a segment at a time rather than an element at a    \
+ * time.                                                                       \
+ *                                                                             \
+ * Returns NULL and sets `*len` to 0 if `pos` has not been committed.          \
+ */                                                                            \
+T *ss_concurrent_array_##LBL##_chunk(                                          \
+    struct ss_concurrent_array_##LBL *array,                                   \
+    size_t pos,                                                                \
+    size_t *len                                                                \
+);
+
+#define DEFINE_CONCURRENT_ARRAY(T) DEFINE_CONCURRENT_ARRAY2(T, T)
+
+// Use label for cases when type spans multiple words, is a pointer, etc.
+#define DEFINE_CONCURRENT_ARRAY2(T, LBL)                                       \
+struct ss_concurrent_array_##LBL {                                             \
+    /* The number of positions handed out */                                   \
+    atomic_size_t reserved;                                                    \
+    /* The number of positions visible to readers */                           \
+    atomic_size_t committed;                                                   \
+    /* The first position that could not be allocated, or SIZE_MAX */          \
+    atomic_size_t failed;                                                      \
+    _Atomic(T*) segments[SS_CONCURRENT_ARRAY_NUM_SEGMENTS];                    \
+};                                                                             \
+                                                                               \
+struct ss_concurrent_array_##LBL *ss_concurrent_array_##LBL##_create() {       \
+    struct ss_concurrent_array_##LBL *array =                                  \
+        (struct ss_concurrent_array_##LBL*) malloc(                            \
+            sizeof(struct ss_concurrent_array_##LBL));                         \
+    if (array == NULL) return NULL;                                            \
+                                                                               \
+    atomic_init(&array->reserved, 0);                                          \
+    atomic_init(&array->committed, 0);                                         \
+    atomic_init(&array->failed, SIZE_MAX);                                     \
+    for (size_t i = 0; i < SS_CONCURRENT_ARRAY_NUM_SEGMENTS; ++i) {            \
+        atomic_init(&array->segments[i], NULL);                                \
+    }                                                                          \
+                                                                               \
+    return array;                                                              \
+}                                                                              \
+                                                                               \
+void ss_concurrent_array_##LBL##_free(                                         \
+    struct ss_concurrent_array_##LBL **array,                                  \
+    void (*f)(T** elem)                                                        \
+) {                                                                            \
+    if (array == NULL || *array == NULL) return;                               \
+                                                                               \
+    if (f != NULL) {                                                           \
+        size_t len = atomic_load(&(*array)->committed);                        \
+        for (size_t i = 0; i < len; ++i) {                                     \
+            T *tmp = ss_concurrent_array_##LBL##_get(*array, i);               \
+            f(&tmp);                                                           \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    for (size_t i = 0; i < SS_CONCURRENT_ARRAY_NUM_SEGMENTS; ++i) {            \
+        free(atomic_load(&(*array)->segments[i]));                             \
+    }                                                                          \
+    free(*array);                                                              \
+    *array = NULL;                                                             \
+}                                                                              \
+                                                                               \
+size_t ss_concurrent_array_##LBL##_reserve(                                    \
+    struct ss_concurrent_array_##LBL *array,                                   \
+    size_t num_elems                                                           \
+) {                                                                            \
+    if (array == NULL || num_elems == 0) return SIZE_MAX;                      \
+                                                                               \
+    size_t begin = atomic_fetch_add_explicit(&array->reserved, num_elems,      \
+        memory_order_relaxed);                                                 \
+                                                                               \
+    /* Allocate any segments the range reaches that no one has yet. */         \
+    size_t offset = 0;                                                         \
+    size_t first = ss_concurrent_array_segment_(begin, &offset);               \
+    size_t last = ss_concurrent_array_segment_(begin + num_elems - 1, &offset);\
+                                                                               \
+    for (size_t k = first; k <= last; ++k) {                                   \
+        if (atomic_load_explicit(&array->segments[k], memory_order_acquire)    \
+            != NULL                                                            \
+        ) {                                                                    \
+            continue;                                                          \
+        }                                                                      \
+                                                                               \
+        T *segment = (T*) malloc(ss_concurrent_array_segment_len_(k)           \
+            * sizeof(T));                                                      \
+        if (segment == NULL) {                                                 \
+            ss_concurrent_array_fail_(&array->failed, begin);                  \
+            return SIZE_MAX;                                                   \
+        }                                                                      \
+                                                                               \
+        T *expected = NULL;                                                    \
+        if (! atomic_compare_exchange_strong_explicit(&array->segments[k],     \
+            &expected, segment, memory_order_acq_rel, memory_order_acquire)    \
+        ) {                                                                    \
+            free(segment);                                                     \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    return begin;                                                              \
+}                                                                              \
+                                                                               \
+T *ss_concurrent_array_##LBL##_slot(                                           \
+    struct ss_concurrent_array_##LBL *array,                                   \
+    size_t pos                                                                 \
+) {                                                                            \
+    if (array == NULL                                                          \
+        || pos >= atomic_load_explicit(&array->reserved, memory_order_relaxed) \
+    ) {                                                                        \
+        return NULL;                                                           \
+    }                                                                          \
+                                                                               \
+    size_t offset = 0;                                                         \
+    size_t k = ss_concurrent_array_segment_(pos, &offset);                     \
+    T *segment =                                                               \
+        atomic_load_explicit(&array->segments[k], memory_order_acquire);       \
+                                                                               \
+    return segment == NULL ? NULL : segment + offset;                          \
+}                                                                              \
+                                                                               \
+bool ss_concurrent_array_##LBL##_commit(                                       \
+    struct ss_concurrent_array_##LBL *array,                                   \
+    size_t begin,                                                              \
+    size_t num_elems                                                           \
+) {                                                                            \
+    if (array == NULL) return false;                                           \
+                                                                               \
+    while (atomic_load_explicit(&array->committed, memory_order_acquire)       \
+        != begin                                                               \
+    ) {                                                                        \
+        if (begin >= atomic_load(&array->failed)) return false;                \
+        sched_yield();                                                         \
+    }                                                                          \
+                                                                               \
+    atomic_store_explicit(&array->committed, begin + num_elems,                \
+        memory_order_release);                                                 \
+    return true;                                                               \
+}                                                                              \
+                                                                               \
+bool ss_concurrent_array_##LBL##_append_data(                                  \
+    struct ss_concurrent_array_##LBL *array,                                   \
+    T *data,                                                                   \
+    size_t num_elems                                                           \
+) {                                                                            \
+    if (data == NULL) return false;                                            \
+                                                                               \
+    size_t begin = ss_concurrent_array_##LBL##_reserve(array, num_elems);      \
+    if (begin == SIZE_MAX) return false;                                       \
+                                                                               \
+    /* Copy a segment at a time. */                                            \
+    size_t pos = begin;                                                        \
+    size_t end = begin + num_elems;                                            \
+                                                                               \
+    while (pos < end) {                                                        \
+        size_t offset = 0;                                                     \
+        size_t k = ss_concurrent_array_segment_(pos, &offset);                 \
+        size_t run = ss_concurrent_array_segment_len_(k) - offset;             \
+        if (run > end - pos) { run = end - pos; }                              \
+                                                                               \
+        T *segment =                                                           \
+            atomic_load_explicit(&array->segments[k], memory_order_acquire);   \
+        memcpy(segment + offset, data + (pos - begin), run * sizeof(T));       \
+        pos += run;                                                            \
+    }                                                                          \
+                                                                               \
+    return ss_concurrent_array_##LBL##_commit(array, begin, num_elems);        \
+}                                                                              \
+                                                                               \
+size_t ss_concurrent_array_##LBL##_len(                                        \
+    const struct ss_concurrent_array_##LBL *array                              \
+) {                                                                            \
+    if (array == NULL) return 0;                                               \
+    return atomic_load_explicit(&array->committed, memory_order_acquire);      \
+}                                                                              \
+                                                                               \
+T *ss_concurrent_array_##LBL##_get(                                            \
+    struct ss_concurrent_array_##LBL *array,                                   \
+    size_t pos                                                                 \
+) {                                                                            \
+    size_t len = 0;                                                            \
+    return ss_concurrent_array_##LBL##_chunk(array, pos, &len);                \
+}                                                                              \
+                                                                               \
+T *ss_concurrent_array_##LBL##_chunk(                                          \
+    struct ss_concurrent_array_##LBL *array,                                   \
+    size_t pos,                                                                \
+    size_t *len                                                                \
+) {                                                                            \
+    if (len == NULL) return NULL;                                              \
+    *len = 0;                                                                  \
+                                                                               \
+    size_t committed = ss_concurrent_array_##LBL##_len(array);                 \
+    if (pos >= committed) return NULL;                                         \
+                                                                               \
+    size_t offset = 0;                                                         \
+    size_t k = ss_concurrent_array_segment_(pos, &offset);                     \
+    T *segment =                                                               \
+        atomic_load_explicit(&array->segments[k], memory_order_acquire);       \
+                                                                               \
+    *len = ss_concurrent_array_segment_len_(k) - offset;                       \
+    if (*len > committed - pos) { *len = committed - pos; }                    \
+                                                                               \
+    return segment + offset;                                                   \
+}
+
+#define GENERATE_CONCURRENT_ARRAY(T) GENERATE_CONCURRENT_ARRAY2(T, T)
+
+// Declare and define a concurrent array type in one step.
+#define GENERATE_CONCURRENT_ARRAY2(T, LBL)                                     \
+    DECLARE_CONCURRENT_ARRAY2(T, LBL)                                          \
+    DEFINE_CONCURRENT_ARRAY2(T, LBL)
+
+#endif
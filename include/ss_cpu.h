@@ -0,0 +1,99 @@
+#ifndef SS_LIB_CPU_H
+#define SS_LIB_CPU_H
+
+/* This Source Code Form is subject to the terms of the Mozilla Public License,
+ * v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ * obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/* CPU feature detection and kernel dispatch.
+ *
+ * The instruction sets of the CPU are detected once, on first use. A kernel
+ * with several implementations keeps them in an [ss_cpu_dispatch] table, one
+ * per instruction set; the best one the CPU supports is chosen on the
+ * kernel's first call and cached in the table, so later calls cost one atomic
+ * load and an indirect call. This lets one build run the fastest available
+ * code on each machine.
+ *
+ * Setting the SS_FORCE_ISA environment variable to "scalar", "sse2", "ssse3",
+ * "avx2", or "avx512" limits the instruction sets used to that one and those
+ * below it, to test or compare the slower paths. It cannot enable an
+ * instruction set the CPU lacks; other values are ignored.
+ *
+ * On platforms other than x86 with GCC or Clang, only the scalar level is
+ * detected.
+ *
+ *  Requires:
+ *
+ *  A C11 compiler with stdatomic.h
+ */
+
+#include <stdatomic.h>
+#include <stdbool.h>
+
+// Instruction set levels, each including those below it.
+enum ss_cpu_isa {
+    SS_CPU_SCALAR,
+    SS_CPU_SSE2,
+    SS_CPU_SSSE3,
+    SS_CPU_AVX2,
+    // AVX-512 F, BW, DQ, and VL.
+    SS_CPU_AVX512,
+    SS_CPU_ISA_COUNT
+};
+
+// A type-erased function pointer; cast back to the kernel's own type to call.
+typedef void (*ss_cpu_fn)(void);
+
+// The implementations of a kernel, indexed by the level they require.
+//
+// Define tables with static storage, filling in `impls` for the levels that
+// have an implementation; a level without one falls back to the next one
+// below it. Leave the other members zeroed.
+struct ss_cpu_dispatch {
+    ss_cpu_fn impls[SS_CPU_ISA_COUNT];
+    _Atomic(ss_cpu_fn) chosen_;
+    atomic_uint generation_;
+};
+
+// Get the best instruction set level available, after any limit set by
+// SS_FORCE_ISA or [ss_cpu_force_isa].
+enum ss_cpu_isa ss_cpu_isa(void);
+
+// Check whether code for the given level may be used.
+bool ss_cpu_supports(enum ss_cpu_isa isa);
+
+// Get the lowercase name of a level, as used by SS_FORCE_ISA.
+//
+// Returns NULL if `isa` is not a level.
+const char *ss_cpu_isa_name(enum ss_cpu_isa isa);
+
+// Limit the instruction sets used to `isa` and those below it, replacing any
+// limit set by SS_FORCE_ISA, and choose again the implementations of all
+// kernels on their next call.
+//
+// This is meant for tests; it must not be called while kernels run on other
+// threads.
+//
+// Returns the level now in use, which is lower than `isa` if the CPU does not
+// support it.
+enum ss_cpu_isa ss_cpu_force_isa(enum ss_cpu_isa isa);
+
+// Get the implementation of a kernel for the current level: the one at that
+// level, or else the closest one below it.
+//
+// Returns NULL if there is none at or below the current level.
+ss_cpu_fn ss_cpu_resolve(struct ss_cpu_dispatch *dispatch);
+
+// Add or replace the implementation of a kernel at the given level.
+//
+// This must not be called while the kernel runs on other threads.
+//
+// Returns false if dispatch is NULL or `isa` is not a level.
+bool ss_cpu_register(
+    struct ss_cpu_dispatch *dispatch,
+    enum ss_cpu_isa isa,
+    ss_cpu_fn fn
+);
+
+#endif
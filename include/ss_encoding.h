@@ -0,0 +1,157 @@
+#ifndef SS_LIB_ENCODING_H
+#define SS_LIB_ENCODING_H
+
+/* This Source Code Form is subject to the terms of the Mozilla Public License,
+ * v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ * obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/* Hex and base64 encoding into ss_string, decoding into byte arrays, and JSON
+ * and CSV escaping.
+ *
+ * Encoders write directly into the destination string's spare capacity, and
+ * decoders directly into the destination array's, after reserving the full
+ * output size (or worst-case size, for escaping) once.
+ *
+ * On x86 with GCC or Clang, hex encoding and decoding use SSE2, and base64
+ * encoding and decoding use SSSE3 when ss_cpu.h reports it available. The escaping
+ * functions use SSE2 to find the chars that need escaping and copy the runs
+ * between them in bulk. Other platforms use scalar code.
+ *
+ * Base64 uses the standard alphabet (RFC 4648) with '=' padding. The decoder
+ * also accepts unpadded input, but not whitespace.
+ *
+ *  Requires:
+ *
+ *  ss_array.h
+ *  ss_cpu.h
+ *  ss_math.h
+ *  ss_string.h
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ss_array.h"
+#include "ss_string.h"
+
+// A byte array for decoded data; see ss_array.h for its functions.
+DECLARE_ARRAY2(uint8_t, bytes)
+
+// Append the lowercase hex encoding of `len` bytes of `data` to `dest`.
+//
+// Returns:
+//
+// Returns true on success.
+//
+// If either dest or data are null or `len` is 0, does nothing and returns
+// false.
+//
+// On failure to allocate, returns false and leaves dest unchanged.
+bool ss_string_append_hex(
+    struct ss_string *dest,
+    const uint8_t *data,
+    size_t len
+);
+
+// Append the base64 encoding of `len` bytes of `data` to `dest`.
+//
+// Returns:
+//
+// Returns true on success.
+//
+// If either dest or data are null or `len` is 0, does nothing and returns
+// false.
+//
+// On failure to allocate, returns false and leaves dest unchanged.
+bool ss_string_append_base64(
+    struct ss_string *dest,
+    const uint8_t *data,
+    size_t len
+);
+
+// Append `len` chars of `src` to `dest`, escaped for use in a JSON string.
+//
+// Quotes, backslashes, and control chars are escaped; all other bytes
+// (including UTF-8 sequences) are copied unchanged. The surrounding quotes are
+// not added.
+//
+// Returns:
+//
+// Returns true on success.
+//
+// If either dest or src are null or `len` is 0, does nothing and returns
+// false.
+//
+// On failure to allocate, returns false and leaves dest unchanged.
+bool ss_string_append_json_escaped(
+    struct ss_string *dest,
+    const char *src,
+    size_t len
+);
+
+// Append `len` chars of `src` to `dest` as a CSV field (RFC 4180).
+//
+// If the field contains a comma, quote, CR, or LF, it is enclosed in quotes and
+// any quotes within it are doubled; otherwise it is copied unchanged. The
+// separating comma is not added.
+//
+// Returns:
+//
+// Returns true on success.
+//
+// If either dest or src are null or `len` is 0, does nothing and returns
+// false.
+//
+// On failure to allocate, returns false and leaves dest unchanged.
+bool ss_string_append_csv_field(
+    struct ss_string *dest,
+    const char *src,
+    size_t len
+);
+
+// Decode `len` hex chars from `src`, appending the bytes to `dest`.
+//
+// Upper- and lowercase digits are accepted.
+//
+// Returns:
+//
+// Returns true on success.
+//
+// If either dest or src are null, if `len` is 0 or odd, or if `src` contains a
+// non-hex char, returns false and leaves dest unchanged.
+//
+// On failure to allocate, returns false and leaves dest unchanged.
+bool ss_hex_decode(struct ss_array_bytes *dest, const char *src, size_t len);
+
+// Decode `len` base64 chars from `src`, appending the bytes to `dest`.
+//
+// Returns:
+//
+// Returns true on success.
+//
+// If either dest or src are null, if `len` is 0, or if `src` is not valid
+// base64, returns false and leaves dest unchanged.
+//
+// On failure to allocate, returns false and leaves dest unchanged.
+bool ss_base64_decode(struct ss_array_bytes *dest, const char *src, size_t len);
+
+// Decode `len` hex chars from `src` into `out`, which must have room for
+// `len / 2` bytes.
+//
+// Returns false if `len` is odd or `src` contains a non-hex char.
+bool ss_hex_decode_buffer(const char *src, size_t len, uint8_t *out);
+
+// Get the number of bytes that `len` chars of base64 in `src` decode to.
+//
+// Returns 0 if `len` is not a valid base64 length.
+size_t ss_base64_decoded_len(const char *src, size_t len);
+
+// Decode `len` base64 chars from `src` into `out`, which must have room for
+// [ss_base64_decoded_len] bytes.
+//
+// Returns false if `src` is not valid base64.
+bool ss_base64_decode_buffer(const char *src, size_t len, uint8_t *out);
+
+#endif
@@ -0,0 +1,297 @@
+#ifndef SS_HEAP_H
+#define SS_HEAP_H
+
+/* This Source Code Form is subject to the terms of the Mozilla Public License,
+ * v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ * obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/* Typesafe binary and d-ary heaps (priority queues).
+ *
+ * A heap keeps its elements in an ss_array of the same label, so it grows the
+ * same way an array does, and an existing array can be turned into a heap in
+ * linear time without copying it.
+ *
+ * The ordering is given by LESS, a function or function-like macro called as
+ * `LESS(const T *a, const T *b)` that returns true if `a` should come out of
+ * the heap before `b`. The first element of the heap is one that no other
+ * element is less than, so a LESS that compares with `<` gives a min-heap.
+ *
+ * GENERATE_HEAP gives a binary heap. GENERATE_DARY_HEAP2 lets each node have
+ * `D` children instead: a 4-ary heap is about half as deep as a binary heap
+ * and compares children that are next to each other in memory, which is often
+ * faster when pops are common; pushes are always cheaper with a wider heap.
+ *
+ * Use DECLARE_HEAP in a header and DEFINE_HEAP in a source file, or
+ * GENERATE_HEAP, as with ss_array.h. The array type must be declared first,
+ * and defined in the same source file as the heap.
+ *
+ * Requires: ss_array.h
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+#include "ss_array.h"
+
+#define DECLARE_HEAP(T) DECLARE_HEAP2(T, T)
+
+#define DECLARE_HEAP2(T, LBL)                                                  \
+struct ss_heap_##LBL;                                                          \
+                                                                               \
+/* Create a new, empty heap.                                                   \
+ *                                                                             \
+ * Returns NULL on failure to allocate memory.                                 \
+ */                                                                            \
+struct ss_heap_##LBL *ss_heap_##LBL##_create();                                \
+                                                                               \
+/* Create a new, empty heap with room for `num_elems` elements.                \
+ *                                                                             \
+ * Returns NULL on failure to allocate memory.                                 \
+ */                                                                            \
+struct ss_heap_##LBL *ss_heap_##LBL##_create_with_size(size_t num_elems);      \
+                                                                               \
+/* Create a heap from the elements of an array, taking ownership of the array  \
+ * and setting its pointer to NULL.                                            \
+ *                                                                             \
+ * The elements are rearranged into heap order in linear time.                 \
+ *                                                                             \
+ * Returns NULL if `array` is NULL or on failure to allocate memory, in which  \
+ * case the array is left with the caller.                                     \
+ */                                                                            \
+struct ss_heap_##LBL *ss_heap_##LBL##_create_from_array(                       \
+    struct ss_array_##LBL **array                                              \
+);                                                                             \
+                                                                               \
+/* Free the provided heap and set its pointer to NULL.                         \
+ *                                                                             \
+ * Calls a free function on each element of the heap if one is provided.       \
+ */                                                                            \
+void ss_heap_##LBL##_free(struct ss_heap_##LBL **heap, void (*f)(T** elem));   \
+                                                                               \
+/* Free the heap, set its pointer to NULL, and return its elements as an array,\
+ * in heap order.                                                              \
+ *                                                                             \
+ * Returns NULL if `heap` is NULL.                                             \
+ */                                                                            \
+struct ss_array_##LBL *ss_heap_##LBL##_dissolve(struct ss_heap_##LBL **heap);  \
+                                                                               \
+/* Get the number of elements in the heap. */                                  \
+size_t ss_heap_##LBL##_len(const struct ss_heap_##LBL *heap);                  \
+                                                                               \
+/* Check whether the heap is empty. */                                         \
+bool ss_heap_##LBL##_is_empty(const struct ss_heap_##LBL *heap);               \
+                                                                               \
+/* Add an element to the heap.                                                 \
+ *                                                                             \
+ * Returns false if heap is NULL, or on failure to allocate memory.            \
+ */                                                                            \
+bool ss_heap_##LBL##_push(struct ss_heap_##LBL *heap, T elem);                 \
+                                                                               \
+/* Get the first element of the heap: the one no other element is less than.   \
+ *                                                                             \
+ * Returns NULL if the heap is empty. The element must not be modified in a way\
+ * that changes its order.                                                     \
+ */                                                                            \
+const T *ss_heap_##LBL##_peek(const struct ss_heap_##LBL *heap);               \
+                                                                               \
+/* Remove the first element of the heap into `*elem`.                          \
+ *                                                                             \
+ * Returns false if the heap is empty.                                         \
+ */                                                                            \
+bool ss_heap_##LBL##_pop(struct ss_heap_##LBL *heap, T *elem);                 \
+                                                                               \
+/* Remove the first element of the heap into `*elem` and add `new_elem`, more  \
+ * quickly than a pop followed by a push.                                      \
+ *                                                                             \
+ * Returns false and adds nothing if the heap is empty.                        \
+ */                                                                            \
+bool ss_heap_##LBL##_replace(struct ss_heap_##LBL *heap, T new_elem, T *elem); \
+                                                                               \
+/* Add an element to a heap holding at most `k` elements, keeping the `k`      \
+ * greatest elements seen.                                                     \
+ *                                                                             \
+ * If the heap is full, `elem` replaces the first element if it is greater,    \
+ * and is dropped otherwise. Dropped elements are not freed.                   \
+ *                                                                             \
+ * Returns true if `elem` was added.                                           \
+ */                                                                            \
+bool ss_heap_##LBL##_push_top_k(struct ss_heap_##LBL *heap, T elem, size_t k);
+
+#define DEFINE_HEAP(T, LESS) DEFINE_HEAP2(T, T, LESS)
+
+// Use label for cases when type spans multiple words, is a pointer, etc.
+#define DEFINE_HEAP2(T, LBL, LESS) DEFINE_DARY_HEAP2(T, LBL, LESS, 2)
+
+// Define a heap in which each node has `D` children.
+#define DEFINE_DARY_HEAP2(T, LBL, LESS, D)                                     \
+struct ss_heap_##LBL {                                                         \
+    struct ss_array_##LBL *array;                                              \
+};                                                                             \
+                                                                               \
+/* Move the element at `pos` toward the root until its parent is not greater.  \
+ */                                                                            \
+void ss_heap_##LBL##_sift_up_(T *data, size_t pos) {                           \
+    T elem = data[pos];                                                        \
+                                                                               \
+    while (pos > 0) {                                                          \
+        size_t parent = (pos - 1) / (D);                                       \
+        if (! (LESS(&elem, &data[parent]))) break;                             \
+                                                                               \
+        data[pos] = data[parent];                                              \
+        pos = parent;                                                          \
+    }                                                                          \
+    data[pos] = elem;                                                          \
+}                                                                              \
+                                                                               \
+/* Move the element at `pos` toward the leaves until no child is less. */      \
+void ss_heap_##LBL##_sift_down_(T *data, size_t len, size_t pos) {             \
+    T elem = data[pos];                                                        \
+                                                                               \
+    while (true) {                                                             \
+        size_t first = pos * (D) + 1;                                          \
+        if (first >= len) break;                                               \
+                                                                               \
+        size_t end = len - first < (D) ? len : first + (D);                    \
+        size_t least = first;                                                  \
+        for (size_t c = first + 1; c < end; ++c) {                             \
+            if (LESS(&data[c], &data[least])) { least = c; }                   \
+        }                                                                      \
+                                                                               \
+        if (! (LESS(&data[least], &elem))) break;                              \
+                                                                               \
+        data[pos] = data[least];                                               \
+        pos = least;                                                           \
+    }                                                                          \
+    data[pos] = elem;                                                          \
+}                                                                              \
+                                                                               \
+struct ss_heap_##LBL *ss_heap_##LBL##_create() {                               \
+    return ss_heap_##LBL##_create_with_size(0);                                \
+}                                                                              \
+                                                                               \
+struct ss_heap_##LBL *ss_heap_##LBL##_create_with_size(size_t num_elems) {     \
+    struct ss_array_##LBL *array = num_elems == 0                              \
+        ? ss_array_##LBL##_create()                                            \
+        : ss_array_##LBL##_create_with_size(num_elems);                        \
+    if (array == NULL) return NULL;                                            \
+                                                                               \
+    struct ss_heap_##LBL *heap = ss_heap_##LBL##_create_from_array(&array);    \
+    if (heap == NULL) { ss_array_##LBL##_free(&array, NULL); }                 \
+                                                                               \
+    return heap;                                                               \
+}                                                                              \
+                                                                               \
+struct ss_heap_##LBL *ss_heap_##LBL##_create_from_array(                       \
+    struct ss_array_##LBL **array                                              \
+) {                                                                            \
+    if (array == NULL || *array == NULL) return NULL;                          \
+                                                                               \
+    struct ss_heap_##LBL *heap =                                               \
+        (struct ss_heap_##LBL*) malloc(sizeof(struct ss_heap_##LBL));          \
+    if (heap == NULL) return NULL;                                             \
+                                                                               \
+    heap->array = *array;                                                      \
+    *array = NULL;                                                             \
+                                                                               \
+    /* Sift down every element with children, from the last up. */             \
+    size_t len = heap->array->len;                                             \
+    if (len > 1) {                                                             \
+        for (size_t i = (len - 2) / (D) + 1; i > 0; --i) {                     \
+            ss_heap_##LBL##_sift_down_(heap->array->data, len, i - 1);         \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    return heap;                                                               \
+}                                                                              \
+                                                                               \
+void ss_heap_##LBL##_free(struct ss_heap_##LBL **heap, void (*f)(T** elem)) {  \
+    if (heap == NULL || *heap == NULL) return;                                 \
+                                                                               \
+    ss_array_##LBL##_free(&(*heap)->array, f);                                 \
+    free(*heap);                                                               \
+    *heap = NULL;                                                              \
+}                                                                              \
+                                                                               \
+struct ss_array_##LBL *ss_heap_##LBL##_dissolve(struct ss_heap_##LBL **heap) { \
+    if (heap == NULL || *heap == NULL) return NULL;                            \
+                                                                               \
+    struct ss_array_##LBL *array = (*heap)->array;                             \
+    free(*heap);                                                               \
+    *heap = NULL;                                                              \
+                                                                               \
+    return array;                                                              \
+}                                                                              \
+                                                                               \
+size_t ss_heap_##LBL##_len(const struct ss_heap_##LBL *heap) {                 \
+    if (heap == NULL) return 0;                                                \
+    return heap->array->len;                                                   \
+}                                                                              \
+                                                                               \
+bool ss_heap_##LBL##_is_empty(const struct ss_heap_##LBL *heap) {              \
+    return ss_heap_##LBL##_len(heap) == 0;                                     \
+}                                                                              \
+                                                                               \
+bool ss_heap_##LBL##_push(struct ss_heap_##LBL *heap, T elem) {                \
+    if (heap == NULL) return false;                                            \
+    if (! ss_array_##LBL##_append_data(heap->array, &elem, 1)) return false;   \
+                                                                               \
+    ss_heap_##LBL##_sift_up_(heap->array->data, heap->array->len - 1);         \
+    return true;                                                               \
+}                                                                              \
+                                                                               \
+const T *ss_heap_##LBL##_peek(const struct ss_heap_##LBL *heap) {              \
+    if (ss_heap_##LBL##_is_empty(heap)) return NULL;                           \
+    return &heap->array->data[0];                                              \
+}                                                                              \
+                                                                               \
+bool ss_heap_##LBL##_pop(struct ss_heap_##LBL *heap, T *elem) {                \
+    if (ss_heap_##LBL##_is_empty(heap) || elem == NULL) return false;          \
+                                                                               \
+    struct ss_array_##LBL *array = heap->array;                                \
+    *elem = array->data[0];                                                    \
+    array->len -= 1;                                                           \
+                                                                               \
+    if (array->len > 0) {                                                      \
+        array->data[0] = array->data[array->len];                              \
+        ss_heap_##LBL##_sift_down_(array->data, array->len, 0);                \
+    }                                                                          \
+    return true;                                                               \
+}                                                                              \
+                                                                               \
+bool ss_heap_##LBL##_replace(struct ss_heap_##LBL *heap, T new_elem, T *elem)  \
+{                                                                              \
+    if (ss_heap_##LBL##_is_empty(heap) || elem == NULL) return false;          \
+                                                                               \
+    *elem = heap->array->data[0];                                              \
+    heap->array->data[0] = new_elem;                                           \
+    ss_heap_##LBL##_sift_down_(heap->array->data, heap->array->len, 0);        \
+                                                                               \
+    return true;                                                               \
+}                                                                              \
+                                                                               \
+bool ss_heap_##LBL##_push_top_k(struct ss_heap_##LBL *heap, T elem, size_t k) {\
+    if (heap == NULL || k == 0) return false;                                  \
+                                                                               \
+    if (heap->array->len < k) return ss_heap_##LBL##_push(heap, elem);         \
+    if (! (LESS(&heap->array->data[0], &elem))) return false;                  \
+                                                                               \
+    heap->array->data[0] = elem;                                               \
+    ss_heap_##LBL##_sift_down_(heap->array->data, heap->array->len, 0);        \
+    return true;                                                               \
+}
+
+#define GENERATE_HEAP(T, LESS) GENERATE_HEAP2(T, T, LESS)
+
+// Declare and define a binary heap in one step.
+#define GENERATE_HEAP2(T, LBL, LESS)                                           \
+    DECLARE_HEAP2(T, LBL)                                                      \
+    DEFINE_HEAP2(T, LBL, LESS)
+
+// Declare and define a heap in which each node has `D` children in one step.
+#define GENERATE_DARY_HEAP2(T, LBL, LESS, D)                                   \
+    DECLARE_HEAP2(T, LBL)                                                      \
+    DEFINE_DARY_HEAP2(T, LBL, LESS, D)
+
+#endif
@@ -6,11 +6,36 @@
  * obtain one at https://mozilla.org/MPL/2.0/.
  */
 
+#include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 
 // If num is a power of two, returns num. Otherwise returns the next-highest
 // power of two.
 uint64_t next_pow_of_two(uint64_t num);
 
+// The finalizer of MurmurHash3, which spreads every input bit over the output.
+static inline uint64_t ss_hash_mix(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDull;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ull;
+    h ^= h >> 33;
+    return h;
+}
+
+// Zero `len` bytes in a way the optimizer will not remove, even if the memory
+// is never read again.
+static inline void ss_secure_zero(void *data, size_t len) {
+#ifdef __GNUC__
+    memset(data, 0, len);
+    // Tell the compiler the zeroed memory may be read.
+    __asm__ __volatile__("" : : "r"(data) : "memory");
+#else
+    volatile unsigned char *bytes = (volatile unsigned char*) data;
+    for (size_t i = 0; i < len; ++i) { bytes[i] = 0; }
+#endif
+}
+
 #endif
 
@@ -0,0 +1,146 @@
+#ifndef SS_LIB_MULTISEARCH_H
+#define SS_LIB_MULTISEARCH_H
+
+/* This Source Code Form is subject to the terms of the Mozilla Public License,
+ * v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ * obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/* Search for many patterns at once (Aho-Corasick).
+ *
+ * A pattern set is compiled once into a deterministic automaton, which can then
+ * scan any number of buffers. A scan reads each byte of the input once, so its
+ * cost does not depend on the number of patterns (beyond the number of matches
+ * reported).
+ *
+ * Bytes that appear in no pattern share a single column of the transition
+ * table, so the automaton's size is proportional to the total pattern length
+ * times the number of distinct bytes used by the patterns.
+ *
+ * A compiled search is not modified by scanning, so one may be shared between
+ * threads.
+ *
+ *  Requires:
+ *
+ *  ss_array.h
+ *  ss_math.h
+ *  ss_string.h
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "ss_array.h"
+#include "ss_string.h"
+
+// A compiled set of patterns.
+struct ss_multisearch;
+
+// A match of a pattern within the scanned data.
+struct ss_multisearch_match {
+    // The index of the pattern in the set it was compiled from
+    size_t pattern;
+    // The position of the first char of the match
+    size_t offset;
+};
+
+// An array of matches; see ss_array.h for its functions.
+DECLARE_ARRAY2(struct ss_multisearch_match, multisearch_match)
+
+// Compile the provided null-terminated patterns.
+//
+// The patterns are copied; they do not need to outlive the search.
+//
+// The returned pointer will be NULL if `n` is 0, if any pattern is NULL or
+// empty, or on failure to allocate.
+struct ss_multisearch *ss_multisearch_create(const char **patterns, size_t n);
+
+// Compile the provided patterns, where pattern `i` is `lens[i]` bytes long.
+//
+// Patterns may contain null bytes.
+//
+// The returned pointer will be NULL if `n` is 0, if any pattern is NULL or
+// empty, or on failure to allocate.
+struct ss_multisearch *ss_multisearch_create_from_data(
+    const char **patterns,
+    const size_t *lens,
+    size_t n
+);
+
+// Free the provided search and set its pointer to NULL.
+void ss_multisearch_free(struct ss_multisearch **ms);
+
+// Get the number of patterns in the search.
+size_t ss_multisearch_pattern_count(const struct ss_multisearch *ms);
+
+// Scan `len` bytes of `data`, calling `f` for each match.
+//
+// Matches are reported in order of their end position; matches ending at the
+// same position are reported longest first. Overlapping matches are all
+// reported.
+//
+// `f` returns false to stop the scan.
+//
+// Returns the number of matches reported.
+size_t ss_multisearch_scan(
+    const struct ss_multisearch *ms,
+    const char *data,
+    size_t len,
+    bool (*f)(const struct ss_multisearch_match *match, void *ctx),
+    void *ctx
+);
+
+// Scan `len` bytes of `data`, appending every match to `out`.
+//
+// Matches are appended in the order described by [ss_multisearch_scan].
+//
+// Returns:
+//
+// Returns true on success, even if no match was found.
+//
+// If ms, data, or out are NULL, returns false.
+//
+// On failure to allocate, returns false; matches found before the failure
+// remain in `out`.
+bool ss_multisearch_find_all(
+    const struct ss_multisearch *ms,
+    const char *data,
+    size_t len,
+    struct ss_array_multisearch_match *out
+);
+
+// Check whether any pattern occurs in `len` bytes of `data`.
+//
+// Stops at the first match.
+bool ss_multisearch_contains_any(
+    const struct ss_multisearch *ms,
+    const char *data,
+    size_t len
+);
+
+// Scan the string, calling `f` for each match.
+//
+// See [ss_multisearch_scan].
+size_t ss_string_multisearch_scan(
+    const struct ss_string *s,
+    const struct ss_multisearch *ms,
+    bool (*f)(const struct ss_multisearch_match *match, void *ctx),
+    void *ctx
+);
+
+// Scan the string, appending every match to `out`.
+//
+// See [ss_multisearch_find_all].
+bool ss_string_multisearch_find_all(
+    const struct ss_string *s,
+    const struct ss_multisearch *ms,
+    struct ss_array_multisearch_match *out
+);
+
+// Check whether any pattern occurs in the string.
+bool ss_string_multisearch_contains_any(
+    const struct ss_string *s,
+    const struct ss_multisearch *ms
+);
+
+#endif
@@ -0,0 +1,74 @@
+#ifndef SS_LIB_NUMERIC_H
+#define SS_LIB_NUMERIC_H
+
+/* This Source Code Form is subject to the terms of the Mozilla Public License,
+ * v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ * obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/* Vectorized reductions and searches over buffers of numbers.
+ *
+ * These are the kernels behind ss_array_numeric.h, for 32- and 64-bit signed
+ * integers, float, and double. On x86 with GCC or Clang, each uses the best of
+ * its SSE2, AVX2, and AVX-512 versions that ss_cpu.h allows; other platforms
+ * use scalar loops. All of them are bound by memory bandwidth on large
+ * buffers.
+ *
+ * Integer sums and dot products wrap on overflow. Float sums and dot products
+ * are kept in several partial sums, so they can differ in the last bits from
+ * adding the elements in order. Results involving NaN are unspecified.
+ *
+ * A NULL buffer may be passed with a length of 0.
+ *
+ *  Requires:
+ *
+ *  ss_cpu.h
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Sum `len` elements.
+int32_t ss_numeric_sum_i32(const int32_t *data, size_t len);
+int64_t ss_numeric_sum_i64(const int64_t *data, size_t len);
+float ss_numeric_sum_f32(const float *data, size_t len);
+double ss_numeric_sum_f64(const double *data, size_t len);
+
+// Find the smallest of `len` elements, storing it in `out`.
+//
+// Returns false if `len` is 0.
+bool ss_numeric_min_i32(const int32_t *data, size_t len, int32_t *out);
+bool ss_numeric_min_i64(const int64_t *data, size_t len, int64_t *out);
+bool ss_numeric_min_f32(const float *data, size_t len, float *out);
+bool ss_numeric_min_f64(const double *data, size_t len, double *out);
+
+// Find the largest of `len` elements, storing it in `out`.
+//
+// Returns false if `len` is 0.
+bool ss_numeric_max_i32(const int32_t *data, size_t len, int32_t *out);
+bool ss_numeric_max_i64(const int64_t *data, size_t len, int64_t *out);
+bool ss_numeric_max_f32(const float *data, size_t len, float *out);
+bool ss_numeric_max_f64(const double *data, size_t len, double *out);
+
+// Get the position of the first of `len` elements equal to `value`.
+//
+// Returns SIZE_MAX if no element is equal.
+size_t ss_numeric_find_i32(const int32_t *data, size_t len, int32_t value);
+size_t ss_numeric_find_i64(const int64_t *data, size_t len, int64_t value);
+size_t ss_numeric_find_f32(const float *data, size_t len, float value);
+size_t ss_numeric_find_f64(const double *data, size_t len, double value);
+
+// Count the elements equal to `value`.
+size_t ss_numeric_count_i32(const int32_t *data, size_t len, int32_t value);
+size_t ss_numeric_count_i64(const int64_t *data, size_t len, int64_t value);
+size_t ss_numeric_count_f32(const float *data, size_t len, float value);
+size_t ss_numeric_count_f64(const double *data, size_t len, double value);
+
+// Sum the products of the elements of `a` and `b` at each of `len` positions.
+int32_t ss_numeric_dot_i32(const int32_t *a, const int32_t *b, size_t len);
+int64_t ss_numeric_dot_i64(const int64_t *a, const int64_t *b, size_t len);
+float ss_numeric_dot_f32(const float *a, const float *b, size_t len);
+double ss_numeric_dot_f64(const double *a, const double *b, size_t len);
+
+#endif
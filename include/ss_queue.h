@@ -0,0 +1,672 @@
+#ifndef SS_QUEUE_H
+#define SS_QUEUE_H
+
+/* This Source Code Form is subject to the terms of the Mozilla Public License,
+ * v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ * obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/* Typesafe, bounded, lock-free queues for passing elements between threads.
+ *
+ * An SPSC queue has a single producer thread and a single consumer thread. It
+ * is a ring buffer with a head and a tail index, each written by only one
+ * thread; each side keeps a copy of the other's index and only reloads it when
+ * the queue looks full or empty, so the two threads seldom share a cache line.
+ *
+ * An MPMC queue may be pushed to and popped from by any number of threads. It
+ * is a ring buffer of cells with sequence numbers (Dmitry Vyukov's bounded
+ * queue): a thread claims positions with a compare-and-swap on the head or
+ * tail, and the sequence number of each cell says whether it is ready to be
+ * filled or emptied.
+ *
+ * Both keep their head and tail on separate cache lines. Capacities are
+ * rounded up to a power of two so positions wrap with a mask.
+ *
+ * The try functions return immediately if the queue is full or empty. The
+ * others wait by spinning, then yielding the thread; they never sleep on a
+ * lock. The batch functions move several elements for one update of the
+ * shared indexes.
+ *
+ * Elements are copied in and out by value.
+ *
+ * Use GENERATE_SPSC_QUEUE and GENERATE_MPMC_QUEUE, or the DECLARE and DEFINE
+ * variants as with ss_array.h. Requires a C11 compiler with stdatomic.h.
+ *
+ * Requires: ss_math.h
+ */
+
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ss_math.h"
+
+// The size of a cache line; the head and tail of a queue are kept this far
+// apart.
+#ifndef SS_QUEUE_CACHE_LINE
+    #define SS_QUEUE_CACHE_LINE 64
+#endif
+
+// The number of times to retry before yielding the thread when waiting.
+#define SS_QUEUE_SPINS 64
+
+// Round a requested capacity up to a power of two.
+//
+// Returns 0 if `capacity` is 0 or too large.
+static inline size_t ss_queue_capacity_(size_t capacity) {
+    if (capacity == 0 || capacity > SIZE_MAX / 2 + 1) return 0;
+    return (size_t) next_pow_of_two(capacity);
+}
+
+// Wait a little longer each time, before retrying a full or empty queue.
+static inline void ss_queue_backoff_(unsigned *spins) {
+    if (*spins < SS_QUEUE_SPINS) {
+        *spins += 1;
+    } else {
+        sched_yield();
+    }
+}
+
+#define DECLARE_SPSC_QUEUE(T) DECLARE_SPSC_QUEUE2(T, T)
+
+#define DECLARE_SPSC_QUEUE2(T, LBL)                                            \
+struct ss_spsc_queue_##LBL;                                                    \
+                                                                               \
+/* Create a queue with room for at least `capacity` elements.                  \
+ *                                                                             \
+ * The capacity is rounded up to a power of two.                               \
+ *                                                                             \
+ * Returns NULL if `capacity` is 0 or on failure to allocate memory.           \
+ */                                                                            \
+struct ss_spsc_queue_##LBL *ss_spsc_queue_##LBL##_create(size_t capacity);     \
+                                                                               \
+/* Free the provided queue and set its pointer to NULL.                        \
+ *                                                                             \
+ * Calls a free function on each element still in the queue if one is          \
+ * provided. No other thread may be using the queue.                           \
+ */                                                                            \
+void ss_spsc_queue_##LBL##_free(                                               \
+    struct ss_spsc_queue_##LBL **queue,                                        \
+    void (*f)(T** elem)                                                        \
+);                                                                             \
+                                                                               \
+/* Get the number of elements the queue can hold. */                           \
+size_t ss_spsc_queue_##LBL##_capacity(const struct ss_spsc_queue_##LBL *queue);\
+                                                                               \
+/* Add an element to the queue if there is room.                               \
+ *                                                                             \
+ * Only one thread may push to the queue.                                      \
+ *                                                                             \
+ * Returns false if the queue is full.                                         \
+ */                                                                            \
+bool ss_spsc_queue_##LBL##_try_push(struct ss_spsc_queue_##LBL *queue, T elem);\
+                                                                               \
+/* Add up to `num_elems` elements to the queue, as many as there is room for.  \
+ *                                                                             \
+ * Returns the number of elements added.                                       \
+ */                                                                            \
+size_t ss_spsc_queue_##LBL##_try_push_batch(                                   \
+    struct ss_spsc_queue_##LBL *queue,                                         \
+    T *data,                                                                   \
+    size_t num_elems                                                           \
+);                                                                             \
+                                                                               \
+/* Add an element to the queue, waiting for room if it is full. */             \
+void ss_spsc_queue_##LBL##_push(struct ss_spsc_queue_##LBL *queue, T elem);    \
+                                                                               \
+/* Add `num_elems` elements to the queue, waiting for room as needed. */       \
+void ss_spsc_queue_##LBL##_push_batch(                                         \
+    struct ss_spsc_queue_##LBL *queue,                                         \
+    T *data,                                                                   \
+    size_t num_elems                                                           \
+);                                                                             \
+                                                                               \
+/* Remove the oldest element from the queue into `*elem`, if there is one.     \
+ *                                                                             \
+ * Only one thread may pop from the queue.                                     \
+ *                                                                             \
+ * Returns false if the queue is empty.                                        \
+ */                                                                            \
+bool ss_spsc_queue_##LBL##_try_pop(struct ss_spsc_queue_##LBL *queue, T *elem);\
+                                                                               \
+/* Remove up to `max_elems` of the oldest elements from the queue into `out`.  \
+ *                                                                             \
+ * Returns the number of elements removed.                                     \
+ */                                                                            \
+size_t ss_spsc_queue_##LBL##_try_pop_batch(                                    \
+    struct ss_spsc_queue_##LBL *queue,                                         \
+    T *out,                                                                    \
+    size_t max_elems                                                           \
+);                                                                             \
+                                                                               \
+/* Remove the oldest element from the queue into `*elem`, waiting for one if   \
+ * the queue is empty.                                                         \
+ */                                                                            \
+void ss_spsc_queue_##LBL##_pop(struct ss_spsc_queue_##LBL *queue, T *elem);    \
+                                                                               \
+/* Remove up to `max_elems` of the oldest elements from the queue into `out`,  \
+ * waiting until there is at least one.                                        \
+ *                                                                             \
+ * Returns the number of elements removed, which is 0 only if `max_elems` is 0.\
+ */                                                                            \
+size_t ss_spsc_queue_##LBL##_pop_batch(                                        \
+    struct ss_spsc_queue_##LBL *queue,                                         \
+    T *out,                                                                    \
+    size_t max_elems                                                           \
+);
+
+#define DEFINE_SPSC_QUEUE(T) DEFINE_SPSC_QUEUE2(T, T)
+
+// Use label for cases when type spans multiple words, is a pointer, etc.
+#define DEFINE_SPSC_QUEUE2(T, LBL)                                             \
+struct ss_spsc_queue_##LBL {                                                   \
+    T *data;                                                                   \
+    size_t mask;                                                               \
+    /* Written by the producer. head_cache is the last head it saw. */         \
+    _Alignas(SS_QUEUE_CACHE_LINE) atomic_size_t tail;                          \
+    size_t head_cache;                                                         \
+    /* Written by the consumer. tail_cache is the last tail it saw. */         \
+    _Alignas(SS_QUEUE_CACHE_LINE) atomic_size_t head;                          \
+    size_t tail_cache;                                                         \
+};                                                                             \
+                                                                               \
+struct ss_spsc_queue_##LBL *ss_spsc_queue_##LBL##_create(size_t capacity) {    \
+    capacity = ss_queue_capacity_(capacity);                                   \
+    if (capacity == 0) return NULL;                                            \
+                                                                               \
+    struct ss_spsc_queue_##LBL *queue =                                        \
+        (struct ss_spsc_queue_##LBL*) aligned_alloc(SS_QUEUE_CACHE_LINE,       \
+            sizeof(struct ss_spsc_queue_##LBL));                               \
+    if (queue == NULL) return NULL;                                            \
+                                                                               \
+    queue->data = (T*) malloc(capacity * sizeof(T));                           \
+    if (queue->data == NULL) {                                                 \
+        free(queue);                                                           \
+        return NULL;                                                           \
+    }                                                                          \
+                                                                               \
+    queue->mask = capacity - 1;                                                \
+    atomic_init(&queue->tail, 0);                                              \
+    queue->head_cache = 0;                                                     \
+    atomic_init(&queue->head, 0);                                              \
+    queue->tail_cache = 0;                                                     \
+                                                                               \
+    return queue;                                                              \
+}                                                                              \
+                                                                               \
+void ss_spsc_queue_##LBL##_free(                                               \
+    struct ss_spsc_queue_##LBL **queue,                                        \
+    void (*f)(T** elem)                                                        \
+) {                                                                            \
+    if (queue == NULL || *queue == NULL) return;                               \
+                                                                               \
+    if (f != NULL) {                                                           \
+        size_t tail = atomic_load(&(*queue)->tail);                            \
+        for (size_t i = atomic_load(&(*queue)->head); i != tail; ++i) {        \
+            T *tmp = &(*queue)->data[i & (*queue)->mask];                      \
+            f(&tmp);                                                           \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    free((*queue)->data);                                                      \
+    free(*queue);                                                              \
+    *queue = NULL;                                                             \
+}                                                                              \
+                                                                               \
+size_t ss_spsc_queue_##LBL##_capacity(const struct ss_spsc_queue_##LBL *queue) \
+{                                                                              \
+    if (queue == NULL) return 0;                                               \
+    return queue->mask + 1;                                                    \
+}                                                                              \
+                                                                               \
+size_t ss_spsc_queue_##LBL##_try_push_batch(                                   \
+    struct ss_spsc_queue_##LBL *queue,                                         \
+    T *data,                                                                   \
+    size_t num_elems                                                           \
+) {                                                                            \
+    if (queue == NULL || data == NULL) return 0;                               \
+                                                                               \
+    size_t capacity = queue->mask + 1;                                         \
+    size_t tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);    \
+                                                                               \
+    /* Only look at the consumer's index when the cached one shows too little  \
+     * room, so the producer rarely touches the consumer's cache line. */      \
+    if (capacity - (tail - queue->head_cache) < num_elems) {                   \
+        queue->head_cache =                                                    \
+            atomic_load_explicit(&queue->head, memory_order_acquire);          \
+    }                                                                          \
+                                                                               \
+    size_t room = capacity - (tail - queue->head_cache);                       \
+    if (num_elems > room) { num_elems = room; }                                \
+    if (num_elems == 0) return 0;                                              \
+                                                                               \
+    /* Copy in up to two pieces, wrapping around the end of the buffer. */     \
+    size_t start = tail & queue->mask;                                         \
+    size_t first = capacity - start < num_elems ? capacity - start : num_elems;\
+    memcpy(queue->data + start, data, first * sizeof(T));                      \
+    memcpy(queue->data, data + first, (num_elems - first) * sizeof(T));        \
+                                                                               \
+    atomic_store_explicit(&queue->tail, tail + num_elems,                      \
+        memory_order_release);                                                 \
+    return num_elems;                                                          \
+}                                                                              \
+                                                                               \
+bool ss_spsc_queue_##LBL##_try_push(struct ss_spsc_queue_##LBL *queue, T elem) \
+{                                                                              \
+    return ss_spsc_queue_##LBL##_try_push_batch(queue, &elem, 1) == 1;         \
+}                                                                              \
+                                                                               \
+void ss_spsc_queue_##LBL##_push_batch(                                         \
+    struct ss_spsc_queue_##LBL *queue,                                         \
+    T *data,                                                                   \
+    size_t num_elems                                                           \
+) {                                                                            \
+    if (queue == NULL || data == NULL) return;                                 \
+                                                                               \
+    unsigned spins = 0;                                                        \
+    while (num_elems > 0) {                                                    \
+        size_t pushed =                                                        \
+            ss_spsc_queue_##LBL##_try_push_batch(queue, data, num_elems);      \
+                                                                               \
+        if (pushed == 0) {                                                     \
+            ss_queue_backoff_(&spins);                                         \
+        } else {                                                               \
+            data += pushed;                                                    \
+            num_elems -= pushed;                                               \
+            spins = 0;                                                         \
+        }                                                                      \
+    }                                                                          \
+}                                                                              \
+                                                                               \
+void ss_spsc_queue_##LBL##_push(struct ss_spsc_queue_##LBL *queue, T elem) {   \
+    ss_spsc_queue_##LBL##_push_batch(queue, &elem, 1);                         \
+}                                                                              \
+                                                                               \
+size_t ss_spsc_queue_##LBL##_try_pop_batch(                                    \
+    struct ss_spsc_queue_##LBL *queue,                                         \
+    T *out,                                                                    \
+    size_t max_elems                                                           \
+) {                                                                            \
+    if (queue == NULL || out == NULL) return 0;                                \
+                                                                               \
+    size_t capacity = queue->mask + 1;                                         \
+    size_t head = atomic_load_explicit(&queue->head, memory_order_relaxed);    \
+                                                                               \
+    if (queue->tail_cache - head < max_elems) {                                \
+        queue->tail_cache =                                                    \
+            atomic_load_explicit(&queue->tail, memory_order_acquire);          \
+    }                                                                          \
+                                                                               \
+    size_t avail = queue->tail_cache - head;                                   \
+    if (max_elems > avail) { max_elems = avail; }                              \
+    if (max_elems == 0) return 0;                                              \
+                                                                               \
+    size_t start = head & queue->mask;                                         \
+    size_t first = capacity - start < max_elems ? capacity - start : max_elems;\
+    memcpy(out, queue->data + start, first * sizeof(T));                       \
+    memcpy(out + first, queue->data, (max_elems - first) * sizeof(T));         \
+                                                                               \
+    atomic_store_explicit(&queue->head, head + max_elems,                      \
+        memory_order_release);                                                 \
+    return max_elems;                                                          \
+}                                                                              \
+                                                                               \
+bool ss_spsc_queue_##LBL##_try_pop(struct ss_spsc_queue_##LBL *queue, T *elem) \
+{                                                                              \
+    return ss_spsc_queue_##LBL##_try_pop_batch(queue, elem, 1) == 1;           \
+}                                                                              \
+                                                                               \
+size_t ss_spsc_queue_##LBL##_pop_batch(                                        \
+    struct ss_spsc_queue_##LBL *queue,                                         \
+    T *out,                                                                    \
+    size_t max_elems                                                           \
+) {                                                                            \
+    if (queue == NULL || out == NULL || max_elems == 0) return 0;              \
+                                                                               \
+    unsigned spins = 0;                                                        \
+    size_t popped = 0;                                                         \
+    while ((popped = ss_spsc_queue_##LBL##_try_pop_batch(queue, out,           \
+        max_elems)) == 0                                                       \
+    ) {                                                                        \
+        ss_queue_backoff_(&spins);                                             \
+    }                                                                          \
+    return popped;                                                             \
+}                                                                              \
+                                                                               \
+void ss_spsc_queue_##LBL##_pop(struct ss_spsc_queue_##LBL *queue, T *elem) {   \
+    ss_spsc_queue_##LBL##_pop_batch(queue, elem, 1);                           \
+}
+
+#define GENERATE_SPSC_QUEUE(T) GENERATE_SPSC_QUEUE2(T, T)
+
+// Declare and define a single-producer, single-consumer queue type in one
+// step.
+#define GENERATE_SPSC_QUEUE2(T, LBL)                                           \
+    DECLARE_SPSC_QUEUE2(T, LBL)                                                \
+    DEFINE_SPSC_QUEUE2(T, LBL)
+
+#define DECLARE_MPMC_QUEUE(T) DECLARE_MPMC_QUEUE2(T, T)
+
+#define DECLARE_MPMC_QUEUE2(T, LBL)                                            \
+struct ss_mpmc_queue_##LBL;                                                    \
+                                                                               \
+/* Create a queue with room for at least `capacity` elements.                  \
+ *                                                                             \
+ * The capacity is rounded up to a power of two, and is at least 2.            \
+ *                                                                             \
+ * Returns NULL if `capacity` is 0 or on failure to allocate memory.           \
+ */                                                                            \
+struct ss_mpmc_queue_##LBL *ss_mpmc_queue_##LBL##_create(size_t capacity);     \
+                                                                               \
+/* Free the provided queue and set its pointer to NULL.                        \
+ *                                                                             \
+ * Calls a free function on each element still in the queue if one is          \
+ * provided. No other thread may be using the queue.                           \
+ */                                                                            \
+void ss_mpmc_queue_##LBL##_free(                                               \
+    struct ss_mpmc_queue_##LBL **queue,                                        \
+    void (*f)(T** elem)                                                        \
+);                                                                             \
+                                                                               \
+/* Get the number of elements the queue can hold. */                           \
+size_t ss_mpmc_queue_##LBL##_capacity(const struct ss_mpmc_queue_##LBL *queue);\
+                                                                               \
+/* Add an element to the queue if there is room.                               \
+ *                                                                             \
+ * Any number of threads may push and pop at once.                             \
+ *                                                                             \
+ * Returns false if the queue is full.                                         \
+ */                                                                            \
+bool ss_mpmc_queue_##LBL##_try_push(struct ss_mpmc_queue_##LBL *queue, T elem);\
+                                                                               \
+/* Add up to `num_elems` elements to the queue, as many as there is room for.  \
+ *                                                                             \
+ * The elements added are consecutive in the queue, and are not interleaved    \
+ * with other threads' elements.                                               \
+ *                                                                             \
+ * Returns the number of elements added.                                       \
+ */                                                                            \
+size_t ss_mpmc_queue_##LBL##_try_push_batch(                                   \
+    struct ss_mpmc_queue_##LBL *queue,                                         \
+    T *data,                                                                   \
+    size_t num_elems                                                           \
+);                                                                             \
+                                                                               \
+/* Add an element to the queue, waiting for room if it is full. */             \
+void ss_mpmc_queue_##LBL##_push(struct ss_mpmc_queue_##LBL *queue, T elem);    \
+                                                                               \
+/* Add `num_elems` elements to the queue, waiting for room as needed.          \
+ *                                                                             \
+ * Other threads' elements may be interleaved with these if the queue fills.   \
+ */                                                                            \
+void ss_mpmc_queue_##LBL##_push_batch(                                         \
+    struct ss_mpmc_queue_##LBL *queue,                                         \
+    T *data,                                                                   \
+    size_t num_elems                                                           \
+);                                                                             \
+                                                                               \
+/* Remove the oldest element from the queue into `*elem`, if there is one.     \
+ *                                                                             \
+ * Returns false if the queue is empty.                                        \
+ */                                                                            \
+bool ss_mpmc_queue_##LBL##_try_pop(struct ss_mpmc_queue_##LBL *queue, T *elem);\
+                                                                               \
+/* Remove up to `max_elems` of the oldest elements from the queue into `out`.  \
+ *                                                                             \
+ * Returns the number of elements removed.                                     \
+ */                                                                            \
+size_t ss_mpmc_queue_##LBL##_try_pop_batch(                                    \
+    struct ss_mpmc_queue_##LBL *queue,                                         \
+    T *out,                                                                    \
+    size_t max_elems                                                           \
+);                                                                             \
+                                                                               \
+/* Remove the oldest element from the queue into `*elem`, waiting for one if   \
+ * the queue is empty.                                                         \
+ */                                                                            \
+void ss_mpmc_queue_##LBL##_pop(struct ss_mpmc_queue_##LBL *queue, T *elem);    \
+                                                                               \
+/* Remove up to `max_elems` of the oldest elements from the queue into `out`,  \
+ * waiting until there is at least one.                                        \
+ *                                                                             \
+ * Returns the number of elements removed, which is 0 only if `max_elems` is 0.\
+ */                                                                            \
+size_t ss_mpmc_queue_##LBL##_pop_batch(                                        \
+    struct ss_mpmc_queue_##LBL *queue,                                         \
+    T *out,                                                                    \
+    size_t max_elems                                                           \
+);
+
+#define DEFINE_MPMC_QUEUE(T) DEFINE_MPMC_QUEUE2(T, T)
+
+// Use label for cases when type spans multiple words, is a pointer, etc.
+#define DEFINE_MPMC_QUEUE2(T, LBL)                                             \
+struct ss_mpmc_queue_##LBL##_cell_ {                                           \
+    /* Equal to the position that may next be pushed into the cell, or one     \
+     * more than the position that may next be popped from it. */              \
+    atomic_size_t seq;                                                         \
+    T elem;                                                                    \
+};                                                                             \
+                                                                               \
+struct ss_mpmc_queue_##LBL {                                                   \
+    struct ss_mpmc_queue_##LBL##_cell_ *cells;                                 \
+    size_t mask;                                                               \
+    _Alignas(SS_QUEUE_CACHE_LINE) atomic_size_t tail;                          \
+    _Alignas(SS_QUEUE_CACHE_LINE) atomic_size_t head;                          \
+};                                                                             \
+                                                                               \
+struct ss_mpmc_queue_##LBL *ss_mpmc_queue_##LBL##_create(size_t capacity) {    \
+    capacity = ss_queue_capacity_(capacity);                                   \
+    if (capacity == 0) return NULL;                                            \
+    if (capacity < 2) { capacity = 2; }                                        \
+                                                                               \
+    struct ss_mpmc_queue_##LBL *queue =                                        \
+        (struct ss_mpmc_queue_##LBL*) aligned_alloc(SS_QUEUE_CACHE_LINE,       \
+            sizeof(struct ss_mpmc_queue_##LBL));                               \
+    if (queue == NULL) return NULL;                                            \
+                                                                               \
+    queue->cells = (struct ss_mpmc_queue_##LBL##_cell_*) malloc(               \
+        capacity * sizeof(struct ss_mpmc_queue_##LBL##_cell_));                \
+    if (queue->cells == NULL) {                                                \
+        free(queue);                                                           \
+        return NULL;                                                           \
+    }                                                                          \
+                                                                               \
+    for (size_t i = 0; i < capacity; ++i) {                                    \
+        atomic_init(&queue->cells[i].seq, i);                                  \
+    }                                                                          \
+    queue->mask = capacity - 1;                                                \
+    atomic_init(&queue->tail, 0);                                              \
+    atomic_init(&queue->head, 0);                                              \
+                                                                               \
+    return queue;                                                              \
+}                                                                              \
+                                                                               \
+void ss_mpmc_queue_##LBL##_free(                                               \
+    struct ss_mpmc_queue_##LBL **queue,                                        \
+    void (*f)(T** elem)                                                        \
+) {                                                                            \
+    if (queue == NULL || *queue == NULL) return;                               \
+                                                                               \
+    if (f != NULL) {                                                           \
+        size_t tail = atomic_load(&(*queue)->tail);                            \
+        for (size_t i = atomic_load(&(*queue)->head); i != tail; ++i) {        \
+            T *tmp = &(*queue)->cells[i & (*queue)->mask].elem;                \
+            f(&tmp);                                                           \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    free((*queue)->cells);                                                     \
+    free(*queue);                                                              \
+    *queue = NULL;                                                             \
+}                                                                              \
+                                                                               \
+size_t ss_mpmc_queue_##LBL##_capacity(const struct ss_mpmc_queue_##LBL *queue) \
+{                                                                              \
+    if (queue == NULL) return 0;                                               \
+    return queue->mask + 1;                                                    \
+}                                                                              \
+                                                                               \
+size_t ss_mpmc_queue_##LBL##_try_push_batch(                                   \
+    struct ss_mpmc_queue_##LBL *queue,                                         \
+    T *data,                                                                   \
+    size_t num_elems                                                           \
+) {                                                                            \
+    if (queue == NULL || data == NULL || num_elems == 0) return 0;             \
+                                                                               \
+    size_t pos = atomic_load_explicit(&queue->tail, memory_order_relaxed);     \
+    size_t count = 0;                                                          \
+                                                                               \
+    while (true) {                                                             \
+        /* Count the free cells from pos, then claim them all at once. */      \
+        count = 0;                                                             \
+        while (count < num_elems) {                                            \
+            size_t seq = atomic_load_explicit(                                 \
+                &queue->cells[(pos + count) & queue->mask].seq,                \
+                memory_order_acquire);                                         \
+            if (seq != pos + count) break;                                     \
+            count += 1;                                                        \
+        }                                                                      \
+                                                                               \
+        if (count == 0) {                                                      \
+            size_t seq = atomic_load_explicit(                                 \
+                &queue->cells[pos & queue->mask].seq, memory_order_acquire);   \
+            /* The cell still holds an element from the previous lap. */       \
+            if ((ptrdiff_t) (seq - pos) < 0) return 0;                         \
+                                                                               \
+            pos = atomic_load_explicit(&queue->tail, memory_order_relaxed);    \
+            continue;                                                          \
+        }                                                                      \
+                                                                               \
+        if (atomic_compare_exchange_weak_explicit(&queue->tail, &pos,          \
+            pos + count, memory_order_relaxed, memory_order_relaxed)           \
+        ) {                                                                    \
+            break;                                                             \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    for (size_t i = 0; i < count; ++i) {                                       \
+        struct ss_mpmc_queue_##LBL##_cell_ *cell =                             \
+            &queue->cells[(pos + i) & queue->mask];                            \
+        cell->elem = data[i];                                                  \
+        atomic_store_explicit(&cell->seq, pos + i + 1, memory_order_release);  \
+    }                                                                          \
+    return count;                                                              \
+}                                                                              \
+                                                                               \
+bool ss_mpmc_queue_##LBL##_try_push(struct ss_mpmc_queue_##LBL *queue, T elem) \
+{                                                                              \
+    return ss_mpmc_queue_##LBL##_try_push_batch(queue, &elem, 1) == 1;         \
+}                                                                              \
+                                                                               \
+void ss_mpmc_queue_##LBL##_push_batch(                                         \
+    struct ss_mpmc_queue_##LBL *queue,                                         \
+    T *data,                                                                   \
+    size_t num_elems                                                           \
+) {                                                                            \
+    if (queue == NULL || data == NULL) return;                                 \
+                                                                               \
+    unsigned spins = 0;                                                        \
+    while (num_elems > 0) {                                                    \
+        size_t pushed =                                                        \
+            ss_mpmc_queue_##LBL##_try_push_batch(queue, data, num_elems);      \
+                                                                               \
+        if (pushed == 0) {                                                     \
+            ss_queue_backoff_(&spins);                                         \
+        } else {                                                               \
+            data += pushed;                                                    \
+            num_elems -= pushed;                                               \
+            spins = 0;                                                         \
+        }                                                                      \
+    }                                                                          \
+}                                                                              \
+                                                                               \
+void ss_mpmc_queue_##LBL##_push(struct ss_mpmc_queue_##LBL *queue, T elem) {   \
+    ss_mpmc_queue_##LBL##_push_batch(queue, &elem, 1);                         \
+}                                                                              \
+                                                                               \
+size_t ss_mpmc_queue_##LBL##_try_pop_batch(                                    \
+    struct ss_mpmc_queue_##LBL *queue,                                         \
+    T *out,                                                                    \
+    size_t max_elems                                                           \
+) {                                                                            \
+    if (queue == NULL || out == NULL || max_elems == 0) return 0;              \
+                                                                               \
+    size_t pos = atomic_load_explicit(&queue->head, memory_order_relaxed);     \
+    size_t count = 0;                                                          \
+                                                                               \
+    while (true) {                                                             \
+        count = 0;                                                             \
+        while (count < max_elems) {                                            \
+            size_t seq = atomic_load_explicit(                                 \
+                &queue->cells[(pos + count) & queue->mask].seq,                \
+                memory_order_acquire);                                         \
+            if (seq != pos + count + 1) break;                                 \
+            count += 1;                                                        \
+        }                                                                      \
+                                                                               \
+        if (count == 0) {                                                      \
+            size_t seq = atomic_load_explicit(                                 \
+                &queue->cells[pos & queue->mask].seq, memory_order_acquire);   \
+            /* The cell has not been pushed into on this lap. */               \
+            if ((ptrdiff_t) (seq - (pos + 1)) < 0) return 0;                   \
+                                                                               \
+            pos = atomic_load_explicit(&queue->head, memory_order_relaxed);    \
+            continue;                                                          \
+        }                                                                      \
+                                                                               \
+        if (atomic_compare_exchange_weak_explicit(&queue->head, &pos,          \
+            pos + count, memory_order_relaxed, memory_order_relaxed)           \
+        ) {                                                                    \
+            break;                                                             \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    for (size_t i = 0; i < count; ++i) {                                       \
+        struct ss_mpmc_queue_##LBL##_cell_ *cell =                             \
+            &queue->cells[(pos + i) & queue->mask];                            \
+        out[i] = cell->elem;                                                   \
+        atomic_store_explicit(&cell->seq, pos + i + queue->mask + 1,           \
+            memory_order_release);                                             \
+    }                                                                          \
+    return count;                                                              \
+}                                                                              \
+                                                                               \
+bool ss_mpmc_queue_##LBL##_try_pop(struct ss_mpmc_queue_##LBL *queue, T *elem) \
+{                                                                              \
+    return ss_mpmc_queue_##LBL##_try_pop_batch(queue, elem, 1) == 1;           \
+}                                                                              \
+                                                                               \
+size_t ss_mpmc_queue_##LBL##_pop_batch(                                        \
+    struct ss_mpmc_queue_##LBL *queue,                                         \
+    T *out,                                                                    \
+    size_t max_elems                                                           \
+) {                                                                            \
+    if (queue == NULL || out == NULL || max_elems == 0) return 0;              \
+                                                                               \
+    unsigned spins = 0;                                                        \
+    size_t popped = 0;                                                         \
+    while ((popped = ss_mpmc_queue_##LBL##_try_pop_batch(queue, out,           \
+        max_elems)) == 0                                                       \
+    ) {                                                                        \
+        ss_queue_backoff_(&spins);                                             \
+    }                                                                          \
+    return popped;                                                             \
+}                                                                              \
+                                                                               \
+void ss_mpmc_queue_##LBL##_pop(struct ss_mpmc_queue_##LBL *queue, T *elem) {   \
+    ss_mpmc_queue_##LBL##_pop_batch(queue, elem, 1);                           \
+}
+
+#define GENERATE_MPMC_QUEUE(T) GENERATE_MPMC_QUEUE2(T, T)
+
+// Declare and define a multi-producer, multi-consumer queue type in one step.
+#define GENERATE_MPMC_QUEUE2(T, LBL)                                           \
+    DECLARE_MPMC_QUEUE2(T, LBL)                                                \
+    DEFINE_MPMC_QUEUE2(T, LBL)
+
+#endif
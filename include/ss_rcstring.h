@@ -0,0 +1,85 @@
+#ifndef SS_LIB_RCSTRING_H
+#define SS_LIB_RCSTRING_H
+
+/* This Source Code Form is subject to the terms of the Mozilla Public License,
+ * v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ * obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/* Immutable, reference-counted string type.
+ *
+ * An ss_rcstring's contents never change after creation and its reference
+ * count is atomic, so the same string may be shared by any number of threads.
+ * Each thread that holds a reference must eventually release it; the string is
+ * freed when the last reference is released.
+ *
+ * Strings built with ss_string can be converted without copying by
+ * [ss_rcstring_create_from_string], which takes over the ss_string's buffer.
+ *
+ *  Requires:
+ *
+ *  ss_string.h
+ *  A C11 compiler with <stdatomic.h>
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "ss_string.h"
+
+// An immutable string with an atomic reference count.
+struct ss_rcstring;
+
+// Create a shared string from a copy of the provided C string.
+//
+// The new string has a reference count of one.
+//
+// The returned pointer will be NULL if `s` is NULL or on failure to allocate.
+struct ss_rcstring *ss_rcstring_create_from_cstring(const char *s);
+
+// Create a shared string from a copy of the provided char data.
+//
+// The input data does not need to be null-terminated.
+//
+// The returned pointer will be NULL if `data` is NULL or on failure to
+// allocate.
+struct ss_rcstring *ss_rcstring_create_from_data(const char *data, size_t len);
+
+// Create a shared string by taking ownership of an ss_string's buffer.
+//
+// The string's contents are not copied. On success, the ss_string is freed and
+// its pointer set to NULL.
+//
+// The returned pointer will be NULL on failure to allocate, in which case the
+// ss_string is left unchanged.
+struct ss_rcstring *ss_rcstring_create_from_string(struct ss_string **s);
+
+// Take a new reference to the string.
+//
+// Returns `s`.
+struct ss_rcstring *ss_rcstring_retain(struct ss_rcstring *s);
+
+// Release a reference to the string and set its pointer to NULL.
+//
+// The string is freed when its last reference is released.
+void ss_rcstring_release(struct ss_rcstring **s);
+
+// Get a constant reference to the underlying C string.
+const char *ss_rcstring_as_cstring(const struct ss_rcstring *s);
+
+// Get the length of this string.
+//
+// As with [ss_string_len], the length includes the null terminator.
+size_t ss_rcstring_len(const struct ss_rcstring *s);
+
+// Compare two strings
+//
+// This function has the same semantics as [ss_string_cmp].
+int ss_rcstring_cmp(const struct ss_rcstring *s1, const struct ss_rcstring *s2);
+
+// Create a new, mutable ss_string with a copy of this string's contents.
+//
+// The returned pointer will be NULL on failure to allocate.
+struct ss_string *ss_rcstring_to_string(const struct ss_rcstring *s);
+
+#endif
@@ -0,0 +1,164 @@
+#ifndef SS_LIB_ROPE_H
+#define SS_LIB_ROPE_H
+
+/* This Source Code Form is subject to the terms of the Mozilla Public License,
+ * v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ * obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/* Rope type for large strings that are edited in place.
+ *
+ * A rope is a balanced tree (a treap) of pieces. Each piece references a range
+ * of an immutable, reference-counted buffer, so splitting a piece or taking a
+ * substring never copies the text itself.
+ *
+ * Insert, delete, and character lookup are O(log n) in the number of pieces.
+ * Concatenating two ropes is O(log n). Taking a substring is O(log n + k),
+ * where k is the number of pieces in the range. These bounds are expected
+ * rather than worst-case: each rope draws the treap's priorities from its own
+ * random seed.
+ *
+ * Positions and lengths are in chars; unlike ss_string, the rope's length does
+ * not include a null terminator.
+ *
+ *  Requires:
+ *
+ *  ss_math.h
+ *  ss_string.h
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "ss_string.h"
+
+// A string type supporting efficient edits anywhere in the string.
+struct ss_rope;
+
+// Iterates over the contiguous chunks of a rope.
+//
+// Create with [ss_rope_iter_create]. Modifying the rope invalidates the
+// iterator.
+struct ss_rope_iter {
+    const struct ss_rope *rope_;
+    size_t pos_;
+};
+
+// Create a new, empty rope.
+//
+// The returned pointer will be NULL on failure to allocate.
+struct ss_rope *ss_rope_create();
+
+// Create a rope containing a copy of the provided data.
+//
+// The returned pointer will be NULL on failure to allocate.
+struct ss_rope *ss_rope_create_from_data(const char *data, size_t len);
+
+// Create a rope containing a copy of the provided C string.
+//
+// The returned pointer will be NULL on failure to allocate.
+struct ss_rope *ss_rope_create_from_cstring(const char *s);
+
+// Free the provided rope and set its pointer to NULL.
+void ss_rope_free(struct ss_rope **rope);
+
+// Get the length of the rope in chars.
+size_t ss_rope_len(const struct ss_rope *rope);
+
+// Get the depth of the rope's tree, which is expected to be O(log n) in the
+// number of pieces.
+//
+// This is meant for tests and diagnostics.
+size_t ss_rope_depth(const struct ss_rope *rope);
+
+// Get the char at the specified position.
+//
+// If `pos` is outside the rope's bounds, returns '\0'.
+char ss_rope_char_at(const struct ss_rope *rope, size_t pos);
+
+// Insert a copy of the provided data at the specified position.
+//
+// Returns:
+//
+// Returns true on success.
+//
+// If rope or data are NULL, if `len` is 0, or if `pos` is greater than the
+// rope's length, does nothing and returns false.
+//
+// On failure to allocate, returns false and leaves the rope unchanged.
+bool ss_rope_insert(
+    struct ss_rope *rope,
+    size_t pos,
+    const char *data,
+    size_t len
+);
+
+// Append a copy of the provided data to the end of the rope.
+//
+// This behaves like [ss_rope_insert] at the rope's length.
+bool ss_rope_append(struct ss_rope *rope, const char *data, size_t len);
+
+// Remove `len` chars starting at `pos`.
+//
+// If the range extends past the end of the rope, everything from `pos` to the
+// end is removed.
+//
+// Returns:
+//
+// Returns true on success.
+//
+// If rope is NULL or `pos` is greater than the rope's length, does nothing and
+// returns false.
+//
+// On failure to allocate, returns false and leaves the rope's contents
+// unchanged.
+bool ss_rope_delete(struct ss_rope *rope, size_t pos, size_t len);
+
+// Create a new rope containing `len` chars starting at `pos`.
+//
+// The new rope shares its text buffers with the original; no text is copied.
+// The range is clamped to the end of the rope.
+//
+// The returned pointer will be NULL if the rope is NULL, if `pos` is greater
+// than the rope's length, or on failure to allocate.
+struct ss_rope *ss_rope_substr(
+    const struct ss_rope *rope,
+    size_t pos,
+    size_t len
+);
+
+// Append `src` to `dest`, consuming `src`.
+//
+// `src` is freed and its pointer set to NULL.
+//
+// Returns:
+//
+// Returns true on success.
+//
+// If either rope is NULL, or if they are the same rope, does nothing and
+// returns false.
+bool ss_rope_concat(struct ss_rope *dest, struct ss_rope **src);
+
+// Copy the rope's contents into a new ss_string.
+//
+// The rope must not contain null chars.
+//
+// The returned pointer will be NULL on failure to allocate.
+struct ss_string *ss_rope_to_string(const struct ss_rope *rope);
+
+// Create an iterator over the rope's chunks.
+struct ss_rope_iter ss_rope_iter_create(const struct ss_rope *rope);
+
+// Get the next contiguous chunk of the rope.
+//
+// `data` is set to the chunk's first char (the chunk is not null-terminated)
+// and `len` to its length.
+//
+// Returns false once all chunks have been visited.
+bool ss_rope_iter_next(
+    struct ss_rope_iter *iter,
+    const char **data,
+    size_t *len
+);
+
+#endif
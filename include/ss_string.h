@@ -30,6 +30,7 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 // A string type that manages its own memory and tracks its length.
 struct ss_string;
@@ -51,18 +52,54 @@ struct ss_string *ss_string_create_with_size(size_t sz);
 // The returned pointer will be NULL on failure to allocate.
 struct ss_string *ss_string_create_from_cstring(const char *s);
 
+// Create a string that takes ownership of an existing buffer without copying
+// it.
+//
+// `str` must have been allocated by malloc, calloc, or realloc, and be at least
+// `cap` chars long. `len` is the string's length including the null
+// terminator, as returned by [ss_string_dissolve], so `str[len - 1]` must be
+// '\0'. A buffer returned by [ss_string_dissolve] can be adopted with `cap`
+// equal to `len`.
+//
+// If `str` is NULL, `len` and `cap` must be 0, and the result is an empty
+// string.
+//
+// The returned pointer will be NULL if `len` is greater than `cap`, if the
+// buffer is not null-terminated at `len`, or on failure to allocate. In that
+// case the caller still owns the buffer.
+struct ss_string *ss_string_adopt(char *str, size_t len, size_t cap);
+
 // Free the provided string and set its pointer to NULL.
 void ss_string_free(struct ss_string **s);
 
-// Clear the string's data, but leave the underlying memory buffer unchanged.
+// Convert the string to its underlying C string.
 //
-// `ss_string_clear` only clears the memory contained by the string, not the
-// entire memory buffer.
+// Returns the buffer in `out`, frees all other memory associated with the
+// string, and returns the string's length as reported by [ss_string_len]. The
+// buffer may be larger than the string.
 //
-// The optimizer may optimize the entire call to `ss_string_clear` away.
-// See [ss_string_secure_clear] to guarantee that the buffer is cleared.
+// The pointer to the string will be set to NULL. Managing the buffer becomes
+// the caller's responsibility.
+//
+// `*out` must be NULL. If the string was never allocated, `*out` remains NULL
+// and 0 is returned.
+//
+// The buffer can be handed back to a string with [ss_string_adopt].
+size_t ss_string_dissolve(struct ss_string **s, char **out);
+
+// Make the string empty, but leave the underlying memory buffer unchanged.
+//
+// This only resets the length and terminates the string at its first char; the
+// old contents remain in memory. See [ss_string_secure_clear] to erase them.
 void ss_string_clear(struct ss_string *s);
 
+// Make the string empty and overwrite its entire buffer with '\0', leaving the
+// buffer allocated.
+//
+// Unlike a plain memset, the writes are not optimized away, so use this to
+// erase sensitive data. It takes time proportional to the capacity.
+void ss_string_secure_clear(struct ss_string *s);
+
 // Append the provided C string to an ss_string.
 //
 // Returns:
@@ -118,8 +155,88 @@ bool ss_string_append_string(
     const struct ss_string *src
 );
 
+// Join the provided strings into a new string, placing `sep` between each.
+//
+// The total length is computed before copying, so the new string's buffer is
+// allocated only once.
+//
+// `sep` may be NULL or empty, in which case the parts are simply concatenated.
+// NULL elements of `parts` are treated as empty strings.
+//
+// The returned pointer will be NULL if `parts` is NULL or on failure to
+// allocate. If `n` is 0, returns an empty string.
+struct ss_string *ss_string_join(
+    const char *sep,
+    const struct ss_string **parts,
+    size_t n
+);
+
+// Join the provided C strings into a new string, placing `sep` between each.
+//
+// This behaves like [ss_string_join].
+struct ss_string *ss_string_join_cstrings(
+    const char *sep,
+    const char **parts,
+    size_t n
+);
+
+// Concatenate a NULL-terminated list of C strings into a new string.
+//
+// The buffer is allocated once, sized to the sum of the inputs:
+//
+// ```
+// struct ss_string *path = ss_string_concat(dir, "/", name, ".txt", NULL);
+// ```
+//
+// The returned pointer will be NULL on failure to allocate.
+struct ss_string *ss_string_concat(const char *first, ...);
+
+// Concatenate a NULL-terminated list of ss_strings into a new string.
+//
+// This behaves like [ss_string_concat].
+struct ss_string *ss_string_concat_strings(const struct ss_string *first, ...);
+
+// Ensure that at least `n` more chars can be appended to the string without
+// reallocating.
+//
+// Returns:
+//
+// Returns true on success.
+//
+// If s is null or invalid, does nothing and returns false.
+//
+// On failure to allocate, returns false and leaves s unchanged.
+bool ss_string_reserve(struct ss_string *s, size_t n);
+
+// Get a pointer to the unused capacity following the string's contents.
+//
+// `avail` is set to the number of chars that may be written there; room for the
+// null terminator is already excluded. Call [ss_string_reserve] first to make
+// room, then [ss_string_commit] to add the written chars to the string:
+//
+// ```
+// size_t avail = 0;
+// ss_string_reserve(s, 64);
+// char *spare = ss_string_spare(s, &avail);
+// size_t n = produce_chars(spare, avail);
+// ss_string_commit(s, n);
+// ```
+//
+// Returns NULL if s is null or has no spare capacity.
+char *ss_string_spare(struct ss_string *s, size_t *avail);
+
+// Add `n` chars written into the string's spare capacity to the string.
+//
+// Returns:
+//
+// Returns true on success.
+//
+// If s is null or invalid or if `n` exceeds the spare capacity, does nothing
+// and returns false.
+bool ss_string_commit(struct ss_string *s, size_t n);
+
 // Get a constant reference to the underlying C string.
-const char *ss_string_as_cstring(struct ss_string *s);
+const char *ss_string_as_cstring(const struct ss_string *s);
 
 // Get the length of this string.
 size_t ss_string_len(const struct ss_string *s);
@@ -147,4 +264,19 @@ bool ss_string_is_empty(const struct ss_string *s);
 // strings is NULL (invalid), in which case ss_string_cmp returns -1.
 int ss_string_cmp(const struct ss_string *s1, const struct ss_string *s2);
 
+// Compute a 64-bit hash of the string's contents.
+//
+// The null terminator is not hashed, so a NULL string, a string that was never
+// allocated, and "" all hash alike, and a string hashes the same as its
+// contents passed to [ss_string_hash_data].
+//
+// The hash is not cryptographic, and may differ between platforms of
+// different byte order.
+uint64_t ss_string_hash(const struct ss_string *s);
+
+// Compute a 64-bit hash of `len` chars of data.
+//
+// This behaves like [ss_string_hash]. `data` may be NULL if `len` is 0.
+uint64_t ss_string_hash_data(const char *data, size_t len);
+
 #endif
@@ -0,0 +1,129 @@
+#ifndef SS_LIB_STRING_IO_H
+#define SS_LIB_STRING_IO_H
+
+/* This Source Code Form is subject to the terms of the Mozilla Public License,
+ * v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ * obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/* File and file descriptor input for ss_string.
+ *
+ * - [ss_string_read_file] and [ss_string_read_fd] read directly into a
+ *   string's spare capacity; a regular file is read with a single allocation.
+ * - [ss_file_view_open] maps a file read-only, for large files that do not
+ *   need to be copied at all.
+ * - [ss_line_reader_create] reads lines from a file descriptor through a
+ *   reusable buffer, and [ss_line_iter_create] splits any buffer (such as a
+ *   file view) into lines. Neither copies the lines they return.
+ *
+ * ss_string cannot hold null chars, so these functions are intended for text.
+ *
+ * Only available on POSIX systems.
+ *
+ *  Requires:
+ *
+ *  ss_string.h
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "ss_string.h"
+
+// A read-only, memory-mapped file.
+struct ss_file_view;
+
+// Reads lines from a file descriptor.
+struct ss_line_reader;
+
+// Iterates over the lines of an in-memory buffer.
+//
+// Create with [ss_line_iter_create].
+struct ss_line_iter {
+    const char *data_;
+    size_t len_;
+    size_t pos_;
+};
+
+// Read the entire file at `path` into a new string.
+//
+// The buffer is sized from the file's size before reading, so a regular file
+// is read with a single allocation.
+//
+// The returned pointer will be NULL if the file cannot be read or on failure
+// to allocate.
+struct ss_string *ss_string_read_file(const char *path);
+
+// Read from `fd` until end-of-file, appending the data to `dest`.
+//
+// Data is read directly into the string's spare capacity; the string grows
+// only when that capacity is exhausted.
+//
+// Returns:
+//
+// Returns true on success.
+//
+// If dest is null or invalid, returns false.
+//
+// On a read error or failure to allocate, returns false; `dest` contains
+// whatever was read before the failure.
+bool ss_string_read_fd(struct ss_string *dest, int fd);
+
+// Map the file at `path` into memory, read-only.
+//
+// The returned pointer will be NULL if the file cannot be opened or mapped, or
+// on failure to allocate.
+struct ss_file_view *ss_file_view_open(const char *path);
+
+// Unmap the file and set the view's pointer to NULL.
+void ss_file_view_close(struct ss_file_view **view);
+
+// Get a constant reference to the file's contents.
+//
+// The data is not null-terminated. Returns NULL for an empty file.
+const char *ss_file_view_data(const struct ss_file_view *view);
+
+// Get the length of the file's contents.
+size_t ss_file_view_len(const struct ss_file_view *view);
+
+// Create a line reader for `fd`.
+//
+// `buf_size` is the initial size of the read buffer; if 0, a default is used.
+// The buffer grows as needed to hold long lines.
+//
+// The reader does not take ownership of `fd`.
+//
+// The returned pointer will be NULL on failure to allocate.
+struct ss_line_reader *ss_line_reader_create(int fd, size_t buf_size);
+
+// Free the provided line reader and set its pointer to NULL.
+void ss_line_reader_free(struct ss_line_reader **reader);
+
+// Read the next line.
+//
+// `line` is set to the start of the line and `len` to its length, excluding
+// the '\n'. The line is not null-terminated and is only valid until the next
+// call to `ss_line_reader_next`.
+//
+// Returns false at end-of-file or on error; use [ss_line_reader_failed] to tell
+// them apart.
+bool ss_line_reader_next(
+    struct ss_line_reader *reader,
+    const char **line,
+    size_t *len
+);
+
+// Returns `true` if the reader stopped because of a read error or a failure
+// to allocate.
+bool ss_line_reader_failed(const struct ss_line_reader *reader);
+
+// Create an iterator over the lines of `data`.
+struct ss_line_iter ss_line_iter_create(const char *data, size_t len);
+
+// Get the next line.
+//
+// This behaves like [ss_line_reader_next], but lines point into the original
+// buffer and remain valid as long as it does.
+bool ss_line_iter_next(struct ss_line_iter *iter, const char **line, size_t *len);
+
+#endif
@@ -0,0 +1,121 @@
+#ifndef SS_LIB_STRTAB_H
+#define SS_LIB_STRTAB_H
+
+/* This Source Code Form is subject to the terms of the Mozilla Public License,
+ * v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ * obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/* Packed string table.
+ *
+ * A string table stores any number of strings back to back in a single
+ * growable buffer, with a parallel array of offsets. Compared to an array of
+ * ss_string pointers, this needs no allocation per string and keeps the strings
+ * in order in memory, so iterating over the table reads memory sequentially.
+ *
+ * Each string is stored with a null terminator, so a string in the table can be
+ * used as a C string. Strings may also contain null bytes, in which case their
+ * length must be taken from the view.
+ *
+ * Strings cannot be modified or removed individually once appended, except by
+ * sorting and deduplicating the table.
+ *
+ *  Requires:
+ *
+ *  ss_array.h
+ *  ss_math.h
+ *  ss_string.h
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "ss_string.h"
+
+// A table of strings stored in one buffer.
+struct ss_strtab;
+
+// A string within a table.
+//
+// The view is invalidated by any change to the table.
+struct ss_strtab_view {
+    const char *data;
+    // The length of the string, not including the null terminator
+    size_t len;
+};
+
+// Create a new, empty string table.
+//
+// The returned pointer will be NULL on failure to allocate.
+struct ss_strtab *ss_strtab_create();
+
+// Create a new, empty string table with room for `num_strings` strings
+// containing a total of `num_bytes` chars (not including null terminators).
+//
+// The returned pointer will be NULL on failure to allocate.
+struct ss_strtab *ss_strtab_create_with_size(
+    size_t num_strings,
+    size_t num_bytes
+);
+
+// Free the provided table and set its pointer to NULL.
+void ss_strtab_free(struct ss_strtab **tab);
+
+// Remove all strings from the table without freeing its buffers.
+void ss_strtab_clear(struct ss_strtab *tab);
+
+// Append a copy of `len` chars of `data` to the table.
+//
+// Returns:
+//
+// Returns true on success.
+//
+// If tab is NULL, or data is NULL and `len` is not 0, does nothing and returns
+// false. An empty string may be appended.
+//
+// On failure to allocate, returns false and leaves the table unchanged.
+bool ss_strtab_append(struct ss_strtab *tab, const char *data, size_t len);
+
+// Append a copy of the provided C string to the table.
+//
+// See [ss_strtab_append].
+bool ss_strtab_append_cstring(struct ss_strtab *tab, const char *s);
+
+// Append a copy of the provided string to the table.
+//
+// See [ss_strtab_append].
+bool ss_strtab_append_string(struct ss_strtab *tab, const struct ss_string *s);
+
+// Get the number of strings in the table.
+size_t ss_strtab_len(const struct ss_strtab *tab);
+
+// Get the total number of chars stored in the table, including null
+// terminators.
+size_t ss_strtab_data_len(const struct ss_strtab *tab);
+
+// Get a view of the string at position `pos`.
+//
+// If tab is NULL or `pos` is out of bounds, returns a view with NULL data and a
+// length of 0.
+struct ss_strtab_view ss_strtab_get(const struct ss_strtab *tab, size_t pos);
+
+// Get the string at position `pos` as a C string.
+//
+// If tab is NULL or `pos` is out of bounds, returns NULL.
+const char *ss_strtab_cstring(const struct ss_strtab *tab, size_t pos);
+
+// Sort the strings by content.
+//
+// Strings are compared bytewise as unsigned chars; a string sorts before any
+// longer string that it is a prefix of. The buffer is rewritten in the new
+// order, so the sorted table is still read sequentially.
+//
+// Returns false on failure to allocate, and leaves the table unchanged.
+bool ss_strtab_sort(struct ss_strtab *tab);
+
+// Sort the strings by content and remove duplicates.
+//
+// Returns false on failure to allocate, and leaves the table unchanged.
+bool ss_strtab_dedup(struct ss_strtab *tab);
+
+#endif
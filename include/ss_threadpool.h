@@ -0,0 +1,91 @@
+#ifndef SS_LIB_THREADPOOL_H
+#define SS_LIB_THREADPOOL_H
+
+/* This Source Code Form is subject to the terms of the Mozilla Public License,
+ * v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ * obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/* Work-stealing thread pool.
+ *
+ * Each worker thread has its own deque of tasks (a Chase-Lev deque). A worker
+ * pushes and pops tasks at one end of its deque without locking; idle workers
+ * steal from the other end of other workers' deques. Tasks submitted from
+ * outside the pool go to a shared queue that all workers take from.
+ *
+ * [ss_parallel_for] splits a range in half recursively, pushing one half as a
+ * task for others to steal while working on the other, until ranges are no
+ * longer than the grain size. Uneven work is balanced by stealing, and ranges
+ * are only split as far as idle workers need.
+ *
+ * Threads waiting for tasks to finish, in [ss_threadpool_wait] or
+ * [ss_parallel_for], run queued tasks while they wait.
+ *
+ * Idle workers sleep until more tasks are submitted.
+ *
+ * The pool's functions may be called from any thread, including from within
+ * tasks.
+ *
+ * Requires POSIX threads.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// A pool of worker threads.
+struct ss_threadpool;
+
+// Get the number of online CPUs, or 1 if it cannot be determined.
+size_t ss_threadpool_num_cpus(void);
+
+// Create a pool with `num_threads` worker threads.
+//
+// If `num_threads` is 0, creates one thread per online CPU.
+//
+// The returned pointer will be NULL on failure to allocate or to start the
+// threads.
+struct ss_threadpool *ss_threadpool_create(size_t num_threads);
+
+// Wait for all tasks to finish, stop the worker threads, free the pool, and
+// set its pointer to NULL.
+//
+// Must not be called from within one of the pool's tasks.
+void ss_threadpool_free(struct ss_threadpool **pool);
+
+// Get the number of worker threads in the pool.
+size_t ss_threadpool_num_threads(const struct ss_threadpool *pool);
+
+// Submit a task that calls `fn(ctx)`.
+//
+// Returns false if pool or fn are NULL, or on failure to allocate.
+bool ss_threadpool_submit(
+    struct ss_threadpool *pool,
+    void (*fn)(void *ctx),
+    void *ctx
+);
+
+// Wait until every submitted task has finished, running tasks on the calling
+// thread in the meantime.
+//
+// Tasks submitted while waiting (including by other tasks) are waited for as
+// well.
+void ss_threadpool_wait(struct ss_threadpool *pool);
+
+// Call `fn` on subranges covering [`begin`, `end`), in parallel, and wait for
+// all of them to finish.
+//
+// Each call covers at most `grain` elements, unless the range could not be
+// split for lack of memory. If `grain` is 0, one is chosen to give about eight
+// subranges per thread.
+//
+// If pool is NULL, calls `fn` once on the whole range on the calling thread.
+void ss_parallel_for(
+    struct ss_threadpool *pool,
+    size_t begin,
+    size_t end,
+    size_t grain,
+    void (*fn)(size_t begin, size_t end, void *ctx),
+    void *ctx
+);
+
+#endif
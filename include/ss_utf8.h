@@ -0,0 +1,70 @@
+#ifndef SS_LIB_UTF8_H
+#define SS_LIB_UTF8_H
+
+/* This Source Code Form is subject to the terms of the Mozilla Public License,
+ * v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ * obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/* UTF-8 validation, length, and code point iteration.
+ *
+ * On x86 with GCC or Clang, validation uses a vectorized lookup-table
+ * algorithm (SSSE3 or AVX2, chosen at runtime through ss_cpu.h) with a fast
+ * path for ASCII blocks. Other platforms use a scalar validator.
+ *
+ * Valid UTF-8 follows RFC 3629: overlong encodings, surrogates, and code
+ * points above U+10FFFF are rejected.
+ *
+ *  Requires:
+ *
+ *  ss_cpu.h, ss_string.h
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ss_string.h"
+
+// The code point produced for invalid sequences.
+#define SS_UTF8_REPLACEMENT_CHAR 0xFFFD
+
+// Iterates over the code points of a UTF-8 buffer.
+//
+// Create with [ss_utf8_iter_create] or [ss_string_utf8_iter].
+struct ss_utf8_iter {
+    const char *data_;
+    size_t len_;
+    size_t pos_;
+};
+
+// Check whether `len` bytes of `data` are valid UTF-8.
+bool ss_utf8_validate(const char *data, size_t len);
+
+// Count the code points in `len` bytes of valid UTF-8 data.
+//
+// The result is unspecified if the data is not valid UTF-8.
+size_t ss_utf8_len(const char *data, size_t len);
+
+// Create an iterator over the code points of `data`.
+struct ss_utf8_iter ss_utf8_iter_create(const char *data, size_t len);
+
+// Decode the next code point.
+//
+// Invalid sequences produce [SS_UTF8_REPLACEMENT_CHAR] and advance by one byte.
+//
+// Returns false once all code points have been read.
+bool ss_utf8_iter_next(struct ss_utf8_iter *iter, uint32_t *code_point);
+
+// Check whether the string is valid UTF-8.
+bool ss_string_utf8_validate(const struct ss_string *s);
+
+// Count the code points in a string containing valid UTF-8.
+size_t ss_string_utf8_len(const struct ss_string *s);
+
+// Create an iterator over the string's code points.
+//
+// Modifying the string invalidates the iterator.
+struct ss_utf8_iter ss_string_utf8_iter(const struct ss_string *s);
+
+#endif
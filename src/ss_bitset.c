@@ -0,0 +1,303 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public License,
+ * v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ * obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ss_bitset.h"
+#include "ss_math.h"
+
+#ifdef USE_SS_LIB_ASSERT
+    #include "ss_assert.h"
+#else
+    #include <assert.h>
+
+    #define ss_check(EXPR, MSG) assert(EXPR)
+    #define ss_assert assert
+    #define ss_assert_msg(EXPR, ...) assert(EXPR)
+#endif
+
+#define SS_BITSET_WORD_BITS 64
+
+struct ss_bitset {
+    uint64_t *words;
+    // The number of bits; bits past this in the last word are always clear.
+    size_t len;
+    // capacity is words
+    size_t capacity;
+};
+
+static size_t ss_bitset_num_words_(size_t num_bits) {
+    return num_bits / SS_BITSET_WORD_BITS
+        + (num_bits % SS_BITSET_WORD_BITS != 0);
+}
+
+static size_t ss_bitset_popcount_(uint64_t word) {
+#ifdef __GNUC__
+    return (size_t) __builtin_popcountll(word);
+#else
+    size_t count = 0;
+    for (; word != 0; word &= word - 1) { count += 1; }
+    return count;
+#endif
+}
+
+static size_t ss_bitset_ctz_(uint64_t word) {
+#ifdef __GNUC__
+    return (size_t) __builtin_ctzll(word);
+#else
+    size_t count = 0;
+    for (; (word & 1) == 0; word >>= 1) { count += 1; }
+    return count;
+#endif
+}
+
+// Clear the bits of the last word that are past the end.
+static void ss_bitset_trim_(struct ss_bitset *bits) {
+    size_t extra = bits->len % SS_BITSET_WORD_BITS;
+    if (extra != 0) {
+        bits->words[bits->len / SS_BITSET_WORD_BITS] &=
+            ((uint64_t) 1 << extra) - 1;
+    }
+}
+
+struct ss_bitset *ss_bitset_create() {
+    return ss_bitset_create_with_size(0);
+}
+
+struct ss_bitset *ss_bitset_create_with_size(size_t num_bits) {
+    struct ss_bitset *bits =
+        (struct ss_bitset*) malloc(sizeof(struct ss_bitset));
+    if (bits == NULL) return NULL;
+
+    bits->words = NULL;
+    bits->len = 0;
+    bits->capacity = 0;
+
+    if (! ss_bitset_resize(bits, num_bits)) {
+        free(bits);
+        return NULL;
+    }
+
+    return bits;
+}
+
+void ss_bitset_free(struct ss_bitset **bits) {
+    if (bits == NULL || *bits == NULL) return;
+
+    free((*bits)->words);
+    free(*bits);
+    *bits = NULL;
+}
+
+size_t ss_bitset_len(const struct ss_bitset *bits) {
+    if (bits == NULL) return 0;
+    return bits->len;
+}
+
+bool ss_bitset_resize(struct ss_bitset *bits, size_t num_bits) {
+    if (bits == NULL) return false;
+
+    size_t old_words = ss_bitset_num_words_(bits->len);
+    size_t new_words = ss_bitset_num_words_(num_bits);
+
+    if (new_words > bits->capacity) {
+        // next_pow_of_two wraps to 0 past the largest power of two.
+        uint64_t new_cap = next_pow_of_two(new_words);
+        if (new_cap < new_words || new_cap > SIZE_MAX / sizeof(uint64_t)) {
+            return false;
+        }
+
+        uint64_t *words = (uint64_t*) realloc(bits->words,
+            (size_t) new_cap * sizeof(uint64_t));
+        if (words == NULL) return false;
+
+        bits->words = words;
+        bits->capacity = (size_t) new_cap;
+    }
+
+    if (new_words > old_words) {
+        memset(bits->words + old_words, 0,
+            (new_words - old_words) * sizeof(uint64_t));
+    }
+
+    bits->len = num_bits;
+    if (num_bits < SS_BITSET_WORD_BITS * old_words) { ss_bitset_trim_(bits); }
+
+    return true;
+}
+
+bool ss_bitset_set(struct ss_bitset *bits, size_t pos) {
+    // A bitset can't hold SIZE_MAX + 1 bits.
+    if (bits == NULL || pos == SIZE_MAX) return false;
+
+    if (pos >= bits->len && ! ss_bitset_resize(bits, pos + 1)) return false;
+
+    bits->words[pos / SS_BITSET_WORD_BITS] |=
+        (uint64_t) 1 << (pos % SS_BITSET_WORD_BITS);
+    return true;
+}
+
+void ss_bitset_clear(struct ss_bitset *bits, size_t pos) {
+    if (bits == NULL || pos >= bits->len) return;
+
+    bits->words[pos / SS_BITSET_WORD_BITS] &=
+        ~((uint64_t) 1 << (pos % SS_BITSET_WORD_BITS));
+}
+
+bool ss_bitset_test(const struct ss_bitset *bits, size_t pos) {
+    if (bits == NULL || pos >= bits->len) return false;
+
+    return (bits->words[pos / SS_BITSET_WORD_BITS]
+        >> (pos % SS_BITSET_WORD_BITS)) & 1;
+}
+
+void ss_bitset_set_all(struct ss_bitset *bits) {
+    if (bits == NULL || bits->len == 0) return;
+
+    memset(bits->words, 0xFF,
+        ss_bitset_num_words_(bits->len) * sizeof(uint64_t));
+    ss_bitset_trim_(bits);
+}
+
+void ss_bitset_clear_all(struct ss_bitset *bits) {
+    if (bits == NULL || bits->len == 0) return;
+
+    memset(bits->words, 0, ss_bitset_num_words_(bits->len) * sizeof(uint64_t));
+}
+
+size_t ss_bitset_count(const struct ss_bitset *bits) {
+    if (bits == NULL) return 0;
+
+    size_t count = 0;
+    size_t num_words = ss_bitset_num_words_(bits->len);
+
+    for (size_t i = 0; i < num_words; ++i) {
+        count += ss_bitset_popcount_(bits->words[i]);
+    }
+    return count;
+}
+
+size_t ss_bitset_next_set(const struct ss_bitset *bits, size_t pos) {
+    if (bits == NULL || pos >= bits->len) return SIZE_MAX;
+
+    size_t num_words = ss_bitset_num_words_(bits->len);
+    size_t i = pos / SS_BITSET_WORD_BITS;
+
+    // Ignore the bits before pos in its word.
+    uint64_t word =
+        bits->words[i] & (~(uint64_t) 0 << (pos % SS_BITSET_WORD_BITS));
+
+    while (word == 0) {
+        if (++i == num_words) return SIZE_MAX;
+        word = bits->words[i];
+    }
+
+    return i * SS_BITSET_WORD_BITS + ss_bitset_ctz_(word);
+}
+
+size_t ss_bitset_find_first(const struct ss_bitset *bits) {
+    return ss_bitset_next_set(bits, 0);
+}
+
+// The bulk operations work on raw word arrays that do not alias, so the
+// compiler can vectorize the loops.
+
+static void ss_bitset_and_words_(
+    uint64_t *restrict dest,
+    const uint64_t *restrict src,
+    size_t num_words
+) {
+    for (size_t i = 0; i < num_words; ++i) { dest[i] &= src[i]; }
+}
+
+static void ss_bitset_or_words_(
+    uint64_t *restrict dest,
+    const uint64_t *restrict src,
+    size_t num_words
+) {
+    for (size_t i = 0; i < num_words; ++i) { dest[i] |= src[i]; }
+}
+
+static void ss_bitset_xor_words_(
+    uint64_t *restrict dest,
+    const uint64_t *restrict src,
+    size_t num_words
+) {
+    for (size_t i = 0; i < num_words; ++i) { dest[i] ^= src[i]; }
+}
+
+static void ss_bitset_andnot_words_(
+    uint64_t *restrict dest,
+    const uint64_t *restrict src,
+    size_t num_words
+) {
+    for (size_t i = 0; i < num_words; ++i) { dest[i] &= ~src[i]; }
+}
+
+bool ss_bitset_and(struct ss_bitset *dest, const struct ss_bitset *src) {
+    if (dest == NULL || src == NULL) return false;
+    if (dest == src) return true;
+
+    size_t dest_words = ss_bitset_num_words_(dest->len);
+    size_t src_words = ss_bitset_num_words_(src->len);
+    size_t common = dest_words < src_words ? dest_words : src_words;
+
+    ss_bitset_and_words_(dest->words, src->words, common);
+    if (dest_words > common) {
+        memset(dest->words + common, 0,
+            (dest_words - common) * sizeof(uint64_t));
+    }
+    return true;
+}
+
+bool ss_bitset_or(struct ss_bitset *dest, const struct ss_bitset *src) {
+    if (dest == NULL || src == NULL) return false;
+    if (dest == src) return true;
+
+    if (dest->len < src->len && ! ss_bitset_resize(dest, src->len)) {
+        return false;
+    }
+
+    ss_bitset_or_words_(dest->words, src->words,
+        ss_bitset_num_words_(src->len));
+    return true;
+}
+
+bool ss_bitset_xor(struct ss_bitset *dest, const struct ss_bitset *src) {
+    if (dest == NULL || src == NULL) return false;
+
+    if (dest == src) {
+        ss_bitset_clear_all(dest);
+        return true;
+    }
+
+    if (dest->len < src->len && ! ss_bitset_resize(dest, src->len)) {
+        return false;
+    }
+
+    ss_bitset_xor_words_(dest->words, src->words,
+        ss_bitset_num_words_(src->len));
+    return true;
+}
+
+bool ss_bitset_andnot(struct ss_bitset *dest, const struct ss_bitset *src) {
+    if (dest == NULL || src == NULL) return false;
+
+    if (dest == src) {
+        ss_bitset_clear_all(dest);
+        return true;
+    }
+
+    size_t dest_words = ss_bitset_num_words_(dest->len);
+    size_t src_words = ss_bitset_num_words_(src->len);
+
+    ss_bitset_andnot_words_(dest->words, src->words,
+        dest_words < src_words ? dest_words : src_words);
+    return true;
+}
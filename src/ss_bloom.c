@@ -0,0 +1,336 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public License,
+ * v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ * obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ss_bloom.h"
+#include "ss_string.h"
+
+#ifdef USE_SS_LIB_ASSERT
+    #include "ss_assert.h"
+#else
+    #include <assert.h>
+
+    #define ss_check(EXPR, MSG) assert(EXPR)
+    #define ss_assert assert
+    #define ss_assert_msg(EXPR, ...) assert(EXPR)
+#endif
+
+#ifdef __GNUC__
+    #define SS_BLOOM_PREFETCH_(P) __builtin_prefetch(P)
+#else
+    #define SS_BLOOM_PREFETCH_(P) ((void) (P))
+#endif
+
+// A block of a blocked filter is one cache line.
+#define SS_BLOOM_BLOCK_BITS 512
+#define SS_BLOOM_BLOCK_WORDS (SS_BLOOM_BLOCK_BITS / 64)
+
+#define SS_BLOOM_LN2 0.69314718055994530942
+
+// The number of keys hashed and prefetched at a time by the batch functions.
+#define SS_BLOOM_BATCH 16
+
+struct ss_bloom {
+    uint64_t *words;
+    size_t num_bits;
+    // Only used by blocked filters
+    size_t num_blocks;
+    size_t num_hashes;
+    bool blocked;
+};
+
+// The false-positive rate of a blocked filter of `num_bits` holding
+// `expected` keys.
+//
+// The number of keys in a block follows a Poisson distribution; each block's
+// rate is that of a small standard filter, weighted by how likely the block is
+// to hold that many keys.
+static double ss_bloom_blocked_fp_rate_(
+    double num_bits,
+    double expected,
+    double num_hashes
+) {
+    double per_block = expected * SS_BLOOM_BLOCK_BITS / num_bits;
+    double spread = 10.0 * sqrt(per_block) + 10.0;
+    double first = per_block > spread ? floor(per_block - spread) : 0.0;
+
+    double rate = 0.0;
+    for (double j = first; j <= per_block + spread; j += 1.0) {
+        double log_prob = -per_block + j * log(per_block) - lgamma(j + 1.0);
+        double bit_set =
+            1.0 - pow(1.0 - 1.0 / SS_BLOOM_BLOCK_BITS, j * num_hashes);
+
+        rate += exp(log_prob) * pow(bit_set, num_hashes);
+    }
+    return rate;
+}
+
+static struct ss_bloom *ss_bloom_create_(
+    size_t expected,
+    double fp_rate,
+    bool blocked
+) {
+    if (expected == 0 || ! (fp_rate > 0.0 && fp_rate < 1.0)) return NULL;
+
+    // The standard sizing: m = -n ln(p) / ln(2)^2 bits and k = m/n ln(2)
+    // hashes.
+    double n = (double) expected;
+    double bits = ceil(-n * log(fp_rate) / (SS_BLOOM_LN2 * SS_BLOOM_LN2));
+    double hashes = round(bits / n * SS_BLOOM_LN2);
+    if (hashes < 1.0) { hashes = 1.0; }
+
+    size_t word_bits = blocked ? SS_BLOOM_BLOCK_BITS : 64;
+    bits = ceil(bits / (double) word_bits) * (double) word_bits;
+
+    if (blocked) {
+        // Grow the filter until uneven filling of the blocks is made up for.
+        for (size_t i = 0;
+            i < 100 && ss_bloom_blocked_fp_rate_(bits, n, hashes) > fp_rate;
+            ++i
+        ) {
+            bits = ceil(bits * 1.05 / SS_BLOOM_BLOCK_BITS)
+                * SS_BLOOM_BLOCK_BITS;
+        }
+    }
+
+    if (bits > (double) (SIZE_MAX / 2)) return NULL;
+
+    struct ss_bloom *bloom = (struct ss_bloom*) malloc(sizeof(struct ss_bloom));
+    if (bloom == NULL) return NULL;
+
+    bloom->num_bits = (size_t) bits;
+    bloom->num_blocks = bloom->num_bits / SS_BLOOM_BLOCK_BITS;
+    bloom->num_hashes = (size_t) hashes;
+    bloom->blocked = blocked;
+
+    size_t sz = bloom->num_bits / 8;
+    if (blocked) {
+        bloom->words = (uint64_t*) aligned_alloc(SS_BLOOM_BLOCK_BITS / 8, sz);
+        if (bloom->words != NULL) { memset(bloom->words, 0, sz); }
+    } else {
+        bloom->words = (uint64_t*) calloc(sz, 1);
+    }
+
+    if (bloom->words == NULL) {
+        free(bloom);
+        return NULL;
+    }
+
+    return bloom;
+}
+
+struct ss_bloom *ss_bloom_create(size_t expected, double fp_rate) {
+    return ss_bloom_create_(expected, fp_rate, false);
+}
+
+struct ss_bloom *ss_bloom_create_blocked(size_t expected, double fp_rate) {
+    return ss_bloom_create_(expected, fp_rate, true);
+}
+
+void ss_bloom_free(struct ss_bloom **bloom) {
+    if (bloom == NULL || *bloom == NULL) return;
+
+    free((*bloom)->words);
+    free(*bloom);
+    *bloom = NULL;
+}
+
+size_t ss_bloom_num_bits(const struct ss_bloom *bloom) {
+    if (bloom == NULL) return 0;
+    return bloom->num_bits;
+}
+
+size_t ss_bloom_num_hashes(const struct ss_bloom *bloom) {
+    if (bloom == NULL) return 0;
+    return bloom->num_hashes;
+}
+
+void ss_bloom_clear(struct ss_bloom *bloom) {
+    if (bloom == NULL) return;
+    memset(bloom->words, 0, bloom->num_bits / 8);
+}
+
+// Double hashing: the i-th bit of a key is at h1 + i * h2, where h1 is the
+// key's hash and h2 is taken from a remix of it.
+static uint64_t ss_bloom_second_hash_(uint64_t hash) {
+    return ((hash * 0x9E3779B97F4A7C15ull) >> 32) | 1;
+}
+
+// Get the block of a blocked filter that holds a key's bits.
+static uint64_t *ss_bloom_block_(const struct ss_bloom *bloom, uint64_t hash) {
+    return bloom->words
+        + (size_t) ((hash >> 32) % bloom->num_blocks) * SS_BLOOM_BLOCK_WORDS;
+}
+
+// Within a block, double hashing repeats too often: two keys in a block with
+// the same h2 share most of their bits. Instead, each bit is taken from the
+// top of the next multiple of the hash, which depends on all of its bits.
+static uint64_t ss_bloom_block_step_(uint64_t *state) {
+    *state *= 0xD6E8FEB86659FD93ull;
+    return *state >> (64 - 9);
+}
+
+void ss_bloom_add_hash(struct ss_bloom *bloom, uint64_t hash) {
+    if (bloom == NULL) return;
+
+    if (bloom->blocked) {
+        uint64_t *block = ss_bloom_block_(bloom, hash);
+        uint64_t state = hash;
+
+        for (size_t i = 0; i < bloom->num_hashes; ++i) {
+            uint64_t bit = ss_bloom_block_step_(&state);
+            block[bit / 64] |= (uint64_t) 1 << (bit % 64);
+        }
+    } else {
+        uint64_t h2 = ss_bloom_second_hash_(hash);
+        uint64_t pos = hash;
+
+        for (size_t i = 0; i < bloom->num_hashes; ++i, pos += h2) {
+            size_t bit = (size_t) (pos % bloom->num_bits);
+            bloom->words[bit / 64] |= (uint64_t) 1 << (bit % 64);
+        }
+    }
+}
+
+bool ss_bloom_contains_hash(const struct ss_bloom *bloom, uint64_t hash) {
+    if (bloom == NULL) return false;
+
+    // Checking every bit without branching on each is faster than stopping at
+    // the first clear bit; k is small and a blocked filter's words are cached.
+    uint64_t found = 1;
+
+    if (bloom->blocked) {
+        const uint64_t *block = ss_bloom_block_(bloom, hash);
+        uint64_t state = hash;
+
+        for (size_t i = 0; i < bloom->num_hashes; ++i) {
+            uint64_t bit = ss_bloom_block_step_(&state);
+            found &= block[bit / 64] >> (bit % 64);
+        }
+    } else {
+        uint64_t h2 = ss_bloom_second_hash_(hash);
+        uint64_t pos = hash;
+
+        for (size_t i = 0; i < bloom->num_hashes; ++i, pos += h2) {
+            size_t bit = (size_t) (pos % bloom->num_bits);
+            found &= bloom->words[bit / 64] >> (bit % 64);
+        }
+    }
+    return found & 1;
+}
+
+void ss_bloom_add(struct ss_bloom *bloom, const struct ss_string *key) {
+    ss_bloom_add_hash(bloom, ss_string_hash(key));
+}
+
+bool ss_bloom_contains(
+    const struct ss_bloom *bloom,
+    const struct ss_string *key
+) {
+    return ss_bloom_contains_hash(bloom, ss_string_hash(key));
+}
+
+void ss_bloom_add_data(struct ss_bloom *bloom, const char *data, size_t len) {
+    ss_bloom_add_hash(bloom, ss_string_hash_data(data, len));
+}
+
+bool ss_bloom_contains_data(
+    const struct ss_bloom *bloom,
+    const char *data,
+    size_t len
+) {
+    return ss_bloom_contains_hash(bloom, ss_string_hash_data(data, len));
+}
+
+// Hash a group of keys and prefetch the memory they will touch.
+static void ss_bloom_prefetch_(
+    const struct ss_bloom *bloom,
+    const struct ss_string **keys,
+    size_t n,
+    uint64_t *hashes
+) {
+    for (size_t i = 0; i < n; ++i) {
+        hashes[i] = ss_string_hash(keys[i]);
+
+        if (bloom->blocked) {
+            SS_BLOOM_PREFETCH_(ss_bloom_block_(bloom, hashes[i]));
+        } else {
+            uint64_t h2 = ss_bloom_second_hash_(hashes[i]);
+            uint64_t pos = hashes[i];
+
+            for (size_t j = 0; j < bloom->num_hashes; ++j, pos += h2) {
+                SS_BLOOM_PREFETCH_(
+                    &bloom->words[(size_t) (pos % bloom->num_bits) / 64]);
+            }
+        }
+    }
+}
+
+void ss_bloom_add_batch(
+    struct ss_bloom *bloom,
+    const struct ss_string **keys,
+    size_t n
+) {
+    if (bloom == NULL || keys == NULL) return;
+
+    uint64_t hashes[SS_BLOOM_BATCH];
+
+    for (size_t i = 0; i < n; i += SS_BLOOM_BATCH) {
+        size_t group = n - i < SS_BLOOM_BATCH ? n - i : SS_BLOOM_BATCH;
+
+        ss_bloom_prefetch_(bloom, keys + i, group, hashes);
+        for (size_t j = 0; j < group; ++j) {
+            ss_bloom_add_hash(bloom, hashes[j]);
+        }
+    }
+}
+
+size_t ss_bloom_contains_batch(
+    const struct ss_bloom *bloom,
+    const struct ss_string **keys,
+    size_t n,
+    bool *out
+) {
+    if (bloom == NULL || keys == NULL || out == NULL) return 0;
+
+    uint64_t hashes[SS_BLOOM_BATCH];
+    size_t found = 0;
+
+    for (size_t i = 0; i < n; i += SS_BLOOM_BATCH) {
+        size_t group = n - i < SS_BLOOM_BATCH ? n - i : SS_BLOOM_BATCH;
+
+        ss_bloom_prefetch_(bloom, keys + i, group, hashes);
+        for (size_t j = 0; j < group; ++j) {
+            out[i + j] = ss_bloom_contains_hash(bloom, hashes[j]);
+            found += out[i + j];
+        }
+    }
+    return found;
+}
+
+bool ss_bloom_union(struct ss_bloom *dest, const struct ss_bloom *src) {
+    if (dest == NULL || src == NULL) return false;
+    if (dest == src) return true;
+    if (dest->num_bits != src->num_bits
+        || dest->num_hashes != src->num_hashes
+        || dest->blocked != src->blocked
+    ) {
+        return false;
+    }
+
+    size_t num_words = dest->num_bits / 64;
+    uint64_t *restrict d = dest->words;
+    const uint64_t *restrict s = src->words;
+
+    for (size_t i = 0; i < num_words; ++i) { d[i] |= s[i]; }
+
+    return true;
+}
@@ -0,0 +1,144 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public License,
+ * v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ * obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ss_cpu.h"
+
+#if (defined __x86_64__ || defined __i386__) && defined __GNUC__
+    #define SS_CPU_X86
+#endif
+
+static const char *const ss_cpu_isa_names_[SS_CPU_ISA_COUNT] = {
+    "scalar", "sse2", "ssse3", "avx2", "avx512"
+};
+
+// The level the CPU supports, or -1 until it has been detected.
+static atomic_int ss_cpu_detected_ = -1;
+
+// The level in use, or -1 until it has been chosen.
+static atomic_int ss_cpu_current_ = -1;
+
+// Incremented whenever the level in use changes, which makes the choice cached
+// in every dispatch table stale. Starts at 1 so that a zeroed table is stale.
+static atomic_uint ss_cpu_generation_ = 1;
+
+static enum ss_cpu_isa ss_cpu_detect_(void) {
+#ifdef SS_CPU_X86
+    __builtin_cpu_init();
+
+    // These also check that the OS saves the wider registers.
+    if (__builtin_cpu_supports("avx512f")
+        && __builtin_cpu_supports("avx512bw")
+        && __builtin_cpu_supports("avx512dq")
+        && __builtin_cpu_supports("avx512vl")
+    ) {
+        return SS_CPU_AVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) return SS_CPU_AVX2;
+    if (__builtin_cpu_supports("ssse3")) return SS_CPU_SSSE3;
+    if (__builtin_cpu_supports("sse2")) return SS_CPU_SSE2;
+#endif
+
+    return SS_CPU_SCALAR;
+}
+
+static enum ss_cpu_isa ss_cpu_detected_isa_(void) {
+    // Threads that race here detect the same level.
+    int isa = atomic_load_explicit(&ss_cpu_detected_, memory_order_relaxed);
+    if (isa < 0) {
+        isa = (int) ss_cpu_detect_();
+        atomic_store_explicit(&ss_cpu_detected_, isa, memory_order_relaxed);
+    }
+
+    return (enum ss_cpu_isa) isa;
+}
+
+// Get the level named by SS_FORCE_ISA, or SS_CPU_ISA_COUNT if it is unset or
+// names no level.
+static enum ss_cpu_isa ss_cpu_env_limit_(void) {
+    const char *name = getenv("SS_FORCE_ISA");
+    if (name == NULL) return SS_CPU_ISA_COUNT;
+
+    for (size_t i = 0; i < SS_CPU_ISA_COUNT; ++i) {
+        if (strcmp(name, ss_cpu_isa_names_[i]) == 0) {
+            return (enum ss_cpu_isa) i;
+        }
+    }
+
+    return SS_CPU_ISA_COUNT;
+}
+
+enum ss_cpu_isa ss_cpu_isa(void) {
+    int isa = atomic_load_explicit(&ss_cpu_current_, memory_order_acquire);
+    if (isa >= 0) return (enum ss_cpu_isa) isa;
+
+    enum ss_cpu_isa detected = ss_cpu_detected_isa_();
+    enum ss_cpu_isa limit = ss_cpu_env_limit_();
+    int chosen = (int) (limit < detected ? limit : detected);
+
+    // Keep a level forced in the meantime.
+    int expected = -1;
+    atomic_compare_exchange_strong(&ss_cpu_current_, &expected, chosen);
+    return (enum ss_cpu_isa) atomic_load(&ss_cpu_current_);
+}
+
+bool ss_cpu_supports(enum ss_cpu_isa isa) {
+    return isa < SS_CPU_ISA_COUNT && isa <= ss_cpu_isa();
+}
+
+const char *ss_cpu_isa_name(enum ss_cpu_isa isa) {
+    if (isa >= SS_CPU_ISA_COUNT) return NULL;
+    return ss_cpu_isa_names_[isa];
+}
+
+enum ss_cpu_isa ss_cpu_force_isa(enum ss_cpu_isa isa) {
+    enum ss_cpu_isa detected = ss_cpu_detected_isa_();
+    if (isa > detected) { isa = detected; }
+
+    atomic_store(&ss_cpu_current_, (int) isa);
+    atomic_fetch_add(&ss_cpu_generation_, 1);
+    return isa;
+}
+
+ss_cpu_fn ss_cpu_resolve(struct ss_cpu_dispatch *dispatch) {
+    if (dispatch == NULL) return NULL;
+
+    unsigned int generation =
+        atomic_load_explicit(&ss_cpu_generation_, memory_order_acquire);
+    if (atomic_load_explicit(&dispatch->generation_, memory_order_acquire)
+        == generation
+    ) {
+        return atomic_load_explicit(&dispatch->chosen_, memory_order_relaxed);
+    }
+
+    ss_cpu_fn chosen = NULL;
+    for (int isa = (int) ss_cpu_isa(); isa >= 0 && chosen == NULL; --isa) {
+        chosen = dispatch->impls[isa];
+    }
+
+    // Publish the choice before the generation that marks it current.
+    atomic_store_explicit(&dispatch->chosen_, chosen, memory_order_relaxed);
+    atomic_store_explicit(&dispatch->generation_, generation,
+        memory_order_release);
+    return chosen;
+}
+
+bool ss_cpu_register(
+    struct ss_cpu_dispatch *dispatch,
+    enum ss_cpu_isa isa,
+    ss_cpu_fn fn
+) {
+    if (dispatch == NULL || isa >= SS_CPU_ISA_COUNT) return false;
+
+    dispatch->impls[isa] = fn;
+    // The generation is never 0, so the next call chooses again.
+    atomic_store(&dispatch->generation_, 0);
+    return true;
+}
@@ -0,0 +1,619 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public License,
+ * v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ * obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ss_array.h"
+#include "ss_cpu.h"
+#include "ss_encoding.h"
+#include "ss_string.h"
+
+#if (defined __x86_64__ || defined __i386__) && defined __GNUC__
+    #define SS_ENCODING_X86
+    #include <immintrin.h>
+#endif
+
+GENERATE_ARRAY2(uint8_t, bytes)
+
+static const char ss_hex_digits_[] = "0123456789abcdef";
+
+static const char ss_base64_alphabet_[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// Invalid chars map to 0xFF; valid chars map to 0-63.
+static const uint8_t ss_base64_values_[256] = {
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,  62, 255,
+    255, 255,  63,  52,  53,  54,  55,  56,  57,  58,  59,  60,  61, 255, 255,
+    255, 255, 255, 255, 255,   0,   1,   2,   3,   4,   5,   6,   7,   8,   9,
+     10,  11,  12,  13,  14,  15,  16,  17,  18,  19,  20,  21,  22,  23,  24,
+     25, 255, 255, 255, 255, 255, 255,  26,  27,  28,  29,  30,  31,  32,  33,
+     34,  35,  36,  37,  38,  39,  40,  41,  42,  43,  44,  45,  46,  47,  48,
+     49,  50,  51, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255
+};
+
+// Get the value of a hex digit, or -1 if `c` is not a hex digit.
+static int32_t ss_hex_value_(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+#ifdef __SSE2__
+
+// Convert each nibble (0-15) to its lowercase hex digit.
+static __m128i ss_hex_digits_sse2_(__m128i nibbles) {
+    __m128i digits = _mm_add_epi8(nibbles, _mm_set1_epi8('0'));
+    __m128i is_letter = _mm_cmpgt_epi8(nibbles, _mm_set1_epi8(9));
+    return _mm_add_epi8(digits,
+        _mm_and_si128(is_letter, _mm_set1_epi8('a' - '0' - 10)));
+}
+
+// Convert 16 hex digits to their values, clearing bits of `valid` for chars
+// that are not hex digits.
+static __m128i ss_hex_values_sse2_(__m128i chars, __m128i *valid) {
+    __m128i d = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+    __m128i is_digit = _mm_cmpeq_epi8(_mm_min_epu8(d, _mm_set1_epi8(9)), d);
+
+    // Folding to lowercase makes 'A'-'F' and 'a'-'f' a single range.
+    __m128i l = _mm_sub_epi8(_mm_or_si128(chars, _mm_set1_epi8(0x20)),
+        _mm_set1_epi8('a'));
+    __m128i is_letter = _mm_cmpeq_epi8(_mm_min_epu8(l, _mm_set1_epi8(5)), l);
+
+    *valid = _mm_and_si128(*valid, _mm_or_si128(is_digit, is_letter));
+
+    return _mm_or_si128(
+        _mm_and_si128(is_digit, d),
+        _mm_and_si128(is_letter, _mm_add_epi8(l, _mm_set1_epi8(10)))
+    );
+}
+
+// Combine pairs of nibbles into bytes, as 16-bit lanes.
+static __m128i ss_hex_combine_sse2_(__m128i nibbles) {
+    __m128i high = _mm_slli_epi16(
+        _mm_and_si128(nibbles, _mm_set1_epi16(0x00FF)), 4);
+    return _mm_or_si128(high, _mm_srli_epi16(nibbles, 8));
+}
+
+// Get a mask of the chars that must be escaped in a JSON string.
+static int32_t ss_json_special_sse2_(__m128i chars) {
+    __m128i control = _mm_cmpeq_epi8(
+        _mm_min_epu8(chars, _mm_set1_epi8(0x1F)), chars);
+    __m128i quote = _mm_cmpeq_epi8(chars, _mm_set1_epi8('"'));
+    __m128i backslash = _mm_cmpeq_epi8(chars, _mm_set1_epi8('\\'));
+
+    return _mm_movemask_epi8(
+        _mm_or_si128(control, _mm_or_si128(quote, backslash)));
+}
+
+// Get a mask of the chars that require a CSV field to be quoted.
+static int32_t ss_csv_special_sse2_(__m128i chars) {
+    __m128i comma = _mm_cmpeq_epi8(chars, _mm_set1_epi8(','));
+    __m128i quote = _mm_cmpeq_epi8(chars, _mm_set1_epi8('"'));
+    __m128i cr = _mm_cmpeq_epi8(chars, _mm_set1_epi8('\r'));
+    __m128i lf = _mm_cmpeq_epi8(chars, _mm_set1_epi8('\n'));
+
+    return _mm_movemask_epi8(_mm_or_si128(_mm_or_si128(comma, quote),
+        _mm_or_si128(cr, lf)));
+}
+
+#endif // __SSE2__
+
+#ifdef SS_ENCODING_X86
+
+// Encode 12 bytes (of the 16 loaded) into 16 base64 chars.
+//
+// See Muła and Lemire, "Faster Base64 Encoding and Decoding Using AVX2
+// Instructions" (2018).
+__attribute__((target("ssse3")))
+static __m128i ss_base64_encode_block_ssse3_(__m128i in) {
+    in = _mm_shuffle_epi8(in,
+        _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+
+    // Move each 6-bit group into its own byte.
+    __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0FC0FC00));
+    __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+    __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003F03F0));
+    __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+    __m128i indices = _mm_or_si128(t1, t3);
+
+    // Map each range of indices to the offset of its range in ASCII.
+    __m128i range = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+    __m128i less = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+    range = _mm_or_si128(range, _mm_and_si128(less, _mm_set1_epi8(13)));
+
+    const __m128i shift_lut = _mm_setr_epi8(
+        'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+        '/' - 63, 'A', 0, 0
+    );
+
+    return _mm_add_epi8(_mm_shuffle_epi8(shift_lut, range), indices);
+}
+
+__attribute__((target("ssse3")))
+static size_t ss_base64_encode_ssse3_(const uint8_t *src, size_t len, char *out)
+{
+    size_t i = 0;
+    size_t o = 0;
+
+    // Each block reads 16 bytes but consumes 12.
+    for (; len - i >= 16; i += 12, o += 16) {
+        __m128i in = _mm_loadu_si128((const __m128i*) (src + i));
+        _mm_storeu_si128((__m128i*) (out + o),
+            ss_base64_encode_block_ssse3_(in));
+    }
+
+    return i;
+}
+
+// Decode 16 base64 chars into 12 bytes (in the low 12 bytes of the result).
+//
+// Returns false if any char is outside the base64 alphabet.
+__attribute__((target("ssse3")))
+static bool ss_base64_decode_block_ssse3_(__m128i in, __m128i *out) {
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+    __m128i high = _mm_and_si128(_mm_srli_epi32(in, 4), nibble);
+    __m128i low = _mm_and_si128(in, nibble);
+
+    // Each valid char's low nibble selects a bitmask of the high nibbles that
+    // it is valid with.
+    const __m128i mask_lut = _mm_setr_epi8(
+        (char) 0xA8, (char) 0xF8, (char) 0xF8, (char) 0xF8,
+        (char) 0xF8, (char) 0xF8, (char) 0xF8, (char) 0xF8,
+        (char) 0xF8, (char) 0xF8, (char) 0xF0, 0x54,
+        0x50, 0x50, 0x50, 0x54
+    );
+    const __m128i bitpos_lut = _mm_setr_epi8(
+        0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, (char) 0x80,
+        0, 0, 0, 0, 0, 0, 0, 0
+    );
+    const __m128i shift_lut = _mm_setr_epi8(
+        0, 0, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0
+    );
+
+    __m128i allowed = _mm_shuffle_epi8(mask_lut, low);
+    __m128i bit = _mm_shuffle_epi8(bitpos_lut, high);
+    __m128i invalid = _mm_cmpeq_epi8(_mm_and_si128(allowed, bit),
+        _mm_setzero_si128());
+    if (_mm_movemask_epi8(invalid) != 0) return false;
+
+    // '/' shares its high nibble with '+' but needs a different shift.
+    __m128i is_slash = _mm_cmpeq_epi8(in, _mm_set1_epi8('/'));
+    __m128i shift = _mm_or_si128(
+        _mm_andnot_si128(is_slash, _mm_shuffle_epi8(shift_lut, high)),
+        _mm_and_si128(is_slash, _mm_set1_epi8(16))
+    );
+    __m128i values = _mm_add_epi8(in, shift);
+
+    // Pack four 6-bit values into three bytes.
+    __m128i merged = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+    merged = _mm_madd_epi16(merged, _mm_set1_epi32(0x00011000));
+    *out = _mm_shuffle_epi8(merged, _mm_setr_epi8(
+        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1
+    ));
+
+    return true;
+}
+
+// Decode whole blocks while they fit in the `out_len` bytes of output,
+// stopping before the first block with an invalid char, and return the number
+// of chars decoded.
+__attribute__((target("ssse3")))
+static size_t ss_base64_decode_ssse3_(
+    const char *src,
+    size_t len,
+    uint8_t *out,
+    size_t out_len
+) {
+    size_t i = 0;
+    size_t o = 0;
+
+    // Each block writes 16 bytes, of which 12 are output.
+    for (; len - i >= 16 && o + 16 <= out_len; i += 16, o += 12) {
+        __m128i block;
+        __m128i in = _mm_loadu_si128((const __m128i*) (src + i));
+        if (! ss_base64_decode_block_ssse3_(in, &block)) break;
+
+        _mm_storeu_si128((__m128i*) (out + o), block);
+    }
+
+    return i;
+}
+
+#endif // SS_ENCODING_X86
+
+static void ss_hex_encode_(const uint8_t *src, size_t len, char *out) {
+    size_t i = 0;
+
+#ifdef __SSE2__
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+    for (; len - i >= 16; i += 16) {
+        __m128i in = _mm_loadu_si128((const __m128i*) (src + i));
+        __m128i high = ss_hex_digits_sse2_(
+            _mm_and_si128(_mm_srli_epi16(in, 4), nibble));
+        __m128i low = ss_hex_digits_sse2_(_mm_and_si128(in, nibble));
+
+        _mm_storeu_si128((__m128i*) (out + 2 * i),
+            _mm_unpacklo_epi8(high, low));
+        _mm_storeu_si128((__m128i*) (out + 2 * i + 16),
+            _mm_unpackhi_epi8(high, low));
+    }
+#endif
+
+    for (; i < len; ++i) {
+        out[2 * i] = ss_hex_digits_[src[i] >> 4];
+        out[2 * i + 1] = ss_hex_digits_[src[i] & 0x0F];
+    }
+}
+
+bool ss_hex_decode_buffer(const char *src, size_t len, uint8_t *out) {
+    if (src == NULL || out == NULL || len % 2 != 0) return false;
+
+    size_t i = 0;
+
+#ifdef __SSE2__
+    __m128i valid = _mm_set1_epi8(-1);
+    for (; len - i >= 32; i += 32) {
+        __m128i a = ss_hex_values_sse2_(
+            _mm_loadu_si128((const __m128i*) (src + i)), &valid);
+        __m128i b = ss_hex_values_sse2_(
+            _mm_loadu_si128((const __m128i*) (src + i + 16)), &valid);
+
+        _mm_storeu_si128((__m128i*) (out + i / 2), _mm_packus_epi16(
+            ss_hex_combine_sse2_(a), ss_hex_combine_sse2_(b)));
+    }
+    if (_mm_movemask_epi8(valid) != 0xFFFF) return false;
+#endif
+
+    for (; i < len; i += 2) {
+        int32_t high = ss_hex_value_(src[i]);
+        int32_t low = ss_hex_value_(src[i + 1]);
+        if (high < 0 || low < 0) return false;
+
+        out[i / 2] = (uint8_t) ((high << 4) | low);
+    }
+
+    return true;
+}
+
+// Encodes whole blocks, returning the number of bytes encoded.
+typedef size_t (*ss_base64_encode_blocks_fn_)(
+    const uint8_t *src,
+    size_t len,
+    char *out
+);
+
+static struct ss_cpu_dispatch ss_base64_encode_dispatch_ = {
+    .impls = {
+        [SS_CPU_SCALAR] = NULL,
+#ifdef SS_ENCODING_X86
+        [SS_CPU_SSSE3] = (ss_cpu_fn) ss_base64_encode_ssse3_,
+#endif
+    }
+};
+
+static void ss_base64_encode_(const uint8_t *src, size_t len, char *out) {
+    size_t i = 0;
+    size_t o = 0;
+
+    ss_base64_encode_blocks_fn_ encode_blocks = (ss_base64_encode_blocks_fn_)
+        ss_cpu_resolve(&ss_base64_encode_dispatch_);
+    if (encode_blocks != NULL) {
+        i = encode_blocks(src, len, out);
+        o = i / 3 * 4;
+    }
+
+    for (; len - i >= 3; i += 3, o += 4) {
+        uint32_t n = (uint32_t) src[i] << 16 | (uint32_t) src[i + 1] << 8
+            | src[i + 2];
+
+        out[o] = ss_base64_alphabet_[n >> 18];
+        out[o + 1] = ss_base64_alphabet_[(n >> 12) & 0x3F];
+        out[o + 2] = ss_base64_alphabet_[(n >> 6) & 0x3F];
+        out[o + 3] = ss_base64_alphabet_[n & 0x3F];
+    }
+
+    if (len - i == 1) {
+        out[o] = ss_base64_alphabet_[src[i] >> 2];
+        out[o + 1] = ss_base64_alphabet_[(src[i] & 0x03) << 4];
+        out[o + 2] = '=';
+        out[o + 3] = '=';
+    } else if (len - i == 2) {
+        out[o] = ss_base64_alphabet_[src[i] >> 2];
+        out[o + 1] = ss_base64_alphabet_[
+            ((src[i] & 0x03) << 4) | (src[i + 1] >> 4)];
+        out[o + 2] = ss_base64_alphabet_[(src[i + 1] & 0x0F) << 2];
+        out[o + 3] = '=';
+    }
+}
+
+// Get the length of base64 input once padding is removed, or SIZE_MAX if the
+// length is invalid.
+static size_t ss_base64_unpadded_len_(const char *src, size_t len) {
+    if (len % 4 == 0) {
+        if (len > 0 && src[len - 1] == '=') { len -= 1; }
+        if (len > 0 && src[len - 1] == '=') { len -= 1; }
+    }
+
+    return len % 4 == 1 ? SIZE_MAX : len;
+}
+
+size_t ss_base64_decoded_len(const char *src, size_t len) {
+    if (src == NULL) return 0;
+
+    len = ss_base64_unpadded_len_(src, len);
+    if (len == SIZE_MAX) return 0;
+
+    return len / 4 * 3 + (len % 4 == 0 ? 0 : len % 4 - 1);
+}
+
+// Decodes whole blocks, returning the number of chars decoded.
+typedef size_t (*ss_base64_decode_blocks_fn_)(
+    const char *src,
+    size_t len,
+    uint8_t *out,
+    size_t out_len
+);
+
+static struct ss_cpu_dispatch ss_base64_decode_dispatch_ = {
+    .impls = {
+        [SS_CPU_SCALAR] = NULL,
+#ifdef SS_ENCODING_X86
+        [SS_CPU_SSSE3] = (ss_cpu_fn) ss_base64_decode_ssse3_,
+#endif
+    }
+};
+
+bool ss_base64_decode_buffer(const char *src, size_t len, uint8_t *out) {
+    if (src == NULL || out == NULL) return false;
+
+    size_t out_len = ss_base64_decoded_len(src, len);
+    len = ss_base64_unpadded_len_(src, len);
+    if (len == SIZE_MAX) return false;
+
+    size_t i = 0;
+    size_t o = 0;
+
+    // The scalar loop reports any invalid block that stopped the vector one.
+    ss_base64_decode_blocks_fn_ decode_blocks = (ss_base64_decode_blocks_fn_)
+        ss_cpu_resolve(&ss_base64_decode_dispatch_);
+    if (decode_blocks != NULL) {
+        i = decode_blocks(src, len, out, out_len);
+        o = i / 4 * 3;
+    }
+
+    const uint8_t *values = ss_base64_values_;
+    for (; len - i >= 4; i += 4, o += 3) {
+        uint8_t a = values[(uint8_t) src[i]];
+        uint8_t b = values[(uint8_t) src[i + 1]];
+        uint8_t c = values[(uint8_t) src[i + 2]];
+        uint8_t d = values[(uint8_t) src[i + 3]];
+        if ((a | b | c | d) > 63) return false;
+
+        uint32_t n = (uint32_t) a << 18 | (uint32_t) b << 12
+            | (uint32_t) c << 6 | d;
+        out[o] = (uint8_t) (n >> 16);
+        out[o + 1] = (uint8_t) (n >> 8);
+        out[o + 2] = (uint8_t) n;
+    }
+
+    if (len - i >= 2) {
+        uint8_t a = values[(uint8_t) src[i]];
+        uint8_t b = values[(uint8_t) src[i + 1]];
+        uint8_t c = len - i == 3 ? values[(uint8_t) src[i + 2]] : 0;
+        if ((a | b | c) > 63) return false;
+
+        out[o] = (uint8_t) (a << 2 | b >> 4);
+        if (len - i == 3) {
+            out[o + 1] = (uint8_t) (b << 4 | c >> 2);
+        }
+    }
+
+    return true;
+}
+
+bool ss_string_append_hex(
+    struct ss_string *dest,
+    const uint8_t *data,
+    size_t len
+) {
+    if (dest == NULL || data == NULL || len == 0) return false;
+    if (! ss_string_reserve(dest, len * 2)) return false;
+
+    size_t avail = 0;
+    char *out = ss_string_spare(dest, &avail);
+
+    ss_hex_encode_(data, len, out);
+    return ss_string_commit(dest, len * 2);
+}
+
+bool ss_string_append_base64(
+    struct ss_string *dest,
+    const uint8_t *data,
+    size_t len
+) {
+    if (dest == NULL || data == NULL || len == 0) return false;
+
+    size_t out_len = (len + 2) / 3 * 4;
+    if (! ss_string_reserve(dest, out_len)) return false;
+
+    size_t avail = 0;
+    char *out = ss_string_spare(dest, &avail);
+
+    ss_base64_encode_(data, len, out);
+    return ss_string_commit(dest, out_len);
+}
+
+static bool ss_json_is_special_(char c) {
+    return (unsigned char) c < 0x20 || c == '"' || c == '\\';
+}
+
+static bool ss_csv_is_special_(char c) {
+    return c == ',' || c == '"' || c == '\r' || c == '\n';
+}
+
+// Find the first char at or after `i` that must be escaped in JSON, or `len`.
+static size_t ss_json_scan_(const char *src, size_t i, size_t len) {
+#ifdef __SSE2__
+    for (; len - i >= 16; i += 16) {
+        int32_t mask = ss_json_special_sse2_(
+            _mm_loadu_si128((const __m128i*) (src + i)));
+        if (mask != 0) return i + (size_t) __builtin_ctz((uint32_t) mask);
+    }
+#endif
+
+    for (; i < len; ++i) {
+        if (ss_json_is_special_(src[i])) return i;
+    }
+    return len;
+}
+
+// Find the first char at or after `i` that must be quoted in CSV, or `len`.
+static size_t ss_csv_scan_(const char *src, size_t i, size_t len) {
+#ifdef __SSE2__
+    for (; len - i >= 16; i += 16) {
+        int32_t mask = ss_csv_special_sse2_(
+            _mm_loadu_si128((const __m128i*) (src + i)));
+        if (mask != 0) return i + (size_t) __builtin_ctz((uint32_t) mask);
+    }
+#endif
+
+    for (; i < len; ++i) {
+        if (ss_csv_is_special_(src[i])) return i;
+    }
+    return len;
+}
+
+bool ss_string_append_json_escaped(
+    struct ss_string *dest,
+    const char *src,
+    size_t len
+) {
+    if (dest == NULL || src == NULL || len == 0) return false;
+
+    // The longest escape is \u00XX.
+    if (! ss_string_reserve(dest, len * 6)) return false;
+
+    size_t avail = 0;
+    char *out = ss_string_spare(dest, &avail);
+    size_t o = 0;
+    size_t i = 0;
+
+    while (i < len) {
+        size_t special = ss_json_scan_(src, i, len);
+
+        memcpy(out + o, src + i, special - i);
+        o += special - i;
+        if (special == len) break;
+
+        char c = src[special];
+        out[o++] = '\\';
+        switch (c) {
+            case '"': out[o++] = '"'; break;
+            case '\\': out[o++] = '\\'; break;
+            case '\b': out[o++] = 'b'; break;
+            case '\f': out[o++] = 'f'; break;
+            case '\n': out[o++] = 'n'; break;
+            case '\r': out[o++] = 'r'; break;
+            case '\t': out[o++] = 't'; break;
+            default:
+                out[o++] = 'u';
+                out[o++] = '0';
+                out[o++] = '0';
+                out[o++] = ss_hex_digits_[(unsigned char) c >> 4];
+                out[o++] = ss_hex_digits_[(unsigned char) c & 0x0F];
+        }
+
+        i = special + 1;
+    }
+
+    ss_assert(o <= avail);
+    return ss_string_commit(dest, o);
+}
+
+bool ss_string_append_csv_field(
+    struct ss_string *dest,
+    const char *src,
+    size_t len
+) {
+    if (dest == NULL || src == NULL || len == 0) return false;
+
+    bool quoted = ss_csv_scan_(src, 0, len) != len;
+
+    // Every char may be a doubled quote, plus the enclosing quotes.
+    if (! ss_string_reserve(dest, quoted ? len * 2 + 2 : len)) return false;
+
+    size_t avail = 0;
+    char *out = ss_string_spare(dest, &avail);
+
+    if (! quoted) {
+        memcpy(out, src, len);
+        return ss_string_commit(dest, len);
+    }
+
+    size_t o = 0;
+    size_t i = 0;
+
+    out[o++] = '"';
+
+    // Only quotes need to be changed within a quoted field.
+    while (i < len) {
+        const char *quote = (const char*) memchr(src + i, '"', len - i);
+        size_t end = quote == NULL ? len : (size_t) (quote - src) + 1;
+
+        memcpy(out + o, src + i, end - i);
+        o += end - i;
+        if (quote != NULL) { out[o++] = '"'; }
+
+        i = end;
+    }
+
+    out[o++] = '"';
+
+    ss_assert(o <= avail);
+    return ss_string_commit(dest, o);
+}
+
+bool ss_hex_decode(struct ss_array_bytes *dest, const char *src, size_t len) {
+    if (dest == NULL || src == NULL || len == 0 || len % 2 != 0) return false;
+    if (! ss_array_bytes_reserve(dest, len / 2)) return false;
+
+    if (! ss_hex_decode_buffer(src, len, dest->data + dest->len)) return false;
+
+    dest->len += len / 2;
+    return true;
+}
+
+bool ss_base64_decode(struct ss_array_bytes *dest, const char *src, size_t len)
+{
+    if (dest == NULL || src == NULL || len == 0) return false;
+
+    size_t out_len = ss_base64_decoded_len(src, len);
+    if (out_len == 0) return false;
+    if (! ss_array_bytes_reserve(dest, out_len)) return false;
+
+    if (! ss_base64_decode_buffer(src, len, dest->data + dest->len)) {
+        return false;
+    }
+
+    dest->len += out_len;
+    return true;
+}
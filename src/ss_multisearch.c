@@ -0,0 +1,401 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public License,
+ * v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ * obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ss_array.h"
+#include "ss_multisearch.h"
+#include "ss_string.h"
+
+#ifdef USE_SS_LIB_ASSERT
+    #include "ss_assert.h"
+#else
+    #include <assert.h>
+
+    #define ss_check(EXPR, MSG) assert(EXPR)
+    #define ss_assert assert
+    #define ss_assert_msg(EXPR, ...) assert(EXPR)
+#endif
+
+GENERATE_ARRAY2(struct ss_multisearch_match, multisearch_match)
+
+// Marks a state or pattern list with no (further) pattern.
+#define SS_MULTISEARCH_NONE_ UINT32_MAX
+
+// State 0 is the root: the state matching nothing.
+struct ss_multisearch {
+    // The number of columns in the transition table: one per distinct byte
+    // used by the patterns, plus column 0 for all other bytes
+    size_t num_classes;
+    size_t num_states;
+    size_t num_patterns;
+    // Maps each byte to its column in the transition table
+    uint16_t classes[256];
+    // num_states rows of num_classes columns
+    uint32_t *transitions;
+    // The first pattern ending at each state, or SS_MULTISEARCH_NONE_
+    uint32_t *outputs;
+    // The nearest state on the failure path that has an output, or 0
+    uint32_t *dict_links;
+    // For each state, the first state with an output to report when it is
+    // reached: the state itself, its dict link, or 0 if there are none
+    uint32_t *reports;
+    // The length of each pattern
+    size_t *pattern_lens;
+    // The next pattern identical to each pattern, or SS_MULTISEARCH_NONE_
+    uint32_t *same_patterns;
+};
+
+static void ss_multisearch_assign_classes_(
+    struct ss_multisearch *ms,
+    const char **patterns,
+    const size_t *lens,
+    size_t n
+) {
+    memset(ms->classes, 0, sizeof(ms->classes));
+
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < lens[i]; ++j) {
+            ms->classes[(unsigned char) patterns[i][j]] = 1;
+        }
+    }
+
+    uint16_t next = 1;
+    for (size_t c = 0; c < 256; ++c) {
+        if (ms->classes[c] != 0) { ms->classes[c] = next++; }
+    }
+    ms->num_classes = next;
+}
+
+// Add each pattern to the trie, using the transition table for its edges.
+//
+// While building, 0 means "no edge"; the root is never a child.
+static void ss_multisearch_build_trie_(
+    struct ss_multisearch *ms,
+    const char **patterns,
+    const size_t *lens
+) {
+    ms->num_states = 1;
+    ms->outputs[0] = SS_MULTISEARCH_NONE_;
+
+    for (size_t i = 0; i < ms->num_patterns; ++i) {
+        size_t state = 0;
+
+        for (size_t j = 0; j < lens[i]; ++j) {
+            uint16_t cls = ms->classes[(unsigned char) patterns[i][j]];
+            uint32_t *edge = &ms->transitions[state * ms->num_classes + cls];
+
+            if (*edge == 0) {
+                *edge = (uint32_t) ms->num_states;
+                ms->outputs[ms->num_states] = SS_MULTISEARCH_NONE_;
+                ms->num_states += 1;
+            }
+            state = *edge;
+        }
+
+        // Patterns ending at the same state are chained in input order.
+        ms->pattern_lens[i] = lens[i];
+        ms->same_patterns[i] = SS_MULTISEARCH_NONE_;
+
+        uint32_t *last = &ms->outputs[state];
+        while (*last != SS_MULTISEARCH_NONE_) {
+            last = &ms->same_patterns[*last];
+        }
+        *last = (uint32_t) i;
+    }
+}
+
+// Compute failure links breadth-first, replacing each missing edge with the
+// transition taken from the failure state to make the automaton deterministic.
+static bool ss_multisearch_link_(struct ss_multisearch *ms) {
+    size_t cols = ms->num_classes;
+    uint32_t *fail = (uint32_t*) malloc(ms->num_states * sizeof(uint32_t));
+    uint32_t *queue = (uint32_t*) malloc(ms->num_states * sizeof(uint32_t));
+
+    if (fail == NULL || queue == NULL) {
+        free(fail);
+        free(queue);
+        return false;
+    }
+
+    size_t head = 0;
+    size_t tail = 0;
+
+    fail[0] = 0;
+    ms->dict_links[0] = 0;
+
+    // Children of the root fail to the root; missing edges already lead there.
+    for (size_t c = 0; c < cols; ++c) {
+        uint32_t child = ms->transitions[c];
+        if (child != 0) {
+            fail[child] = 0;
+            ms->dict_links[child] = 0;
+            queue[tail++] = child;
+        }
+    }
+
+    while (head < tail) {
+        uint32_t state = queue[head++];
+        uint32_t *row = &ms->transitions[state * cols];
+        const uint32_t *fail_row = &ms->transitions[fail[state] * cols];
+
+        for (size_t c = 0; c < cols; ++c) {
+            uint32_t child = row[c];
+
+            if (child == 0) {
+                row[c] = fail_row[c];
+                continue;
+            }
+
+            uint32_t child_fail = fail_row[c];
+            fail[child] = child_fail;
+            ms->dict_links[child] =
+                ms->outputs[child_fail] != SS_MULTISEARCH_NONE_
+                ? child_fail
+                : ms->dict_links[child_fail];
+            queue[tail++] = child;
+        }
+    }
+
+    for (size_t s = 0; s < ms->num_states; ++s) {
+        ms->reports[s] = ms->outputs[s] != SS_MULTISEARCH_NONE_
+            ? (uint32_t) s
+            : ms->dict_links[s];
+    }
+
+    free(fail);
+    free(queue);
+    return true;
+}
+
+struct ss_multisearch *ss_multisearch_create_from_data(
+    const char **patterns,
+    const size_t *lens,
+    size_t n
+) {
+    if (patterns == NULL || lens == NULL || n == 0) return NULL;
+    if (n >= SS_MULTISEARCH_NONE_) return NULL;
+
+    // One state per pattern byte is the upper bound; it is trimmed after the
+    // trie is built.
+    size_t max_states = 1;
+    for (size_t i = 0; i < n; ++i) {
+        if (patterns[i] == NULL || lens[i] == 0) return NULL;
+        if (lens[i] >= SS_MULTISEARCH_NONE_ - max_states) return NULL;
+        max_states += lens[i];
+    }
+
+    struct ss_multisearch *ms =
+        (struct ss_multisearch*) malloc(sizeof(struct ss_multisearch));
+    if (ms == NULL) return NULL;
+
+    ms->num_patterns = n;
+    ss_multisearch_assign_classes_(ms, patterns, lens, n);
+
+    ms->transitions = (uint32_t*) calloc(
+        max_states * ms->num_classes, sizeof(uint32_t));
+    ms->outputs = (uint32_t*) malloc(max_states * sizeof(uint32_t));
+    ms->dict_links = NULL;
+    ms->reports = NULL;
+    ms->pattern_lens = (size_t*) malloc(n * sizeof(size_t));
+    ms->same_patterns = (uint32_t*) malloc(n * sizeof(uint32_t));
+
+    if (ms->transitions == NULL || ms->outputs == NULL
+        || ms->pattern_lens == NULL || ms->same_patterns == NULL
+    ) {
+        ss_multisearch_free(&ms);
+        return NULL;
+    }
+
+    ss_multisearch_build_trie_(ms, patterns, lens);
+
+    if (ms->num_states < max_states) {
+        // Shrinking; failure leaves the larger buffers in place.
+        uint32_t *transitions = (uint32_t*) realloc(ms->transitions,
+            ms->num_states * ms->num_classes * sizeof(uint32_t));
+        if (transitions != NULL) { ms->transitions = transitions; }
+
+        uint32_t *outputs = (uint32_t*) realloc(ms->outputs,
+            ms->num_states * sizeof(uint32_t));
+        if (outputs != NULL) { ms->outputs = outputs; }
+    }
+
+    ms->dict_links = (uint32_t*) malloc(ms->num_states * sizeof(uint32_t));
+    ms->reports = (uint32_t*) malloc(ms->num_states * sizeof(uint32_t));
+
+    if (ms->dict_links == NULL || ms->reports == NULL
+        || ! ss_multisearch_link_(ms)
+    ) {
+        ss_multisearch_free(&ms);
+        return NULL;
+    }
+
+    return ms;
+}
+
+struct ss_multisearch *ss_multisearch_create(const char **patterns, size_t n) {
+    if (patterns == NULL || n == 0) return NULL;
+
+    size_t *lens = (size_t*) malloc(n * sizeof(size_t));
+    if (lens == NULL) return NULL;
+
+    for (size_t i = 0; i < n; ++i) {
+        lens[i] = patterns[i] == NULL ? 0 : strlen(patterns[i]);
+    }
+
+    struct ss_multisearch *ms =
+        ss_multisearch_create_from_data(patterns, lens, n);
+
+    free(lens);
+    return ms;
+}
+
+void ss_multisearch_free(struct ss_multisearch **ms) {
+    if (ms == NULL || *ms == NULL) return;
+
+    free((*ms)->transitions);
+    free((*ms)->outputs);
+    free((*ms)->dict_links);
+    free((*ms)->reports);
+    free((*ms)->pattern_lens);
+    free((*ms)->same_patterns);
+    free(*ms);
+    *ms = NULL;
+}
+
+size_t ss_multisearch_pattern_count(const struct ss_multisearch *ms) {
+    if (ms == NULL) return 0;
+    return ms->num_patterns;
+}
+
+size_t ss_multisearch_scan(
+    const struct ss_multisearch *ms,
+    const char *data,
+    size_t len,
+    bool (*f)(const struct ss_multisearch_match *match, void *ctx),
+    void *ctx
+) {
+    if (ms == NULL || data == NULL || f == NULL) return 0;
+
+    const uint32_t *transitions = ms->transitions;
+    const uint32_t *reports = ms->reports;
+    size_t cols = ms->num_classes;
+    size_t count = 0;
+    uint32_t state = 0;
+
+    for (size_t i = 0; i < len; ++i) {
+        state = transitions[state * cols
+            + ms->classes[(unsigned char) data[i]]];
+        if (reports[state] == 0) continue;
+
+        for (uint32_t s = reports[state]; s != 0; s = ms->dict_links[s]) {
+            for (uint32_t p = ms->outputs[s];
+                p != SS_MULTISEARCH_NONE_;
+                p = ms->same_patterns[p]
+            ) {
+                struct ss_multisearch_match match = {
+                    .pattern = p,
+                    .offset = i + 1 - ms->pattern_lens[p]
+                };
+
+                count += 1;
+                if (! f(&match, ctx)) return count;
+            }
+        }
+    }
+
+    return count;
+}
+
+struct ss_multisearch_collect_ {
+    struct ss_array_multisearch_match *out;
+    bool failed;
+};
+
+static bool ss_multisearch_collect_(
+    const struct ss_multisearch_match *match,
+    void *ctx
+) {
+    struct ss_multisearch_collect_ *collect =
+        (struct ss_multisearch_collect_*) ctx;
+
+    struct ss_multisearch_match copy = *match;
+    if (! ss_array_multisearch_match_append_data(collect->out, &copy, 1)) {
+        collect->failed = true;
+        return false;
+    }
+    return true;
+}
+
+bool ss_multisearch_find_all(
+    const struct ss_multisearch *ms,
+    const char *data,
+    size_t len,
+    struct ss_array_multisearch_match *out
+) {
+    if (ms == NULL || data == NULL || out == NULL) return false;
+
+    struct ss_multisearch_collect_ collect = { .out = out, .failed = false };
+    ss_multisearch_scan(ms, data, len, ss_multisearch_collect_, &collect);
+
+    return ! collect.failed;
+}
+
+static bool ss_multisearch_stop_(
+    const struct ss_multisearch_match *match,
+    void *ctx
+) {
+    (void) match;
+    (void) ctx;
+    return false;
+}
+
+bool ss_multisearch_contains_any(
+    const struct ss_multisearch *ms,
+    const char *data,
+    size_t len
+) {
+    return ss_multisearch_scan(ms, data, len, ss_multisearch_stop_, NULL) > 0;
+}
+
+static size_t ss_multisearch_string_len_(const struct ss_string *s) {
+    size_t len = ss_string_len(s);
+    return len == 0 ? 0 : len - 1;
+}
+
+size_t ss_string_multisearch_scan(
+    const struct ss_string *s,
+    const struct ss_multisearch *ms,
+    bool (*f)(const struct ss_multisearch_match *match, void *ctx),
+    void *ctx
+) {
+    return ss_multisearch_scan(ms, ss_string_as_cstring(s),
+        ss_multisearch_string_len_(s), f, ctx);
+}
+
+bool ss_string_multisearch_find_all(
+    const struct ss_string *s,
+    const struct ss_multisearch *ms,
+    struct ss_array_multisearch_match *out
+) {
+    size_t len = ss_multisearch_string_len_(s);
+
+    // An empty string has no matches, but may not have a buffer either.
+    if (len == 0) return ms != NULL && out != NULL;
+
+    return ss_multisearch_find_all(ms, ss_string_as_cstring(s), len, out);
+}
+
+bool ss_string_multisearch_contains_any(
+    const struct ss_string *s,
+    const struct ss_multisearch *ms
+) {
+    return ss_multisearch_contains_any(ms, ss_string_as_cstring(s),
+        ss_multisearch_string_len_(s));
+}
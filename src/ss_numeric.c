@@ -0,0 +1,1774 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public License,
+ * v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ * obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ss_cpu.h"
+#include "ss_numeric.h"
+
+#if (defined __x86_64__ || defined __i386__) && defined __GNUC__
+    #define SS_NUMERIC_X86
+    #include <immintrin.h>
+#endif
+
+// Each vectorized function below works through as many whole blocks of the
+// input as it can and returns the number of elements it covered, folding its
+// result into the caller's. The caller finishes the remaining elements with a
+// scalar loop, which is also all that runs on other platforms.
+//
+// The searches instead return the position of the first match if one was
+// found; the scalar loop then stops at once.
+
+// Sum with four partial sums, so that each addition need not wait on the last.
+static float ss_numeric_sum_f32_scalar_(const float *data, size_t len) {
+    float s0 = 0.0f, s1 = 0.0f, s2 = 0.0f, s3 = 0.0f;
+    size_t i = 0;
+
+    for (; len - i >= 4; i += 4) {
+        s0 += data[i];
+        s1 += data[i + 1];
+        s2 += data[i + 2];
+        s3 += data[i + 3];
+    }
+    for (; i < len; ++i) { s0 += data[i]; }
+
+    return (s0 + s1) + (s2 + s3);
+}
+
+static double ss_numeric_sum_f64_scalar_(const double *data, size_t len) {
+    double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+    size_t i = 0;
+
+    for (; len - i >= 4; i += 4) {
+        s0 += data[i];
+        s1 += data[i + 1];
+        s2 += data[i + 2];
+        s3 += data[i + 3];
+    }
+    for (; i < len; ++i) { s0 += data[i]; }
+
+    return (s0 + s1) + (s2 + s3);
+}
+
+static float ss_numeric_dot_f32_scalar_(
+    const float *a,
+    const float *b,
+    size_t len
+) {
+    float s0 = 0.0f, s1 = 0.0f, s2 = 0.0f, s3 = 0.0f;
+    size_t i = 0;
+
+    for (; len - i >= 4; i += 4) {
+        s0 += a[i] * b[i];
+        s1 += a[i + 1] * b[i + 1];
+        s2 += a[i + 2] * b[i + 2];
+        s3 += a[i + 3] * b[i + 3];
+    }
+    for (; i < len; ++i) { s0 += a[i] * b[i]; }
+
+    return (s0 + s1) + (s2 + s3);
+}
+
+static double ss_numeric_dot_f64_scalar_(
+    const double *a,
+    const double *b,
+    size_t len
+) {
+    double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+    size_t i = 0;
+
+    for (; len - i >= 4; i += 4) {
+        s0 += a[i] * b[i];
+        s1 += a[i + 1] * b[i + 1];
+        s2 += a[i + 2] * b[i + 2];
+        s3 += a[i + 3] * b[i + 3];
+    }
+    for (; i < len; ++i) { s0 += a[i] * b[i]; }
+
+    return (s0 + s1) + (s2 + s3);
+}
+
+#ifdef SS_NUMERIC_X86
+
+__attribute__((target("sse2")))
+static size_t ss_numeric_sum_i32_sse2_(
+    const int32_t *data,
+    size_t len,
+    uint32_t *sum
+) {
+    __m128i acc = _mm_setzero_si128();
+    size_t i = 0;
+
+    for (; len - i >= 4; i += 4) {
+        acc = _mm_add_epi32(acc,
+            _mm_loadu_si128((const __m128i*) (data + i)));
+    }
+
+    uint32_t lanes[4];
+    _mm_storeu_si128((__m128i*) lanes, acc);
+    *sum += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    return i;
+}
+
+__attribute__((target("sse2")))
+static size_t ss_numeric_sum_i64_sse2_(
+    const int64_t *data,
+    size_t len,
+    uint64_t *sum
+) {
+    __m128i acc = _mm_setzero_si128();
+    size_t i = 0;
+
+    for (; len - i >= 2; i += 2) {
+        acc = _mm_add_epi64(acc,
+            _mm_loadu_si128((const __m128i*) (data + i)));
+    }
+
+    uint64_t lanes[2];
+    _mm_storeu_si128((__m128i*) lanes, acc);
+    *sum += lanes[0] + lanes[1];
+    return i;
+}
+
+__attribute__((target("sse2")))
+static size_t ss_numeric_sum_f32_sse2_(
+    const float *data,
+    size_t len,
+    float *sum
+) {
+    __m128 acc0 = _mm_setzero_ps();
+    __m128 acc1 = _mm_setzero_ps();
+    __m128 acc2 = _mm_setzero_ps();
+    __m128 acc3 = _mm_setzero_ps();
+    size_t i = 0;
+
+    for (; len - i >= 16; i += 16) {
+        acc0 = _mm_add_ps(acc0, _mm_loadu_ps(data + i));
+        acc1 = _mm_add_ps(acc1, _mm_loadu_ps(data + i + 4));
+        acc2 = _mm_add_ps(acc2, _mm_loadu_ps(data + i + 8));
+        acc3 = _mm_add_ps(acc3, _mm_loadu_ps(data + i + 12));
+    }
+
+    float lanes[4];
+    _mm_storeu_ps(lanes,
+        _mm_add_ps(_mm_add_ps(acc0, acc1), _mm_add_ps(acc2, acc3)));
+    *sum += (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    return i;
+}
+
+__attribute__((target("sse2")))
+static size_t ss_numeric_sum_f64_sse2_(
+    const double *data,
+    size_t len,
+    double *sum
+) {
+    __m128d acc0 = _mm_setzero_pd();
+    __m128d acc1 = _mm_setzero_pd();
+    __m128d acc2 = _mm_setzero_pd();
+    __m128d acc3 = _mm_setzero_pd();
+    size_t i = 0;
+
+    for (; len - i >= 8; i += 8) {
+        acc0 = _mm_add_pd(acc0, _mm_loadu_pd(data + i));
+        acc1 = _mm_add_pd(acc1, _mm_loadu_pd(data + i + 2));
+        acc2 = _mm_add_pd(acc2, _mm_loadu_pd(data + i + 4));
+        acc3 = _mm_add_pd(acc3, _mm_loadu_pd(data + i + 6));
+    }
+
+    double lanes[2];
+    _mm_storeu_pd(lanes,
+        _mm_add_pd(_mm_add_pd(acc0, acc1), _mm_add_pd(acc2, acc3)));
+    *sum += lanes[0] + lanes[1];
+    return i;
+}
+
+// SSE2 has no 32-bit min or max, so select by comparison.
+__attribute__((target("sse2")))
+static size_t ss_numeric_minmax_i32_sse2_(
+    const int32_t *data,
+    size_t len,
+    bool max,
+    int32_t *best
+) {
+    __m128i acc = _mm_set1_epi32(*best);
+    size_t i = 0;
+
+    for (; len - i >= 4; i += 4) {
+        __m128i x = _mm_loadu_si128((const __m128i*) (data + i));
+        __m128i take = max
+            ? _mm_cmpgt_epi32(x, acc)
+            : _mm_cmpgt_epi32(acc, x);
+        acc = _mm_or_si128(_mm_and_si128(take, x), _mm_andnot_si128(take, acc));
+    }
+
+    int32_t lanes[4];
+    _mm_storeu_si128((__m128i*) lanes, acc);
+    for (size_t l = 0; l < 4; ++l) {
+        if (max ? lanes[l] > *best : lanes[l] < *best) { *best = lanes[l]; }
+    }
+    return i;
+}
+
+__attribute__((target("sse2")))
+static size_t ss_numeric_minmax_f32_sse2_(
+    const float *data,
+    size_t len,
+    bool max,
+    float *best
+) {
+    __m128 acc = _mm_set1_ps(*best);
+    size_t i = 0;
+
+    for (; len - i >= 4; i += 4) {
+        __m128 x = _mm_loadu_ps(data + i);
+        acc = max ? _mm_max_ps(acc, x) : _mm_min_ps(acc, x);
+    }
+
+    float lanes[4];
+    _mm_storeu_ps(lanes, acc);
+    for (size_t l = 0; l < 4; ++l) {
+        if (max ? lanes[l] > *best : lanes[l] < *best) { *best = lanes[l]; }
+    }
+    return i;
+}
+
+__attribute__((target("sse2")))
+static size_t ss_numeric_minmax_f64_sse2_(
+    const double *data,
+    size_t len,
+    bool max,
+    double *best
+) {
+    __m128d acc = _mm_set1_pd(*best);
+    size_t i = 0;
+
+    for (; len - i >= 2; i += 2) {
+        __m128d x = _mm_loadu_pd(data + i);
+        acc = max ? _mm_max_pd(acc, x) : _mm_min_pd(acc, x);
+    }
+
+    double lanes[2];
+    _mm_storeu_pd(lanes, acc);
+    for (size_t l = 0; l < 2; ++l) {
+        if (max ? lanes[l] > *best : lanes[l] < *best) { *best = lanes[l]; }
+    }
+    return i;
+}
+
+__attribute__((target("sse2")))
+static int ss_numeric_eq_i32_sse2_(const int32_t *data, __m128i value) {
+    __m128i x = _mm_loadu_si128((const __m128i*) data);
+    return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(x, value)));
+}
+
+// SSE2 has no 64-bit comparison: both 32-bit halves must be equal.
+__attribute__((target("sse2")))
+static int ss_numeric_eq_i64_sse2_(const int64_t *data, __m128i value) {
+    __m128i x = _mm_loadu_si128((const __m128i*) data);
+    __m128i eq = _mm_cmpeq_epi32(x, value);
+    eq = _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_movemask_pd(_mm_castsi128_pd(eq));
+}
+
+__attribute__((target("sse2")))
+static size_t ss_numeric_find_i32_sse2_(
+    const int32_t *data,
+    size_t len,
+    int32_t value
+) {
+    const __m128i v = _mm_set1_epi32(value);
+    size_t i = 0;
+
+    for (; len - i >= 4; i += 4) {
+        int mask = ss_numeric_eq_i32_sse2_(data + i, v);
+        if (mask != 0) return i + (size_t) __builtin_ctz((unsigned int) mask);
+    }
+
+    return i;
+}
+
+__attribute__((target("sse2")))
+static size_t ss_numeric_find_i64_sse2_(
+    const int64_t *data,
+    size_t len,
+    int64_t value
+) {
+    const __m128i v = _mm_set1_epi64x(value);
+    size_t i = 0;
+
+    for (; len - i >= 2; i += 2) {
+        int mask = ss_numeric_eq_i64_sse2_(data + i, v);
+        if (mask != 0) return i + (size_t) __builtin_ctz((unsigned int) mask);
+    }
+
+    return i;
+}
+
+__attribute__((target("sse2")))
+static size_t ss_numeric_find_f32_sse2_(
+    const float *data,
+    size_t len,
+    float value
+) {
+    const __m128 v = _mm_set1_ps(value);
+    size_t i = 0;
+
+    for (; len - i >= 4; i += 4) {
+        int mask = _mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(data + i), v));
+        if (mask != 0) return i + (size_t) __builtin_ctz((unsigned int) mask);
+    }
+
+    return i;
+}
+
+__attribute__((target("sse2")))
+static size_t ss_numeric_find_f64_sse2_(
+    const double *data,
+    size_t len,
+    double value
+) {
+    const __m128d v = _mm_set1_pd(value);
+    size_t i = 0;
+
+    for (; len - i >= 2; i += 2) {
+        int mask = _mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(data + i), v));
+        if (mask != 0) return i + (size_t) __builtin_ctz((unsigned int) mask);
+    }
+
+    return i;
+}
+
+__attribute__((target("sse2")))
+static size_t ss_numeric_count_i32_sse2_(
+    const int32_t *data,
+    size_t len,
+    int32_t value,
+    size_t *count
+) {
+    const __m128i v = _mm_set1_epi32(value);
+    size_t i = 0;
+
+    for (; len - i >= 4; i += 4) {
+        int mask = ss_numeric_eq_i32_sse2_(data + i, v);
+        *count += (size_t) __builtin_popcount((unsigned int) mask);
+    }
+
+    return i;
+}
+
+__attribute__((target("sse2")))
+static size_t ss_numeric_count_i64_sse2_(
+    const int64_t *data,
+    size_t len,
+    int64_t value,
+    size_t *count
+) {
+    const __m128i v = _mm_set1_epi64x(value);
+    size_t i = 0;
+
+    for (; len - i >= 2; i += 2) {
+        int mask = ss_numeric_eq_i64_sse2_(data + i, v);
+        *count += (size_t) __builtin_popcount((unsigned int) mask);
+    }
+
+    return i;
+}
+
+__attribute__((target("sse2")))
+static size_t ss_numeric_count_f32_sse2_(
+    const float *data,
+    size_t len,
+    float value,
+    size_t *count
+) {
+    const __m128 v = _mm_set1_ps(value);
+    size_t i = 0;
+
+    for (; len - i >= 4; i += 4) {
+        int mask = _mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(data + i), v));
+        *count += (size_t) __builtin_popcount((unsigned int) mask);
+    }
+
+    return i;
+}
+
+__attribute__((target("sse2")))
+static size_t ss_numeric_count_f64_sse2_(
+    const double *data,
+    size_t len,
+    double value,
+    size_t *count
+) {
+    const __m128d v = _mm_set1_pd(value);
+    size_t i = 0;
+
+    for (; len - i >= 2; i += 2) {
+        int mask = _mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(data + i), v));
+        *count += (size_t) __builtin_popcount((unsigned int) mask);
+    }
+
+    return i;
+}
+
+__attribute__((target("sse2")))
+static size_t ss_numeric_dot_f32_sse2_(
+    const float *a,
+    const float *b,
+    size_t len,
+    float *sum
+) {
+    __m128 acc0 = _mm_setzero_ps();
+    __m128 acc1 = _mm_setzero_ps();
+    __m128 acc2 = _mm_setzero_ps();
+    __m128 acc3 = _mm_setzero_ps();
+    size_t i = 0;
+
+    for (; len - i >= 16; i += 16) {
+        acc0 = _mm_add_ps(acc0,
+            _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+        acc1 = _mm_add_ps(acc1,
+            _mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+        acc2 = _mm_add_ps(acc2,
+            _mm_mul_ps(_mm_loadu_ps(a + i + 8), _mm_loadu_ps(b + i + 8)));
+        acc3 = _mm_add_ps(acc3,
+            _mm_mul_ps(_mm_loadu_ps(a + i + 12), _mm_loadu_ps(b + i + 12)));
+    }
+
+    float lanes[4];
+    _mm_storeu_ps(lanes,
+        _mm_add_ps(_mm_add_ps(acc0, acc1), _mm_add_ps(acc2, acc3)));
+    *sum += (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    return i;
+}
+
+__attribute__((target("sse2")))
+static size_t ss_numeric_dot_f64_sse2_(
+    const double *a,
+    const double *b,
+    size_t len,
+    double *sum
+) {
+    __m128d acc0 = _mm_setzero_pd();
+    __m128d acc1 = _mm_setzero_pd();
+    __m128d acc2 = _mm_setzero_pd();
+    __m128d acc3 = _mm_setzero_pd();
+    size_t i = 0;
+
+    for (; len - i >= 8; i += 8) {
+        acc0 = _mm_add_pd(acc0,
+            _mm_mul_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+        acc1 = _mm_add_pd(acc1,
+            _mm_mul_pd(_mm_loadu_pd(a + i + 2), _mm_loadu_pd(b + i + 2)));
+        acc2 = _mm_add_pd(acc2,
+            _mm_mul_pd(_mm_loadu_pd(a + i + 4), _mm_loadu_pd(b + i + 4)));
+        acc3 = _mm_add_pd(acc3,
+            _mm_mul_pd(_mm_loadu_pd(a + i + 6), _mm_loadu_pd(b + i + 6)));
+    }
+
+    double lanes[2];
+    _mm_storeu_pd(lanes,
+        _mm_add_pd(_mm_add_pd(acc0, acc1), _mm_add_pd(acc2, acc3)));
+    *sum += lanes[0] + lanes[1];
+    return i;
+}
+
+__attribute__((target("avx2")))
+static size_t ss_numeric_sum_i32_avx2_(
+    const int32_t *data,
+    size_t len,
+    uint32_t *sum
+) {
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+
+    for (; len - i >= 8; i += 8) {
+        acc = _mm256_add_epi32(acc,
+            _mm256_loadu_si256((const __m256i*) (data + i)));
+    }
+
+    uint32_t lanes[8];
+    _mm256_storeu_si256((__m256i*) lanes, acc);
+    for (size_t l = 0; l < 8; ++l) { *sum += lanes[l]; }
+    return i;
+}
+
+__attribute__((target("avx2")))
+static size_t ss_numeric_sum_i64_avx2_(
+    const int64_t *data,
+    size_t len,
+    uint64_t *sum
+) {
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+
+    for (; len - i >= 4; i += 4) {
+        acc = _mm256_add_epi64(acc,
+            _mm256_loadu_si256((const __m256i*) (data + i)));
+    }
+
+    uint64_t lanes[4];
+    _mm256_storeu_si256((__m256i*) lanes, acc);
+    *sum += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    return i;
+}
+
+__attribute__((target("avx2")))
+static size_t ss_numeric_sum_f32_avx2_(
+    const float *data,
+    size_t len,
+    float *sum
+) {
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    __m256 acc2 = _mm256_setzero_ps();
+    __m256 acc3 = _mm256_setzero_ps();
+    size_t i = 0;
+
+    for (; len - i >= 32; i += 32) {
+        acc0 = _mm256_add_ps(acc0, _mm256_loadu_ps(data + i));
+        acc1 = _mm256_add_ps(acc1, _mm256_loadu_ps(data + i + 8));
+        acc2 = _mm256_add_ps(acc2, _mm256_loadu_ps(data + i + 16));
+        acc3 = _mm256_add_ps(acc3, _mm256_loadu_ps(data + i + 24));
+    }
+
+    float lanes[8];
+    _mm256_storeu_ps(lanes, _mm256_add_ps(
+        _mm256_add_ps(acc0, acc1), _mm256_add_ps(acc2, acc3)));
+    *sum += ss_numeric_sum_f32_scalar_(lanes, 8);
+    return i;
+}
+
+__attribute__((target("avx2")))
+static size_t ss_numeric_sum_f64_avx2_(
+    const double *data,
+    size_t len,
+    double *sum
+) {
+    __m256d acc0 = _mm256_setzero_pd();
+    __m256d acc1 = _mm256_setzero_pd();
+    __m256d acc2 = _mm256_setzero_pd();
+    __m256d acc3 = _mm256_setzero_pd();
+    size_t i = 0;
+
+    for (; len - i >= 16; i += 16) {
+        acc0 = _mm256_add_pd(acc0, _mm256_loadu_pd(data + i));
+        acc1 = _mm256_add_pd(acc1, _mm256_loadu_pd(data + i + 4));
+        acc2 = _mm256_add_pd(acc2, _mm256_loadu_pd(data + i + 8));
+        acc3 = _mm256_add_pd(acc3, _mm256_loadu_pd(data + i + 12));
+    }
+
+    double lanes[4];
+    _mm256_storeu_pd(lanes, _mm256_add_pd(
+        _mm256_add_pd(acc0, acc1), _mm256_add_pd(acc2, acc3)));
+    *sum += (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    return i;
+}
+
+__attribute__((target("avx2")))
+static size_t ss_numeric_minmax_i32_avx2_(
+    const int32_t *data,
+    size_t len,
+    bool max,
+    int32_t *best
+) {
+    __m256i acc = _mm256_set1_epi32(*best);
+    size_t i = 0;
+
+    for (; len - i >= 8; i += 8) {
+        __m256i x = _mm256_loadu_si256((const __m256i*) (data + i));
+        acc = max ? _mm256_max_epi32(acc, x) : _mm256_min_epi32(acc, x);
+    }
+
+    int32_t lanes[8];
+    _mm256_storeu_si256((__m256i*) lanes, acc);
+    for (size_t l = 0; l < 8; ++l) {
+        if (max ? lanes[l] > *best : lanes[l] < *best) { *best = lanes[l]; }
+    }
+    return i;
+}
+
+// AVX2 has no 64-bit min or max, so select by comparison.
+__attribute__((target("avx2")))
+static size_t ss_numeric_minmax_i64_avx2_(
+    const int64_t *data,
+    size_t len,
+    bool max,
+    int64_t *best
+) {
+    __m256i acc = _mm256_set1_epi64x(*best);
+    size_t i = 0;
+
+    for (; len - i >= 4; i += 4) {
+        __m256i x = _mm256_loadu_si256((const __m256i*) (data + i));
+        __m256i take = max
+            ? _mm256_cmpgt_epi64(x, acc)
+            : _mm256_cmpgt_epi64(acc, x);
+        acc = _mm256_blendv_epi8(acc, x, take);
+    }
+
+    int64_t lanes[4];
+    _mm256_storeu_si256((__m256i*) lanes, acc);
+    for (size_t l = 0; l < 4; ++l) {
+        if (max ? lanes[l] > *best : lanes[l] < *best) { *best = lanes[l]; }
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+static size_t ss_numeric_minmax_f32_avx2_(
+    const float *data,
+    size_t len,
+    bool max,
+    float *best
+) {
+    __m256 acc = _mm256_set1_ps(*best);
+    size_t i = 0;
+
+    for (; len - i >= 8; i += 8) {
+        __m256 x = _mm256_loadu_ps(data + i);
+        acc = max ? _mm256_max_ps(acc, x) : _mm256_min_ps(acc, x);
+    }
+
+    float lanes[8];
+    _mm256_storeu_ps(lanes, acc);
+    for (size_t l = 0; l < 8; ++l) {
+        if (max ? lanes[l] > *best : lanes[l] < *best) { *best = lanes[l]; }
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+static size_t ss_numeric_minmax_f64_avx2_(
+    const double *data,
+    size_t len,
+    bool max,
+    double *best
+) {
+    __m256d acc = _mm256_set1_pd(*best);
+    size_t i = 0;
+
+    for (; len - i >= 4; i += 4) {
+        __m256d x = _mm256_loadu_pd(data + i);
+        acc = max ? _mm256_max_pd(acc, x) : _mm256_min_pd(acc, x);
+    }
+
+    double lanes[4];
+    _mm256_storeu_pd(lanes, acc);
+    for (size_t l = 0; l < 4; ++l) {
+        if (max ? lanes[l] > *best : lanes[l] < *best) { *best = lanes[l]; }
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+static int ss_numeric_eq_i32_avx2_(const int32_t *data, __m256i value) {
+    __m256i x = _mm256_loadu_si256((const __m256i*) data);
+    return _mm256_movemask_ps(
+        _mm256_castsi256_ps(_mm256_cmpeq_epi32(x, value)));
+}
+
+__attribute__((target("avx2")))
+static int ss_numeric_eq_i64_avx2_(const int64_t *data, __m256i value) {
+    __m256i x = _mm256_loadu_si256((const __m256i*) data);
+    return _mm256_movemask_pd(
+        _mm256_castsi256_pd(_mm256_cmpeq_epi64(x, value)));
+}
+
+__attribute__((target("avx2")))
+static int ss_numeric_eq_f32_avx2_(const float *data, __m256 value) {
+    return _mm256_movemask_ps(
+        _mm256_cmp_ps(_mm256_loadu_ps(data), value, _CMP_EQ_OQ));
+}
+
+__attribute__((target("avx2")))
+static int ss_numeric_eq_f64_avx2_(const double *data, __m256d value) {
+    return _mm256_movemask_pd(
+        _mm256_cmp_pd(_mm256_loadu_pd(data), value, _CMP_EQ_OQ));
+}
+
+__attribute__((target("avx2")))
+static size_t ss_numeric_find_i32_avx2_(
+    const int32_t *data,
+    size_t len,
+    int32_t value
+) {
+    const __m256i v = _mm256_set1_epi32(value);
+    size_t i = 0;
+
+    for (; len - i >= 8; i += 8) {
+        int mask = ss_numeric_eq_i32_avx2_(data + i, v);
+        if (mask != 0) return i + (size_t) __builtin_ctz((unsigned int) mask);
+    }
+
+    return i;
+}
+
+__attribute__((target("avx2")))
+static size_t ss_numeric_find_i64_avx2_(
+    const int64_t *data,
+    size_t len,
+    int64_t value
+) {
+    const __m256i v = _mm256_set1_epi64x(value);
+    size_t i = 0;
+
+    for (; len - i >= 4; i += 4) {
+        int mask = ss_numeric_eq_i64_avx2_(data + i, v);
+        if (mask != 0) return i + (size_t) __builtin_ctz((unsigned int) mask);
+    }
+
+    return i;
+}
+
+__attribute__((target("avx2")))
+static size_t ss_numeric_find_f32_avx2_(
+    const float *data,
+    size_t len,
+    float value
+) {
+    const __m256 v = _mm256_set1_ps(value);
+    size_t i = 0;
+
+    for (; len - i >= 8; i += 8) {
+        int mask = ss_numeric_eq_f32_avx2_(data + i, v);
+        if (mask != 0) return i + (size_t) __builtin_ctz((unsigned int) mask);
+    }
+
+    return i;
+}
+
+__attribute__((target("avx2")))
+static size_t ss_numeric_find_f64_avx2_(
+    const double *data,
+    size_t len,
+    double value
+) {
+    const __m256d v = _mm256_set1_pd(value);
+    size_t i = 0;
+
+    for (; len - i >= 4; i += 4) {
+        int mask = ss_numeric_eq_f64_avx2_(data + i, v);
+        if (mask != 0) return i + (size_t) __builtin_ctz((unsigned int) mask);
+    }
+
+    return i;
+}
+
+__attribute__((target("avx2")))
+static size_t ss_numeric_count_i32_avx2_(
+    const int32_t *data,
+    size_t len,
+    int32_t value,
+    size_t *count
+) {
+    const __m256i v = _mm256_set1_epi32(value);
+    size_t i = 0;
+
+    for (; len - i >= 8; i += 8) {
+        int mask = ss_numeric_eq_i32_avx2_(data + i, v);
+        *count += (size_t) __builtin_popcount((unsigned int) mask);
+    }
+
+    return i;
+}
+
+__attribute__((target("avx2")))
+static size_t ss_numeric_count_i64_avx2_(
+    const int64_t *data,
+    size_t len,
+    int64_t value,
+    size_t *count
+) {
+    const __m256i v = _mm256_set1_epi64x(value);
+    size_t i = 0;
+
+    for (; len - i >= 4; i += 4) {
+        int mask = ss_numeric_eq_i64_avx2_(data + i, v);
+        *count += (size_t) __builtin_popcount((unsigned int) mask);
+    }
+
+    return i;
+}
+
+__attribute__((target("avx2")))
+static size_t ss_numeric_count_f32_avx2_(
+    const float *data,
+    size_t len,
+    float value,
+    size_t *count
+) {
+    const __m256 v = _mm256_set1_ps(value);
+    size_t i = 0;
+
+    for (; len - i >= 8; i += 8) {
+        int mask = ss_numeric_eq_f32_avx2_(data + i, v);
+        *count += (size_t) __builtin_popcount((unsigned int) mask);
+    }
+
+    return i;
+}
+
+__attribute__((target("avx2")))
+static size_t ss_numeric_count_f64_avx2_(
+    const double *data,
+    size_t len,
+    double value,
+    size_t *count
+) {
+    const __m256d v = _mm256_set1_pd(value);
+    size_t i = 0;
+
+    for (; len - i >= 4; i += 4) {
+        int mask = ss_numeric_eq_f64_avx2_(data + i, v);
+        *count += (size_t) __builtin_popcount((unsigned int) mask);
+    }
+
+    return i;
+}
+
+__attribute__((target("avx2")))
+static size_t ss_numeric_dot_i32_avx2_(
+    const int32_t *a,
+    const int32_t *b,
+    size_t len,
+    uint32_t *sum
+) {
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+
+    for (; len - i >= 8; i += 8) {
+        __m256i x = _mm256_loadu_si256((const __m256i*) (a + i));
+        __m256i y = _mm256_loadu_si256((const __m256i*) (b + i));
+        acc = _mm256_add_epi32(acc, _mm256_mullo_epi32(x, y));
+    }
+
+    uint32_t lanes[8];
+    _mm256_storeu_si256((__m256i*) lanes, acc);
+    for (size_t l = 0; l < 8; ++l) { *sum += lanes[l]; }
+    return i;
+}
+
+__attribute__((target("avx2")))
+static size_t ss_numeric_dot_f32_avx2_(
+    const float *a,
+    const float *b,
+    size_t len,
+    float *sum
+) {
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    __m256 acc2 = _mm256_setzero_ps();
+    __m256 acc3 = _mm256_setzero_ps();
+    size_t i = 0;
+
+    for (; len - i >= 32; i += 32) {
+        acc0 = _mm256_add_ps(acc0, _mm256_mul_ps(
+            _mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+        acc1 = _mm256_add_ps(acc1, _mm256_mul_ps(
+            _mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8)));
+        acc2 = _mm256_add_ps(acc2, _mm256_mul_ps(
+            _mm256_loadu_ps(a + i + 16), _mm256_loadu_ps(b + i + 16)));
+        acc3 = _mm256_add_ps(acc3, _mm256_mul_ps(
+            _mm256_loadu_ps(a + i + 24), _mm256_loadu_ps(b + i + 24)));
+    }
+
+    float lanes[8];
+    _mm256_storeu_ps(lanes, _mm256_add_ps(
+        _mm256_add_ps(acc0, acc1), _mm256_add_ps(acc2, acc3)));
+    *sum += ss_numeric_sum_f32_scalar_(lanes, 8);
+    return i;
+}
+
+__attribute__((target("avx2")))
+static size_t ss_numeric_dot_f64_avx2_(
+    const double *a,
+    const double *b,
+    size_t len,
+    double *sum
+) {
+    __m256d acc0 = _mm256_setzero_pd();
+    __m256d acc1 = _mm256_setzero_pd();
+    __m256d acc2 = _mm256_setzero_pd();
+    __m256d acc3 = _mm256_setzero_pd();
+    size_t i = 0;
+
+    for (; len - i >= 16; i += 16) {
+        acc0 = _mm256_add_pd(acc0, _mm256_mul_pd(
+            _mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+        acc1 = _mm256_add_pd(acc1, _mm256_mul_pd(
+            _mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4)));
+        acc2 = _mm256_add_pd(acc2, _mm256_mul_pd(
+            _mm256_loadu_pd(a + i + 8), _mm256_loadu_pd(b + i + 8)));
+        acc3 = _mm256_add_pd(acc3, _mm256_mul_pd(
+            _mm256_loadu_pd(a + i + 12), _mm256_loadu_pd(b + i + 12)));
+    }
+
+    double lanes[4];
+    _mm256_storeu_pd(lanes, _mm256_add_pd(
+        _mm256_add_pd(acc0, acc1), _mm256_add_pd(acc2, acc3)));
+    *sum += (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    return i;
+}
+
+#define SS_NUMERIC_AVX512_ "avx512f,avx512bw,avx512dq,avx512vl"
+
+__attribute__((target(SS_NUMERIC_AVX512_)))
+static size_t ss_numeric_sum_i32_avx512_(
+    const int32_t *data,
+    size_t len,
+    uint32_t *sum
+) {
+    __m512i acc = _mm512_setzero_si512();
+    size_t i = 0;
+
+    for (; len - i >= 16; i += 16) {
+        acc = _mm512_add_epi32(acc, _mm512_loadu_si512(data + i));
+    }
+
+    uint32_t lanes[16];
+    _mm512_storeu_si512(lanes, acc);
+    for (size_t l = 0; l < 16; ++l) { *sum += lanes[l]; }
+    return i;
+}
+
+__attribute__((target(SS_NUMERIC_AVX512_)))
+static size_t ss_numeric_sum_i64_avx512_(
+    const int64_t *data,
+    size_t len,
+    uint64_t *sum
+) {
+    __m512i acc = _mm512_setzero_si512();
+    size_t i = 0;
+
+    for (; len - i >= 8; i += 8) {
+        acc = _mm512_add_epi64(acc, _mm512_loadu_si512(data + i));
+    }
+
+    uint64_t lanes[8];
+    _mm512_storeu_si512(lanes, acc);
+    for (size_t l = 0; l < 8; ++l) { *sum += lanes[l]; }
+    return i;
+}
+
+__attribute__((target(SS_NUMERIC_AVX512_)))
+static size_t ss_numeric_sum_f32_avx512_(
+    const float *data,
+    size_t len,
+    float *sum
+) {
+    __m512 acc0 = _mm512_setzero_ps();
+    __m512 acc1 = _mm512_setzero_ps();
+    __m512 acc2 = _mm512_setzero_ps();
+    __m512 acc3 = _mm512_setzero_ps();
+    size_t i = 0;
+
+    for (; len - i >= 64; i += 64) {
+        acc0 = _mm512_add_ps(acc0, _mm512_loadu_ps(data + i));
+        acc1 = _mm512_add_ps(acc1, _mm512_loadu_ps(data + i + 16));
+        acc2 = _mm512_add_ps(acc2, _mm512_loadu_ps(data + i + 32));
+        acc3 = _mm512_add_ps(acc3, _mm512_loadu_ps(data + i + 48));
+    }
+
+    float lanes[16];
+    _mm512_storeu_ps(lanes, _mm512_add_ps(
+        _mm512_add_ps(acc0, acc1), _mm512_add_ps(acc2, acc3)));
+    for (size_t l = 0; l < 16; ++l) { *sum += lanes[l]; }
+    return i;
+}
+
+__attribute__((target(SS_NUMERIC_AVX512_)))
+static size_t ss_numeric_sum_f64_avx512_(
+    const double *data,
+    size_t len,
+    double *sum
+) {
+    __m512d acc0 = _mm512_setzero_pd();
+    __m512d acc1 = _mm512_setzero_pd();
+    __m512d acc2 = _mm512_setzero_pd();
+    __m512d acc3 = _mm512_setzero_pd();
+    size_t i = 0;
+
+    for (; len - i >= 32; i += 32) {
+        acc0 = _mm512_add_pd(acc0, _mm512_loadu_pd(data + i));
+        acc1 = _mm512_add_pd(acc1, _mm512_loadu_pd(data + i + 8));
+        acc2 = _mm512_add_pd(acc2, _mm512_loadu_pd(data + i + 16));
+        acc3 = _mm512_add_pd(acc3, _mm512_loadu_pd(data + i + 24));
+    }
+
+    double lanes[8];
+    _mm512_storeu_pd(lanes, _mm512_add_pd(
+        _mm512_add_pd(acc0, acc1), _mm512_add_pd(acc2, acc3)));
+    for (size_t l = 0; l < 8; ++l) { *sum += lanes[l]; }
+    return i;
+}
+
+// Unlike AVX2, AVX-512 has a 64-bit min and max.
+__attribute__((target(SS_NUMERIC_AVX512_)))
+static size_t ss_numeric_minmax_i64_avx512_(
+    const int64_t *data,
+    size_t len,
+    bool max,
+    int64_t *best
+) {
+    __m512i acc = _mm512_set1_epi64(*best);
+    size_t i = 0;
+
+    for (; len - i >= 8; i += 8) {
+        __m512i x = _mm512_loadu_si512(data + i);
+        acc = max ? _mm512_max_epi64(acc, x) : _mm512_min_epi64(acc, x);
+    }
+
+    int64_t lanes[8];
+    _mm512_storeu_si512(lanes, acc);
+    for (size_t l = 0; l < 8; ++l) {
+        if (max ? lanes[l] > *best : lanes[l] < *best) { *best = lanes[l]; }
+    }
+    return i;
+}
+
+__attribute__((target(SS_NUMERIC_AVX512_)))
+static size_t ss_numeric_find_i32_avx512_(
+    const int32_t *data,
+    size_t len,
+    int32_t value
+) {
+    const __m512i v = _mm512_set1_epi32(value);
+    size_t i = 0;
+
+    for (; len - i >= 16; i += 16) {
+        __mmask16 mask = _mm512_cmpeq_epi32_mask(_mm512_loadu_si512(data + i),
+            v);
+        if (mask != 0) return i + (size_t) __builtin_ctz(mask);
+    }
+
+    return i;
+}
+
+__attribute__((target(SS_NUMERIC_AVX512_)))
+static size_t ss_numeric_count_i32_avx512_(
+    const int32_t *data,
+    size_t len,
+    int32_t value,
+    size_t *count
+) {
+    const __m512i v = _mm512_set1_epi32(value);
+    size_t i = 0;
+
+    for (; len - i >= 16; i += 16) {
+        __mmask16 mask = _mm512_cmpeq_epi32_mask(_mm512_loadu_si512(data + i),
+            v);
+        *count += (size_t) __builtin_popcount(mask);
+    }
+
+    return i;
+}
+
+// AVX-512 DQ adds the 64-bit multiply that SSE2 and AVX2 lack.
+__attribute__((target(SS_NUMERIC_AVX512_)))
+static size_t ss_numeric_dot_i64_avx512_(
+    const int64_t *a,
+    const int64_t *b,
+    size_t len,
+    uint64_t *sum
+) {
+    __m512i acc = _mm512_setzero_si512();
+    size_t i = 0;
+
+    for (; len - i >= 8; i += 8) {
+        acc = _mm512_add_epi64(acc, _mm512_mullo_epi64(
+            _mm512_loadu_si512(a + i), _mm512_loadu_si512(b + i)));
+    }
+
+    uint64_t lanes[8];
+    _mm512_storeu_si512(lanes, acc);
+    for (size_t l = 0; l < 8; ++l) { *sum += lanes[l]; }
+    return i;
+}
+
+__attribute__((target(SS_NUMERIC_AVX512_)))
+static size_t ss_numeric_dot_f32_avx512_(
+    const float *a,
+    const float *b,
+    size_t len,
+    float *sum
+) {
+    __m512 acc0 = _mm512_setzero_ps();
+    __m512 acc1 = _mm512_setzero_ps();
+    __m512 acc2 = _mm512_setzero_ps();
+    __m512 acc3 = _mm512_setzero_ps();
+    size_t i = 0;
+
+    for (; len - i >= 64; i += 64) {
+        acc0 = _mm512_add_ps(acc0, _mm512_mul_ps(
+            _mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i)));
+        acc1 = _mm512_add_ps(acc1, _mm512_mul_ps(
+            _mm512_loadu_ps(a + i + 16), _mm512_loadu_ps(b + i + 16)));
+        acc2 = _mm512_add_ps(acc2, _mm512_mul_ps(
+            _mm512_loadu_ps(a + i + 32), _mm512_loadu_ps(b + i + 32)));
+        acc3 = _mm512_add_ps(acc3, _mm512_mul_ps(
+            _mm512_loadu_ps(a + i + 48), _mm512_loadu_ps(b + i + 48)));
+    }
+
+    float lanes[16];
+    _mm512_storeu_ps(lanes, _mm512_add_ps(
+        _mm512_add_ps(acc0, acc1), _mm512_add_ps(acc2, acc3)));
+    for (size_t l = 0; l < 16; ++l) { *sum += lanes[l]; }
+    return i;
+}
+
+__attribute__((target(SS_NUMERIC_AVX512_)))
+static size_t ss_numeric_dot_f64_avx512_(
+    const double *a,
+    const double *b,
+    size_t len,
+    double *sum
+) {
+    __m512d acc0 = _mm512_setzero_pd();
+    __m512d acc1 = _mm512_setzero_pd();
+    __m512d acc2 = _mm512_setzero_pd();
+    __m512d acc3 = _mm512_setzero_pd();
+    size_t i = 0;
+
+    for (; len - i >= 32; i += 32) {
+        acc0 = _mm512_add_pd(acc0, _mm512_mul_pd(
+            _mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i)));
+        acc1 = _mm512_add_pd(acc1, _mm512_mul_pd(
+            _mm512_loadu_pd(a + i + 8), _mm512_loadu_pd(b + i + 8)));
+        acc2 = _mm512_add_pd(acc2, _mm512_mul_pd(
+            _mm512_loadu_pd(a + i + 16), _mm512_loadu_pd(b + i + 16)));
+        acc3 = _mm512_add_pd(acc3, _mm512_mul_pd(
+            _mm512_loadu_pd(a + i + 24), _mm512_loadu_pd(b + i + 24)));
+    }
+
+    double lanes[8];
+    _mm512_storeu_pd(lanes, _mm512_add_pd(
+        _mm512_add_pd(acc0, acc1), _mm512_add_pd(acc2, acc3)));
+    for (size_t l = 0; l < 8; ++l) { *sum += lanes[l]; }
+    return i;
+}
+
+#endif // SS_NUMERIC_X86
+
+// Block functions of each kernel, by the level they need. The scalar level has
+// none; there, the scalar loop covers the whole input.
+#ifdef SS_NUMERIC_X86
+    #define SS_NUMERIC_DISPATCH_(SSE2, AVX2, AVX512)                           \
+        { .impls = {                                                           \
+            [SS_CPU_SSE2] = (ss_cpu_fn) (SSE2),                                \
+            [SS_CPU_AVX2] = (ss_cpu_fn) (AVX2),                                \
+            [SS_CPU_AVX512] = (ss_cpu_fn) (AVX512)                             \
+        } }
+#else
+    #define SS_NUMERIC_DISPATCH_(SSE2, AVX2, AVX512) { .impls = { NULL } }
+#endif
+
+typedef size_t (*ss_numeric_sum_i32_fn_)(
+    const int32_t *data,
+    size_t len,
+    uint32_t *sum
+);
+static struct ss_cpu_dispatch ss_numeric_sum_i32_dispatch_ =
+    SS_NUMERIC_DISPATCH_(
+        ss_numeric_sum_i32_sse2_,
+        ss_numeric_sum_i32_avx2_,
+        ss_numeric_sum_i32_avx512_
+    );
+
+typedef size_t (*ss_numeric_sum_i64_fn_)(
+    const int64_t *data,
+    size_t len,
+    uint64_t *sum
+);
+static struct ss_cpu_dispatch ss_numeric_sum_i64_dispatch_ =
+    SS_NUMERIC_DISPATCH_(
+        ss_numeric_sum_i64_sse2_,
+        ss_numeric_sum_i64_avx2_,
+        ss_numeric_sum_i64_avx512_
+    );
+
+typedef size_t (*ss_numeric_sum_f32_fn_)(
+    const float *data,
+    size_t len,
+    float *sum
+);
+static struct ss_cpu_dispatch ss_numeric_sum_f32_dispatch_ =
+    SS_NUMERIC_DISPATCH_(
+        ss_numeric_sum_f32_sse2_,
+        ss_numeric_sum_f32_avx2_,
+        ss_numeric_sum_f32_avx512_
+    );
+
+typedef size_t (*ss_numeric_sum_f64_fn_)(
+    const double *data,
+    size_t len,
+    double *sum
+);
+static struct ss_cpu_dispatch ss_numeric_sum_f64_dispatch_ =
+    SS_NUMERIC_DISPATCH_(
+        ss_numeric_sum_f64_sse2_,
+        ss_numeric_sum_f64_avx2_,
+        ss_numeric_sum_f64_avx512_
+    );
+
+typedef size_t (*ss_numeric_minmax_i32_fn_)(
+    const int32_t *data,
+    size_t len,
+    bool max,
+    int32_t *best
+);
+static struct ss_cpu_dispatch ss_numeric_minmax_i32_dispatch_ =
+    SS_NUMERIC_DISPATCH_(
+        ss_numeric_minmax_i32_sse2_,
+        ss_numeric_minmax_i32_avx2_,
+        NULL
+    );
+
+typedef size_t (*ss_numeric_minmax_i64_fn_)(
+    const int64_t *data,
+    size_t len,
+    bool max,
+    int64_t *best
+);
+static struct ss_cpu_dispatch ss_numeric_minmax_i64_dispatch_ =
+    SS_NUMERIC_DISPATCH_(
+        NULL,
+        ss_numeric_minmax_i64_avx2_,
+        ss_numeric_minmax_i64_avx512_
+    );
+
+typedef size_t (*ss_numeric_minmax_f32_fn_)(
+    const float *data,
+    size_t len,
+    bool max,
+    float *best
+);
+static struct ss_cpu_dispatch ss_numeric_minmax_f32_dispatch_ =
+    SS_NUMERIC_DISPATCH_(
+        ss_numeric_minmax_f32_sse2_,
+        ss_numeric_minmax_f32_avx2_,
+        NULL
+    );
+
+typedef size_t (*ss_numeric_minmax_f64_fn_)(
+    const double *data,
+    size_t len,
+    bool max,
+    double *best
+);
+static struct ss_cpu_dispatch ss_numeric_minmax_f64_dispatch_ =
+    SS_NUMERIC_DISPATCH_(
+        ss_numeric_minmax_f64_sse2_,
+        ss_numeric_minmax_f64_avx2_,
+        NULL
+    );
+
+typedef size_t (*ss_numeric_find_i32_fn_)(
+    const int32_t *data,
+    size_t len,
+    int32_t value
+);
+static struct ss_cpu_dispatch ss_numeric_find_i32_dispatch_ =
+    SS_NUMERIC_DISPATCH_(
+        ss_numeric_find_i32_sse2_,
+        ss_numeric_find_i32_avx2_,
+        ss_numeric_find_i32_avx512_
+    );
+
+typedef size_t (*ss_numeric_find_i64_fn_)(
+    const int64_t *data,
+    size_t len,
+    int64_t value
+);
+static struct ss_cpu_dispatch ss_numeric_find_i64_dispatch_ =
+    SS_NUMERIC_DISPATCH_(
+        ss_numeric_find_i64_sse2_,
+        ss_numeric_find_i64_avx2_,
+        NULL
+    );
+
+typedef size_t (*ss_numeric_find_f32_fn_)(
+    const float *data,
+    size_t len,
+    float value
+);
+static struct ss_cpu_dispatch ss_numeric_find_f32_dispatch_ =
+    SS_NUMERIC_DISPATCH_(
+        ss_numeric_find_f32_sse2_,
+        ss_numeric_find_f32_avx2_,
+        NULL
+    );
+
+typedef size_t (*ss_numeric_find_f64_fn_)(
+    const double *data,
+    size_t len,
+    double value
+);
+static struct ss_cpu_dispatch ss_numeric_find_f64_dispatch_ =
+    SS_NUMERIC_DISPATCH_(
+        ss_numeric_find_f64_sse2_,
+        ss_numeric_find_f64_avx2_,
+        NULL
+    );
+
+typedef size_t (*ss_numeric_count_i32_fn_)(
+    const int32_t *data,
+    size_t len,
+    int32_t value,
+    size_t *count
+);
+static struct ss_cpu_dispatch ss_numeric_count_i32_dispatch_ =
+    SS_NUMERIC_DISPATCH_(
+        ss_numeric_count_i32_sse2_,
+        ss_numeric_count_i32_avx2_,
+        ss_numeric_count_i32_avx512_
+    );
+
+typedef size_t (*ss_numeric_count_i64_fn_)(
+    const int64_t *data,
+    size_t len,
+    int64_t value,
+    size_t *count
+);
+static struct ss_cpu_dispatch ss_numeric_count_i64_dispatch_ =
+    SS_NUMERIC_DISPATCH_(
+        ss_numeric_count_i64_sse2_,
+        ss_numeric_count_i64_avx2_,
+        NULL
+    );
+
+typedef size_t (*ss_numeric_count_f32_fn_)(
+    const float *data,
+    size_t len,
+    float value,
+    size_t *count
+);
+static struct ss_cpu_dispatch ss_numeric_count_f32_dispatch_ =
+    SS_NUMERIC_DISPATCH_(
+        ss_numeric_count_f32_sse2_,
+        ss_numeric_count_f32_avx2_,
+        NULL
+    );
+
+typedef size_t (*ss_numeric_count_f64_fn_)(
+    const double *data,
+    size_t len,
+    double value,
+    size_t *count
+);
+static struct ss_cpu_dispatch ss_numeric_count_f64_dispatch_ =
+    SS_NUMERIC_DISPATCH_(
+        ss_numeric_count_f64_sse2_,
+        ss_numeric_count_f64_avx2_,
+        NULL
+    );
+
+typedef size_t (*ss_numeric_dot_i32_fn_)(
+    const int32_t *a,
+    const int32_t *b,
+    size_t len,
+    uint32_t *sum
+);
+static struct ss_cpu_dispatch ss_numeric_dot_i32_dispatch_ =
+    SS_NUMERIC_DISPATCH_(NULL, ss_numeric_dot_i32_avx2_, NULL);
+
+typedef size_t (*ss_numeric_dot_i64_fn_)(
+    const int64_t *a,
+    const int64_t *b,
+    size_t len,
+    uint64_t *sum
+);
+static struct ss_cpu_dispatch ss_numeric_dot_i64_dispatch_ =
+    SS_NUMERIC_DISPATCH_(NULL, NULL, ss_numeric_dot_i64_avx512_);
+
+typedef size_t (*ss_numeric_dot_f32_fn_)(
+    const float *a,
+    const float *b,
+    size_t len,
+    float *sum
+);
+static struct ss_cpu_dispatch ss_numeric_dot_f32_dispatch_ =
+    SS_NUMERIC_DISPATCH_(
+        ss_numeric_dot_f32_sse2_,
+        ss_numeric_dot_f32_avx2_,
+        ss_numeric_dot_f32_avx512_
+    );
+
+typedef size_t (*ss_numeric_dot_f64_fn_)(
+    const double *a,
+    const double *b,
+    size_t len,
+    double *sum
+);
+static struct ss_cpu_dispatch ss_numeric_dot_f64_dispatch_ =
+    SS_NUMERIC_DISPATCH_(
+        ss_numeric_dot_f64_sse2_,
+        ss_numeric_dot_f64_avx2_,
+        ss_numeric_dot_f64_avx512_
+    );
+
+int32_t ss_numeric_sum_i32(const int32_t *data, size_t len) {
+    if (data == NULL) return 0;
+
+    uint32_t sum = 0;
+    size_t i = 0;
+
+    ss_numeric_sum_i32_fn_ blocks = (ss_numeric_sum_i32_fn_)
+        ss_cpu_resolve(&ss_numeric_sum_i32_dispatch_);
+    if (blocks != NULL) { i = blocks(data, len, &sum); }
+
+    for (; i < len; ++i) { sum += (uint32_t) data[i]; }
+    return (int32_t) sum;
+}
+
+int64_t ss_numeric_sum_i64(const int64_t *data, size_t len) {
+    if (data == NULL) return 0;
+
+    uint64_t sum = 0;
+    size_t i = 0;
+
+    ss_numeric_sum_i64_fn_ blocks = (ss_numeric_sum_i64_fn_)
+        ss_cpu_resolve(&ss_numeric_sum_i64_dispatch_);
+    if (blocks != NULL) { i = blocks(data, len, &sum); }
+
+    for (; i < len; ++i) { sum += (uint64_t) data[i]; }
+    return (int64_t) sum;
+}
+
+float ss_numeric_sum_f32(const float *data, size_t len) {
+    if (data == NULL) return 0.0f;
+
+    float sum = 0.0f;
+    size_t i = 0;
+
+    ss_numeric_sum_f32_fn_ blocks = (ss_numeric_sum_f32_fn_)
+        ss_cpu_resolve(&ss_numeric_sum_f32_dispatch_);
+    if (blocks != NULL) { i = blocks(data, len, &sum); }
+
+    return sum + ss_numeric_sum_f32_scalar_(data + i, len - i);
+}
+
+double ss_numeric_sum_f64(const double *data, size_t len) {
+    if (data == NULL) return 0.0;
+
+    double sum = 0.0;
+    size_t i = 0;
+
+    ss_numeric_sum_f64_fn_ blocks = (ss_numeric_sum_f64_fn_)
+        ss_cpu_resolve(&ss_numeric_sum_f64_dispatch_);
+    if (blocks != NULL) { i = blocks(data, len, &sum); }
+
+    return sum + ss_numeric_sum_f64_scalar_(data + i, len - i);
+}
+
+static bool ss_numeric_minmax_i32_(
+    const int32_t *data,
+    size_t len,
+    bool max,
+    int32_t *out
+) {
+    if (data == NULL || len == 0 || out == NULL) return false;
+
+    int32_t best = data[0];
+    size_t i = 1;
+
+    ss_numeric_minmax_i32_fn_ blocks = (ss_numeric_minmax_i32_fn_)
+        ss_cpu_resolve(&ss_numeric_minmax_i32_dispatch_);
+    if (blocks != NULL) { i = blocks(data, len, max, &best); }
+
+    for (; i < len; ++i) {
+        if (max ? data[i] > best : data[i] < best) { best = data[i]; }
+    }
+
+    *out = best;
+    return true;
+}
+
+static bool ss_numeric_minmax_i64_(
+    const int64_t *data,
+    size_t len,
+    bool max,
+    int64_t *out
+) {
+    if (data == NULL || len == 0 || out == NULL) return false;
+
+    int64_t best = data[0];
+    size_t i = 1;
+
+    ss_numeric_minmax_i64_fn_ blocks = (ss_numeric_minmax_i64_fn_)
+        ss_cpu_resolve(&ss_numeric_minmax_i64_dispatch_);
+    if (blocks != NULL) { i = blocks(data, len, max, &best); }
+
+    for (; i < len; ++i) {
+        if (max ? data[i] > best : data[i] < best) { best = data[i]; }
+    }
+
+    *out = best;
+    return true;
+}
+
+static bool ss_numeric_minmax_f32_(
+    const float *data,
+    size_t len,
+    bool max,
+    float *out
+) {
+    if (data == NULL || len == 0 || out == NULL) return false;
+
+    float best = data[0];
+    size_t i = 1;
+
+    ss_numeric_minmax_f32_fn_ blocks = (ss_numeric_minmax_f32_fn_)
+        ss_cpu_resolve(&ss_numeric_minmax_f32_dispatch_);
+    if (blocks != NULL) { i = blocks(data, len, max, &best); }
+
+    for (; i < len; ++i) {
+        if (max ? data[i] > best : data[i] < best) { best = data[i]; }
+    }
+
+    *out = best;
+    return true;
+}
+
+static bool ss_numeric_minmax_f64_(
+    const double *data,
+    size_t len,
+    bool max,
+    double *out
+) {
+    if (data == NULL || len == 0 || out == NULL) return false;
+
+    double best = data[0];
+    size_t i = 1;
+
+    ss_numeric_minmax_f64_fn_ blocks = (ss_numeric_minmax_f64_fn_)
+        ss_cpu_resolve(&ss_numeric_minmax_f64_dispatch_);
+    if (blocks != NULL) { i = blocks(data, len, max, &best); }
+
+    for (; i < len; ++i) {
+        if (max ? data[i] > best : data[i] < best) { best = data[i]; }
+    }
+
+    *out = best;
+    return true;
+}
+
+bool ss_numeric_min_i32(const int32_t *data, size_t len, int32_t *out) {
+    return ss_numeric_minmax_i32_(data, len, false, out);
+}
+
+bool ss_numeric_min_i64(const int64_t *data, size_t len, int64_t *out) {
+    return ss_numeric_minmax_i64_(data, len, false, out);
+}
+
+bool ss_numeric_min_f32(const float *data, size_t len, float *out) {
+    return ss_numeric_minmax_f32_(data, len, false, out);
+}
+
+bool ss_numeric_min_f64(const double *data, size_t len, double *out) {
+    return ss_numeric_minmax_f64_(data, len, false, out);
+}
+
+bool ss_numeric_max_i32(const int32_t *data, size_t len, int32_t *out) {
+    return ss_numeric_minmax_i32_(data, len, true, out);
+}
+
+bool ss_numeric_max_i64(const int64_t *data, size_t len, int64_t *out) {
+    return ss_numeric_minmax_i64_(data, len, true, out);
+}
+
+bool ss_numeric_max_f32(const float *data, size_t len, float *out) {
+    return ss_numeric_minmax_f32_(data, len, true, out);
+}
+
+bool ss_numeric_max_f64(const double *data, size_t len, double *out) {
+    return ss_numeric_minmax_f64_(data, len, true, out);
+}
+
+size_t ss_numeric_find_i32(const int32_t *data, size_t len, int32_t value) {
+    if (data == NULL) return SIZE_MAX;
+
+    size_t i = 0;
+
+    ss_numeric_find_i32_fn_ blocks = (ss_numeric_find_i32_fn_)
+        ss_cpu_resolve(&ss_numeric_find_i32_dispatch_);
+    if (blocks != NULL) { i = blocks(data, len, value); }
+
+    for (; i < len; ++i) {
+        if (data[i] == value) return i;
+    }
+    return SIZE_MAX;
+}
+
+size_t ss_numeric_find_i64(const int64_t *data, size_t len, int64_t value) {
+    if (data == NULL) return SIZE_MAX;
+
+    size_t i = 0;
+
+    ss_numeric_find_i64_fn_ blocks = (ss_numeric_find_i64_fn_)
+        ss_cpu_resolve(&ss_numeric_find_i64_dispatch_);
+    if (blocks != NULL) { i = blocks(data, len, value); }
+
+    for (; i < len; ++i) {
+        if (data[i] == value) return i;
+    }
+    return SIZE_MAX;
+}
+
+size_t ss_numeric_find_f32(const float *data, size_t len, float value) {
+    if (data == NULL) return SIZE_MAX;
+
+    size_t i = 0;
+
+    ss_numeric_find_f32_fn_ blocks = (ss_numeric_find_f32_fn_)
+        ss_cpu_resolve(&ss_numeric_find_f32_dispatch_);
+    if (blocks != NULL) { i = blocks(data, len, value); }
+
+    for (; i < len; ++i) {
+        if (data[i] == value) return i;
+    }
+    return SIZE_MAX;
+}
+
+size_t ss_numeric_find_f64(const double *data, size_t len, double value) {
+    if (data == NULL) return SIZE_MAX;
+
+    size_t i = 0;
+
+    ss_numeric_find_f64_fn_ blocks = (ss_numeric_find_f64_fn_)
+        ss_cpu_resolve(&ss_numeric_find_f64_dispatch_);
+    if (blocks != NULL) { i = blocks(data, len, value); }
+
+    for (; i < len; ++i) {
+        if (data[i] == value) return i;
+    }
+    return SIZE_MAX;
+}
+
+size_t ss_numeric_count_i32(const int32_t *data, size_t len, int32_t value) {
+    if (data == NULL) return 0;
+
+    size_t count = 0;
+    size_t i = 0;
+
+    ss_numeric_count_i32_fn_ blocks = (ss_numeric_count_i32_fn_)
+        ss_cpu_resolve(&ss_numeric_count_i32_dispatch_);
+    if (blocks != NULL) { i = blocks(data, len, value, &count); }
+
+    for (; i < len; ++i) {
+        if (data[i] == value) { count += 1; }
+    }
+    return count;
+}
+
+size_t ss_numeric_count_i64(const int64_t *data, size_t len, int64_t value) {
+    if (data == NULL) return 0;
+
+    size_t count = 0;
+    size_t i = 0;
+
+    ss_numeric_count_i64_fn_ blocks = (ss_numeric_count_i64_fn_)
+        ss_cpu_resolve(&ss_numeric_count_i64_dispatch_);
+    if (blocks != NULL) { i = blocks(data, len, value, &count); }
+
+    for (; i < len; ++i) {
+        if (data[i] == value) { count += 1; }
+    }
+    return count;
+}
+
+size_t ss_numeric_count_f32(const float *data, size_t len, float value) {
+    if (data == NULL) return 0;
+
+    size_t count = 0;
+    size_t i = 0;
+
+    ss_numeric_count_f32_fn_ blocks = (ss_numeric_count_f32_fn_)
+        ss_cpu_resolve(&ss_numeric_count_f32_dispatch_);
+    if (blocks != NULL) { i = blocks(data, len, value, &count); }
+
+    for (; i < len; ++i) {
+        if (data[i] == value) { count += 1; }
+    }
+    return count;
+}
+
+size_t ss_numeric_count_f64(const double *data, size_t len, double value) {
+    if (data == NULL) return 0;
+
+    size_t count = 0;
+    size_t i = 0;
+
+    ss_numeric_count_f64_fn_ blocks = (ss_numeric_count_f64_fn_)
+        ss_cpu_resolve(&ss_numeric_count_f64_dispatch_);
+    if (blocks != NULL) { i = blocks(data, len, value, &count); }
+
+    for (; i < len; ++i) {
+        if (data[i] == value) { count += 1; }
+    }
+    return count;
+}
+
+int32_t ss_numeric_dot_i32(const int32_t *a, const int32_t *b, size_t len) {
+    if (a == NULL || b == NULL) return 0;
+
+    uint32_t sum = 0;
+    size_t i = 0;
+
+    // SSE2 has no 32-bit multiply that keeps the low halves.
+    ss_numeric_dot_i32_fn_ blocks = (ss_numeric_dot_i32_fn_)
+        ss_cpu_resolve(&ss_numeric_dot_i32_dispatch_);
+    if (blocks != NULL) { i = blocks(a, b, len, &sum); }
+
+    for (; i < len; ++i) { sum += (uint32_t) a[i] * (uint32_t) b[i]; }
+    return (int32_t) sum;
+}
+
+int64_t ss_numeric_dot_i64(const int64_t *a, const int64_t *b, size_t len) {
+    if (a == NULL || b == NULL) return 0;
+
+    uint64_t s0 = 0, s1 = 0;
+    size_t i = 0;
+
+    // Only AVX-512 has a 64-bit multiply.
+    ss_numeric_dot_i64_fn_ blocks = (ss_numeric_dot_i64_fn_)
+        ss_cpu_resolve(&ss_numeric_dot_i64_dispatch_);
+    if (blocks != NULL) { i = blocks(a, b, len, &s0); }
+
+    for (; len - i >= 2; i += 2) {
+        s0 += (uint64_t) a[i] * (uint64_t) b[i];
+        s1 += (uint64_t) a[i + 1] * (uint64_t) b[i + 1];
+    }
+    for (; i < len; ++i) { s0 += (uint64_t) a[i] * (uint64_t) b[i]; }
+
+    return (int64_t) (s0 + s1);
+}
+
+float ss_numeric_dot_f32(const float *a, const float *b, size_t len) {
+    if (a == NULL || b == NULL) return 0.0f;
+
+    float sum = 0.0f;
+    size_t i = 0;
+
+    ss_numeric_dot_f32_fn_ blocks = (ss_numeric_dot_f32_fn_)
+        ss_cpu_resolve(&ss_numeric_dot_f32_dispatch_);
+    if (blocks != NULL) { i = blocks(a, b, len, &sum); }
+
+    return sum + ss_numeric_dot_f32_scalar_(a + i, b + i, len - i);
+}
+
+double ss_numeric_dot_f64(const double *a, const double *b, size_t len) {
+    if (a == NULL || b == NULL) return 0.0;
+
+    double sum = 0.0;
+    size_t i = 0;
+
+    ss_numeric_dot_f64_fn_ blocks = (ss_numeric_dot_f64_fn_)
+        ss_cpu_resolve(&ss_numeric_dot_f64_dispatch_);
+    if (blocks != NULL) { i = blocks(a, b, len, &sum); }
+
+    return sum + ss_numeric_dot_f64_scalar_(a + i, b + i, len - i);
+}
@@ -0,0 +1,122 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public License,
+ * v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ * obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ss_rcstring.h"
+#include "ss_string.h"
+
+#ifdef USE_SS_LIB_ASSERT
+    #include "ss_assert.h"
+#else
+    #include <assert.h>
+
+    #define ss_check(EXPR, MSG) assert(EXPR)
+    #define ss_assert assert
+    #define ss_assert_msg(EXPR, ...) assert(EXPR)
+#endif
+
+struct ss_rcstring {
+    atomic_size_t refs;
+    // The length of the string, including the null terminator
+    size_t len;
+    // A valid C string; either inline_ or a buffer taken from an ss_string
+    char *str;
+    char inline_[];
+};
+
+struct ss_rcstring *ss_rcstring_create_from_data(const char *data, size_t len) {
+    if (data == NULL) return NULL;
+
+    struct ss_rcstring *s = (struct ss_rcstring*)
+        malloc(sizeof(struct ss_rcstring) + len + 1);
+    if (s == NULL) return NULL;
+
+    atomic_init(&s->refs, 1);
+    s->len = len + 1;
+    s->str = s->inline_;
+    memcpy(s->str, data, len);
+    s->str[len] = '\0';
+
+    return s;
+}
+
+struct ss_rcstring *ss_rcstring_create_from_cstring(const char *s) {
+    if (s == NULL) return NULL;
+    return ss_rcstring_create_from_data(s, strlen(s));
+}
+
+struct ss_rcstring *ss_rcstring_create_from_string(struct ss_string **s) {
+    if (s == NULL || *s == NULL) return NULL;
+
+    if (ss_string_len(*s) == 0) {
+        // Nothing to take; an empty string lives inline.
+        struct ss_rcstring *rc = ss_rcstring_create_from_data("", 0);
+        if (rc != NULL) { ss_string_free(s); }
+        return rc;
+    }
+
+    // Allocate before dissolving so that failure leaves the string intact.
+    struct ss_rcstring *rc =
+        (struct ss_rcstring*) malloc(sizeof(struct ss_rcstring));
+    if (rc == NULL) return NULL;
+
+    char *buf = NULL;
+    atomic_init(&rc->refs, 1);
+    rc->len = ss_string_dissolve(s, &buf);
+    rc->str = buf;
+
+    ss_assert(rc->str[rc->len - 1] == '\0');
+    return rc;
+}
+
+struct ss_rcstring *ss_rcstring_retain(struct ss_rcstring *s) {
+    if (s == NULL) return NULL;
+
+    // A new reference can only be made from an existing one, so no ordering
+    // is needed here.
+    atomic_fetch_add_explicit(&s->refs, 1, memory_order_relaxed);
+    return s;
+}
+
+void ss_rcstring_release(struct ss_rcstring **s) {
+    if (s == NULL || *s == NULL) return;
+
+    struct ss_rcstring *rc = *s;
+    *s = NULL;
+
+    if (atomic_fetch_sub_explicit(&rc->refs, 1, memory_order_release) == 1) {
+        // Synchronize with every other thread's release before freeing.
+        atomic_thread_fence(memory_order_acquire);
+
+        if (rc->str != rc->inline_) { free(rc->str); }
+        free(rc);
+    }
+}
+
+const char *ss_rcstring_as_cstring(const struct ss_rcstring *s) {
+    if (s == NULL) return NULL;
+    return s->str;
+}
+
+size_t ss_rcstring_len(const struct ss_rcstring *s) {
+    if (s == NULL) return 0;
+    return s->len;
+}
+
+int ss_rcstring_cmp(const struct ss_rcstring *s1, const struct ss_rcstring *s2)
+{
+    return s1 == NULL && s2 == NULL ? 0
+        : s1 == NULL || s2 == NULL ? -1
+        : strcmp(s1->str, s2->str);
+}
+
+struct ss_string *ss_rcstring_to_string(const struct ss_rcstring *s) {
+    if (s == NULL) return NULL;
+    return ss_string_create_from_cstring(s->str);
+}
@@ -0,0 +1,540 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public License,
+ * v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ * obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ss_rope.h"
+#include "ss_string.h"
+
+#ifdef USE_SS_LIB_ASSERT
+    #include "ss_assert.h"
+#else
+    #include <assert.h>
+
+    #define ss_check(EXPR, MSG) assert(EXPR)
+    #define ss_assert assert
+    #define ss_assert_msg(EXPR, ...) assert(EXPR)
+#endif
+
+// Immutable text shared by any number of pieces.
+struct ss_rope_buf_ {
+    size_t refs;
+    size_t len;
+    char data[];
+};
+
+// A treap node referencing a range of a buffer.
+struct ss_rope_node_ {
+    struct ss_rope_node_ *left;
+    struct ss_rope_node_ *right;
+    struct ss_rope_buf_ *buf;
+    // The start of this piece within buf
+    size_t offset;
+    // The length of this piece
+    size_t len;
+    // The length of all pieces in this subtree
+    size_t total;
+    uint32_t priority;
+};
+
+struct ss_rope {
+    struct ss_rope_node_ *root;
+    // State for the priority generator
+    uint32_t seed;
+};
+
+// Counts the ropes created, so that each one starts from a different seed.
+static atomic_uint ss_rope_count_ = 0;
+
+// Ropes built from the same seed draw the same priorities, and concatenating
+// them would leave the tree as deep as it is long.
+static uint32_t ss_rope_seed_(const struct ss_rope *rope) {
+    uint32_t x = (uint32_t) atomic_fetch_add(&ss_rope_count_, 1) * 0x9E3779B9u;
+    x ^= (uint32_t) ((uintptr_t) rope >> 4);
+
+    // Finalizer from MurmurHash3, spreading both inputs over all bits
+    x ^= x >> 16;
+    x *= 0x85EBCA6Bu;
+    x ^= x >> 13;
+    x *= 0xC2B2AE35u;
+    x ^= x >> 16;
+
+    // xorshift32 never leaves 0.
+    return x == 0 ? 2463534242u : x;
+}
+
+static uint32_t ss_rope_next_priority_(struct ss_rope *rope) {
+    // xorshift32
+    uint32_t x = rope->seed;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    rope->seed = x;
+    return x;
+}
+
+static size_t ss_rope_total_(const struct ss_rope_node_ *node) {
+    return node == NULL ? 0 : node->total;
+}
+
+static void ss_rope_update_(struct ss_rope_node_ *node) {
+    node->total = ss_rope_total_(node->left) + node->len
+        + ss_rope_total_(node->right);
+}
+
+static struct ss_rope_buf_ *ss_rope_buf_create_(const char *data, size_t len) {
+    struct ss_rope_buf_ *buf =
+        (struct ss_rope_buf_*) malloc(sizeof(struct ss_rope_buf_) + len);
+    if (buf == NULL) return NULL;
+
+    buf->refs = 0;
+    buf->len = len;
+    memcpy(buf->data, data, len);
+
+    return buf;
+}
+
+static void ss_rope_buf_release_(struct ss_rope_buf_ *buf) {
+    ss_assert(buf->refs > 0);
+    buf->refs -= 1;
+    if (buf->refs == 0) { free(buf); }
+}
+
+static struct ss_rope_node_ *ss_rope_node_create_(
+    struct ss_rope_buf_ *buf,
+    size_t offset,
+    size_t len,
+    uint32_t priority
+) {
+    struct ss_rope_node_ *node =
+        (struct ss_rope_node_*) malloc(sizeof(struct ss_rope_node_));
+    if (node == NULL) return NULL;
+
+    node->left = NULL;
+    node->right = NULL;
+    node->buf = buf;
+    node->offset = offset;
+    node->len = len;
+    node->total = len;
+    node->priority = priority;
+    buf->refs += 1;
+
+    return node;
+}
+
+static void ss_rope_node_free_(struct ss_rope_node_ *node) {
+    if (node == NULL) return;
+
+    ss_rope_node_free_(node->left);
+    ss_rope_node_free_(node->right);
+    ss_rope_buf_release_(node->buf);
+    free(node);
+}
+
+static struct ss_rope_node_ *ss_rope_merge_(
+    struct ss_rope_node_ *a,
+    struct ss_rope_node_ *b
+) {
+    if (a == NULL) return b;
+    if (b == NULL) return a;
+
+    if (a->priority >= b->priority) {
+        a->right = ss_rope_merge_(a->right, b);
+        ss_rope_update_(a);
+        return a;
+    } else {
+        b->left = ss_rope_merge_(a, b->left);
+        ss_rope_update_(b);
+        return b;
+    }
+}
+
+// Split the tree so that the first `pos` chars are in `left` and the rest are
+// in `right`.
+//
+// A piece spanning `pos` is split in two, which requires an allocation. On
+// failure to allocate, returns false and leaves the tree unchanged.
+static bool ss_rope_split_(
+    struct ss_rope_node_ *node,
+    size_t pos,
+    struct ss_rope_node_ **left,
+    struct ss_rope_node_ **right
+) {
+    if (node == NULL) {
+        *left = NULL;
+        *right = NULL;
+        return true;
+    }
+
+    size_t left_total = ss_rope_total_(node->left);
+    struct ss_rope_node_ *l = NULL;
+    struct ss_rope_node_ *r = NULL;
+
+    if (pos <= left_total) {
+        if (! ss_rope_split_(node->left, pos, &l, &r)) return false;
+        node->left = r;
+        ss_rope_update_(node);
+        *left = l;
+        *right = node;
+    } else if (pos >= left_total + node->len) {
+        size_t sub_pos = pos - left_total - node->len;
+        if (! ss_rope_split_(node->right, sub_pos, &l, &r)) return false;
+        node->right = l;
+        ss_rope_update_(node);
+        *left = node;
+        *right = r;
+    } else {
+        // The split falls inside this piece. The new node inherits this node's
+        // priority, so it remains a valid root for the right subtree.
+        size_t k = pos - left_total;
+        struct ss_rope_node_ *tail = ss_rope_node_create_(
+            node->buf,
+            node->offset + k,
+            node->len - k,
+            node->priority
+        );
+        if (tail == NULL) return false;
+
+        tail->right = node->right;
+        ss_rope_update_(tail);
+
+        node->len = k;
+        node->right = NULL;
+        ss_rope_update_(node);
+
+        *left = node;
+        *right = tail;
+    }
+
+    return true;
+}
+
+// Find the node containing `pos` and the offset of `pos` within that piece.
+static const struct ss_rope_node_ *ss_rope_find_(
+    const struct ss_rope_node_ *node,
+    size_t pos,
+    size_t *piece_pos
+) {
+    while (node != NULL) {
+        size_t left_total = ss_rope_total_(node->left);
+
+        if (pos < left_total) {
+            node = node->left;
+        } else if (pos < left_total + node->len) {
+            *piece_pos = pos - left_total;
+            return node;
+        } else {
+            pos -= left_total + node->len;
+            node = node->right;
+        }
+    }
+
+    return NULL;
+}
+
+struct ss_rope *ss_rope_create() {
+    struct ss_rope *rope = (struct ss_rope*) malloc(sizeof(struct ss_rope));
+    if (rope == NULL) return NULL;
+
+    rope->root = NULL;
+    rope->seed = ss_rope_seed_(rope);
+
+    return rope;
+}
+
+struct ss_rope *ss_rope_create_from_data(const char *data, size_t len) {
+    struct ss_rope *rope = ss_rope_create();
+    if (rope == NULL) return NULL;
+
+    if (data != NULL && len > 0 && ! ss_rope_insert(rope, 0, data, len)) {
+        ss_rope_free(&rope);
+        return NULL;
+    }
+
+    return rope;
+}
+
+struct ss_rope *ss_rope_create_from_cstring(const char *s) {
+    if (s == NULL) return NULL;
+    return ss_rope_create_from_data(s, strlen(s));
+}
+
+void ss_rope_free(struct ss_rope **rope) {
+    if (rope == NULL || *rope == NULL) return;
+
+    ss_rope_node_free_((*rope)->root);
+    (*rope)->root = NULL;
+    free(*rope);
+    *rope = NULL;
+}
+
+size_t ss_rope_len(const struct ss_rope *rope) {
+    if (rope == NULL) return 0;
+    return ss_rope_total_(rope->root);
+}
+
+static size_t ss_rope_depth_(const struct ss_rope_node_ *node) {
+    if (node == NULL) return 0;
+
+    size_t left = ss_rope_depth_(node->left);
+    size_t right = ss_rope_depth_(node->right);
+    return 1 + (left > right ? left : right);
+}
+
+size_t ss_rope_depth(const struct ss_rope *rope) {
+    if (rope == NULL) return 0;
+    return ss_rope_depth_(rope->root);
+}
+
+char ss_rope_char_at(const struct ss_rope *rope, size_t pos) {
+    if (rope == NULL) return '\0';
+
+    size_t piece_pos = 0;
+    const struct ss_rope_node_ *node =
+        ss_rope_find_(rope->root, pos, &piece_pos);
+    if (node == NULL) return '\0';
+
+    return node->buf->data[node->offset + piece_pos];
+}
+
+bool ss_rope_insert(
+    struct ss_rope *rope,
+    size_t pos,
+    const char *data,
+    size_t len
+) {
+    if (rope == NULL || data == NULL || len == 0) return false;
+    if (pos > ss_rope_len(rope)) return false;
+
+    struct ss_rope_buf_ *buf = ss_rope_buf_create_(data, len);
+    if (buf == NULL) return false;
+
+    struct ss_rope_node_ *node =
+        ss_rope_node_create_(buf, 0, len, ss_rope_next_priority_(rope));
+    if (node == NULL) {
+        free(buf);
+        return false;
+    }
+
+    struct ss_rope_node_ *left = NULL;
+    struct ss_rope_node_ *right = NULL;
+    if (! ss_rope_split_(rope->root, pos, &left, &right)) {
+        ss_rope_node_free_(node);
+        return false;
+    }
+
+    rope->root = ss_rope_merge_(ss_rope_merge_(left, node), right);
+    return true;
+}
+
+bool ss_rope_append(struct ss_rope *rope, const char *data, size_t len) {
+    return ss_rope_insert(rope, ss_rope_len(rope), data, len);
+}
+
+bool ss_rope_delete(struct ss_rope *rope, size_t pos, size_t len) {
+    if (rope == NULL) return false;
+
+    size_t rope_len = ss_rope_len(rope);
+    if (pos > rope_len) return false;
+    if (len > rope_len - pos) { len = rope_len - pos; }
+    if (len == 0) return true;
+
+    struct ss_rope_node_ *left = NULL;
+    struct ss_rope_node_ *rest = NULL;
+    if (! ss_rope_split_(rope->root, pos, &left, &rest)) return false;
+
+    struct ss_rope_node_ *middle = NULL;
+    struct ss_rope_node_ *right = NULL;
+    if (! ss_rope_split_(rest, len, &middle, &right)) {
+        rope->root = ss_rope_merge_(left, rest);
+        return false;
+    }
+
+    ss_rope_node_free_(middle);
+    rope->root = ss_rope_merge_(left, right);
+    return true;
+}
+
+// Builds a treap from pieces added in order, in O(1) amortized time per piece.
+//
+// `spine` is the bottom of the tree's right spine. While building, each spine
+// node's `right` points up to its parent on the spine instead of down to its
+// child, so a new piece climbs from the bottom rather than descending from the
+// root.
+struct ss_rope_builder_ {
+    struct ss_rope *rope;
+    struct ss_rope_node_ *spine;
+    bool failed;
+};
+
+static void ss_rope_builder_add_(
+    struct ss_rope_builder_ *builder,
+    const struct ss_rope_node_ *src,
+    size_t piece_pos,
+    size_t len
+) {
+    struct ss_rope_node_ *node = ss_rope_node_create_(
+        src->buf,
+        src->offset + piece_pos,
+        len,
+        ss_rope_next_priority_(builder->rope)
+    );
+    if (node == NULL) {
+        builder->failed = true;
+        return;
+    }
+
+    // Spine nodes of lower priority become the new node's left subtree. Equal
+    // priorities keep the earlier node above, as [ss_rope_merge_] does.
+    struct ss_rope_node_ *last = NULL;
+    struct ss_rope_node_ *top = builder->spine;
+    while (top != NULL && top->priority < node->priority) {
+        struct ss_rope_node_ *parent = top->right;
+        top->right = last;
+        ss_rope_update_(top);
+        last = top;
+        top = parent;
+    }
+
+    node->left = last;
+    node->right = top;
+    ss_rope_update_(node);
+    builder->spine = node;
+}
+
+// Restore the spine's links and make the finished tree the rope's root.
+static void ss_rope_builder_finish_(struct ss_rope_builder_ *builder) {
+    struct ss_rope_node_ *last = NULL;
+    struct ss_rope_node_ *top = builder->spine;
+    while (top != NULL) {
+        struct ss_rope_node_ *parent = top->right;
+        top->right = last;
+        ss_rope_update_(top);
+        last = top;
+        top = parent;
+    }
+
+    builder->rope->root = last;
+    builder->spine = NULL;
+}
+
+// Add the parts of the pieces in [start, end) of the subtree to the builder,
+// in order. Only the subtrees overlapping the range are visited.
+static void ss_rope_collect_(
+    const struct ss_rope_node_ *node,
+    size_t start,
+    size_t end,
+    struct ss_rope_builder_ *builder
+) {
+    if (node == NULL || start >= end || builder->failed) return;
+
+    size_t left_total = ss_rope_total_(node->left);
+    size_t right_start = left_total + node->len;
+
+    if (start < left_total) {
+        ss_rope_collect_(node->left, start, end < left_total ? end : left_total,
+            builder);
+    }
+
+    size_t from = start > left_total ? start : left_total;
+    size_t to = end < right_start ? end : right_start;
+    if (from < to && ! builder->failed) {
+        ss_rope_builder_add_(builder, node, from - left_total, to - from);
+    }
+
+    if (end > right_start) {
+        size_t sub_start = start > right_start ? start - right_start : 0;
+        ss_rope_collect_(node->right, sub_start, end - right_start, builder);
+    }
+}
+
+struct ss_rope *ss_rope_substr(
+    const struct ss_rope *rope,
+    size_t pos,
+    size_t len
+) {
+    if (rope == NULL) return NULL;
+
+    size_t rope_len = ss_rope_len(rope);
+    if (pos > rope_len) return NULL;
+    if (len > rope_len - pos) { len = rope_len - pos; }
+
+    struct ss_rope *sub = ss_rope_create();
+    if (sub == NULL) return NULL;
+
+    struct ss_rope_builder_ builder = {
+        .rope = sub, .spine = NULL, .failed = false
+    };
+    ss_rope_collect_(rope->root, pos, pos + len, &builder);
+    ss_rope_builder_finish_(&builder);
+
+    if (builder.failed) {
+        ss_rope_free(&sub);
+        return NULL;
+    }
+
+    return sub;
+}
+
+bool ss_rope_concat(struct ss_rope *dest, struct ss_rope **src) {
+    if (dest == NULL || src == NULL || *src == NULL || dest == *src) {
+        return false;
+    }
+
+    dest->root = ss_rope_merge_(dest->root, (*src)->root);
+    (*src)->root = NULL;
+    ss_rope_free(src);
+
+    return true;
+}
+
+struct ss_string *ss_rope_to_string(const struct ss_rope *rope) {
+    if (rope == NULL) return NULL;
+
+    size_t len = ss_rope_len(rope);
+    if (len == 0) return ss_string_create();
+
+    // Sized for the whole rope, so the appends below never reallocate.
+    struct ss_string *s = ss_string_create_with_size(len + 1);
+    if (s == NULL) return NULL;
+
+    struct ss_rope_iter iter = ss_rope_iter_create(rope);
+    const char *chunk = NULL;
+    size_t chunk_len = 0;
+
+    while (ss_rope_iter_next(&iter, &chunk, &chunk_len)) {
+        ss_string_append_data(s, chunk, chunk_len);
+    }
+
+    return s;
+}
+
+struct ss_rope_iter ss_rope_iter_create(const struct ss_rope *rope) {
+    struct ss_rope_iter iter = { .rope_ = rope, .pos_ = 0 };
+    return iter;
+}
+
+bool ss_rope_iter_next(
+    struct ss_rope_iter *iter,
+    const char **data,
+    size_t *len
+) {
+    if (iter == NULL || iter->rope_ == NULL) return false;
+
+    size_t piece_pos = 0;
+    const struct ss_rope_node_ *node =
+        ss_rope_find_(iter->rope_->root, iter->pos_, &piece_pos);
+    if (node == NULL) return false;
+
+    *data = node->buf->data + node->offset + piece_pos;
+    *len = node->len - piece_pos;
+    iter->pos_ += *len;
+
+    return true;
+}
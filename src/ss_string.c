@@ -3,6 +3,7 @@
  * obtain one at https://mozilla.org/MPL/2.0/.
  */
 
+#include <stdarg.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
@@ -75,6 +76,23 @@ struct ss_string *ss_string_create_from_cstring(const char *s) {
     return str;
 }
 
+struct ss_string *ss_string_adopt(char *str, size_t len, size_t cap) {
+    if (len > cap) return NULL;
+    if (str == NULL && cap > 0) return NULL;
+    if (len > 0 && str[len - 1] != '\0') return NULL;
+
+    struct ss_string *s = ss_string_create();
+    if (s == NULL) return NULL;
+
+    s->str = str;
+    s->len = len;
+    s->capacity = cap;
+
+    if (len == 0 && cap > 0) { str[0] = '\0'; }
+
+    return s;
+}
+
 void ss_string_free(struct ss_string **s) {
     if (s == NULL || *s == NULL) return;
     free((*s)->str);
@@ -83,10 +101,30 @@ void ss_string_free(struct ss_string **s) {
     *s = NULL;
 }
 
+size_t ss_string_dissolve(struct ss_string **s, char **out) {
+    if (s == NULL || *s == NULL || out == NULL || *out != NULL) return 0;
+
+    size_t len = ss_string_len(*s);
+    *out = (*s)->str;
+
+    (*s)->str = NULL;
+    free(*s);
+    *s = NULL;
+
+    return len;
+}
+
 void ss_string_clear(struct ss_string *s) {
     if (s == NULL || s->str == NULL) return;
 
-    memset(s->str, '\0', s->len);
+    s->str[0] = '\0';
+    s->len = 0;
+}
+
+void ss_string_secure_clear(struct ss_string *s) {
+    if (s == NULL || s->str == NULL) return;
+
+    ss_secure_zero(s->str, s->capacity);
     s->len = 0;
 }
 
@@ -163,9 +201,12 @@ bool ss_string_append_data(struct ss_string *dest, const char *src, size_t len)
 bool ss_string_append_char(struct ss_string *dest, char src) {
     if (dest == NULL || src == '\0') { return false; }
 
+    // Adjust for cleared strings - count the virtual terminator.
+    if (dest->str != NULL && dest->len == 0) { dest->len = 1; }
+
     if (dest->str == NULL) {
         // Storage was not yet allocated.
-        char *new_str = (char*) calloc('\0', 16);
+        char *new_str = (char*) calloc(16, sizeof(char));
         if (new_str == NULL) return false;
 
         dest->len = 1;
@@ -225,7 +266,203 @@ bool ss_string_append_string(
     return true;
 }
 
-const char *ss_string_as_cstring(struct ss_string *s) {
+// The length of the string's contents, not counting the null terminator.
+static size_t ss_string_content_len_(const struct ss_string *s) {
+    if (s == NULL || s->str == NULL || s->len == 0) return 0;
+    return s->len - 1;
+}
+
+// Create a string with an uninitialized buffer large enough for `len` chars
+// plus the null terminator.
+static struct ss_string *ss_string_create_for_len_(size_t len) {
+    struct ss_string *s = ss_string_create();
+    if (s == NULL || len == 0) return s;
+
+    size_t cap = next_pow_of_two(len + 1);
+    s->str = (char*) malloc(cap);
+    if (s->str == NULL) {
+        free(s);
+        return NULL;
+    }
+
+    s->capacity = cap;
+    return s;
+}
+
+// Append `len` chars to a string created by ss_string_create_for_len_.
+//
+// The caller guarantees that the buffer is large enough; the terminator is
+// written by ss_string_finish_.
+static void ss_string_copy_in_(struct ss_string *s, const char *src, size_t len)
+{
+    if (len == 0) return;
+    if (s->len == 0) { s->len = 1; }
+
+    memcpy(s->str + s->len - 1, src, len);
+    s->len += len;
+}
+
+static void ss_string_finish_(struct ss_string *s) {
+    if (s->str == NULL) return;
+    if (s->len == 0) { s->len = 1; }
+
+    s->str[s->len - 1] = '\0';
+    ss_assert(s->len <= s->capacity);
+}
+
+struct ss_string *ss_string_join(
+    const char *sep,
+    const struct ss_string **parts,
+    size_t n
+) {
+    if (parts == NULL) return NULL;
+
+    size_t sep_len = sep == NULL ? 0 : strlen(sep);
+    size_t total = n > 0 ? sep_len * (n - 1) : 0;
+    for (size_t i = 0; i < n; ++i) {
+        total += ss_string_content_len_(parts[i]);
+    }
+
+    struct ss_string *s = ss_string_create_for_len_(total);
+    if (s == NULL || total == 0) return s;
+
+    for (size_t i = 0; i < n; ++i) {
+        if (i > 0) { ss_string_copy_in_(s, sep, sep_len); }
+        if (parts[i] != NULL) {
+            ss_string_copy_in_(s, parts[i]->str,
+                ss_string_content_len_(parts[i]));
+        }
+    }
+
+    ss_string_finish_(s);
+    return s;
+}
+
+struct ss_string *ss_string_join_cstrings(
+    const char *sep,
+    const char **parts,
+    size_t n
+) {
+    if (parts == NULL) return NULL;
+
+    size_t sep_len = sep == NULL ? 0 : strlen(sep);
+    size_t total = n > 0 ? sep_len * (n - 1) : 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (parts[i] != NULL) { total += strlen(parts[i]); }
+    }
+
+    struct ss_string *s = ss_string_create_for_len_(total);
+    if (s == NULL || total == 0) return s;
+
+    for (size_t i = 0; i < n; ++i) {
+        if (i > 0) { ss_string_copy_in_(s, sep, sep_len); }
+        if (parts[i] != NULL) {
+            ss_string_copy_in_(s, parts[i], strlen(parts[i]));
+        }
+    }
+
+    ss_string_finish_(s);
+    return s;
+}
+
+struct ss_string *ss_string_concat(const char *first, ...) {
+    va_list args;
+    va_list count_args;
+    va_start(args, first);
+    va_copy(count_args, args);
+
+    size_t total = 0;
+    for (const char *p = first; p != NULL; p = va_arg(count_args, const char*))
+    {
+        total += strlen(p);
+    }
+    va_end(count_args);
+
+    struct ss_string *s = ss_string_create_for_len_(total);
+    if (s != NULL && total > 0) {
+        for (const char *p = first; p != NULL; p = va_arg(args, const char*)) {
+            ss_string_copy_in_(s, p, strlen(p));
+        }
+        ss_string_finish_(s);
+    }
+
+    va_end(args);
+    return s;
+}
+
+struct ss_string *ss_string_concat_strings(const struct ss_string *first, ...)
+{
+    va_list args;
+    va_list count_args;
+    va_start(args, first);
+    va_copy(count_args, args);
+
+    size_t total = 0;
+    for (const struct ss_string *p = first;
+        p != NULL;
+        p = va_arg(count_args, const struct ss_string*)
+    ) {
+        total += ss_string_content_len_(p);
+    }
+    va_end(count_args);
+
+    struct ss_string *s = ss_string_create_for_len_(total);
+    if (s != NULL && total > 0) {
+        for (const struct ss_string *p = first;
+            p != NULL;
+            p = va_arg(args, const struct ss_string*)
+        ) {
+            ss_string_copy_in_(s, p->str, ss_string_content_len_(p));
+        }
+        ss_string_finish_(s);
+    }
+
+    va_end(args);
+    return s;
+}
+
+bool ss_string_reserve(struct ss_string *s, size_t n) {
+    if (s == NULL) return false;
+
+    size_t required = ss_string_content_len_(s) + n + 1;
+    if (required > s->capacity) {
+        size_t new_cap = next_pow_of_two(required);
+        char *new_str = (char*) realloc(s->str, new_cap);
+        if (new_str == NULL) return false;
+
+        s->str = new_str;
+        s->capacity = new_cap;
+    }
+
+    if (s->len == 0) {
+        s->len = 1;
+        s->str[0] = '\0';
+    }
+
+    return true;
+}
+
+char *ss_string_spare(struct ss_string *s, size_t *avail) {
+    if (s == NULL || avail == NULL || s->str == NULL || s->len == 0) {
+        return NULL;
+    }
+    if (s->capacity <= s->len) { *avail = 0; return NULL; }
+
+    *avail = s->capacity - s->len;
+    return s->str + s->len - 1;
+}
+
+bool ss_string_commit(struct ss_string *s, size_t n) {
+    if (s == NULL || s->str == NULL || s->len == 0) return false;
+    if (n > s->capacity - s->len) return false;
+
+    s->len += n;
+    s->str[s->len - 1] = '\0';
+
+    return true;
+}
+
+const char *ss_string_as_cstring(const struct ss_string *s) {
     if (s == NULL) return NULL;
     return s->str;
 }
@@ -245,3 +482,36 @@ int ss_string_cmp(const struct ss_string *s1, const struct ss_string *s2) {
         : strcmp(s1->str, s2->str);
 }
 
+uint64_t ss_string_hash(const struct ss_string *s) {
+    return ss_string_hash_data(
+        ss_string_content_len_(s) == 0 ? NULL : s->str,
+        ss_string_content_len_(s)
+    );
+}
+
+uint64_t ss_string_hash_data(const char *data, size_t len) {
+    const uint64_t k1 = 0x9E3779B97F4A7C15ull;
+    const uint64_t k2 = 0xC2B2AE3D27D4EB4Full;
+
+    uint64_t h = (uint64_t) len * k1;
+    size_t i = 0;
+
+    // Hash a word at a time.
+    for (; i + sizeof(uint64_t) <= len; i += sizeof(uint64_t)) {
+        uint64_t word = 0;
+        memcpy(&word, data + i, sizeof(uint64_t));
+
+        word *= k2;
+        word ^= word >> 31;
+        h = (h ^ word) * k1;
+        h = (h << 27) | (h >> 37);
+    }
+
+    if (i < len) {
+        uint64_t word = 0;
+        memcpy(&word, data + i, len - i);
+        h = (h ^ (word * k2)) * k1;
+    }
+
+    return ss_hash_mix(h);
+}
@@ -0,0 +1,327 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public License,
+ * v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ * obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef _POSIX_C_SOURCE
+    #define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "ss_string.h"
+#include "ss_string_io.h"
+
+#ifdef USE_SS_LIB_ASSERT
+    #include "ss_assert.h"
+#else
+    #include <assert.h>
+
+    #define ss_check(EXPR, MSG) assert(EXPR)
+    #define ss_assert assert
+    #define ss_assert_msg(EXPR, ...) assert(EXPR)
+#endif
+
+// The smallest amount of spare capacity to read into at once.
+#define SS_READ_CHUNK 4096
+
+#define SS_LINE_READER_DEFAULT_SIZE 8192
+
+struct ss_file_view {
+    void *map;
+    size_t len;
+};
+
+struct ss_line_reader {
+    int fd;
+    char *buf;
+    size_t capacity;
+    // The start of unread data in buf
+    size_t pos;
+    // The end of valid data in buf
+    size_t end;
+    bool eof;
+    bool failed;
+};
+
+bool ss_string_read_fd(struct ss_string *dest, int fd) {
+    if (dest == NULL || fd < 0) return false;
+
+    while (true) {
+        size_t avail = 0;
+        char *spare = ss_string_spare(dest, &avail);
+
+        if (spare == NULL || avail == 0) {
+            // Grow geometrically, but by at least one chunk.
+            size_t grow = ss_string_len(dest);
+            if (grow < SS_READ_CHUNK) { grow = SS_READ_CHUNK; }
+
+            if (! ss_string_reserve(dest, grow)) return false;
+            spare = ss_string_spare(dest, &avail);
+        }
+
+        ssize_t n = read(fd, spare, avail);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        if (n == 0) return true;
+
+        ss_string_commit(dest, (size_t) n);
+    }
+}
+
+struct ss_string *ss_string_read_file(const char *path) {
+    if (path == NULL) return NULL;
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return NULL;
+
+    struct ss_string *s = ss_string_create();
+    if (s == NULL) {
+        close(fd);
+        return NULL;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        // One extra char lets the final read see end-of-file without growing
+        // the buffer.
+        if (! ss_string_reserve(s, (size_t) st.st_size + 1)) {
+            ss_string_free(&s);
+            close(fd);
+            return NULL;
+        }
+    }
+
+    if (! ss_string_read_fd(s, fd)) {
+        ss_string_free(&s);
+    }
+
+    close(fd);
+    return s;
+}
+
+struct ss_file_view *ss_file_view_open(const char *path) {
+    if (path == NULL) return NULL;
+
+    struct ss_file_view *view =
+        (struct ss_file_view*) malloc(sizeof(struct ss_file_view));
+    if (view == NULL) return NULL;
+
+    view->map = NULL;
+    view->len = 0;
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        free(view);
+        return NULL;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        free(view);
+        return NULL;
+    }
+
+    // mmap rejects zero-length mappings; an empty file is an empty view.
+    if (st.st_size > 0) {
+        void *map = mmap(NULL, (size_t) st.st_size, PROT_READ, MAP_PRIVATE,
+            fd, 0);
+        if (map == MAP_FAILED) {
+            close(fd);
+            free(view);
+            return NULL;
+        }
+
+        view->map = map;
+        view->len = (size_t) st.st_size;
+    }
+
+    // The mapping remains valid after the descriptor is closed.
+    close(fd);
+    return view;
+}
+
+void ss_file_view_close(struct ss_file_view **view) {
+    if (view == NULL || *view == NULL) return;
+
+    if ((*view)->map != NULL) {
+        munmap((*view)->map, (*view)->len);
+        (*view)->map = NULL;
+    }
+
+    free(*view);
+    *view = NULL;
+}
+
+const char *ss_file_view_data(const struct ss_file_view *view) {
+    if (view == NULL) return NULL;
+    return (const char*) view->map;
+}
+
+size_t ss_file_view_len(const struct ss_file_view *view) {
+    if (view == NULL) return 0;
+    return view->len;
+}
+
+struct ss_line_reader *ss_line_reader_create(int fd, size_t buf_size) {
+    struct ss_line_reader *reader =
+        (struct ss_line_reader*) malloc(sizeof(struct ss_line_reader));
+    if (reader == NULL) return NULL;
+
+    if (buf_size == 0) { buf_size = SS_LINE_READER_DEFAULT_SIZE; }
+
+    reader->buf = (char*) malloc(buf_size);
+    if (reader->buf == NULL) {
+        free(reader);
+        return NULL;
+    }
+
+    reader->fd = fd;
+    reader->capacity = buf_size;
+    reader->pos = 0;
+    reader->end = 0;
+    reader->eof = false;
+    reader->failed = false;
+
+    return reader;
+}
+
+void ss_line_reader_free(struct ss_line_reader **reader) {
+    if (reader == NULL || *reader == NULL) return;
+
+    free((*reader)->buf);
+    (*reader)->buf = NULL;
+    free(*reader);
+    *reader = NULL;
+}
+
+// Read more data into the buffer, making room by discarding consumed data or by
+// growing the buffer.
+//
+// Returns false at end-of-file or on error.
+static bool ss_line_reader_fill_(struct ss_line_reader *reader) {
+    if (reader->pos > 0) {
+        memmove(reader->buf, reader->buf + reader->pos,
+            reader->end - reader->pos);
+        reader->end -= reader->pos;
+        reader->pos = 0;
+    }
+
+    if (reader->end == reader->capacity) {
+        size_t new_cap = reader->capacity * 2;
+        char *buf = (char*) realloc(reader->buf, new_cap);
+        if (buf == NULL) {
+            reader->failed = true;
+            return false;
+        }
+
+        reader->buf = buf;
+        reader->capacity = new_cap;
+    }
+
+    while (true) {
+        ssize_t n = read(reader->fd, reader->buf + reader->end,
+            reader->capacity - reader->end);
+
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            reader->failed = true;
+            return false;
+        }
+        if (n == 0) {
+            reader->eof = true;
+            return false;
+        }
+
+        reader->end += (size_t) n;
+        return true;
+    }
+}
+
+bool ss_line_reader_next(
+    struct ss_line_reader *reader,
+    const char **line,
+    size_t *len
+) {
+    if (reader == NULL || line == NULL || len == NULL) return false;
+    if (reader->failed) return false;
+
+    // Only the bytes not yet scanned are searched after each fill.
+    size_t scanned = 0;
+
+    while (true) {
+        const char *start = reader->buf + reader->pos;
+        size_t unread = reader->end - reader->pos;
+        const char *nl = (const char*)
+            memchr(start + scanned, '\n', unread - scanned);
+
+        if (nl != NULL) {
+            *line = start;
+            *len = (size_t) (nl - start);
+            reader->pos += *len + 1;
+            return true;
+        }
+
+        scanned = unread;
+
+        if (reader->eof || ! ss_line_reader_fill_(reader)) {
+            if (reader->failed || reader->end == reader->pos) return false;
+
+            // The last line has no terminating newline.
+            *line = reader->buf + reader->pos;
+            *len = reader->end - reader->pos;
+            reader->pos = reader->end;
+            return true;
+        }
+    }
+}
+
+bool ss_line_reader_failed(const struct ss_line_reader *reader) {
+    return reader == NULL || reader->failed;
+}
+
+struct ss_line_iter ss_line_iter_create(const char *data, size_t len) {
+    struct ss_line_iter iter = {
+        .data_ = data,
+        .len_ = data == NULL ? 0 : len,
+        .pos_ = 0
+    };
+    return iter;
+}
+
+bool ss_line_iter_next(struct ss_line_iter *iter, const char **line, size_t *len)
+{
+    if (iter == NULL || line == NULL || len == NULL) return false;
+    if (iter->pos_ >= iter->len_) return false;
+
+    const char *start = iter->data_ + iter->pos_;
+    size_t remaining = iter->len_ - iter->pos_;
+    const char *nl = (const char*) memchr(start, '\n', remaining);
+
+    *line = start;
+    if (nl == NULL) {
+        *len = remaining;
+        iter->pos_ = iter->len_;
+    } else {
+        *len = (size_t) (nl - start);
+        iter->pos_ += *len + 1;
+    }
+
+    return true;
+}
+
+#endif
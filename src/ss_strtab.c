@@ -0,0 +1,228 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public License,
+ * v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ * obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ss_array.h"
+#include "ss_math.h"
+#include "ss_strtab.h"
+#include "ss_string.h"
+
+#ifdef USE_SS_LIB_ASSERT
+    #include "ss_assert.h"
+#else
+    #include <assert.h>
+
+    #define ss_check(EXPR, MSG) assert(EXPR)
+    #define ss_assert assert
+    #define ss_assert_msg(EXPR, ...) assert(EXPR)
+#endif
+
+DECLARE_ARRAY2(size_t, strtab_offsets)
+GENERATE_ARRAY2(size_t, strtab_offsets)
+
+struct ss_strtab {
+    char *data;
+    // The number of chars used in data, including null terminators
+    size_t len;
+    size_t capacity;
+    // The end of each string (one past its null terminator) in data. Each
+    // string starts where the previous one ends.
+    struct ss_array_strtab_offsets *ends;
+};
+
+static size_t ss_strtab_start_(const struct ss_strtab *tab, size_t pos) {
+    return pos == 0 ? 0 : tab->ends->data[pos - 1];
+}
+
+struct ss_strtab *ss_strtab_create() {
+    return ss_strtab_create_with_size(0, 0);
+}
+
+struct ss_strtab *ss_strtab_create_with_size(
+    size_t num_strings,
+    size_t num_bytes
+) {
+    struct ss_strtab *tab =
+        (struct ss_strtab*) malloc(sizeof(struct ss_strtab));
+    if (tab == NULL) return NULL;
+
+    tab->data = NULL;
+    tab->len = 0;
+    tab->capacity = 0;
+    tab->ends = ss_array_strtab_offsets_create_with_size(num_strings);
+
+    if (tab->ends == NULL) {
+        free(tab);
+        return NULL;
+    }
+
+    if (num_strings > 0 || num_bytes > 0) {
+        tab->capacity = num_bytes + num_strings;
+        tab->data = (char*) malloc(tab->capacity);
+
+        if (tab->data == NULL) {
+            ss_strtab_free(&tab);
+            return NULL;
+        }
+    }
+
+    return tab;
+}
+
+void ss_strtab_free(struct ss_strtab **tab) {
+    if (tab == NULL || *tab == NULL) return;
+
+    free((*tab)->data);
+    ss_array_strtab_offsets_free(&(*tab)->ends, NULL);
+    free(*tab);
+    *tab = NULL;
+}
+
+void ss_strtab_clear(struct ss_strtab *tab) {
+    if (tab == NULL) return;
+
+    tab->len = 0;
+    tab->ends->len = 0;
+}
+
+bool ss_strtab_append(struct ss_strtab *tab, const char *data, size_t len) {
+    if (tab == NULL || (data == NULL && len > 0)) return false;
+
+    // Reserving the offset first leaves the table unchanged if either
+    // allocation fails.
+    if (! ss_array_strtab_offsets_reserve(tab->ends, 1)) return false;
+
+    size_t required = tab->len + len + 1;
+    if (required > tab->capacity) {
+        size_t new_cap = next_pow_of_two(required);
+        char *new_data = (char*) realloc(tab->data, new_cap);
+        if (new_data == NULL) return false;
+
+        tab->data = new_data;
+        tab->capacity = new_cap;
+    }
+
+    if (len > 0) { memcpy(tab->data + tab->len, data, len); }
+    tab->data[tab->len + len] = '\0';
+    tab->len = required;
+
+    tab->ends->data[tab->ends->len] = required;
+    tab->ends->len += 1;
+
+    return true;
+}
+
+bool ss_strtab_append_cstring(struct ss_strtab *tab, const char *s) {
+    if (s == NULL) return false;
+    return ss_strtab_append(tab, s, strlen(s));
+}
+
+bool ss_strtab_append_string(struct ss_strtab *tab, const struct ss_string *s) {
+    if (s == NULL) return false;
+
+    size_t len = ss_string_len(s);
+    if (len == 0) return ss_strtab_append(tab, "", 0);
+
+    return ss_strtab_append(tab, ss_string_as_cstring(s), len - 1);
+}
+
+size_t ss_strtab_len(const struct ss_strtab *tab) {
+    if (tab == NULL) return 0;
+    return tab->ends->len;
+}
+
+size_t ss_strtab_data_len(const struct ss_strtab *tab) {
+    if (tab == NULL) return 0;
+    return tab->len;
+}
+
+struct ss_strtab_view ss_strtab_get(const struct ss_strtab *tab, size_t pos) {
+    struct ss_strtab_view view = { .data = NULL, .len = 0 };
+    if (tab == NULL || pos >= tab->ends->len) return view;
+
+    size_t start = ss_strtab_start_(tab, pos);
+    view.data = tab->data + start;
+    view.len = tab->ends->data[pos] - start - 1;
+
+    return view;
+}
+
+const char *ss_strtab_cstring(const struct ss_strtab *tab, size_t pos) {
+    return ss_strtab_get(tab, pos).data;
+}
+
+static int ss_strtab_view_cmp_(const void *a, const void *b) {
+    const struct ss_strtab_view *lhs = (const struct ss_strtab_view*) a;
+    const struct ss_strtab_view *rhs = (const struct ss_strtab_view*) b;
+
+    size_t len = lhs->len < rhs->len ? lhs->len : rhs->len;
+    int cmp = len == 0 ? 0 : memcmp(lhs->data, rhs->data, len);
+    if (cmp != 0) return cmp;
+
+    return (lhs->len > rhs->len) - (lhs->len < rhs->len);
+}
+
+// Sort the strings, optionally dropping duplicates, and rewrite the table in
+// the new order.
+static bool ss_strtab_sort_(struct ss_strtab *tab, bool dedup) {
+    if (tab == NULL) return false;
+
+    size_t n = tab->ends->len;
+    if (n < 2) return true;
+
+    struct ss_strtab_view *views =
+        (struct ss_strtab_view*) malloc(n * sizeof(struct ss_strtab_view));
+    char *new_data = (char*) malloc(tab->capacity);
+
+    if (views == NULL || new_data == NULL) {
+        free(views);
+        free(new_data);
+        return false;
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        views[i] = ss_strtab_get(tab, i);
+    }
+
+    qsort(views, n, sizeof(struct ss_strtab_view), ss_strtab_view_cmp_);
+
+    // The views point into the old buffer, so the offsets can be rewritten in
+    // place.
+    size_t len = 0;
+    size_t count = 0;
+
+    for (size_t i = 0; i < n; ++i) {
+        if (dedup && count > 0
+            && ss_strtab_view_cmp_(&views[i], &views[i - 1]) == 0
+        ) {
+            continue;
+        }
+
+        memcpy(new_data + len, views[i].data, views[i].len + 1);
+        len += views[i].len + 1;
+        tab->ends->data[count++] = len;
+    }
+
+    free(views);
+    free(tab->data);
+
+    tab->data = new_data;
+    tab->len = len;
+    tab->ends->len = count;
+
+    return true;
+}
+
+bool ss_strtab_sort(struct ss_strtab *tab) {
+    return ss_strtab_sort_(tab, false);
+}
+
+bool ss_strtab_dedup(struct ss_strtab *tab) {
+    return ss_strtab_sort_(tab, true);
+}
@@ -0,0 +1,622 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public License,
+ * v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ * obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef _POSIX_C_SOURCE
+    #define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+#ifndef _WIN32
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <unistd.h>
+
+#include "ss_threadpool.h"
+
+#ifdef USE_SS_LIB_ASSERT
+    #include "ss_assert.h"
+#else
+    #include <assert.h>
+
+    #define ss_check(EXPR, MSG) assert(EXPR)
+    #define ss_assert assert
+    #define ss_assert_msg(EXPR, ...) assert(EXPR)
+#endif
+
+// The initial number of slots in a worker's deque.
+#define SS_DEQUE_INITIAL_SIZE 64
+
+// The number of times an idle worker looks for a task before sleeping.
+#define SS_THREADPOOL_SPINS 64
+
+// The number of subranges per thread that ss_parallel_for aims for when no
+// grain size is given.
+#define SS_PARALLEL_FOR_SPLITS 8
+
+struct ss_parallel_for_;
+
+struct ss_threadpool_task_ {
+    // For submitted tasks
+    void (*fn)(void *ctx);
+    void *ctx;
+    // For ss_parallel_for subranges; NULL for submitted tasks
+    struct ss_parallel_for_ *loop;
+    size_t begin;
+    size_t end;
+    // The next task in the shared queue
+    struct ss_threadpool_task_ *next;
+};
+
+struct ss_parallel_for_ {
+    void (*fn)(size_t begin, size_t end, void *ctx);
+    void *ctx;
+    size_t grain;
+    // The number of subrange tasks not yet finished
+    atomic_size_t pending;
+};
+
+// A circular buffer of deque slots. The size is a power of two.
+struct ss_deque_buf_ {
+    int64_t size;
+    // Buffers replaced by a larger one; they may still be read by thieves, so
+    // are only freed with the deque.
+    struct ss_deque_buf_ *retired;
+    _Atomic(struct ss_threadpool_task_*) slots[];
+};
+
+// A Chase-Lev work-stealing deque. The owner pushes and pops at the bottom;
+// thieves steal from the top.
+struct ss_deque_ {
+    _Atomic int64_t top;
+    _Atomic int64_t bottom;
+    _Atomic(struct ss_deque_buf_*) buf;
+};
+
+struct ss_threadpool_worker_ {
+    struct ss_threadpool *pool;
+    struct ss_deque_ deque;
+    pthread_t thread;
+    // State for choosing steal victims
+    uint32_t seed;
+};
+
+struct ss_threadpool {
+    struct ss_threadpool_worker_ *workers;
+    size_t num_threads;
+
+    // Tasks submitted from outside the pool, oldest first
+    pthread_mutex_t queue_lock;
+    struct ss_threadpool_task_ *queue_head;
+    struct ss_threadpool_task_ *queue_tail;
+
+    // Idle workers wait on `wake` while holding `sleep_lock`
+    pthread_mutex_t sleep_lock;
+    pthread_cond_t wake;
+    atomic_size_t num_sleeping;
+    atomic_bool stop;
+
+    // The number of submitted tasks not yet finished
+    atomic_size_t unfinished;
+};
+
+// The worker running on the current thread, if any.
+static _Thread_local struct ss_threadpool_worker_ *ss_threadpool_current_ =
+    NULL;
+
+static struct ss_deque_buf_ *ss_deque_buf_create_(int64_t size) {
+    struct ss_deque_buf_ *buf = (struct ss_deque_buf_*) malloc(
+        sizeof(struct ss_deque_buf_)
+        + (size_t) size * sizeof(struct ss_threadpool_task_*));
+    if (buf == NULL) return NULL;
+
+    buf->size = size;
+    buf->retired = NULL;
+    return buf;
+}
+
+static bool ss_deque_init_(struct ss_deque_ *deque) {
+    struct ss_deque_buf_ *buf = ss_deque_buf_create_(SS_DEQUE_INITIAL_SIZE);
+    if (buf == NULL) return false;
+
+    atomic_init(&deque->top, 0);
+    atomic_init(&deque->bottom, 0);
+    atomic_init(&deque->buf, buf);
+    return true;
+}
+
+static void ss_deque_destroy_(struct ss_deque_ *deque) {
+    struct ss_deque_buf_ *buf =
+        atomic_load_explicit(&deque->buf, memory_order_relaxed);
+
+    while (buf != NULL) {
+        struct ss_deque_buf_ *retired = buf->retired;
+        free(buf);
+        buf = retired;
+    }
+}
+
+// Push a task onto the bottom of the deque. Only the owner may push.
+static bool ss_deque_push_(
+    struct ss_deque_ *deque,
+    struct ss_threadpool_task_ *task
+) {
+    int64_t b = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+    int64_t t = atomic_load_explicit(&deque->top, memory_order_acquire);
+    struct ss_deque_buf_ *buf =
+        atomic_load_explicit(&deque->buf, memory_order_relaxed);
+
+    if (b - t > buf->size - 1) {
+        struct ss_deque_buf_ *bigger = ss_deque_buf_create_(buf->size * 2);
+        if (bigger == NULL) return false;
+
+        for (int64_t i = t; i < b; ++i) {
+            atomic_store_explicit(&bigger->slots[i & (bigger->size - 1)],
+                atomic_load_explicit(&buf->slots[i & (buf->size - 1)],
+                    memory_order_relaxed),
+                memory_order_relaxed);
+        }
+
+        bigger->retired = buf;
+        atomic_store_explicit(&deque->buf, bigger, memory_order_release);
+        buf = bigger;
+    }
+
+    atomic_store_explicit(&buf->slots[b & (buf->size - 1)], task,
+        memory_order_relaxed);
+    // Publish the task to thieves, which load bottom with acquire.
+    atomic_store_explicit(&deque->bottom, b + 1, memory_order_release);
+
+    return true;
+}
+
+// Pop a task from the bottom of the deque. Only the owner may pop.
+static struct ss_threadpool_task_ *ss_deque_pop_(struct ss_deque_ *deque) {
+    int64_t b = atomic_load_explicit(&deque->bottom, memory_order_relaxed) - 1;
+    struct ss_deque_buf_ *buf =
+        atomic_load_explicit(&deque->buf, memory_order_relaxed);
+
+    atomic_store_explicit(&deque->bottom, b, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    int64_t t = atomic_load_explicit(&deque->top, memory_order_relaxed);
+
+    if (t > b) {
+        // Empty
+        atomic_store_explicit(&deque->bottom, b + 1, memory_order_relaxed);
+        return NULL;
+    }
+
+    struct ss_threadpool_task_ *task = atomic_load_explicit(
+        &buf->slots[b & (buf->size - 1)], memory_order_relaxed);
+
+    if (t == b) {
+        // The last task; race any thieves for it.
+        if (! atomic_compare_exchange_strong_explicit(&deque->top, &t, t + 1,
+            memory_order_seq_cst, memory_order_relaxed)
+        ) {
+            task = NULL;
+        }
+        atomic_store_explicit(&deque->bottom, b + 1, memory_order_relaxed);
+    }
+
+    return task;
+}
+
+// Steal a task from the top of the deque. Any thread may steal.
+//
+// Returns NULL if the deque is empty or another thread took the task first.
+static struct ss_threadpool_task_ *ss_deque_steal_(struct ss_deque_ *deque) {
+    int64_t t = atomic_load_explicit(&deque->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    int64_t b = atomic_load_explicit(&deque->bottom, memory_order_acquire);
+
+    if (t >= b) return NULL;
+
+    struct ss_deque_buf_ *buf =
+        atomic_load_explicit(&deque->buf, memory_order_acquire);
+    struct ss_threadpool_task_ *task = atomic_load_explicit(
+        &buf->slots[t & (buf->size - 1)], memory_order_relaxed);
+
+    if (! atomic_compare_exchange_strong_explicit(&deque->top, &t, t + 1,
+        memory_order_seq_cst, memory_order_relaxed)
+    ) {
+        return NULL;
+    }
+
+    return task;
+}
+
+static struct ss_threadpool_worker_ *ss_threadpool_worker_(
+    struct ss_threadpool *pool
+) {
+    struct ss_threadpool_worker_ *worker = ss_threadpool_current_;
+    return worker != NULL && worker->pool == pool ? worker : NULL;
+}
+
+static void ss_threadpool_wake_(struct ss_threadpool *pool) {
+    // Pairs with the fence in ss_threadpool_sleep_: either the sleeper sees
+    // the new task, or this sees the sleeper.
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(&pool->num_sleeping, memory_order_relaxed) == 0) {
+        return;
+    }
+
+    pthread_mutex_lock(&pool->sleep_lock);
+    pthread_cond_signal(&pool->wake);
+    pthread_mutex_unlock(&pool->sleep_lock);
+}
+
+// Queue a task: on the current worker's deque if called from one of the pool's
+// workers, or else on the shared queue.
+static bool ss_threadpool_push_(
+    struct ss_threadpool *pool,
+    struct ss_threadpool_task_ *task
+) {
+    struct ss_threadpool_worker_ *worker = ss_threadpool_worker_(pool);
+
+    if (worker != NULL) {
+        if (! ss_deque_push_(&worker->deque, task)) return false;
+    } else {
+        task->next = NULL;
+
+        pthread_mutex_lock(&pool->queue_lock);
+        if (pool->queue_tail == NULL) {
+            pool->queue_head = task;
+        } else {
+            pool->queue_tail->next = task;
+        }
+        pool->queue_tail = task;
+        pthread_mutex_unlock(&pool->queue_lock);
+    }
+
+    ss_threadpool_wake_(pool);
+    return true;
+}
+
+static struct ss_threadpool_task_ *ss_threadpool_dequeue_(
+    struct ss_threadpool *pool
+) {
+    pthread_mutex_lock(&pool->queue_lock);
+
+    struct ss_threadpool_task_ *task = pool->queue_head;
+    if (task != NULL) {
+        pool->queue_head = task->next;
+        if (pool->queue_head == NULL) { pool->queue_tail = NULL; }
+    }
+
+    pthread_mutex_unlock(&pool->queue_lock);
+    return task;
+}
+
+// Find a task to run: from the worker's own deque, the shared queue, or
+// another worker's deque, in that order.
+static struct ss_threadpool_task_ *ss_threadpool_find_(
+    struct ss_threadpool *pool,
+    struct ss_threadpool_worker_ *worker
+) {
+    struct ss_threadpool_task_ *task = NULL;
+
+    if (worker != NULL) {
+        task = ss_deque_pop_(&worker->deque);
+        if (task != NULL) return task;
+    }
+
+    task = ss_threadpool_dequeue_(pool);
+    if (task != NULL) return task;
+
+    // Start from a random victim so thieves spread out.
+    size_t start = 0;
+    if (worker != NULL) {
+        uint32_t x = worker->seed;
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        worker->seed = x;
+        start = x % pool->num_threads;
+    }
+
+    for (size_t i = 0; i < pool->num_threads; ++i) {
+        struct ss_threadpool_worker_ *victim =
+            &pool->workers[(start + i) % pool->num_threads];
+        if (victim == worker) continue;
+
+        task = ss_deque_steal_(&victim->deque);
+        if (task != NULL) return task;
+    }
+
+    return NULL;
+}
+
+static void ss_parallel_for_run_(
+    struct ss_threadpool *pool,
+    struct ss_parallel_for_ *loop,
+    size_t begin,
+    size_t end
+);
+
+static void ss_threadpool_run_(
+    struct ss_threadpool *pool,
+    struct ss_threadpool_task_ *task
+) {
+    if (task->loop != NULL) {
+        struct ss_parallel_for_ *loop = task->loop;
+        ss_parallel_for_run_(pool, loop, task->begin, task->end);
+        free(task);
+        atomic_fetch_sub_explicit(&loop->pending, 1, memory_order_release);
+    } else {
+        task->fn(task->ctx);
+        free(task);
+    }
+
+    atomic_fetch_sub_explicit(&pool->unfinished, 1, memory_order_release);
+}
+
+// Sleep until woken, unless a task turns up first.
+static struct ss_threadpool_task_ *ss_threadpool_sleep_(
+    struct ss_threadpool *pool,
+    struct ss_threadpool_worker_ *worker
+) {
+    pthread_mutex_lock(&pool->sleep_lock);
+    atomic_fetch_add_explicit(&pool->num_sleeping, 1, memory_order_seq_cst);
+
+    // Look again now that pushers will see this worker as sleeping.
+    struct ss_threadpool_task_ *task = ss_threadpool_find_(pool, worker);
+    if (task == NULL && ! atomic_load(&pool->stop)) {
+        pthread_cond_wait(&pool->wake, &pool->sleep_lock);
+    }
+
+    atomic_fetch_sub_explicit(&pool->num_sleeping, 1, memory_order_relaxed);
+    pthread_mutex_unlock(&pool->sleep_lock);
+
+    return task;
+}
+
+static void *ss_threadpool_work_(void *arg) {
+    struct ss_threadpool_worker_ *worker = (struct ss_threadpool_worker_*) arg;
+    struct ss_threadpool *pool = worker->pool;
+    ss_threadpool_current_ = worker;
+
+    while (true) {
+        struct ss_threadpool_task_ *task = NULL;
+
+        for (size_t i = 0; i < SS_THREADPOOL_SPINS && task == NULL; ++i) {
+            task = ss_threadpool_find_(pool, worker);
+            if (task == NULL) { sched_yield(); }
+        }
+
+        if (task == NULL) {
+            if (atomic_load(&pool->stop)) break;
+            task = ss_threadpool_sleep_(pool, worker);
+        }
+
+        if (task != NULL) { ss_threadpool_run_(pool, task); }
+    }
+
+    return NULL;
+}
+
+// Run queued tasks until `*counter` reaches 0.
+static void ss_threadpool_help_until_(
+    struct ss_threadpool *pool,
+    atomic_size_t *counter
+) {
+    struct ss_threadpool_worker_ *worker = ss_threadpool_worker_(pool);
+
+    while (atomic_load_explicit(counter, memory_order_acquire) > 0) {
+        struct ss_threadpool_task_ *task = ss_threadpool_find_(pool, worker);
+
+        if (task != NULL) {
+            ss_threadpool_run_(pool, task);
+        } else {
+            sched_yield();
+        }
+    }
+}
+
+static void ss_threadpool_stop_(struct ss_threadpool *pool, size_t started) {
+    pthread_mutex_lock(&pool->sleep_lock);
+    atomic_store(&pool->stop, true);
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->sleep_lock);
+
+    for (size_t i = 0; i < started; ++i) {
+        pthread_join(pool->workers[i].thread, NULL);
+    }
+}
+
+static void ss_threadpool_destroy_(
+    struct ss_threadpool *pool,
+    size_t initialized
+) {
+    for (size_t i = 0; i < initialized; ++i) {
+        ss_deque_destroy_(&pool->workers[i].deque);
+    }
+
+    pthread_cond_destroy(&pool->wake);
+    pthread_mutex_destroy(&pool->sleep_lock);
+    pthread_mutex_destroy(&pool->queue_lock);
+    free(pool->workers);
+    free(pool);
+}
+
+size_t ss_threadpool_num_cpus(void) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    return cpus > 0 ? (size_t) cpus : 1;
+}
+
+struct ss_threadpool *ss_threadpool_create(size_t num_threads) {
+    if (num_threads == 0) { num_threads = ss_threadpool_num_cpus(); }
+
+    struct ss_threadpool *pool =
+        (struct ss_threadpool*) malloc(sizeof(struct ss_threadpool));
+    if (pool == NULL) return NULL;
+
+    pool->workers = (struct ss_threadpool_worker_*) calloc(num_threads,
+        sizeof(struct ss_threadpool_worker_));
+    if (pool->workers == NULL) {
+        free(pool);
+        return NULL;
+    }
+
+    pool->num_threads = num_threads;
+    pool->queue_head = NULL;
+    pool->queue_tail = NULL;
+    pthread_mutex_init(&pool->queue_lock, NULL);
+    pthread_mutex_init(&pool->sleep_lock, NULL);
+    pthread_cond_init(&pool->wake, NULL);
+    atomic_init(&pool->num_sleeping, 0);
+    atomic_init(&pool->stop, false);
+    atomic_init(&pool->unfinished, 0);
+
+    for (size_t i = 0; i < num_threads; ++i) {
+        pool->workers[i].pool = pool;
+        pool->workers[i].seed = (uint32_t) (2463534242u + i * 2654435761u);
+
+        if (! ss_deque_init_(&pool->workers[i].deque)) {
+            ss_threadpool_destroy_(pool, i);
+            return NULL;
+        }
+    }
+
+    for (size_t i = 0; i < num_threads; ++i) {
+        if (pthread_create(&pool->workers[i].thread, NULL,
+            ss_threadpool_work_, &pool->workers[i]) != 0
+        ) {
+            ss_threadpool_stop_(pool, i);
+            ss_threadpool_destroy_(pool, num_threads);
+            return NULL;
+        }
+    }
+
+    return pool;
+}
+
+void ss_threadpool_free(struct ss_threadpool **pool) {
+    if (pool == NULL || *pool == NULL) return;
+
+    ss_assert(ss_threadpool_worker_(*pool) == NULL);
+
+    ss_threadpool_wait(*pool);
+    ss_threadpool_stop_(*pool, (*pool)->num_threads);
+    ss_threadpool_destroy_(*pool, (*pool)->num_threads);
+    *pool = NULL;
+}
+
+size_t ss_threadpool_num_threads(const struct ss_threadpool *pool) {
+    if (pool == NULL) return 0;
+    return pool->num_threads;
+}
+
+bool ss_threadpool_submit(
+    struct ss_threadpool *pool,
+    void (*fn)(void *ctx),
+    void *ctx
+) {
+    if (pool == NULL || fn == NULL) return false;
+
+    struct ss_threadpool_task_ *task = (struct ss_threadpool_task_*) malloc(
+        sizeof(struct ss_threadpool_task_));
+    if (task == NULL) return false;
+
+    task->fn = fn;
+    task->ctx = ctx;
+    task->loop = NULL;
+
+    atomic_fetch_add_explicit(&pool->unfinished, 1, memory_order_relaxed);
+    if (! ss_threadpool_push_(pool, task)) {
+        atomic_fetch_sub_explicit(&pool->unfinished, 1, memory_order_relaxed);
+        free(task);
+        return false;
+    }
+
+    return true;
+}
+
+void ss_threadpool_wait(struct ss_threadpool *pool) {
+    if (pool == NULL) return;
+
+    // A task waiting from within the pool would wait for itself.
+    bool in_task = ss_threadpool_worker_(pool) != NULL;
+    ss_check(! in_task, "ss_threadpool_wait called from a task\n");
+    if (in_task) return;
+
+    ss_threadpool_help_until_(pool, &pool->unfinished);
+}
+
+// Split off the upper half of the range as a task until it is no longer than
+// the grain, then run what remains.
+static void ss_parallel_for_run_(
+    struct ss_threadpool *pool,
+    struct ss_parallel_for_ *loop,
+    size_t begin,
+    size_t end
+) {
+    while (end - begin > loop->grain) {
+        size_t mid = begin + (end - begin) / 2;
+
+        struct ss_threadpool_task_ *task = (struct ss_threadpool_task_*)
+            malloc(sizeof(struct ss_threadpool_task_));
+        if (task == NULL) break;
+
+        task->fn = NULL;
+        task->ctx = NULL;
+        task->loop = loop;
+        task->begin = mid;
+        task->end = end;
+
+        atomic_fetch_add_explicit(&loop->pending, 1, memory_order_relaxed);
+        atomic_fetch_add_explicit(&pool->unfinished, 1, memory_order_relaxed);
+
+        if (! ss_threadpool_push_(pool, task)) {
+            atomic_fetch_sub_explicit(&pool->unfinished, 1,
+                memory_order_relaxed);
+            atomic_fetch_sub_explicit(&loop->pending, 1, memory_order_relaxed);
+            free(task);
+            break;
+        }
+
+        end = mid;
+    }
+
+    loop->fn(begin, end, loop->ctx);
+}
+
+void ss_parallel_for(
+    struct ss_threadpool *pool,
+    size_t begin,
+    size_t end,
+    size_t grain,
+    void (*fn)(size_t begin, size_t end, void *ctx),
+    void *ctx
+) {
+    if (fn == NULL || begin >= end) return;
+
+    if (pool == NULL) {
+        fn(begin, end, ctx);
+        return;
+    }
+
+    if (grain == 0) {
+        grain = (end - begin) / (pool->num_threads * SS_PARALLEL_FOR_SPLITS);
+        if (grain == 0) { grain = 1; }
+    }
+
+    struct ss_parallel_for_ loop = {
+        .fn = fn,
+        .ctx = ctx,
+        .grain = grain
+    };
+    atomic_init(&loop.pending, 0);
+
+    ss_parallel_for_run_(pool, &loop, begin, end);
+    ss_threadpool_help_until_(pool, &loop.pending);
+}
+
+#endif
@@ -0,0 +1,455 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public License,
+ * v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ * obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "ss_cpu.h"
+#include "ss_string.h"
+#include "ss_utf8.h"
+
+#if (defined __x86_64__ || defined __i386__) && defined __GNUC__
+    #define SS_UTF8_X86
+    #include <immintrin.h>
+#endif
+
+// The valid range of the second byte of a sequence, indexed by its lead byte.
+//
+// Lead bytes that can never start a valid sequence have an empty range.
+static bool ss_utf8_second_byte_range_(
+    unsigned char lead,
+    unsigned char *lo,
+    unsigned char *hi,
+    size_t *seq_len
+) {
+    *lo = 0x80;
+    *hi = 0xBF;
+
+    if (lead >= 0xC2 && lead <= 0xDF) {
+        *seq_len = 2;
+    } else if (lead == 0xE0) {
+        *lo = 0xA0;
+        *seq_len = 3;
+    } else if (lead == 0xED) {
+        // Excludes the surrogates
+        *hi = 0x9F;
+        *seq_len = 3;
+    } else if (lead >= 0xE1 && lead <= 0xEF) {
+        *seq_len = 3;
+    } else if (lead == 0xF0) {
+        *lo = 0x90;
+        *seq_len = 4;
+    } else if (lead >= 0xF1 && lead <= 0xF3) {
+        *seq_len = 4;
+    } else if (lead == 0xF4) {
+        // Nothing above U+10FFFF
+        *hi = 0x8F;
+        *seq_len = 4;
+    } else {
+        return false;
+    }
+
+    return true;
+}
+
+// Get the length of the valid sequence at s[0], or 0 if it is invalid.
+static size_t ss_utf8_sequence_len_(const unsigned char *s, size_t len) {
+    if (s[0] < 0x80) return 1;
+
+    unsigned char lo = 0;
+    unsigned char hi = 0;
+    size_t n = 0;
+
+    if (! ss_utf8_second_byte_range_(s[0], &lo, &hi, &n)) return 0;
+    if (n > len) return 0;
+    if (s[1] < lo || s[1] > hi) return 0;
+
+    for (size_t i = 2; i < n; ++i) {
+        if ((s[i] & 0xC0) != 0x80) return 0;
+    }
+
+    return n;
+}
+
+static bool ss_utf8_validate_scalar_(const unsigned char *s, size_t len) {
+    size_t i = 0;
+
+    while (i < len) {
+        // Skip ASCII a word at a time.
+        if (len - i >= 8) {
+            uint64_t word;
+            memcpy(&word, s + i, sizeof(word));
+            if ((word & 0x8080808080808080ull) == 0) {
+                i += 8;
+                continue;
+            }
+        }
+
+        size_t n = ss_utf8_sequence_len_(s + i, len - i);
+        if (n == 0) return false;
+        i += n;
+    }
+
+    return true;
+}
+
+#ifdef SS_UTF8_X86
+
+// Find where scalar validation must resume after the vectorized validator has
+// processed `pos` bytes: the start of any sequence that the block boundary
+// splits.
+static size_t ss_utf8_resume_pos_(const unsigned char *s, size_t pos) {
+    for (size_t k = 1; k <= 3 && k <= pos; ++k) {
+        unsigned char c = s[pos - k];
+        if (c < 0x80) break;
+        if (c >= 0xC0) return pos - k;
+    }
+    return pos;
+}
+
+/* The lookup-table validator classifies each pair of adjacent bytes with
+ * three 16-entry table lookups (high nibble of the first byte, low nibble of
+ * the first byte, high nibble of the second byte); a bit that survives in all
+ * three lookups marks an error. A separate check ensures that the third and
+ * fourth bytes of long sequences are continuations.
+ *
+ * See Keiser and Lemire, "Validating UTF-8 In Less Than One Instruction Per
+ * Byte" (2021).
+ */
+
+#define SS_TOO_SHORT  (1 << 0)
+#define SS_TOO_LONG   (1 << 1)
+#define SS_OVERLONG_3 (1 << 2)
+#define SS_TOO_LARGE  (1 << 3)
+#define SS_SURROGATE  (1 << 4)
+#define SS_OVERLONG_2 (1 << 5)
+#define SS_TOO_LARGE_1000 (1 << 6)
+#define SS_OVERLONG_4 (1 << 6)
+#define SS_TWO_CONTS  (1 << 7)
+#define SS_CARRY (SS_TOO_SHORT | SS_TOO_LONG | SS_TWO_CONTS)
+
+static const uint8_t ss_utf8_byte_1_high_[16] = {
+    // 0_______ ________ <ASCII in byte 1>
+    SS_TOO_LONG, SS_TOO_LONG, SS_TOO_LONG, SS_TOO_LONG,
+    SS_TOO_LONG, SS_TOO_LONG, SS_TOO_LONG, SS_TOO_LONG,
+    // 10______ ________ <continuation in byte 1>
+    SS_TWO_CONTS, SS_TWO_CONTS, SS_TWO_CONTS, SS_TWO_CONTS,
+    // 1100____ ________ <two byte lead in byte 1>
+    SS_TOO_SHORT | SS_OVERLONG_2,
+    // 1101____ ________ <two byte lead in byte 1>
+    SS_TOO_SHORT,
+    // 1110____ ________ <three byte lead in byte 1>
+    SS_TOO_SHORT | SS_OVERLONG_3 | SS_SURROGATE,
+    // 1111____ ________ <four+ byte lead in byte 1>
+    SS_TOO_SHORT | SS_TOO_LARGE | SS_TOO_LARGE_1000 | SS_OVERLONG_4
+};
+
+static const uint8_t ss_utf8_byte_1_low_[16] = {
+    // ____0000 ________
+    SS_CARRY | SS_OVERLONG_3 | SS_OVERLONG_2 | SS_OVERLONG_4,
+    // ____0001 ________
+    SS_CARRY | SS_OVERLONG_2,
+    // ____001_ ________
+    SS_CARRY,
+    SS_CARRY,
+    // ____0100 ________
+    SS_CARRY | SS_TOO_LARGE,
+    // ____0101 ________
+    SS_CARRY | SS_TOO_LARGE | SS_TOO_LARGE_1000,
+    // ____011_ ________
+    SS_CARRY | SS_TOO_LARGE | SS_TOO_LARGE_1000,
+    SS_CARRY | SS_TOO_LARGE | SS_TOO_LARGE_1000,
+    // ____1___ ________
+    SS_CARRY | SS_TOO_LARGE | SS_TOO_LARGE_1000,
+    SS_CARRY | SS_TOO_LARGE | SS_TOO_LARGE_1000,
+    SS_CARRY | SS_TOO_LARGE | SS_TOO_LARGE_1000,
+    SS_CARRY | SS_TOO_LARGE | SS_TOO_LARGE_1000,
+    SS_CARRY | SS_TOO_LARGE | SS_TOO_LARGE_1000,
+    // ____1101 ________
+    SS_CARRY | SS_TOO_LARGE | SS_TOO_LARGE_1000 | SS_SURROGATE,
+    SS_CARRY | SS_TOO_LARGE | SS_TOO_LARGE_1000,
+    SS_CARRY | SS_TOO_LARGE | SS_TOO_LARGE_1000
+};
+
+static const uint8_t ss_utf8_byte_2_high_[16] = {
+    // ________ 0_______ <ASCII in byte 2>
+    SS_TOO_SHORT, SS_TOO_SHORT, SS_TOO_SHORT, SS_TOO_SHORT,
+    SS_TOO_SHORT, SS_TOO_SHORT, SS_TOO_SHORT, SS_TOO_SHORT,
+    // ________ 1000____
+    SS_TOO_LONG | SS_OVERLONG_2 | SS_TWO_CONTS | SS_OVERLONG_3
+        | SS_TOO_LARGE_1000 | SS_OVERLONG_4,
+    // ________ 1001____
+    SS_TOO_LONG | SS_OVERLONG_2 | SS_TWO_CONTS | SS_OVERLONG_3 | SS_TOO_LARGE,
+    // ________ 101_____
+    SS_TOO_LONG | SS_OVERLONG_2 | SS_TWO_CONTS | SS_SURROGATE | SS_TOO_LARGE,
+    SS_TOO_LONG | SS_OVERLONG_2 | SS_TWO_CONTS | SS_SURROGATE | SS_TOO_LARGE,
+    // ________ 11______
+    SS_TOO_SHORT, SS_TOO_SHORT, SS_TOO_SHORT, SS_TOO_SHORT
+};
+
+// Subtracting this from the last bytes of a block leaves a nonzero value only
+// where a sequence is still missing bytes at the end of the block.
+static const uint8_t ss_utf8_incomplete_[32] = {
+    255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 0xF0 - 1, 0xE0 - 1, 0xC0 - 1
+};
+
+__attribute__((target("ssse3")))
+static __m128i ss_utf8_check_block_ssse3_(__m128i input, __m128i prev_input) {
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+    const __m128i b1h = _mm_loadu_si128((const __m128i*) ss_utf8_byte_1_high_);
+    const __m128i b1l = _mm_loadu_si128((const __m128i*) ss_utf8_byte_1_low_);
+    const __m128i b2h = _mm_loadu_si128((const __m128i*) ss_utf8_byte_2_high_);
+
+    __m128i prev1 = _mm_alignr_epi8(input, prev_input, 15);
+    __m128i prev2 = _mm_alignr_epi8(input, prev_input, 14);
+    __m128i prev3 = _mm_alignr_epi8(input, prev_input, 13);
+
+    __m128i byte_1_high = _mm_shuffle_epi8(b1h,
+        _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble));
+    __m128i byte_1_low = _mm_shuffle_epi8(b1l, _mm_and_si128(prev1, nibble));
+    __m128i byte_2_high = _mm_shuffle_epi8(b2h,
+        _mm_and_si128(_mm_srli_epi16(input, 4), nibble));
+
+    __m128i special = _mm_and_si128(_mm_and_si128(byte_1_high, byte_1_low),
+        byte_2_high);
+
+    // Only 111_____ remains >= 0x80 after the first subtraction, and only
+    // 1111____ after the second.
+    __m128i is_third = _mm_subs_epu8(prev2, _mm_set1_epi8(0xE0 - 0x80));
+    __m128i is_fourth = _mm_subs_epu8(prev3, _mm_set1_epi8(0xF0 - 0x80));
+    __m128i must23 = _mm_and_si128(_mm_or_si128(is_third, is_fourth),
+        _mm_set1_epi8((char) 0x80));
+
+    return _mm_xor_si128(must23, special);
+}
+
+__attribute__((target("ssse3")))
+static bool ss_utf8_validate_ssse3_(const unsigned char *s, size_t len) {
+    const __m128i max_value =
+        _mm_loadu_si128((const __m128i*) (ss_utf8_incomplete_ + 16));
+
+    __m128i error = _mm_setzero_si128();
+    __m128i prev_input = _mm_setzero_si128();
+    __m128i prev_incomplete = _mm_setzero_si128();
+    size_t i = 0;
+
+    for (; len - i >= 16; i += 16) {
+        __m128i input = _mm_loadu_si128((const __m128i*) (s + i));
+
+        if (_mm_movemask_epi8(input) == 0) {
+            // An ASCII block is valid unless the previous block ended inside
+            // a sequence.
+            error = _mm_or_si128(error, prev_incomplete);
+            prev_incomplete = _mm_setzero_si128();
+        } else {
+            error = _mm_or_si128(error,
+                ss_utf8_check_block_ssse3_(input, prev_input));
+            prev_incomplete = _mm_subs_epu8(input, max_value);
+        }
+
+        prev_input = input;
+    }
+
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128()))
+        != 0xFFFF
+    ) {
+        return false;
+    }
+
+    size_t resume = ss_utf8_resume_pos_(s, i);
+    return ss_utf8_validate_scalar_(s + resume, len - resume);
+}
+
+__attribute__((target("avx2")))
+static __m256i ss_utf8_prev_avx2_(__m256i input, __m256i prev_input, int n) {
+    // The lanes of `input` shifted right by `n` bytes, filled from the end of
+    // `prev_input`.
+    __m256i shifted = _mm256_permute2x128_si256(prev_input, input, 0x21);
+
+    switch (n) {
+        case 1: return _mm256_alignr_epi8(input, shifted, 15);
+        case 2: return _mm256_alignr_epi8(input, shifted, 14);
+        default: return _mm256_alignr_epi8(input, shifted, 13);
+    }
+}
+
+__attribute__((target("avx2")))
+static __m256i ss_utf8_check_block_avx2_(__m256i input, __m256i prev_input) {
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    const __m256i b1h = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128((const __m128i*) ss_utf8_byte_1_high_));
+    const __m256i b1l = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128((const __m128i*) ss_utf8_byte_1_low_));
+    const __m256i b2h = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128((const __m128i*) ss_utf8_byte_2_high_));
+
+    __m256i prev1 = ss_utf8_prev_avx2_(input, prev_input, 1);
+    __m256i prev2 = ss_utf8_prev_avx2_(input, prev_input, 2);
+    __m256i prev3 = ss_utf8_prev_avx2_(input, prev_input, 3);
+
+    __m256i byte_1_high = _mm256_shuffle_epi8(b1h,
+        _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble));
+    __m256i byte_1_low = _mm256_shuffle_epi8(b1l,
+        _mm256_and_si256(prev1, nibble));
+    __m256i byte_2_high = _mm256_shuffle_epi8(b2h,
+        _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble));
+
+    __m256i special = _mm256_and_si256(
+        _mm256_and_si256(byte_1_high, byte_1_low), byte_2_high);
+
+    __m256i is_third = _mm256_subs_epu8(prev2, _mm256_set1_epi8(0xE0 - 0x80));
+    __m256i is_fourth = _mm256_subs_epu8(prev3, _mm256_set1_epi8(0xF0 - 0x80));
+    __m256i must23 = _mm256_and_si256(_mm256_or_si256(is_third, is_fourth),
+        _mm256_set1_epi8((char) 0x80));
+
+    return _mm256_xor_si256(must23, special);
+}
+
+__attribute__((target("avx2")))
+static bool ss_utf8_validate_avx2_(const unsigned char *s, size_t len) {
+    const __m256i max_value =
+        _mm256_loadu_si256((const __m256i*) ss_utf8_incomplete_);
+
+    __m256i error = _mm256_setzero_si256();
+    __m256i prev_input = _mm256_setzero_si256();
+    __m256i prev_incomplete = _mm256_setzero_si256();
+    size_t i = 0;
+
+    for (; len - i >= 32; i += 32) {
+        __m256i input = _mm256_loadu_si256((const __m256i*) (s + i));
+
+        if (_mm256_movemask_epi8(input) == 0) {
+            error = _mm256_or_si256(error, prev_incomplete);
+            prev_incomplete = _mm256_setzero_si256();
+        } else {
+            error = _mm256_or_si256(error,
+                ss_utf8_check_block_avx2_(input, prev_input));
+            prev_incomplete = _mm256_subs_epu8(input, max_value);
+        }
+
+        prev_input = input;
+    }
+
+    if (! _mm256_testz_si256(error, error)) return false;
+
+    size_t resume = ss_utf8_resume_pos_(s, i);
+    return ss_utf8_validate_scalar_(s + resume, len - resume);
+}
+
+#endif // SS_UTF8_X86
+
+typedef bool (*ss_utf8_validate_fn_)(const unsigned char *s, size_t len);
+
+static struct ss_cpu_dispatch ss_utf8_validate_dispatch_ = {
+    .impls = {
+        [SS_CPU_SCALAR] = (ss_cpu_fn) ss_utf8_validate_scalar_,
+#ifdef SS_UTF8_X86
+        [SS_CPU_SSSE3] = (ss_cpu_fn) ss_utf8_validate_ssse3_,
+        [SS_CPU_AVX2] = (ss_cpu_fn) ss_utf8_validate_avx2_,
+#endif
+    }
+};
+
+bool ss_utf8_validate(const char *data, size_t len) {
+    if (data == NULL) return len == 0;
+    const unsigned char *s = (const unsigned char*) data;
+
+    ss_utf8_validate_fn_ validate = (ss_utf8_validate_fn_)
+        ss_cpu_resolve(&ss_utf8_validate_dispatch_);
+    return validate(s, len);
+}
+
+size_t ss_utf8_len(const char *data, size_t len) {
+    if (data == NULL) return 0;
+
+    const unsigned char *s = (const unsigned char*) data;
+    size_t count = 0;
+    size_t i = 0;
+
+#ifdef __SSE2__
+    // Count the bytes that are not continuation bytes (10______). As signed
+    // chars, continuation bytes are the only ones below -64.
+    const __m128i threshold = _mm_set1_epi8(-65);
+    for (; len - i >= 16; i += 16) {
+        __m128i input = _mm_loadu_si128((const __m128i*) (s + i));
+        int mask = _mm_movemask_epi8(_mm_cmpgt_epi8(input, threshold));
+        count += (size_t) __builtin_popcount((unsigned int) mask);
+    }
+#endif
+
+    for (; i < len; ++i) {
+        if ((s[i] & 0xC0) != 0x80) { count += 1; }
+    }
+
+    return count;
+}
+
+struct ss_utf8_iter ss_utf8_iter_create(const char *data, size_t len) {
+    struct ss_utf8_iter iter = {
+        .data_ = data,
+        .len_ = data == NULL ? 0 : len,
+        .pos_ = 0
+    };
+    return iter;
+}
+
+bool ss_utf8_iter_next(struct ss_utf8_iter *iter, uint32_t *code_point) {
+    if (iter == NULL || code_point == NULL || iter->pos_ >= iter->len_) {
+        return false;
+    }
+
+    const unsigned char *s = (const unsigned char*) iter->data_ + iter->pos_;
+    size_t n = ss_utf8_sequence_len_(s, iter->len_ - iter->pos_);
+
+    switch (n) {
+        case 1:
+            *code_point = s[0];
+            break;
+        case 2:
+            *code_point = ((uint32_t) (s[0] & 0x1F) << 6)
+                | (uint32_t) (s[1] & 0x3F);
+            break;
+        case 3:
+            *code_point = ((uint32_t) (s[0] & 0x0F) << 12)
+                | ((uint32_t) (s[1] & 0x3F) << 6)
+                | (uint32_t) (s[2] & 0x3F);
+            break;
+        case 4:
+            *code_point = ((uint32_t) (s[0] & 0x07) << 18)
+                | ((uint32_t) (s[1] & 0x3F) << 12)
+                | ((uint32_t) (s[2] & 0x3F) << 6)
+                | (uint32_t) (s[3] & 0x3F);
+            break;
+        default:
+            *code_point = SS_UTF8_REPLACEMENT_CHAR;
+            n = 1;
+    }
+
+    iter->pos_ += n;
+    return true;
+}
+
+// The string's contents, not counting the null terminator.
+static size_t ss_utf8_string_len_(const struct ss_string *s) {
+    size_t len = ss_string_len(s);
+    return len == 0 ? 0 : len - 1;
+}
+
+bool ss_string_utf8_validate(const struct ss_string *s) {
+    return ss_utf8_validate(ss_string_as_cstring(s), ss_utf8_string_len_(s));
+}
+
+size_t ss_string_utf8_len(const struct ss_string *s) {
+    return ss_utf8_len(ss_string_as_cstring(s), ss_utf8_string_len_(s));
+}
+
+struct ss_utf8_iter ss_string_utf8_iter(const struct ss_string *s) {
+    return ss_utf8_iter_create(ss_string_as_cstring(s), ss_utf8_string_len_(s));
+}
@@ -1,9 +1,34 @@
 #ifdef SS_LIB_RUN_TESTS
 
+// Some tests use POSIX functions.
+#ifndef _POSIX_C_SOURCE
+    #define _POSIX_C_SOURCE 200809L
+#endif
+
 #include <stdio.h>
 
 #include "test_array.h"
+#include "test_array_hash.h"
+#include "test_array_io.h"
+#include "test_array_numeric.h"
+#include "test_array_parallel.h"
+#include "test_array_pipeline.h"
+#include "test_array_sorted.h"
+#include "test_bitset.h"
+#include "test_bloom.h"
+#include "test_concurrent_array.h"
+#include "test_cpu.h"
+#include "test_encoding.h"
+#include "test_heap.h"
+#include "test_multisearch.h"
+#include "test_queue.h"
+#include "test_rcstring.h"
+#include "test_rope.h"
 #include "test_string.h"
+#include "test_string_io.h"
+#include "test_strtab.h"
+#include "test_threadpool.h"
+#include "test_utf8.h"
 
 
 #define run(F) run_test(#F, F)
@@ -20,7 +45,10 @@ static void ss_array_tests() {
     run(default_array_is_empty);
     run(create_empty_array_with_set_capacity);
     run(create_array_from_data);
+    run(create_array_adopting_buffer);
+    run(dissolve_and_adopt_array);
     run(clearing_array_leaves_buffer_valid);
+    run(secure_clear_zeroes_array_buffer);
     run(append_data_to_array);
     run(append_data_to_new_array);
     run(append_array);
@@ -41,7 +69,36 @@ static void ss_array_tests() {
     run(get_reference_to_element);
     run(get_array_length);
     run(check_whether_array_is_empty);
+    run(take_slice_of_array);
+    run(partition_slice);
+    run(sort_array);
+    run(sort_slice_of_array);
+    run(find_in_array);
+    run(reduce_array);
     run(call_free_function_on_elements);
+    run(parallel_sort_array);
+    run(parallel_sort_slice);
+    run(parallel_partition_array);
+    run(parallel_for_each_array);
+    run(parallel_reduce_array);
+    run(search_sorted_array);
+    run(unique_sorted_array);
+    run(merge_sorted_arrays);
+    run(search_array_index);
+    run(collect_array_pipeline);
+    run(reduce_array_pipeline);
+    run(save_and_load_array);
+    run(load_corrupt_array_file);
+    run(map_array_file);
+    run(dedup_array);
+    run(dedup_array_of_strings);
+    run(group_array_by_key);
+    run(sum_and_dot_numeric_arrays);
+    run(min_max_of_numeric_arrays);
+    run(find_and_count_in_numeric_arrays);
+    run(append_to_concurrent_array);
+    run(reserve_and_commit_concurrent_array);
+    run(append_to_concurrent_array_from_threads);
 }
 
 static void ss_string_tests() {
@@ -49,6 +106,8 @@ static void ss_string_tests() {
     run(create_empty_string_with_set_capacity);
     run(create_string_from_cstring);
     run(clearing_string_leaves_buffer_valid);
+    run(secure_clear_zeroes_string_buffer);
+    run(append_after_clear_reuses_buffer);
     run(append_cstring);
     run(append_cstring_to_new_string);
     run(append_data_to_string);
@@ -61,11 +120,119 @@ static void ss_string_tests() {
     run(get_string_length);
     run(check_whether_string_is_empty);
     run(compare_strings);
+    run(join_strings);
+    run(join_cstrings);
+    run(concat_cstrings);
+    run(concat_strings);
+    run(dissolve_string);
+    run(adopt_string_buffer);
+    run(reserve_and_commit_spare_capacity);
+    run(hash_strings);
+    run(read_file_into_string);
+    run(read_fd_appends_to_string);
+    run(map_file_view);
+    run(read_lines_from_fd);
+    run(iterate_lines_of_buffer);
+    run(validate_utf8_samples_at_every_offset);
+    run(validate_long_multibyte_utf8);
+    run(count_utf8_code_points);
+    run(iterate_utf8_code_points);
+    run(append_hex_to_string);
+    run(append_base64_to_string);
+    run(append_json_escaped_to_string);
+    run(append_csv_field_to_string);
+    run(decode_hex_into_byte_array);
+    run(decode_base64_into_byte_array);
+    run(encoding_round_trips);
+}
+
+static void ss_rope_tests() {
+    run(default_rope_is_empty);
+    run(insert_into_rope);
+    run(delete_from_rope);
+    run(rope_substring);
+    run(concat_ropes);
+    run(concat_many_small_ropes);
+    run(iterate_rope_chunks);
+    run(flatten_rope_to_string);
+    run(many_rope_edits_match_flat_buffer);
+}
+
+static void ss_strtab_tests() {
+    run(default_strtab_is_empty);
+    run(append_to_strtab);
+    run(sort_strtab);
+    run(dedup_strtab);
+}
+
+static void ss_multisearch_tests() {
+    run(create_multisearch);
+    run(find_all_overlapping_matches);
+    run(scan_string_with_callback);
+    run(multisearch_matches_naive_search);
+}
+
+static void ss_rcstring_tests() {
+    run(create_rcstring_from_cstring);
+    run(create_rcstring_from_string_takes_buffer);
+    run(retain_and_release_rcstring);
+    run(compare_rcstrings);
+}
+
+static void ss_bitset_tests() {
+    run(set_and_test_bits);
+    run(iterate_set_bits);
+    run(combine_bitsets);
+}
+
+static void ss_cpu_tests() {
+    run(detect_cpu_features);
+    run(dispatch_cpu_kernels);
+    run(run_cpu_kernels_at_each_level);
+}
+
+static void ss_bloom_tests() {
+    run(create_bloom_filter);
+    run(bloom_filter_false_positive_rate);
+    run(bloom_filter_batches);
+    run(union_bloom_filters);
+}
+
+static void ss_heap_tests() {
+    run(push_and_pop_heap);
+    run(heapify_array);
+    run(dary_heap);
+    run(heap_top_k);
+}
+
+static void ss_queue_tests() {
+    run(spsc_queue_push_and_pop);
+    run(spsc_queue_between_threads);
+    run(mpmc_queue_push_and_pop);
+    run(mpmc_queue_between_threads);
+}
+
+static void ss_threadpool_tests() {
+    run(create_threadpool);
+    run(submit_tasks_and_wait);
+    run(parallel_for_covers_range);
+    run(parallel_for_without_pool);
+    run(nested_parallel_for);
 }
 
 int main() {
     ss_array_tests();
     ss_string_tests();
+    ss_rope_tests();
+    ss_rcstring_tests();
+    ss_multisearch_tests();
+    ss_strtab_tests();
+    ss_threadpool_tests();
+    ss_queue_tests();
+    ss_heap_tests();
+    ss_bitset_tests();
+    ss_bloom_tests();
+    ss_cpu_tests();
 
     printf("\nSuccessfully ran %i tests.\n", num_run);
 }
@@ -1,6 +1,8 @@
 #ifndef SS_LIB_TEST_ARRAY
 #define SS_LIB_TEST_ARRAY
 
+#include <stdint.h>
+
 #include "ss_array.h"
 #include "ss_assert.h"
 
@@ -9,7 +11,8 @@ GENERATE_ARRAY(int)
 
 typedef struct S { int a; int b; } S;
 DECLARE_ARRAY2(S, s)
-GENERATE_ARRAY2(S, s)
+DECLARE_ARRAY_SLICE2(S, s)
+DEFINE_ARRAY2(S, s)
 
 typedef struct S2 { int *buf; } S2;
 GENERATE_ARRAY2(S2, s2);
@@ -45,7 +48,7 @@ void create_array_from_data() {
 
     S a = { .a = 1, .b = 1 };
     S b = { .a = 2, .b = 2 };
-    S *ss = { &a, &b };
+    S ss[] = { a, b };
 
     struct ss_array_int *int_array = ss_array_int_create_from(ints, 4);
     struct ss_array_s *s_array = ss_array_s_create_from(ss, 2);
@@ -66,6 +69,43 @@ void create_array_from_data() {
     ss_array_s_free(&s_array, NULL);
 }
 
+void create_array_adopting_buffer() {
+    int *buf = (int*) malloc(sizeof(int) * 8);
+    for (int i = 0; i < 4; ++i) { buf[i] = i + 1; }
+
+    struct ss_array_int *array = ss_array_int_create_adopt(buf, 4, 8);
+    ss_assert(array != NULL);
+    ss_assert(array->data == buf);
+    ss_assert(array->len == 4);
+    ss_assert(array->capacity == 8 * sizeof(int));
+
+    // Appending within the adopted capacity does not reallocate.
+    int more[] = { 5, 6 };
+    ss_assert(ss_array_int_append_data(array, more, 2));
+    ss_assert(array->data == buf && array->data[5] == 6);
+
+    ss_assert(ss_array_int_create_adopt(buf, 9, 8) == NULL);
+    ss_assert(ss_array_int_create_adopt(NULL, 0, 4) == NULL);
+
+    ss_array_int_free(&array, NULL);
+}
+
+void dissolve_and_adopt_array() {
+    int ints[] = { 1, 2, 3 };
+    struct ss_array_int *array = ss_array_int_create_from(ints, 3);
+
+    int *buf = NULL;
+    size_t len = ss_array_int_dissolve(&array, &buf);
+    ss_assert(array == NULL);
+    ss_assert(len == 3 && buf[2] == 3);
+
+    array = ss_array_int_create_adopt(buf, len, len);
+    ss_assert(array->data == buf);
+    ss_assert(ss_array_int_len(array) == 3);
+
+    ss_array_int_free(&array, NULL);
+}
+
 void clearing_array_leaves_buffer_valid() {
     int ints[] = { 1, 2, 3, 4 };
     struct ss_array_int *array = ss_array_int_create_from(ints, 4);
@@ -81,6 +121,30 @@ void clearing_array_leaves_buffer_valid() {
     ss_array_int_free(&array, NULL);
 }
 
+void secure_clear_zeroes_array_buffer() {
+    int ints[] = { 1, 2, 3, 4, 5 };
+    struct ss_array_int *array = ss_array_int_create_from(ints, 5);
+    ss_assert(ss_array_int_reserve(array, 100));
+    size_t cap = array->capacity;
+    int *data = array->data;
+
+    ss_array_int_secure_clear(array);
+    ss_assert(array->len == 0);
+    ss_assert(array->capacity == cap);
+    ss_assert(array->data == data);
+
+    for (size_t i = 0; i < cap / sizeof(int); ++i) {
+        ss_assert(array->data[i] == 0);
+    }
+
+    ss_array_int_free(&array, NULL);
+
+    array = ss_array_int_create();
+    ss_array_int_secure_clear(array);
+    ss_assert(array->len == 0);
+    ss_array_int_free(&array, NULL);
+}
+
 void append_data_to_array() {
     int ints_[] = { 1, 2, 3, 4 };
     int *ints = (int*) malloc(sizeof(int) * 4);
@@ -235,7 +299,7 @@ void array_partition_odd_elems() {
 
 void array_partition_even_elems() {
     int elems[8] = { 9, 2, 3, 8, 4, 7, 5, 6 };
-    struct ss_array_int *array = ss_array_int_create_from(elems, 9);
+    struct ss_array_int *array = ss_array_int_create_from(elems, 8);
 
     int *partition = ss_array_int_partition(array, &less_eq_five);
 
@@ -243,7 +307,7 @@ void array_partition_even_elems() {
     for (i = 0; &array->data[i] != partition; ++i) {
         ss_assert(array->data[i] <= 5);
     }
-    for (i += 1; i < 9; ++i) {
+    for (i += 1; i < 8; ++i) {
         ss_assert(array->data[i] > 5);
     }
 
@@ -419,6 +483,129 @@ void check_whether_array_is_empty() {
     ss_array_int_free(&array, NULL);
 }
 
+void take_slice_of_array() {
+    int elems[6] = { 1, 2, 3, 4, 5, 6 };
+    struct ss_array_int *array = ss_array_int_create_from(elems, 6);
+
+    struct ss_slice_int slice = ss_array_int_slice(array, 1, 4);
+    ss_assert(slice.len == 3);
+    ss_assert(slice.data == &array->data[1]);
+
+    struct ss_slice_int sub = ss_slice_int_subslice(slice, 1, 3);
+    ss_assert(sub.len == 2 && sub.data[0] == 3 && sub.data[1] == 4);
+
+    ss_assert(ss_array_int_slice(array, 4, 7).data == NULL);
+    ss_assert(ss_array_int_slice(array, 4, 3).len == 0);
+    ss_assert(ss_slice_int_subslice(slice, 0, 4).data == NULL);
+    ss_assert(ss_array_int_as_slice(array).len == 6);
+
+    ss_array_int_free(&array, NULL);
+}
+
+void partition_slice() {
+    int elems[8] = { 9, 9, 2, 8, 1, 7, 9, 9 };
+    struct ss_array_int *array = ss_array_int_create_from(elems, 8);
+
+    // Only the middle is partitioned.
+    struct ss_slice_int slice = ss_array_int_slice(array, 2, 6);
+    int *partition = ss_slice_int_partition(slice, &less_eq_five);
+    ss_assert(partition == &array->data[4]);
+
+    ss_assert(array->data[2] <= 5 && array->data[3] <= 5);
+    ss_assert(array->data[4] > 5 && array->data[5] > 5);
+    ss_assert(array->data[0] == 9 && array->data[7] == 9);
+
+    struct ss_slice_int empty = ss_array_int_slice(array, 3, 3);
+    ss_assert(ss_slice_int_partition(empty, &less_eq_five) == empty.data);
+
+    ss_array_int_free(&array, NULL);
+}
+
+int cmp_int(const int *a, const int *b) { return (*a > *b) - (*a < *b); }
+
+void sort_array() {
+    struct ss_array_int *array = ss_array_int_create();
+    uint32_t r = 1;
+
+    // Enough elements for the quicksort path, with many duplicates.
+    for (size_t i = 0; i < 1000; ++i) {
+        r = r * 1103515245u + 12345u;
+        int elem = (int) ((r >> 16) % 100);
+        ss_array_int_append_data(array, &elem, 1);
+    }
+
+    ss_array_int_sort(array, &cmp_int);
+    for (size_t i = 1; i < 1000; ++i) {
+        ss_assert(array->data[i - 1] <= array->data[i]);
+    }
+
+    // Sorted and reverse-sorted input
+    int elems[100];
+    for (int i = 0; i < 100; ++i) { elems[i] = 100 - i; }
+
+    struct ss_slice_int slice = { .data = elems, .len = 100 };
+    ss_slice_int_sort(slice, &cmp_int);
+    ss_slice_int_sort(slice, &cmp_int);
+    for (int i = 0; i < 100; ++i) { ss_assert(elems[i] == i + 1); }
+
+    ss_array_int_free(&array, NULL);
+}
+
+void sort_slice_of_array() {
+    int elems[6] = { 6, 5, 4, 3, 2, 1 };
+    struct ss_array_int *array = ss_array_int_create_from(elems, 6);
+
+    ss_slice_int_sort(ss_array_int_slice(array, 1, 5), &cmp_int);
+
+    int expected[6] = { 6, 2, 3, 4, 5, 1 };
+    ss_assert(memcmp(array->data, expected, sizeof(expected)) == 0);
+
+    ss_array_int_free(&array, NULL);
+}
+
+bool is_even(const int *i) { return *i % 2 == 0; }
+
+void find_in_array() {
+    int elems[5] = { 1, 3, 4, 5, 6 };
+    struct ss_array_int *array = ss_array_int_create_from(elems, 5);
+
+    ss_assert(ss_array_int_find(array, &is_even) == &array->data[2]);
+    ss_assert(ss_slice_int_find(ss_array_int_slice(array, 3, 5), &is_even)
+        == &array->data[4]);
+    ss_assert(ss_slice_int_find(ss_array_int_slice(array, 0, 2), &is_even)
+        == NULL);
+
+    ss_array_int_free(&array, NULL);
+}
+
+int add_int(int acc, const int *elem) { return acc + *elem; }
+
+S add_s(S acc, const S *elem) {
+    acc.a += elem->a;
+    acc.b += elem->b;
+    return acc;
+}
+
+void reduce_array() {
+    int elems[5] = { 1, 2, 3, 4, 5 };
+    struct ss_array_int *array = ss_array_int_create_from(elems, 5);
+
+    ss_assert(ss_array_int_reduce(array, 0, &add_int) == 15);
+    ss_assert(ss_slice_int_reduce(ss_array_int_slice(array, 1, 3), 10,
+        &add_int) == 15);
+    ss_assert(ss_slice_int_reduce(ss_array_int_slice(array, 2, 2), 7,
+        &add_int) == 7);
+
+    S ss[] = { { .a = 1, .b = 2 }, { .a = 3, .b = 4 } };
+    struct ss_array_s *s_array = ss_array_s_create_from(ss, 2);
+    S zero = { .a = 0, .b = 0 };
+    S sum = ss_array_s_reduce(s_array, zero, &add_s);
+    ss_assert(sum.a == 4 && sum.b == 6);
+
+    ss_array_s_free(&s_array, NULL);
+    ss_array_int_free(&array, NULL);
+}
+
 void free_struct_s2(S2** s) {
     free((*s)->buf);
     (*s)->buf = NULL;
@@ -0,0 +1,121 @@
+#ifndef SS_LIB_TEST_ARRAY_HASH
+#define SS_LIB_TEST_ARRAY_HASH
+
+#include <stdint.h>
+#include <string.h>
+
+#include "ss_array.h"
+#include "ss_array_hash.h"
+#include "ss_assert.h"
+#include "ss_string.h"
+#include "test_array.h"
+
+GENERATE_ARRAY_HASH(int, SS_ARRAY_HASH_SCALAR, SS_ARRAY_EQ_SCALAR)
+
+// Pointer element types need a typedef, so that `const T*` means a pointer to
+// a constant pointer.
+typedef struct ss_string *strp;
+
+GENERATE_ARRAY(strp)
+GENERATE_ARRAY_HASH(strp, SS_ARRAY_HASH_STRING, SS_ARRAY_EQ_STRING)
+
+static void free_string_elem(strp **elem) { ss_string_free(*elem); }
+
+void dedup_array() {
+    int ints[] = { 5, 3, 5, 1, 3, 3, 9, 1, 5 };
+    struct ss_array_int *array = ss_array_int_create_from(ints, 9);
+
+    ss_assert(ss_array_int_dedup(array, NULL) == 4);
+    int expected[] = { 5, 3, 1, 9 };
+    ss_assert(array->len == 4);
+    ss_assert(memcmp(array->data, expected, sizeof(expected)) == 0);
+
+    // Enough distinct elements to grow the table several times.
+    array->len = 0;
+    for (int i = 0; i < 3000; ++i) {
+        int elem = (i * 7919) % 1000;
+        ss_array_int_append_data(array, &elem, 1);
+    }
+    ss_assert(ss_array_int_dedup(array, NULL) == 1000);
+    for (size_t i = 0; i < 1000; ++i) {
+        ss_assert(array->data[i] == (int) (i * 7919 % 1000));
+    }
+
+    ss_array_int_free(&array, NULL);
+    ss_assert(ss_array_int_dedup(NULL, NULL) == 0);
+}
+
+void dedup_array_of_strings() {
+    const char *words[] = { "beta", "alpha", "beta", "gamma", "alpha", "beta" };
+    struct ss_array_strp *array = ss_array_strp_create();
+
+    for (size_t i = 0; i < 6; ++i) {
+        strp s = ss_string_create_from_cstring(words[i]);
+        ss_array_strp_append_data(array, &s, 1);
+    }
+
+    // The removed strings are freed.
+    ss_assert(ss_array_strp_dedup(array, &free_string_elem) == 3);
+    ss_assert(strcmp(ss_string_as_cstring(array->data[0]), "beta") == 0);
+    ss_assert(strcmp(ss_string_as_cstring(array->data[1]), "alpha") == 0);
+    ss_assert(strcmp(ss_string_as_cstring(array->data[2]), "gamma") == 0);
+
+    ss_array_strp_free(&array, &free_string_elem);
+}
+
+void group_array_by_key() {
+    int ints[] = { 4, 2, 4, 4, 7, 2, 9 };
+    struct ss_array_int *array = ss_array_int_create_from(ints, 7);
+
+    struct ss_array_groups_int *groups = ss_array_int_group_by(array);
+    ss_assert(groups != NULL);
+    ss_assert(ss_array_groups_int_len(groups) == 4);
+
+    int keys[] = { 4, 2, 7, 9 };
+    size_t counts[] = { 3, 2, 1, 1 };
+    size_t positions[][3] = { { 0, 2, 3 }, { 1, 5 }, { 4 }, { 6 } };
+
+    for (size_t g = 0; g < 4; ++g) {
+        ss_assert(*ss_array_groups_int_key(groups, g) == keys[g]);
+        ss_assert(ss_array_groups_int_count(groups, g) == counts[g]);
+
+        size_t len = 0;
+        const size_t *pos = ss_array_groups_int_positions(groups, g, &len);
+        ss_assert(len == counts[g]);
+        ss_assert(memcmp(pos, positions[g], len * sizeof(size_t)) == 0);
+    }
+
+    ss_assert(ss_array_groups_int_key(groups, 4) == NULL);
+    ss_assert(ss_array_groups_int_count(groups, 4) == 0);
+    ss_assert(ss_array_groups_int_positions(groups, 4, NULL) == NULL);
+
+    ss_array_groups_int_free(&groups);
+    ss_assert(groups == NULL);
+
+    // An empty slice has no groups.
+    struct ss_slice_int empty = { .data = NULL, .len = 0 };
+    groups = ss_slice_int_group_by(empty);
+    ss_assert(groups != NULL && ss_array_groups_int_len(groups) == 0);
+    ss_array_groups_int_free(&groups);
+
+    // Many groups, each of several elements.
+    array->len = 0;
+    for (int i = 0; i < 5000; ++i) {
+        int elem = i % 500;
+        ss_array_int_append_data(array, &elem, 1);
+    }
+
+    groups = ss_array_int_group_by(array);
+    ss_assert(ss_array_groups_int_len(groups) == 500);
+    for (size_t g = 0; g < 500; ++g) {
+        size_t len = 0;
+        const size_t *pos = ss_array_groups_int_positions(groups, g, &len);
+        ss_assert(len == 10);
+        for (size_t i = 0; i < len; ++i) { ss_assert(pos[i] == g + i * 500); }
+    }
+
+    ss_array_groups_int_free(&groups);
+    ss_array_int_free(&array, NULL);
+}
+
+#endif
@@ -0,0 +1,138 @@
+#ifndef SS_LIB_TEST_ARRAY_IO
+#define SS_LIB_TEST_ARRAY_IO
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "ss_array.h"
+#include "ss_array_io.h"
+#include "ss_assert.h"
+#include "test_array.h"
+
+GENERATE_ARRAY_IO(int)
+GENERATE_ARRAY_IO2(S, s)
+
+// Create an empty temporary file, storing its path in `path`.
+static void array_io_temp_path(char *path) {
+    strcpy(path, "/tmp/ss_array_io_XXXXXX");
+    int fd = mkstemp(path);
+    ss_assert(fd >= 0);
+    close(fd);
+}
+
+static struct ss_array_int *array_io_test_array(size_t len) {
+    struct ss_array_int *array = ss_array_int_create_with_size(len);
+    for (size_t i = 0; i < len; ++i) {
+        int elem = (int) (i * 7 + 3);
+        ss_array_int_append_data(array, &elem, 1);
+    }
+    return array;
+}
+
+void save_and_load_array() {
+    char path[32];
+    array_io_temp_path(path);
+
+    size_t lens[] = { 0, 1, 1000 };
+    for (size_t l = 0; l < 3; ++l) {
+        struct ss_array_int *array = array_io_test_array(lens[l]);
+        ss_assert(ss_array_int_save(array, path));
+
+        struct ss_array_int *loaded = ss_array_int_load(path);
+        ss_assert(loaded != NULL);
+        ss_assert(loaded->len == lens[l]);
+        ss_assert(lens[l] == 0
+            || memcmp(loaded->data, array->data, lens[l] * sizeof(int)) == 0);
+
+        ss_array_int_free(&array, NULL);
+        ss_array_int_free(&loaded, NULL);
+    }
+
+    ss_assert(! ss_array_int_save(NULL, path));
+    ss_assert(ss_array_int_load("/nonexistent/ss_array_io") == NULL);
+
+    // An array of a different element size is rejected.
+    ss_assert(ss_array_s_load(path) == NULL);
+
+    unlink(path);
+}
+
+void load_corrupt_array_file() {
+    char path[32];
+    array_io_temp_path(path);
+
+    struct ss_array_int *array = array_io_test_array(100);
+    ss_assert(ss_array_int_save(array, path));
+
+    // Flip a bit of the last element.
+    FILE *file = fopen(path, "r+b");
+    ss_assert(fseek(file, -1, SEEK_END) == 0);
+    int c = fgetc(file);
+    ss_assert(fseek(file, -1, SEEK_END) == 0);
+    fputc(c ^ 1, file);
+    fclose(file);
+
+    ss_assert(ss_array_int_load(path) == NULL);
+
+    // A view only checks the header until asked to verify.
+    struct ss_array_view_int *view = ss_array_view_int_open(path);
+    ss_assert(view != NULL);
+    ss_assert(! ss_array_view_int_verify(view));
+    ss_array_view_int_close(&view);
+
+    // A truncated file is rejected by both.
+    ss_assert(truncate(path, SS_ARRAY_FILE_HEADER_SIZE + 10) == 0);
+    ss_assert(ss_array_int_load(path) == NULL);
+    ss_assert(ss_array_view_int_open(path) == NULL);
+
+    ss_assert(truncate(path, 10) == 0);
+    ss_assert(ss_array_int_load(path) == NULL);
+    ss_assert(ss_array_view_int_open(path) == NULL);
+
+    ss_array_int_free(&array, NULL);
+    unlink(path);
+}
+
+void map_array_file() {
+    char path[32];
+    array_io_temp_path(path);
+
+    struct ss_array_int *array = array_io_test_array(5000);
+    ss_assert(ss_array_int_save(array, path));
+
+    struct ss_array_view_int *view = ss_array_view_int_open(path);
+    ss_assert(view != NULL);
+    ss_assert(ss_array_view_int_verify(view));
+    ss_assert(ss_array_view_int_len(view) == 5000);
+    ss_assert((uintptr_t) ss_array_view_int_data(view) % _Alignof(int) == 0);
+
+    for (size_t i = 0; i < 5000; ++i) {
+        ss_assert(*ss_array_view_int_get(view, i) == array->data[i]);
+    }
+    ss_assert(ss_array_view_int_get(view, 5000) == NULL);
+
+    // The slice functions work on the mapped elements.
+    struct ss_slice_int slice = ss_array_view_int_as_slice(view);
+    ss_assert(slice.len == 5000);
+    ss_assert(ss_slice_int_reduce(slice, 0, &add_int)
+        == ss_array_int_reduce(array, 0, &add_int));
+
+    ss_array_view_int_close(&view);
+    ss_assert(view == NULL);
+
+    // An empty array maps to an empty view.
+    array->len = 0;
+    ss_assert(ss_array_int_save(array, path));
+    view = ss_array_view_int_open(path);
+    ss_assert(view != NULL && ss_array_view_int_len(view) == 0);
+    ss_assert(ss_array_view_int_as_slice(view).len == 0);
+    ss_array_view_int_close(&view);
+
+    ss_array_int_free(&array, NULL);
+    unlink(path);
+}
+
+#endif
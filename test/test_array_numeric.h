@@ -0,0 +1,253 @@
+#ifndef SS_LIB_TEST_ARRAY_NUMERIC
+#define SS_LIB_TEST_ARRAY_NUMERIC
+
+#include <stdint.h>
+
+#include "ss_array.h"
+#include "ss_array_numeric.h"
+#include "ss_assert.h"
+#include "test_array.h"
+
+GENERATE_ARRAY2(int64_t, i64)
+GENERATE_ARRAY(float)
+GENERATE_ARRAY(double)
+GENERATE_ARRAY2(unsigned int, uint)
+
+GENERATE_ARRAY_NUMERIC(int)
+GENERATE_ARRAY_NUMERIC2(int64_t, i64)
+GENERATE_ARRAY_NUMERIC(float)
+GENERATE_ARRAY_NUMERIC(double)
+// No kernel; uses the scalar loops.
+GENERATE_ARRAY_NUMERIC2(unsigned int, uint)
+
+// Lengths around each block size, so that every kernel runs with and without a
+// scalar tail.
+static const size_t numeric_test_lens[] = {
+    0, 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 32, 33, 63, 64, 65, 1000, 1001
+};
+
+#define NUMERIC_TEST_NUM_LENS \
+    (sizeof(numeric_test_lens) / sizeof(numeric_test_lens[0]))
+
+// A value between -50 and 50 for position `i`.
+static int numeric_test_value(size_t i) { return (int) (i * 37 % 101) - 50; }
+
+void sum_and_dot_numeric_arrays() {
+    struct ss_array_int *ints = ss_array_int_create();
+    struct ss_array_i64 *longs = ss_array_i64_create();
+    struct ss_array_float *floats = ss_array_float_create();
+    struct ss_array_double *doubles = ss_array_double_create();
+    struct ss_array_uint *uints = ss_array_uint_create();
+
+    for (size_t l = 0; l < NUMERIC_TEST_NUM_LENS; ++l) {
+        size_t len = numeric_test_lens[l];
+        ints->len = longs->len = floats->len = doubles->len = uints->len = 0;
+
+        int64_t sum = 0;
+        int64_t dot = 0;
+        for (size_t i = 0; i < len; ++i) {
+            int value = numeric_test_value(i);
+            int64_t big = (int64_t) value * 1000000;
+            float f = (float) value;
+            double d = (double) value;
+            unsigned int u = (unsigned int) (value + 50);
+
+            ss_array_int_append_data(ints, &value, 1);
+            ss_array_i64_append_data(longs, &big, 1);
+            ss_array_float_append_data(floats, &f, 1);
+            ss_array_double_append_data(doubles, &d, 1);
+            ss_array_uint_append_data(uints, &u, 1);
+
+            sum += value;
+            dot += value * value;
+        }
+
+        // The values are small enough that every sum is exact.
+        ss_assert(ss_array_int_sum(ints) == sum);
+        ss_assert(ss_array_i64_sum(longs) == sum * 1000000);
+        ss_assert(ss_array_float_sum(floats) == (float) sum);
+        ss_assert(ss_array_double_sum(doubles) == (double) sum);
+        ss_assert(ss_array_uint_sum(uints) == (unsigned int) (sum
+            + 50 * (int64_t) len));
+
+        ss_assert(ss_array_int_dot(ints, ints) == dot);
+        ss_assert(ss_array_i64_dot(longs, longs) == dot * 1000000000000);
+        ss_assert(ss_array_float_dot(floats, floats) == (float) dot);
+        ss_assert(ss_array_double_dot(doubles, doubles) == (double) dot);
+    }
+
+    // Only the common length is used.
+    struct ss_slice_int all = ss_array_int_as_slice(ints);
+    struct ss_slice_int two = ss_array_int_slice(ints, 0, 2);
+    ss_assert(ss_slice_int_dot(all, two)
+        == ints->data[0] * ints->data[0] + ints->data[1] * ints->data[1]);
+
+    // Integer sums wrap, in the vectorized loop as well as the scalar one.
+    ints->len = 0;
+    for (size_t i = 0; i < 17; ++i) {
+        int max = INT32_MAX;
+        ss_array_int_append_data(ints, &max, 1);
+    }
+    ss_assert(ss_array_int_sum(ints) == INT32_MAX - 16);
+
+    ss_assert(ss_array_int_sum(NULL) == 0);
+    ss_assert(ss_array_double_dot(NULL, doubles) == 0.0);
+
+    ss_array_int_free(&ints, NULL);
+    ss_array_i64_free(&longs, NULL);
+    ss_array_float_free(&floats, NULL);
+    ss_array_double_free(&doubles, NULL);
+    ss_array_uint_free(&uints, NULL);
+}
+
+void min_max_of_numeric_arrays() {
+    struct ss_array_int *ints = ss_array_int_create();
+    struct ss_array_i64 *longs = ss_array_i64_create();
+    struct ss_array_float *floats = ss_array_float_create();
+    struct ss_array_double *doubles = ss_array_double_create();
+    struct ss_array_uint *uints = ss_array_uint_create();
+
+    int i_out = 0;
+    int64_t l_out = 0;
+    float f_out = 0.0f;
+    double d_out = 0.0;
+    unsigned int u_out = 0;
+
+    ss_assert(! ss_array_int_min(ints, &i_out));
+    ss_assert(! ss_array_i64_max(longs, &l_out));
+    ss_assert(! ss_array_float_min(floats, &f_out));
+    ss_assert(! ss_array_uint_max(uints, &u_out));
+    ss_assert(ss_array_double_argmin(doubles) == SIZE_MAX);
+    ss_assert(ss_array_int_argmin(NULL) == SIZE_MAX);
+
+    for (size_t l = 1; l < NUMERIC_TEST_NUM_LENS; ++l) {
+        size_t len = numeric_test_lens[l];
+        ints->len = longs->len = floats->len = doubles->len = uints->len = 0;
+
+        for (size_t i = 0; i < len; ++i) {
+            // All elements are between -50 and 50, apart from one minimum and
+            // one maximum placed a third of the way in and at the end.
+            int value = numeric_test_value(i);
+            if (i == len / 3) { value = -100; }
+            if (i == len - 1 && len > 1) { value = 100; }
+
+            int64_t big = (int64_t) value * 1000000000;
+            float f = (float) value;
+            double d = (double) value;
+            unsigned int u = (unsigned int) (value + 100);
+
+            ss_array_int_append_data(ints, &value, 1);
+            ss_array_i64_append_data(longs, &big, 1);
+            ss_array_float_append_data(floats, &f, 1);
+            ss_array_double_append_data(doubles, &d, 1);
+            ss_array_uint_append_data(uints, &u, 1);
+        }
+
+        int max = len > 1 ? 100 : -100;
+
+        ss_assert(ss_array_int_min(ints, &i_out) && i_out == -100);
+        ss_assert(ss_array_int_max(ints, &i_out) && i_out == max);
+        ss_assert(ss_array_i64_min(longs, &l_out)
+            && l_out == -100 * (int64_t) 1000000000);
+        ss_assert(ss_array_i64_max(longs, &l_out)
+            && l_out == max * (int64_t) 1000000000);
+        ss_assert(ss_array_float_min(floats, &f_out) && f_out == -100.0f);
+        ss_assert(ss_array_float_max(floats, &f_out) && f_out == (float) max);
+        ss_assert(ss_array_double_min(doubles, &d_out) && d_out == -100.0);
+        ss_assert(ss_array_double_max(doubles, &d_out)
+            && d_out == (double) max);
+        ss_assert(ss_array_uint_min(uints, &u_out) && u_out == 0);
+        ss_assert(ss_array_uint_max(uints, &u_out)
+            && u_out == (unsigned int) (max + 100));
+
+        ss_assert(ss_array_int_argmin(ints) == len / 3);
+        ss_assert(ss_array_i64_argmin(longs) == len / 3);
+        ss_assert(ss_array_float_argmin(floats) == len / 3);
+        ss_assert(ss_array_double_argmin(doubles) == len / 3);
+        ss_assert(ss_array_uint_argmin(uints) == len / 3);
+    }
+
+    // argmin gives the first of equal minimums.
+    ints->len = 0;
+    for (int i = 0; i < 40; ++i) {
+        int value = i % 10 == 7 ? -1 : i;
+        ss_array_int_append_data(ints, &value, 1);
+    }
+    ss_assert(ss_array_int_argmin(ints) == 7);
+
+    ss_array_int_free(&ints, NULL);
+    ss_array_i64_free(&longs, NULL);
+    ss_array_float_free(&floats, NULL);
+    ss_array_double_free(&doubles, NULL);
+    ss_array_uint_free(&uints, NULL);
+}
+
+void find_and_count_in_numeric_arrays() {
+    struct ss_array_int *ints = ss_array_int_create();
+    struct ss_array_i64 *longs = ss_array_i64_create();
+    struct ss_array_float *floats = ss_array_float_create();
+    struct ss_array_double *doubles = ss_array_double_create();
+    struct ss_array_uint *uints = ss_array_uint_create();
+
+    for (size_t i = 0; i < 1001; ++i) {
+        int value = numeric_test_value(i);
+        // The low 32 bits are the same for every element.
+        int64_t big = (int64_t) value * 4294967296 + 7;
+        float f = (float) value;
+        double d = (double) value;
+        unsigned int u = (unsigned int) (value + 50);
+
+        ss_array_int_append_data(ints, &value, 1);
+        ss_array_i64_append_data(longs, &big, 1);
+        ss_array_float_append_data(floats, &f, 1);
+        ss_array_double_append_data(doubles, &d, 1);
+        ss_array_uint_append_data(uints, &u, 1);
+    }
+
+    for (int value = -52; value <= 52; ++value) {
+        size_t first = SIZE_MAX;
+        size_t count = 0;
+        for (size_t i = 0; i < 1001; ++i) {
+            if (numeric_test_value(i) != value) continue;
+
+            if (first == SIZE_MAX) { first = i; }
+            count += 1;
+        }
+
+        int64_t big = (int64_t) value * 4294967296 + 7;
+        unsigned int u = (unsigned int) (value + 50);
+
+        ss_assert(ss_array_int_find_value(ints, value) == first);
+        ss_assert(ss_array_i64_find_value(longs, big) == first);
+        ss_assert(ss_array_float_find_value(floats, (float) value) == first);
+        ss_assert(ss_array_double_find_value(doubles, value) == first);
+        ss_assert(ss_array_uint_find_value(uints, u) == first);
+
+        ss_assert(ss_array_int_count_value(ints, value) == count);
+        ss_assert(ss_array_i64_count_value(longs, big) == count);
+        ss_assert(ss_array_float_count_value(floats, (float) value) == count);
+        ss_assert(ss_array_double_count_value(doubles, value) == count);
+        ss_assert(ss_array_uint_count_value(uints, u) == count);
+    }
+
+    // Matching one 32-bit half of a 64-bit value is not enough.
+    ss_assert(ss_array_i64_find_value(longs, (int64_t) 60 * 4294967296 + 7)
+        == SIZE_MAX);
+    ss_assert(ss_array_i64_count_value(longs, 4294967296) == 0);
+
+    // Positions are relative to the slice.
+    struct ss_slice_int slice = ss_array_int_slice(ints, 500, 1001);
+    ss_assert(ss_slice_int_find_value(slice, ints->data[990]) + 500 <= 990);
+    ss_assert(ss_slice_int_find_value(slice, ints->data[500]) == 0);
+
+    ss_assert(ss_array_int_find_value(NULL, 0) == SIZE_MAX);
+    ss_assert(ss_array_float_count_value(NULL, 0.0f) == 0);
+
+    ss_array_int_free(&ints, NULL);
+    ss_array_i64_free(&longs, NULL);
+    ss_array_float_free(&floats, NULL);
+    ss_array_double_free(&doubles, NULL);
+    ss_array_uint_free(&uints, NULL);
+}
+
+#endif
@@ -0,0 +1,154 @@
+#ifndef SS_LIB_TEST_ARRAY_PARALLEL
+#define SS_LIB_TEST_ARRAY_PARALLEL
+
+#include <stdint.h>
+#include <stdlib.h>
+
+// Exercise the parallel paths even on machines with few CPUs.
+#define SS_ARRAY_PARALLEL_MAX_THREADS 8
+
+#include "ss_array.h"
+#include "ss_array_parallel.h"
+#include "ss_assert.h"
+#include "ss_threadpool.h"
+#include "test_array.h"
+
+GENERATE_ARRAY_PARALLEL(int)
+
+static struct ss_array_int *random_int_array(size_t len, uint32_t seed) {
+    struct ss_array_int *array = ss_array_int_create_with_size(len);
+
+    for (size_t i = 0; i < len; ++i) {
+        seed = seed * 1103515245u + 12345u;
+        int elem = (int) ((seed >> 8) % 50000);
+        ss_array_int_append_data(array, &elem, 1);
+    }
+    return array;
+}
+
+void parallel_sort_array() {
+    size_t lens[] = { 100, SS_ARRAY_PARALLEL_THRESHOLD, 200003 };
+    // More threads than SS_ARRAY_PARALLEL_MAX_THREADS use only that many.
+    size_t threads[] = { 1, 2, 3, 4, 7, 100000 };
+
+    for (size_t l = 0; l < 3; ++l) {
+        for (size_t t = 0; t < 6; ++t) {
+            struct ss_array_int *array = random_int_array(lens[l], 9);
+            struct ss_array_int *expected = random_int_array(lens[l], 9);
+
+            ss_array_int_parallel_sort(array, &cmp_int, threads[t]);
+            ss_array_int_sort(expected, &cmp_int);
+
+            ss_assert_msg(memcmp(array->data, expected->data,
+                lens[l] * sizeof(int)) == 0,
+                "len %zu, %zu threads\n", lens[l], threads[t]);
+
+            ss_array_int_free(&array, NULL);
+            ss_array_int_free(&expected, NULL);
+        }
+    }
+}
+
+void parallel_sort_slice() {
+    struct ss_array_int *array = random_int_array(100000, 3);
+    int first = array->data[0];
+    int last = array->data[99999];
+
+    struct ss_slice_int slice = ss_array_int_slice(array, 1, 99999);
+    ss_slice_int_parallel_sort(slice, &cmp_int, 4);
+
+    for (size_t i = 1; i < slice.len; ++i) {
+        ss_assert(slice.data[i - 1] <= slice.data[i]);
+    }
+    ss_assert(array->data[0] == first && array->data[99999] == last);
+
+    ss_array_int_free(&array, NULL);
+}
+
+static bool less_than_10000(int *i) { return *i < 10000; }
+
+void parallel_partition_array() {
+    size_t lens[] = { 100, 100000, 123457 };
+    size_t threads[] = { 1, 2, 3, 8, 100000 };
+
+    for (size_t l = 0; l < 3; ++l) {
+        for (size_t t = 0; t < 5; ++t) {
+            struct ss_array_int *array = random_int_array(lens[l], 5);
+
+            size_t expected = 0;
+            for (size_t i = 0; i < lens[l]; ++i) {
+                if (array->data[i] < 10000) { expected += 1; }
+            }
+
+            int *partition = ss_array_int_parallel_partition(array,
+                &less_than_10000, threads[t]);
+            ss_assert(partition == &array->data[expected]);
+
+            for (size_t i = 0; i < lens[l]; ++i) {
+                ss_assert_msg((array->data[i] < 10000) == (i < expected),
+                    "len %zu, %zu threads, pos %zu\n",
+                    lens[l], threads[t], i);
+            }
+
+            ss_array_int_free(&array, NULL);
+        }
+    }
+}
+
+static void square_int(int *elem, void *ctx) {
+    (void) ctx;
+    *elem = *elem * *elem;
+}
+
+void parallel_for_each_array() {
+    struct ss_threadpool *pool = ss_threadpool_create(4);
+    struct ss_array_int *array = ss_array_int_create_with_size(10000);
+
+    for (int i = 0; i < 10000; ++i) {
+        int elem = i % 1000;
+        ss_array_int_append_data(array, &elem, 1);
+    }
+
+    ss_array_int_parallel_for_each(array, pool, &square_int, NULL, 0);
+    for (int i = 0; i < 10000; ++i) {
+        ss_assert(array->data[i] == (i % 1000) * (i % 1000));
+    }
+
+    // A NULL pool runs on the calling thread.
+    struct ss_slice_int slice = ss_array_int_slice(array, 0, 10);
+    ss_slice_int_parallel_for_each(slice, NULL, &square_int, NULL, 0);
+    ss_assert(array->data[3] == 81);
+    ss_assert(array->data[10] == 100);
+
+    ss_array_int_free(&array, NULL);
+    ss_threadpool_free(&pool);
+}
+
+static int add_ints(int a, int b) { return a + b; }
+
+void parallel_reduce_array() {
+    struct ss_threadpool *pool = ss_threadpool_create(4);
+    struct ss_array_int *array = random_int_array(40003, 11);
+    size_t grains[] = { 0, 1, 100, 1000000 };
+
+    int expected = ss_array_int_reduce(array, 0, &add_int);
+
+    for (size_t g = 0; g < 4; ++g) {
+        ss_assert(ss_array_int_parallel_reduce(array, pool, 0, &add_int,
+            &add_ints, grains[g]) == expected);
+    }
+
+    ss_assert(ss_array_int_parallel_reduce(array, NULL, 0, &add_int,
+        &add_ints, 0) == expected);
+    ss_assert(ss_array_int_parallel_reduce(array, pool, 5, &add_int,
+        NULL, 0) == 5);
+
+    struct ss_slice_int slice = ss_array_int_slice(array, 10, 10);
+    ss_assert(ss_slice_int_parallel_reduce(slice, pool, 0, &add_int,
+        &add_ints, 0) == 0);
+
+    ss_array_int_free(&array, NULL);
+    ss_threadpool_free(&pool);
+}
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef SS_LIB_TEST_ARRAY_PIPELINE
+#define SS_LIB_TEST_ARRAY_PIPELINE
+
+#include <stdbool.h>
+
+#include "ss_array.h"
+#include "ss_array_pipeline.h"
+#include "ss_assert.h"
+#include "test_array.h"
+
+GENERATE_ARRAY(long)
+
+#define IS_EVEN(E) (*(E) % 2 == 0)
+#define SQUARE(E) ((long) *(E) * *(E))
+
+static bool is_multiple_of_three(const int *elem) { return *elem % 3 == 0; }
+
+static long add_long(long acc, const long *elem) { return acc + *elem; }
+
+GENERATE_ARRAY_PIPELINE(even_squares, int, int, long, long, IS_EVEN, SQUARE)
+GENERATE_ARRAY_FILTER(threes, int, int, is_multiple_of_three)
+
+void collect_array_pipeline() {
+    struct ss_array_int *numbers = ss_array_int_create();
+    for (int i = 0; i < 100; ++i) { ss_array_int_append_data(numbers, &i, 1); }
+
+    struct ss_array_long *squares = ss_array_long_create();
+    ss_assert(ss_pipeline_even_squares_collect(
+        ss_array_int_as_slice(numbers), squares));
+    ss_assert(squares->len == 50);
+    for (size_t i = 0; i < 50; ++i) {
+        ss_assert(squares->data[i] == (long) (2 * i * 2 * i));
+    }
+
+    // Results are appended, and a pre-reserved destination is not reallocated.
+    ss_assert(ss_array_long_reserve(squares, 100));
+    long *data = squares->data;
+    ss_assert(ss_pipeline_even_squares_collect(
+        ss_array_int_slice(numbers, 90, 100), squares));
+    ss_assert(squares->len == 55);
+    ss_assert(squares->data == data);
+    ss_assert(squares->data[54] == 98 * 98);
+
+    struct ss_array_int *threes = ss_array_int_create();
+    ss_assert(ss_pipeline_threes_collect(ss_array_int_as_slice(numbers),
+        threes));
+    ss_assert(threes->len == 34);
+    ss_assert(threes->data[33] == 99);
+
+    ss_assert(! ss_pipeline_threes_collect(ss_array_int_as_slice(numbers),
+        NULL));
+
+    ss_array_int_free(&numbers, NULL);
+    ss_array_int_free(&threes, NULL);
+    ss_array_long_free(&squares, NULL);
+}
+
+void reduce_array_pipeline() {
+    struct ss_array_int *numbers = ss_array_int_create();
+    for (int i = 1; i <= 10; ++i) { ss_array_int_append_data(numbers, &i, 1); }
+    struct ss_slice_int all = ss_array_int_as_slice(numbers);
+
+    // 4 + 16 + 36 + 64 + 100
+    ss_assert(ss_pipeline_even_squares_reduce(all, 0, &add_long) == 220);
+    ss_assert(ss_pipeline_even_squares_reduce(all, 5, NULL) == 5);
+    ss_assert(ss_pipeline_even_squares_count(all) == 5);
+
+    ss_assert(ss_pipeline_threes_reduce(all, 0, &add_int) == 18);
+    ss_assert(ss_pipeline_threes_count(all) == 3);
+
+    struct ss_slice_int empty = { .data = NULL, .len = 0 };
+    ss_assert(ss_pipeline_threes_count(empty) == 0);
+    ss_assert(ss_pipeline_threes_reduce(empty, 7, &add_int) == 7);
+
+    ss_array_int_free(&numbers, NULL);
+}
+
+#endif
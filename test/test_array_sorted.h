@@ -0,0 +1,149 @@
+#ifndef SS_LIB_TEST_ARRAY_SORTED
+#define SS_LIB_TEST_ARRAY_SORTED
+
+#include <stdint.h>
+
+#include "ss_array.h"
+#include "ss_array_sorted.h"
+#include "ss_assert.h"
+#include "test_array.h"
+
+GENERATE_ARRAY_SORTED(int)
+
+// Create a sorted array of `len` values in [0, `range`), with duplicates.
+static struct ss_array_int *sorted_int_array(size_t len, int range) {
+    struct ss_array_int *array = ss_array_int_create_with_size(len);
+    uint32_t seed = (uint32_t) len;
+
+    for (size_t i = 0; i < len; ++i) {
+        seed = seed * 1103515245u + 12345u;
+        int elem = (int) ((seed >> 8) % (uint32_t) range);
+        ss_array_int_append_data(array, &elem, 1);
+    }
+
+    ss_array_int_sort(array, &cmp_int);
+    return array;
+}
+
+void search_sorted_array() {
+    size_t lens[] = { 0, 1, 2, 3, 10, 257, 1000 };
+
+    for (size_t l = 0; l < 7; ++l) {
+        struct ss_array_int *array = sorted_int_array(lens[l], 200);
+
+        for (int key = -1; key <= 200; ++key) {
+            size_t lower = 0;
+            while (lower < array->len && array->data[lower] < key) { ++lower; }
+            size_t upper = lower;
+            while (upper < array->len && array->data[upper] == key) { ++upper; }
+
+            ss_assert(ss_array_int_lower_bound(array, &key, &cmp_int) == lower);
+            ss_assert(ss_array_int_upper_bound(array, &key, &cmp_int) == upper);
+
+            int *found = ss_array_int_binary_search(array, &key, &cmp_int);
+            if (lower == upper) {
+                ss_assert(found == NULL);
+            } else {
+                ss_assert(found == &array->data[lower]);
+            }
+        }
+
+        ss_array_int_free(&array, NULL);
+    }
+
+    struct ss_slice_int empty = { .data = NULL, .len = 0 };
+    int key = 1;
+    ss_assert(ss_slice_int_lower_bound(empty, &key, &cmp_int) == 0);
+    ss_assert(ss_slice_int_binary_search(empty, &key, &cmp_int) == NULL);
+}
+
+void unique_sorted_array() {
+    struct ss_array_int *array = sorted_int_array(1000, 50);
+
+    ss_assert(ss_array_int_unique(array, &cmp_int, NULL) == 50);
+    for (int i = 0; i < 50; ++i) { ss_assert(array->data[i] == i); }
+
+    int one = 1;
+    struct ss_array_int *single = ss_array_int_create_from(&one, 1);
+    ss_assert(ss_array_int_unique(single, &cmp_int, NULL) == 1);
+
+    ss_array_int_free(&array, NULL);
+    ss_array_int_free(&single, NULL);
+}
+
+void merge_sorted_arrays() {
+    int a_data[] = { 1, 2, 2, 2, 5, 7 };
+    int b_data[] = { 0, 2, 2, 5, 6, 8, 9 };
+    struct ss_slice_int a = { .data = a_data, .len = 6 };
+    struct ss_slice_int b = { .data = b_data, .len = 7 };
+    struct ss_slice_int empty = { .data = NULL, .len = 0 };
+
+    int merged[] = { 0, 1, 2, 2, 2, 2, 2, 5, 5, 6, 7, 8, 9 };
+    int united[] = { 0, 1, 2, 2, 2, 5, 6, 7, 8, 9 };
+    int common[] = { 2, 2, 5 };
+
+    struct ss_array_int *dest = ss_array_int_create();
+
+    ss_assert(ss_array_int_merge(dest, a, b, &cmp_int));
+    ss_assert(dest->len == 13);
+    ss_assert(memcmp(dest->data, merged, sizeof(merged)) == 0);
+
+    // Results are appended.
+    ss_assert(ss_array_int_set_union(dest, a, b, &cmp_int));
+    ss_assert(dest->len == 23);
+    ss_assert(memcmp(dest->data + 13, united, sizeof(united)) == 0);
+
+    dest->len = 0;
+    ss_assert(ss_array_int_set_intersection(dest, a, b, &cmp_int));
+    ss_assert(dest->len == 3);
+    ss_assert(memcmp(dest->data, common, sizeof(common)) == 0);
+
+    dest->len = 0;
+    ss_assert(ss_array_int_set_intersection(dest, a, empty, &cmp_int));
+    ss_assert(dest->len == 0);
+    ss_assert(ss_array_int_set_union(dest, empty, b, &cmp_int));
+    ss_assert(dest->len == 7);
+    ss_assert(memcmp(dest->data, b_data, sizeof(b_data)) == 0);
+
+    ss_assert(! ss_array_int_merge(NULL, a, b, &cmp_int));
+    ss_assert(! ss_array_int_merge(dest, a, b, NULL));
+
+    ss_array_int_free(&dest, NULL);
+}
+
+void search_array_index() {
+    size_t lens[] = { 0, 1, 2, 7, 8, 100, 100000 };
+
+    for (size_t l = 0; l < 7; ++l) {
+        struct ss_array_int *array = sorted_int_array(lens[l], 1000);
+        struct ss_array_index_int *index = ss_array_index_int_create(
+            ss_array_int_as_slice(array), &cmp_int);
+        ss_assert(index != NULL);
+
+        for (int key = -1; key <= 1000; ++key) {
+            size_t pos = ss_array_int_lower_bound(array, &key, &cmp_int);
+            const int *found = ss_array_index_int_lower_bound(index, &key);
+
+            if (pos == array->len) {
+                ss_assert_msg(found == NULL, "len %zu, key %d\n",
+                    lens[l], key);
+            } else {
+                ss_assert_msg(found != NULL && *found == array->data[pos],
+                    "len %zu, key %d\n", lens[l], key);
+            }
+
+            ss_assert(ss_array_index_int_contains(index, &key)
+                == (ss_array_int_binary_search(array, &key, &cmp_int)
+                    != NULL));
+        }
+
+        ss_array_index_int_free(&index);
+        ss_assert(index == NULL);
+        ss_array_int_free(&array, NULL);
+    }
+
+    struct ss_slice_int empty = { .data = NULL, .len = 0 };
+    ss_assert(ss_array_index_int_create(empty, NULL) == NULL);
+}
+
+#endif
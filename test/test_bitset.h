@@ -0,0 +1,127 @@
+#ifndef SS_LIB_TEST_BITSET
+#define SS_LIB_TEST_BITSET
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "ss_assert.h"
+#include "ss_bitset.h"
+
+void set_and_test_bits() {
+    struct ss_bitset *bits = ss_bitset_create();
+    ss_assert(bits != NULL);
+    ss_assert(ss_bitset_len(bits) == 0);
+    ss_assert(! ss_bitset_test(bits, 0));
+    ss_assert(ss_bitset_find_first(bits) == SIZE_MAX);
+
+    // Setting past the end grows the bitset.
+    ss_assert(ss_bitset_set(bits, 3));
+    ss_assert(ss_bitset_len(bits) == 4);
+    ss_assert(ss_bitset_set(bits, 200));
+    ss_assert(ss_bitset_len(bits) == 201);
+
+    for (size_t i = 0; i < 201; ++i) {
+        ss_assert(ss_bitset_test(bits, i) == (i == 3 || i == 200));
+    }
+    ss_assert(! ss_bitset_test(bits, 1000));
+
+    ss_bitset_clear(bits, 3);
+    ss_bitset_clear(bits, 1000);
+    ss_assert(! ss_bitset_test(bits, 3));
+    ss_assert(ss_bitset_count(bits) == 1);
+
+    ss_bitset_set_all(bits);
+    ss_assert(ss_bitset_count(bits) == 201);
+
+    // Shrinking discards bits; growing again brings back clear bits.
+    ss_assert(ss_bitset_resize(bits, 70));
+    ss_assert(ss_bitset_count(bits) == 70);
+    ss_assert(ss_bitset_resize(bits, 300));
+    ss_assert(ss_bitset_count(bits) == 70);
+    ss_assert(! ss_bitset_test(bits, 70));
+
+    ss_bitset_clear_all(bits);
+    ss_assert(ss_bitset_len(bits) == 300);
+    ss_assert(ss_bitset_count(bits) == 0);
+
+    // Setting bit SIZE_MAX would need a length of SIZE_MAX + 1.
+    ss_assert(! ss_bitset_set(bits, SIZE_MAX));
+    ss_assert(ss_bitset_len(bits) == 300);
+
+    ss_bitset_free(&bits);
+    ss_assert(bits == NULL);
+}
+
+void iterate_set_bits() {
+    struct ss_bitset *bits = ss_bitset_create_with_size(1000);
+    ss_assert(ss_bitset_len(bits) == 1000);
+    ss_assert(ss_bitset_count(bits) == 0);
+
+    for (size_t i = 5; i < 1000; i += 7) { ss_bitset_set(bits, i); }
+    ss_bitset_set(bits, 999);
+
+    size_t expected = 5;
+    size_t count = 0;
+    for (size_t i = ss_bitset_next_set(bits, 0); i != SIZE_MAX;
+        i = ss_bitset_next_set(bits, i + 1)
+    ) {
+        ss_assert(i == expected);
+        expected = expected + 7 < 1000 ? expected + 7 : 999;
+        count += 1;
+    }
+    ss_assert(count == ss_bitset_count(bits));
+    ss_assert(ss_bitset_find_first(bits) == 5);
+    ss_assert(ss_bitset_next_set(bits, 1000) == SIZE_MAX);
+
+    ss_bitset_free(&bits);
+}
+
+void combine_bitsets() {
+    struct ss_bitset *a = ss_bitset_create();
+    struct ss_bitset *b = ss_bitset_create();
+
+    for (size_t i = 0; i < 500; i += 2) { ss_bitset_set(a, i); }
+    for (size_t i = 0; i < 300; i += 3) { ss_bitset_set(b, i); }
+
+    struct ss_bitset *result = ss_bitset_create();
+
+    ss_assert(ss_bitset_or(result, a));
+    ss_assert(ss_bitset_and(result, b));
+    ss_assert(ss_bitset_len(result) == ss_bitset_len(a));
+    for (size_t i = 0; i < 500; ++i) {
+        ss_assert(ss_bitset_test(result, i) == (i % 6 == 0 && i < 300));
+    }
+
+    ss_bitset_clear_all(result);
+    ss_assert(ss_bitset_or(result, b));
+    ss_assert(ss_bitset_or(result, a));
+    for (size_t i = 0; i < 500; ++i) {
+        ss_assert(ss_bitset_test(result, i)
+            == (i % 2 == 0 || (i % 3 == 0 && i < 300)));
+    }
+
+    ss_bitset_clear_all(result);
+    ss_assert(ss_bitset_xor(result, a));
+    ss_assert(ss_bitset_xor(result, b));
+    for (size_t i = 0; i < 500; ++i) {
+        ss_assert(ss_bitset_test(result, i)
+            == ((i % 2 == 0) != (i % 3 == 0 && i < 300)));
+    }
+
+    ss_assert(ss_bitset_or(result, a));
+    ss_assert(ss_bitset_andnot(result, b));
+    for (size_t i = 0; i < 500; ++i) {
+        ss_assert(ss_bitset_test(result, i)
+            == (i % 2 == 0 && (i % 3 != 0 || i >= 300)));
+    }
+
+    ss_assert(ss_bitset_xor(result, result));
+    ss_assert(ss_bitset_count(result) == 0);
+    ss_assert(! ss_bitset_and(result, NULL));
+
+    ss_bitset_free(&a);
+    ss_bitset_free(&b);
+    ss_bitset_free(&result);
+}
+
+#endif
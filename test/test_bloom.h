@@ -0,0 +1,135 @@
+#ifndef SS_LIB_TEST_BLOOM
+#define SS_LIB_TEST_BLOOM
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ss_assert.h"
+#include "ss_bloom.h"
+#include "ss_string.h"
+
+#define BLOOM_TEST_KEYS 10000
+
+// Check that every added key is found and that about `fp_rate` of absent keys
+// are.
+static void check_bloom(struct ss_bloom *bloom, double fp_rate) {
+    char key[32];
+
+    for (int i = 0; i < BLOOM_TEST_KEYS; ++i) {
+        int len = snprintf(key, sizeof(key), "key-%d", i);
+        ss_bloom_add_data(bloom, key, (size_t) len);
+    }
+
+    for (int i = 0; i < BLOOM_TEST_KEYS; ++i) {
+        int len = snprintf(key, sizeof(key), "key-%d", i);
+        ss_assert(ss_bloom_contains_data(bloom, key, (size_t) len));
+    }
+
+    size_t false_positives = 0;
+    for (int i = 0; i < 10 * BLOOM_TEST_KEYS; ++i) {
+        int len = snprintf(key, sizeof(key), "absent-%d", i);
+        false_positives += ss_bloom_contains_data(bloom, key, (size_t) len);
+    }
+
+    double rate = (double) false_positives / (10 * BLOOM_TEST_KEYS);
+    ss_assert_msg(rate < fp_rate * 1.5, "rate %f, expected %f\n",
+        rate, fp_rate);
+}
+
+void create_bloom_filter() {
+    ss_assert(ss_bloom_create(0, 0.01) == NULL);
+    ss_assert(ss_bloom_create(100, 0.0) == NULL);
+    ss_assert(ss_bloom_create(100, 1.0) == NULL);
+
+    struct ss_bloom *bloom = ss_bloom_create(1000, 0.01);
+    ss_assert(bloom != NULL);
+    // About 9.6 bits and 7 hashes per key.
+    ss_assert(ss_bloom_num_bits(bloom) >= 9585);
+    ss_assert(ss_bloom_num_hashes(bloom) == 7);
+    ss_assert(! ss_bloom_contains_data(bloom, "abc", 3));
+
+    ss_bloom_free(&bloom);
+    ss_assert(bloom == NULL);
+
+    bloom = ss_bloom_create_blocked(1000, 0.01);
+    ss_assert(ss_bloom_num_bits(bloom) % 512 == 0);
+    ss_bloom_free(&bloom);
+}
+
+void bloom_filter_false_positive_rate() {
+    struct ss_bloom *bloom = ss_bloom_create(BLOOM_TEST_KEYS, 0.01);
+    check_bloom(bloom, 0.01);
+
+    ss_bloom_clear(bloom);
+    ss_assert(! ss_bloom_contains_data(bloom, "key-1", 5));
+    ss_bloom_free(&bloom);
+
+    bloom = ss_bloom_create_blocked(BLOOM_TEST_KEYS, 0.01);
+    check_bloom(bloom, 0.01);
+    ss_bloom_free(&bloom);
+
+    bloom = ss_bloom_create_blocked(BLOOM_TEST_KEYS, 0.001);
+    check_bloom(bloom, 0.001);
+    ss_bloom_free(&bloom);
+}
+
+void bloom_filter_batches() {
+    struct ss_string *keys[100];
+    const struct ss_string *const_keys[100];
+    bool found[100];
+
+    for (int i = 0; i < 100; ++i) {
+        char key[16];
+        snprintf(key, sizeof(key), "batch-%d", i);
+        keys[i] = ss_string_create_from_cstring(key);
+        const_keys[i] = keys[i];
+    }
+
+    struct ss_bloom *blooms[] = {
+        ss_bloom_create(100, 0.001),
+        ss_bloom_create_blocked(100, 0.001)
+    };
+
+    for (size_t b = 0; b < 2; ++b) {
+        // Add the even keys.
+        for (int i = 0; i < 100; i += 2) { ss_bloom_add(blooms[b], keys[i]); }
+
+        size_t n = ss_bloom_contains_batch(blooms[b], const_keys, 100, found);
+        ss_assert(n >= 50);
+        for (int i = 0; i < 100; ++i) {
+            ss_assert(found[i] == ss_bloom_contains(blooms[b], keys[i]));
+            if (i % 2 == 0) { ss_assert(found[i]); }
+        }
+
+        ss_bloom_add_batch(blooms[b], const_keys, 100);
+        ss_assert(ss_bloom_contains_batch(blooms[b], const_keys, 100, found)
+            == 100);
+    }
+
+    for (int i = 0; i < 100; ++i) { ss_string_free(&keys[i]); }
+    ss_bloom_free(&blooms[0]);
+    ss_bloom_free(&blooms[1]);
+}
+
+void union_bloom_filters() {
+    struct ss_bloom *a = ss_bloom_create_blocked(100, 0.01);
+    struct ss_bloom *b = ss_bloom_create_blocked(100, 0.01);
+    struct ss_bloom *other = ss_bloom_create(100, 0.01);
+
+    ss_bloom_add_data(a, "left", 4);
+    ss_bloom_add_data(b, "right", 5);
+
+    ss_assert(! ss_bloom_union(a, other));
+    ss_assert(! ss_bloom_contains_data(a, "right", 5));
+
+    ss_assert(ss_bloom_union(a, b));
+    ss_assert(ss_bloom_contains_data(a, "left", 4));
+    ss_assert(ss_bloom_contains_data(a, "right", 5));
+
+    ss_bloom_free(&a);
+    ss_bloom_free(&b);
+    ss_bloom_free(&other);
+}
+
+#endif
@@ -0,0 +1,180 @@
+#ifndef SS_LIB_TEST_CONCURRENT_ARRAY
+#define SS_LIB_TEST_CONCURRENT_ARRAY
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+
+#include "ss_assert.h"
+#include "ss_concurrent_array.h"
+
+GENERATE_CONCURRENT_ARRAY(int)
+
+void append_to_concurrent_array() {
+    struct ss_concurrent_array_int *array = ss_concurrent_array_int_create();
+    ss_assert(array != NULL);
+    ss_assert(ss_concurrent_array_int_len(array) == 0);
+    ss_assert(ss_concurrent_array_int_get(array, 0) == NULL);
+
+    int data[1000];
+    for (int i = 0; i < 1000; ++i) { data[i] = i; }
+
+    // Appends crossing several segment boundaries
+    ss_assert(ss_concurrent_array_int_append_data(array, data, 10));
+    ss_assert(ss_concurrent_array_int_append_data(array, data + 10, 990));
+    ss_assert(! ss_concurrent_array_int_append_data(array, data, 0));
+    ss_assert(! ss_concurrent_array_int_append_data(array, NULL, 1));
+    ss_assert(ss_concurrent_array_int_len(array) == 1000);
+
+    int *first = ss_concurrent_array_int_get(array, 0);
+    for (int i = 0; i < 1000; ++i) {
+        ss_assert(*ss_concurrent_array_int_get(array, (size_t) i) == i);
+    }
+    ss_assert(ss_concurrent_array_int_get(array, 1000) == NULL);
+
+    // Elements never move as the array grows.
+    for (int i = 0; i < 10; ++i) {
+        ss_assert(ss_concurrent_array_int_append_data(array, data, 1000));
+    }
+    ss_assert(ss_concurrent_array_int_get(array, 0) == first);
+
+    // Reading by chunk visits every element once.
+    size_t pos = 0;
+    size_t len = 0;
+    size_t chunks = 0;
+    int *chunk = NULL;
+
+    while ((chunk = ss_concurrent_array_int_chunk(array, pos, &len)) != NULL) {
+        for (size_t i = 0; i < len; ++i) {
+            ss_assert(chunk[i] == (int) ((pos + i) % 1000));
+        }
+        pos += len;
+        chunks += 1;
+    }
+    ss_assert(pos == 11000);
+    ss_assert(len == 0);
+    ss_assert(chunks < 11000 / SS_CONCURRENT_ARRAY_FIRST_SEGMENT);
+
+    ss_concurrent_array_int_free(&array, NULL);
+    ss_assert(array == NULL);
+}
+
+void reserve_and_commit_concurrent_array() {
+    struct ss_concurrent_array_int *array = ss_concurrent_array_int_create();
+
+    size_t a = ss_concurrent_array_int_reserve(array, 100);
+    size_t b = ss_concurrent_array_int_reserve(array, 50);
+    ss_assert(a == 0 && b == 100);
+    ss_assert(ss_concurrent_array_int_reserve(array, 0) == SIZE_MAX);
+    ss_assert(ss_concurrent_array_int_slot(array, 150) == NULL);
+
+    for (size_t i = 0; i < 150; ++i) {
+        *ss_concurrent_array_int_slot(array, i) = (int) i * 2;
+    }
+
+    // Nothing is visible until committed.
+    ss_assert(ss_concurrent_array_int_len(array) == 0);
+
+    ss_assert(ss_concurrent_array_int_commit(array, a, 100));
+    ss_assert(ss_concurrent_array_int_len(array) == 100);
+    ss_assert(ss_concurrent_array_int_get(array, 100) == NULL);
+
+    ss_assert(ss_concurrent_array_int_commit(array, b, 50));
+    ss_assert(ss_concurrent_array_int_len(array) == 150);
+    ss_assert(*ss_concurrent_array_int_get(array, 149) == 298);
+
+    ss_concurrent_array_int_free(&array, NULL);
+}
+
+struct concurrent_append_job {
+    struct ss_concurrent_array_int *array;
+    int id;
+    atomic_bool *done;
+};
+
+#define CONCURRENT_APPENDS_PER_THREAD 20000
+
+static void *append_concurrently(void *arg) {
+    struct concurrent_append_job *job = (struct concurrent_append_job*) arg;
+    int batch[7];
+    int next = 0;
+
+    while (next < CONCURRENT_APPENDS_PER_THREAD) {
+        // Vary the batch size to mix small and large reservations.
+        int n = next % 7 + 1;
+        if (n > CONCURRENT_APPENDS_PER_THREAD - next) {
+            n = CONCURRENT_APPENDS_PER_THREAD - next;
+        }
+
+        for (int i = 0; i < n; ++i) {
+            batch[i] = job->id * CONCURRENT_APPENDS_PER_THREAD + next + i;
+        }
+        ss_assert(ss_concurrent_array_int_append_data(job->array, batch,
+            (size_t) n));
+        next += n;
+    }
+    return NULL;
+}
+
+// Check that the committed prefix holds each writer's values in order.
+static void *scan_concurrently(void *arg) {
+    struct concurrent_append_job *job = (struct concurrent_append_job*) arg;
+
+    while (! atomic_load(job->done)) {
+        int last[4] = { -1, -1, -1, -1 };
+        size_t len = ss_concurrent_array_int_len(job->array);
+
+        for (size_t i = 0; i < len; ++i) {
+            int elem = *ss_concurrent_array_int_get(job->array, i);
+            int id = elem / CONCURRENT_APPENDS_PER_THREAD;
+            ss_assert(id >= 0 && id < 4);
+            ss_assert(elem > last[id]);
+            last[id] = elem;
+        }
+    }
+    return NULL;
+}
+
+void append_to_concurrent_array_from_threads() {
+    struct ss_concurrent_array_int *array = ss_concurrent_array_int_create();
+    atomic_bool done;
+    atomic_init(&done, false);
+
+    struct concurrent_append_job jobs[5];
+    pthread_t threads[5];
+
+    for (int i = 0; i < 5; ++i) {
+        jobs[i].array = array;
+        jobs[i].id = i;
+        jobs[i].done = &done;
+    }
+
+    ss_assert(pthread_create(&threads[4], NULL, scan_concurrently, &jobs[4])
+        == 0);
+    for (size_t i = 0; i < 4; ++i) {
+        ss_assert(pthread_create(&threads[i], NULL, append_concurrently,
+            &jobs[i]) == 0);
+    }
+    for (size_t i = 0; i < 4; ++i) { pthread_join(threads[i], NULL); }
+
+    atomic_store(&done, true);
+    pthread_join(threads[4], NULL);
+
+    size_t len = ss_concurrent_array_int_len(array);
+    ss_assert(len == 4 * CONCURRENT_APPENDS_PER_THREAD);
+
+    int last[4] = { -1, -1, -1, -1 };
+    for (size_t i = 0; i < len; ++i) {
+        int elem = *ss_concurrent_array_int_get(array, i);
+        int id = elem / CONCURRENT_APPENDS_PER_THREAD;
+        ss_assert(elem > last[id]);
+        last[id] = elem;
+    }
+    for (int i = 0; i < 4; ++i) {
+        ss_assert(last[i] == (i + 1) * CONCURRENT_APPENDS_PER_THREAD - 1);
+    }
+
+    ss_concurrent_array_int_free(&array, NULL);
+}
+
+#endif
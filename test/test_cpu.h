@@ -0,0 +1,153 @@
+#ifndef SS_LIB_TEST_CPU
+#define SS_LIB_TEST_CPU
+
+#include <stdint.h>
+#include <string.h>
+
+#include "ss_array.h"
+#include "ss_assert.h"
+#include "ss_cpu.h"
+#include "ss_encoding.h"
+#include "ss_numeric.h"
+#include "ss_string.h"
+#include "ss_utf8.h"
+
+typedef int (*cpu_test_fn)(void);
+
+static int cpu_test_scalar(void) { return SS_CPU_SCALAR; }
+static int cpu_test_sse2(void) { return SS_CPU_SSE2; }
+static int cpu_test_avx2(void) { return SS_CPU_AVX2; }
+
+// Get the level of the implementation that the table resolves to, or -1.
+static int cpu_test_resolved(struct ss_cpu_dispatch *dispatch) {
+    cpu_test_fn fn = (cpu_test_fn) ss_cpu_resolve(dispatch);
+    return fn == NULL ? -1 : fn();
+}
+
+void detect_cpu_features() {
+    enum ss_cpu_isa isa = ss_cpu_isa();
+    ss_assert(isa < SS_CPU_ISA_COUNT);
+    ss_assert(ss_cpu_isa() == isa);
+
+    ss_assert(ss_cpu_supports(SS_CPU_SCALAR));
+    ss_assert(ss_cpu_supports(isa));
+    ss_assert(isa == SS_CPU_AVX512 || ! ss_cpu_supports(isa + 1));
+    ss_assert(! ss_cpu_supports(SS_CPU_ISA_COUNT));
+
+    ss_assert(strcmp(ss_cpu_isa_name(SS_CPU_SCALAR), "scalar") == 0);
+    ss_assert(strcmp(ss_cpu_isa_name(SS_CPU_AVX512), "avx512") == 0);
+    ss_assert(ss_cpu_isa_name(SS_CPU_ISA_COUNT) == NULL);
+
+    // A level the CPU lacks cannot be forced.
+    enum ss_cpu_isa detected = ss_cpu_force_isa(SS_CPU_AVX512);
+    ss_assert(detected >= isa);
+
+    ss_assert(ss_cpu_force_isa(SS_CPU_SCALAR) == SS_CPU_SCALAR);
+    ss_assert(ss_cpu_isa() == SS_CPU_SCALAR);
+    ss_assert(! ss_cpu_supports(SS_CPU_SSE2) || detected == SS_CPU_SCALAR);
+
+    ss_cpu_force_isa(isa);
+    ss_assert(ss_cpu_isa() == isa);
+}
+
+void dispatch_cpu_kernels() {
+    enum ss_cpu_isa isa = ss_cpu_isa();
+
+    static struct ss_cpu_dispatch dispatch = {
+        .impls = {
+            [SS_CPU_SCALAR] = (ss_cpu_fn) cpu_test_scalar,
+            [SS_CPU_SSE2] = (ss_cpu_fn) cpu_test_sse2,
+            [SS_CPU_AVX2] = (ss_cpu_fn) cpu_test_avx2
+        }
+    };
+
+    // Each level uses the closest implementation at or below it.
+    int expected[] = { 0, 1, 1, 3, 3 };
+    for (int i = 0; i < SS_CPU_ISA_COUNT; ++i) {
+        enum ss_cpu_isa forced = ss_cpu_force_isa((enum ss_cpu_isa) i);
+        ss_assert(cpu_test_resolved(&dispatch) == expected[forced]);
+        // Cached
+        ss_assert(cpu_test_resolved(&dispatch) == expected[forced]);
+    }
+
+    // Registering replaces the cached choice.
+    ss_cpu_force_isa(SS_CPU_SSSE3);
+    ss_assert(ss_cpu_register(&dispatch, SS_CPU_SSE2,
+        (ss_cpu_fn) cpu_test_avx2));
+    ss_assert(cpu_test_resolved(&dispatch)
+        == (ss_cpu_isa() >= SS_CPU_SSE2 ? SS_CPU_AVX2 : SS_CPU_SCALAR));
+
+    ss_assert(! ss_cpu_register(&dispatch, SS_CPU_ISA_COUNT, NULL));
+    ss_assert(! ss_cpu_register(NULL, SS_CPU_SCALAR, NULL));
+
+    // A table without a scalar implementation resolves to NULL at that level.
+    static struct ss_cpu_dispatch vector_only = {
+        .impls = { [SS_CPU_SSE2] = (ss_cpu_fn) cpu_test_sse2 }
+    };
+    ss_cpu_force_isa(SS_CPU_SCALAR);
+    ss_assert(cpu_test_resolved(&vector_only) == -1);
+    ss_assert(ss_cpu_resolve(NULL) == NULL);
+
+    ss_cpu_force_isa(isa);
+}
+
+// Every implementation of the dispatched kernels gives the same results.
+void run_cpu_kernels_at_each_level() {
+    enum ss_cpu_isa isa = ss_cpu_isa();
+
+    int32_t ints[1000];
+    int64_t longs[1000];
+    double doubles[1000];
+    for (int32_t i = 0; i < 1000; ++i) {
+        ints[i] = i % 7 - 3;
+        longs[i] = (int64_t) (i % 11) * 1000003;
+        doubles[i] = (double) (i % 5);
+    }
+    ints[777] = -10;
+
+    int64_t dot = 0;
+    for (size_t i = 0; i < 1000; ++i) { dot += longs[i] * longs[i]; }
+
+    const char *text = "Dispatch each kernel: \xC3\xA9t\xC3\xA9, \xE2\x82\xAC, "
+        "\xF0\x9F\x98\x80 and enough ASCII to fill several blocks.";
+    char invalid[64];
+    memset(invalid, 'a', sizeof(invalid));
+    invalid[40] = (char) 0xC3;
+
+    struct ss_string *encoded = ss_string_create();
+    struct ss_array_bytes *decoded = ss_array_bytes_create();
+
+    for (int level = 0; level <= (int) isa; ++level) {
+        ss_cpu_force_isa((enum ss_cpu_isa) level);
+
+        int32_t min = 0;
+        int64_t max = 0;
+        ss_assert(ss_numeric_sum_i32(ints, 1000) == -10);
+        ss_assert(ss_numeric_min_i32(ints, 1000, &min) && min == -10);
+        ss_assert(ss_numeric_find_i32(ints, 1000, -10) == 777);
+        ss_assert(ss_numeric_count_i32(ints, 1000, 3) == 142);
+        ss_assert(ss_numeric_max_i64(longs, 1000, &max)
+            && max == 10 * (int64_t) 1000003);
+        ss_assert(ss_numeric_dot_i64(longs, longs, 1000) == dot);
+        ss_assert(ss_numeric_sum_f64(doubles, 1000) == 2000.0);
+        ss_assert(ss_numeric_dot_f64(doubles, doubles, 1000) == 6000.0);
+
+        ss_assert(ss_utf8_validate(text, strlen(text)));
+        ss_assert(! ss_utf8_validate(invalid, sizeof(invalid)));
+
+        ss_string_clear(encoded);
+        ss_array_bytes_clear(decoded);
+        ss_assert(ss_string_append_base64(encoded, (const uint8_t*) text,
+            strlen(text)));
+        const char *base64 = ss_string_as_cstring(encoded);
+        ss_assert(ss_base64_decode(decoded, base64, strlen(base64)));
+        ss_assert(ss_array_bytes_len(decoded) == strlen(text));
+        ss_assert(memcmp(ss_array_bytes_ptr(decoded), text, strlen(text)) == 0);
+    }
+
+    ss_string_free(&encoded);
+    ss_array_bytes_free(&decoded, NULL);
+    ss_cpu_force_isa(isa);
+}
+
+#endif
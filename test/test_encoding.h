@@ -0,0 +1,180 @@
+#ifndef SS_LIB_TEST_ENCODING
+#define SS_LIB_TEST_ENCODING
+
+#include <stdint.h>
+#include <string.h>
+
+#include "ss_assert.h"
+#include "ss_encoding.h"
+#include "ss_string.h"
+
+void append_hex_to_string() {
+    const uint8_t data[] = { 0x00, 0x01, 0xAB, 0xFF, 0x7E };
+    struct ss_string *s = ss_string_create_from_cstring("id=");
+
+    ss_assert(ss_string_append_hex(s, data, 5));
+    ss_assert(strcmp(ss_string_as_cstring(s), "id=0001abff7e") == 0);
+    ss_assert(ss_string_len(s) == 14);
+
+    ss_assert(! ss_string_append_hex(s, data, 0));
+    ss_string_free(&s);
+}
+
+void append_base64_to_string() {
+    // RFC 4648 test vectors
+    const char *inputs[] = { "f", "fo", "foo", "foob", "fooba", "foobar" };
+    const char *outputs[] = {
+        "Zg==", "Zm8=", "Zm9v", "Zm9vYg==", "Zm9vYmE=", "Zm9vYmFy"
+    };
+
+    for (size_t i = 0; i < 6; ++i) {
+        struct ss_string *s = ss_string_create();
+        ss_assert(ss_string_append_base64(s,
+            (const uint8_t*) inputs[i], strlen(inputs[i])));
+        ss_assert_msg(strcmp(ss_string_as_cstring(s), outputs[i]) == 0,
+            "encoded '%s' as '%s'\n", inputs[i], ss_string_as_cstring(s));
+        ss_string_free(&s);
+    }
+}
+
+void append_json_escaped_to_string() {
+    struct ss_string *s = ss_string_create_from_cstring("\"");
+
+    // Specials on both sides of the 16-byte vectorized blocks.
+    const char *src = "a \"quoted\" path: C:\\dir\n\ttab\x01\x1f end";
+    ss_assert(ss_string_append_json_escaped(s, src, strlen(src)));
+    ss_assert(ss_string_append_char(s, '"'));
+
+    const char *expected =
+        "\"a \\\"quoted\\\" path: C:\\\\dir\\n\\ttab\\u0001\\u001f end\"";
+    ss_assert_msg(strcmp(ss_string_as_cstring(s), expected) == 0,
+        "escaped as '%s'\n", ss_string_as_cstring(s));
+    ss_assert(ss_string_len(s) == strlen(expected) + 1);
+
+    ss_assert(! ss_string_append_json_escaped(s, src, 0));
+    ss_string_free(&s);
+
+    // Clean input, including UTF-8, is copied unchanged.
+    s = ss_string_create();
+    src = "plain text that is longer than one block, caf\xc3\xa9";
+    ss_assert(ss_string_append_json_escaped(s, src, strlen(src)));
+    ss_assert(strcmp(ss_string_as_cstring(s), src) == 0);
+    ss_string_free(&s);
+}
+
+void append_csv_field_to_string() {
+    struct ss_string *s = ss_string_create();
+
+    ss_assert(ss_string_append_csv_field(s, "plain", 5));
+    ss_assert(ss_string_append_char(s, ','));
+    ss_assert(ss_string_append_csv_field(s, "a, b", 4));
+    ss_assert(ss_string_append_char(s, ','));
+    ss_assert(ss_string_append_csv_field(s, "say \"hi\"", 8));
+    ss_assert(ss_string_append_char(s, ','));
+    ss_assert(ss_string_append_csv_field(s, "two\r\nlines", 10));
+
+    const char *expected =
+        "plain,\"a, b\",\"say \"\"hi\"\"\",\"two\r\nlines\"";
+    ss_assert_msg(strcmp(ss_string_as_cstring(s), expected) == 0,
+        "field written as '%s'\n", ss_string_as_cstring(s));
+
+    ss_assert(! ss_string_append_csv_field(s, "x", 0));
+    ss_string_free(&s);
+
+    // A quote past the first vectorized block.
+    s = ss_string_create();
+    const char *src = "0123456789abcdefghij\"";
+    ss_assert(ss_string_append_csv_field(s, src, strlen(src)));
+    ss_assert(strcmp(ss_string_as_cstring(s),
+        "\"0123456789abcdefghij\"\"\"") == 0);
+    ss_string_free(&s);
+}
+
+void decode_hex_into_byte_array() {
+    struct ss_array_bytes *bytes = ss_array_bytes_create();
+
+    ss_assert(ss_hex_decode(bytes, "0001aBfF7e", 10));
+    ss_assert(ss_array_bytes_len(bytes) == 5);
+
+    const uint8_t *data = ss_array_bytes_ptr(bytes);
+    ss_assert(data[0] == 0x00 && data[1] == 0x01 && data[2] == 0xAB);
+    ss_assert(data[3] == 0xFF && data[4] == 0x7E);
+
+    ss_assert(! ss_hex_decode(bytes, "abc", 3));
+    ss_assert(! ss_hex_decode(bytes, "zz", 2));
+    ss_assert(ss_array_bytes_len(bytes) == 5);
+
+    ss_array_bytes_free(&bytes, NULL);
+}
+
+void decode_base64_into_byte_array() {
+    struct ss_array_bytes *bytes = ss_array_bytes_create();
+
+    ss_assert(ss_base64_decode(bytes, "Zm9vYmE=", 8));
+    ss_assert(ss_array_bytes_len(bytes) == 5);
+    ss_assert(memcmp(ss_array_bytes_ptr(bytes), "fooba", 5) == 0);
+
+    // Unpadded input is accepted.
+    ss_assert(ss_base64_decode(bytes, "Zm8", 3));
+    ss_assert(ss_array_bytes_len(bytes) == 7);
+    ss_assert(memcmp(ss_array_bytes_ptr(bytes), "foobafo", 7) == 0);
+
+    ss_assert(! ss_base64_decode(bytes, "Zm9v!mE=", 8));
+    ss_assert(! ss_base64_decode(bytes, "Z", 1));
+    ss_assert(ss_array_bytes_len(bytes) == 7);
+
+    ss_array_bytes_free(&bytes, NULL);
+}
+
+void encoding_round_trips() {
+    uint8_t data[200];
+    uint8_t decoded[200];
+    uint32_t r = 7;
+
+    for (size_t i = 0; i < sizeof(data); ++i) {
+        r = r * 1103515245u + 12345u;
+        data[i] = (uint8_t) (r >> 16);
+    }
+
+    for (size_t len = 1; len <= sizeof(data); ++len) {
+        struct ss_string *hex = ss_string_create();
+        struct ss_string *b64 = ss_string_create();
+
+        ss_assert(ss_string_append_hex(hex, data, len));
+        ss_assert(ss_string_append_base64(b64, data, len));
+
+        const char *h = ss_string_as_cstring(hex);
+        const char *b = ss_string_as_cstring(b64);
+        size_t h_len = ss_string_len(hex) - 1;
+        size_t b_len = ss_string_len(b64) - 1;
+
+        ss_assert(h_len == len * 2);
+        ss_assert(ss_hex_decode_buffer(h, h_len, decoded));
+        ss_assert(memcmp(decoded, data, len) == 0);
+
+        ss_assert(ss_base64_decoded_len(b, b_len) == len);
+        ss_assert(ss_base64_decode_buffer(b, b_len, decoded));
+        ss_assert_msg(memcmp(decoded, data, len) == 0, "len %li\n", len);
+
+        // Corrupt a char in the vectorized region, then in the tail.
+        char *corrupt = (char*) malloc(b_len);
+        memcpy(corrupt, b, b_len);
+        corrupt[0] = '*';
+        ss_assert(! ss_base64_decode_buffer(corrupt, b_len, decoded));
+        memcpy(corrupt, b, b_len);
+        corrupt[b_len > 4 ? b_len - 4 : 0] = '-';
+        ss_assert(! ss_base64_decode_buffer(corrupt, b_len, decoded));
+        free(corrupt);
+
+        corrupt = (char*) malloc(h_len);
+        memcpy(corrupt, h, h_len);
+        corrupt[h_len / 2] = 'g';
+        ss_assert(! ss_hex_decode_buffer(corrupt, h_len, decoded));
+        free(corrupt);
+
+        ss_string_free(&hex);
+        ss_string_free(&b64);
+    }
+}
+
+#endif
@@ -0,0 +1,160 @@
+#ifndef SS_LIB_TEST_HEAP
+#define SS_LIB_TEST_HEAP
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "ss_array.h"
+#include "ss_assert.h"
+#include "ss_heap.h"
+#include "test_array.h"
+
+static bool int_less(const int *a, const int *b) { return *a < *b; }
+
+#define INT_GREATER(A, B) (*(A) > *(B))
+
+GENERATE_HEAP(int, int_less)
+
+GENERATE_ARRAY2(int, int4)
+GENERATE_DARY_HEAP2(int, int4, int_less, 4)
+
+GENERATE_ARRAY2(int, intmax)
+GENERATE_HEAP2(int, intmax, INT_GREATER)
+
+static int heap_test_value(uint32_t *seed) {
+    *seed = *seed * 1103515245u + 12345u;
+    return (int) ((*seed >> 8) % 1000);
+}
+
+void push_and_pop_heap() {
+    struct ss_heap_int *heap = ss_heap_int_create();
+    ss_assert(heap != NULL);
+    ss_assert(ss_heap_int_is_empty(heap));
+    ss_assert(ss_heap_int_peek(heap) == NULL);
+
+    int elem = 0;
+    ss_assert(! ss_heap_int_pop(heap, &elem));
+
+    uint32_t seed = 1;
+    for (size_t i = 0; i < 1000; ++i) {
+        ss_assert(ss_heap_int_push(heap, heap_test_value(&seed)));
+    }
+    ss_assert(ss_heap_int_len(heap) == 1000);
+
+    int last = -1;
+    for (size_t i = 0; i < 1000; ++i) {
+        int top = *ss_heap_int_peek(heap);
+        ss_assert(ss_heap_int_pop(heap, &elem));
+        ss_assert(elem == top);
+        ss_assert(elem >= last);
+        last = elem;
+    }
+    ss_assert(ss_heap_int_is_empty(heap));
+
+    ss_heap_int_free(&heap, NULL);
+    ss_assert(heap == NULL);
+}
+
+void heapify_array() {
+    struct ss_array_int *array = ss_array_int_create_with_size(500);
+    uint32_t seed = 7;
+    for (size_t i = 0; i < 500; ++i) {
+        int value = heap_test_value(&seed);
+        ss_array_int_append_data(array, &value, 1);
+    }
+    int *data = array->data;
+
+    struct ss_heap_int *heap = ss_heap_int_create_from_array(&array);
+    ss_assert(heap != NULL);
+    ss_assert(array == NULL);
+    ss_assert(ss_heap_int_len(heap) == 500);
+
+    // The elements stay in the array's buffer, in heap order.
+    struct ss_array_int *heap_array = ss_heap_int_dissolve(&heap);
+    ss_assert(heap == NULL);
+    ss_assert(heap_array->data == data);
+    for (size_t i = 1; i < 500; ++i) {
+        ss_assert(data[(i - 1) / 2] <= data[i]);
+    }
+
+    heap = ss_heap_int_create_from_array(&heap_array);
+    int last = -1;
+    int elem = 0;
+    while (ss_heap_int_pop(heap, &elem)) {
+        ss_assert(elem >= last);
+        last = elem;
+    }
+
+    ss_heap_int_free(&heap, NULL);
+}
+
+void dary_heap() {
+    struct ss_heap_int4 *heap = ss_heap_int4_create_with_size(16);
+    uint32_t seed = 3;
+
+    for (size_t i = 0; i < 2000; ++i) {
+        ss_assert(ss_heap_int4_push(heap, heap_test_value(&seed)));
+    }
+
+    // Replace the least elements with larger ones, as a timer queue would.
+    int elem = 0;
+    for (size_t i = 0; i < 500; ++i) {
+        int top = *ss_heap_int4_peek(heap);
+        ss_assert(ss_heap_int4_replace(heap, top + 1000, &elem));
+        ss_assert(elem == top);
+    }
+    ss_assert(ss_heap_int4_len(heap) == 2000);
+
+    struct ss_array_int4 *array = ss_heap_int4_dissolve(&heap);
+    for (size_t i = 1; i < array->len; ++i) {
+        ss_assert(array->data[(i - 1) / 4] <= array->data[i]);
+    }
+
+    heap = ss_heap_int4_create_from_array(&array);
+    int last = -1;
+    while (ss_heap_int4_pop(heap, &elem)) {
+        ss_assert(elem >= last);
+        last = elem;
+    }
+
+    ss_heap_int4_free(&heap, NULL);
+}
+
+void heap_top_k() {
+    struct ss_heap_int *heap = ss_heap_int_create();
+    struct ss_array_int *all = ss_array_int_create();
+    uint32_t seed = 11;
+
+    for (size_t i = 0; i < 10000; ++i) {
+        int value = heap_test_value(&seed);
+        ss_heap_int_push_top_k(heap, value, 10);
+        ss_array_int_append_data(all, &value, 1);
+    }
+    ss_assert(ss_heap_int_len(heap) == 10);
+    ss_assert(! ss_heap_int_push_top_k(heap, -1, 10));
+    ss_assert(! ss_heap_int_push_top_k(heap, 1, 0));
+
+    // The ten greatest come out least first.
+    ss_array_int_sort(all, &cmp_int);
+    int elem = 0;
+    for (size_t i = 0; i < 10; ++i) {
+        ss_assert(ss_heap_int_pop(heap, &elem));
+        ss_assert(elem == all->data[all->len - 10 + i]);
+    }
+
+    // With a max-heap, the ten least are kept.
+    struct ss_heap_intmax *max_heap = ss_heap_intmax_create();
+    for (size_t i = 0; i < all->len; ++i) {
+        ss_heap_intmax_push_top_k(max_heap, all->data[all->len - 1 - i], 10);
+    }
+    for (size_t i = 0; i < 10; ++i) {
+        ss_assert(ss_heap_intmax_pop(max_heap, &elem));
+        ss_assert(elem == all->data[9 - i]);
+    }
+
+    ss_array_int_free(&all, NULL);
+    ss_heap_int_free(&heap, NULL);
+    ss_heap_intmax_free(&max_heap, NULL);
+}
+
+#endif
@@ -0,0 +1,136 @@
+#ifndef SS_LIB_TEST_MULTISEARCH
+#define SS_LIB_TEST_MULTISEARCH
+
+#include <stdint.h>
+#include <string.h>
+
+#include "ss_assert.h"
+#include "ss_multisearch.h"
+#include "ss_string.h"
+
+void create_multisearch() {
+    const char *patterns[] = { "he", "she", "his", "hers" };
+    struct ss_multisearch *ms = ss_multisearch_create(patterns, 4);
+    ss_assert(ms != NULL);
+    ss_assert(ss_multisearch_pattern_count(ms) == 4);
+
+    ss_multisearch_free(&ms);
+    ss_assert(ms == NULL);
+
+    const char *empty[] = { "he", "" };
+    ss_assert(ss_multisearch_create(empty, 2) == NULL);
+    ss_assert(ss_multisearch_create(patterns, 0) == NULL);
+}
+
+void find_all_overlapping_matches() {
+    const char *patterns[] = { "he", "she", "his", "hers" };
+    struct ss_multisearch *ms = ss_multisearch_create(patterns, 4);
+    struct ss_array_multisearch_match *matches =
+        ss_array_multisearch_match_create();
+
+    ss_assert(ss_multisearch_find_all(ms, "ushers", 6, matches));
+    ss_assert(ss_array_multisearch_match_len(matches) == 3);
+
+    // "she" and "he" end at the same position; the longer is reported first.
+    const struct ss_multisearch_match *m =
+        ss_array_multisearch_match_ptr(matches);
+    ss_assert(m[0].pattern == 1 && m[0].offset == 1);
+    ss_assert(m[1].pattern == 0 && m[1].offset == 2);
+    ss_assert(m[2].pattern == 3 && m[2].offset == 2);
+
+    ss_array_multisearch_match_free(&matches, NULL);
+    ss_multisearch_free(&ms);
+}
+
+static bool count_pattern_matches(
+    const struct ss_multisearch_match *match,
+    void *ctx
+) {
+    size_t *counts = (size_t*) ctx;
+    counts[match->pattern] += 1;
+    return true;
+}
+
+void scan_string_with_callback() {
+    const char *patterns[] = { "error", "warn", "err", "error" };
+    struct ss_multisearch *ms = ss_multisearch_create(patterns, 4);
+    struct ss_string *s = ss_string_create_from_cstring(
+        "warn: disk error; errno set; warning");
+
+    size_t counts[4] = { 0 };
+    ss_assert(ss_string_multisearch_scan(s, ms, count_pattern_matches, counts)
+        == 6);
+
+    // Duplicate patterns each report their own matches.
+    ss_assert(counts[0] == 1 && counts[3] == 1);
+    ss_assert(counts[1] == 2);
+    ss_assert(counts[2] == 2);
+
+    ss_assert(ss_string_multisearch_contains_any(s, ms));
+    ss_string_free(&s);
+
+    s = ss_string_create_from_cstring("all good here");
+    ss_assert(! ss_string_multisearch_contains_any(s, ms));
+    ss_string_free(&s);
+
+    ss_multisearch_free(&ms);
+}
+
+void multisearch_matches_naive_search() {
+    // A small alphabet produces many overlapping and nested matches.
+    char pattern_buf[40][6];
+    const char *patterns[40];
+    size_t lens[40];
+    char text[500];
+    uint32_t r = 42;
+
+    for (size_t i = 0; i < 40; ++i) {
+        r = r * 1103515245u + 12345u;
+        lens[i] = 1 + (r >> 16) % 5;
+        for (size_t j = 0; j < lens[i]; ++j) {
+            r = r * 1103515245u + 12345u;
+            pattern_buf[i][j] = (char) ('a' + (r >> 16) % 3);
+        }
+        patterns[i] = pattern_buf[i];
+    }
+
+    for (size_t i = 0; i < sizeof(text); ++i) {
+        r = r * 1103515245u + 12345u;
+        // Include bytes that appear in no pattern.
+        text[i] = (char) ('a' + (r >> 16) % 4);
+    }
+
+    struct ss_multisearch *ms =
+        ss_multisearch_create_from_data(patterns, lens, 40);
+    struct ss_array_multisearch_match *matches =
+        ss_array_multisearch_match_create();
+
+    ss_assert(ss_multisearch_find_all(ms, text, sizeof(text), matches));
+
+    size_t expected = 0;
+    for (size_t p = 0; p < 40; ++p) {
+        for (size_t i = 0; i + lens[p] <= sizeof(text); ++i) {
+            if (memcmp(text + i, patterns[p], lens[p]) != 0) continue;
+            expected += 1;
+
+            bool found = false;
+            for (size_t m = 0; m < ss_array_multisearch_match_len(matches); ++m)
+            {
+                struct ss_multisearch_match *match =
+                    ss_array_multisearch_match_get(matches, m);
+                if (match->pattern == p && match->offset == i) {
+                    found = true;
+                    break;
+                }
+            }
+            ss_assert_msg(found, "pattern %zu at %zu not found\n", p, i);
+        }
+    }
+
+    ss_assert(ss_array_multisearch_match_len(matches) == expected);
+
+    ss_array_multisearch_match_free(&matches, NULL);
+    ss_multisearch_free(&ms);
+}
+
+#endif
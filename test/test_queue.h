@@ -0,0 +1,218 @@
+#ifndef SS_LIB_TEST_QUEUE
+#define SS_LIB_TEST_QUEUE
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "ss_assert.h"
+#include "ss_queue.h"
+
+GENERATE_SPSC_QUEUE(int)
+GENERATE_MPMC_QUEUE(int)
+
+#define QUEUE_TEST_ELEMS 100000
+
+void spsc_queue_push_and_pop() {
+    ss_assert(ss_spsc_queue_int_create(0) == NULL);
+
+    struct ss_spsc_queue_int *queue = ss_spsc_queue_int_create(5);
+    ss_assert(queue != NULL);
+    ss_assert(ss_spsc_queue_int_capacity(queue) == 8);
+
+    int elem = 0;
+    ss_assert(! ss_spsc_queue_int_try_pop(queue, &elem));
+
+    for (int i = 0; i < 8; ++i) {
+        ss_assert(ss_spsc_queue_int_try_push(queue, i));
+    }
+    ss_assert(! ss_spsc_queue_int_try_push(queue, 8));
+
+    for (int i = 0; i < 5; ++i) {
+        ss_assert(ss_spsc_queue_int_try_pop(queue, &elem));
+        ss_assert(elem == i);
+    }
+
+    // A batch that wraps around the end of the buffer is cut short when full.
+    int data[] = { 10, 11, 12, 13, 14, 15 };
+    ss_assert(ss_spsc_queue_int_try_push_batch(queue, data, 6) == 5);
+
+    int out[16];
+    ss_assert(ss_spsc_queue_int_try_pop_batch(queue, out, 16) == 8);
+    int expected[] = { 5, 6, 7, 10, 11, 12, 13, 14 };
+    for (size_t i = 0; i < 8; ++i) { ss_assert(out[i] == expected[i]); }
+
+    ss_assert(ss_spsc_queue_int_try_pop_batch(queue, out, 16) == 0);
+
+    ss_spsc_queue_int_free(&queue, NULL);
+    ss_assert(queue == NULL);
+}
+
+static void *spsc_produce(void *arg) {
+    struct ss_spsc_queue_int *queue = (struct ss_spsc_queue_int*) arg;
+    int batch[13];
+    int next = 0;
+
+    // Alternate single pushes and batches.
+    while (next < QUEUE_TEST_ELEMS) {
+        if (next % 2 == 0 || QUEUE_TEST_ELEMS - next < 13) {
+            ss_spsc_queue_int_push(queue, next++);
+        } else {
+            for (int i = 0; i < 13; ++i) { batch[i] = next + i; }
+            ss_spsc_queue_int_push_batch(queue, batch, 13);
+            next += 13;
+        }
+    }
+    return NULL;
+}
+
+void spsc_queue_between_threads() {
+    struct ss_spsc_queue_int *queue = ss_spsc_queue_int_create(64);
+    pthread_t producer;
+    ss_assert(pthread_create(&producer, NULL, spsc_produce, queue) == 0);
+
+    int expected = 0;
+    int out[10];
+
+    while (expected < QUEUE_TEST_ELEMS) {
+        if (expected % 3 == 0) {
+            int elem = 0;
+            ss_spsc_queue_int_pop(queue, &elem);
+            ss_assert(elem == expected++);
+        } else {
+            size_t n = ss_spsc_queue_int_pop_batch(queue, out, 10);
+            ss_assert(n > 0 && n <= 10);
+            for (size_t i = 0; i < n; ++i) {
+                ss_assert(out[i] == expected++);
+            }
+        }
+    }
+
+    pthread_join(producer, NULL);
+    ss_spsc_queue_int_free(&queue, NULL);
+}
+
+void mpmc_queue_push_and_pop() {
+    ss_assert(ss_mpmc_queue_int_create(0) == NULL);
+
+    struct ss_mpmc_queue_int *queue = ss_mpmc_queue_int_create(1);
+    ss_assert(ss_mpmc_queue_int_capacity(queue) == 2);
+    ss_mpmc_queue_int_free(&queue, NULL);
+
+    queue = ss_mpmc_queue_int_create(4);
+    int elem = 0;
+    ss_assert(! ss_mpmc_queue_int_try_pop(queue, &elem));
+
+    int data[] = { 1, 2, 3, 4, 5, 6 };
+    ss_assert(ss_mpmc_queue_int_try_push_batch(queue, data, 6) == 4);
+    ss_assert(! ss_mpmc_queue_int_try_push(queue, 5));
+
+    ss_assert(ss_mpmc_queue_int_try_pop(queue, &elem));
+    ss_assert(elem == 1);
+    ss_assert(ss_mpmc_queue_int_try_push(queue, 5));
+
+    int out[8];
+    ss_assert(ss_mpmc_queue_int_try_pop_batch(queue, out, 8) == 4);
+    for (size_t i = 0; i < 4; ++i) { ss_assert(out[i] == (int) i + 2); }
+
+    // Wrap around several times.
+    for (int i = 0; i < 100; ++i) {
+        ss_assert(ss_mpmc_queue_int_try_push_batch(queue, data, 3) == 3);
+        ss_assert(ss_mpmc_queue_int_try_pop_batch(queue, out, 8) == 3);
+        ss_assert(out[0] == 1 && out[2] == 3);
+    }
+
+    ss_mpmc_queue_int_free(&queue, NULL);
+}
+
+struct mpmc_test_job {
+    struct ss_mpmc_queue_int *queue;
+    int id;
+    atomic_uchar *seen;
+    atomic_size_t *consumed;
+};
+
+#define MPMC_TEST_THREADS 3
+
+static void *mpmc_produce(void *arg) {
+    struct mpmc_test_job *job = (struct mpmc_test_job*) arg;
+    int batch[5];
+
+    for (int i = 0; i < QUEUE_TEST_ELEMS; i += 5) {
+        for (int j = 0; j < 5; ++j) {
+            batch[j] = job->id * QUEUE_TEST_ELEMS + i + j;
+        }
+        ss_mpmc_queue_int_push_batch(job->queue, batch, 5);
+    }
+    return NULL;
+}
+
+static void *mpmc_consume(void *arg) {
+    struct mpmc_test_job *job = (struct mpmc_test_job*) arg;
+    size_t total = MPMC_TEST_THREADS * QUEUE_TEST_ELEMS;
+    int last[MPMC_TEST_THREADS] = { -1, -1, -1 };
+    int out[7];
+
+    while (atomic_load(job->consumed) < total) {
+        size_t n = ss_mpmc_queue_int_try_pop_batch(job->queue, out, 7);
+        if (n == 0) {
+            sched_yield();
+            continue;
+        }
+
+        for (size_t i = 0; i < n; ++i) {
+            // Each producer's elements arrive in order.
+            int producer = out[i] / QUEUE_TEST_ELEMS;
+            ss_assert(out[i] > last[producer]);
+            last[producer] = out[i];
+
+            atomic_fetch_add(&job->seen[out[i]], 1);
+        }
+        atomic_fetch_add(job->consumed, n);
+    }
+    return NULL;
+}
+
+void mpmc_queue_between_threads() {
+    struct ss_mpmc_queue_int *queue = ss_mpmc_queue_int_create(32);
+    size_t total = MPMC_TEST_THREADS * QUEUE_TEST_ELEMS;
+    atomic_uchar *seen = (atomic_uchar*) malloc(total * sizeof(atomic_uchar));
+    for (size_t i = 0; i < total; ++i) { atomic_init(&seen[i], 0); }
+
+    atomic_size_t consumed;
+    atomic_init(&consumed, 0);
+
+    struct mpmc_test_job jobs[MPMC_TEST_THREADS];
+    pthread_t producers[MPMC_TEST_THREADS];
+    pthread_t consumers[MPMC_TEST_THREADS];
+
+    for (int i = 0; i < MPMC_TEST_THREADS; ++i) {
+        jobs[i].queue = queue;
+        jobs[i].id = i;
+        jobs[i].seen = seen;
+        jobs[i].consumed = &consumed;
+    }
+
+    for (size_t i = 0; i < MPMC_TEST_THREADS; ++i) {
+        ss_assert(pthread_create(&consumers[i], NULL, mpmc_consume, &jobs[i])
+            == 0);
+        ss_assert(pthread_create(&producers[i], NULL, mpmc_produce, &jobs[i])
+            == 0);
+    }
+
+    for (size_t i = 0; i < MPMC_TEST_THREADS; ++i) {
+        pthread_join(producers[i], NULL);
+        pthread_join(consumers[i], NULL);
+    }
+
+    for (size_t i = 0; i < total; ++i) {
+        ss_assert_msg(atomic_load(&seen[i]) == 1, "%zu\n", i);
+    }
+
+    free(seen);
+    ss_mpmc_queue_int_free(&queue, NULL);
+}
+
+#endif
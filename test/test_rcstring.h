@@ -0,0 +1,70 @@
+#ifndef SS_LIB_TEST_RCSTRING
+#define SS_LIB_TEST_RCSTRING
+
+#include <string.h>
+
+#include "ss_assert.h"
+#include "ss_rcstring.h"
+#include "ss_string.h"
+
+void create_rcstring_from_cstring() {
+    struct ss_rcstring *s = ss_rcstring_create_from_cstring("shared");
+    ss_assert(s != NULL);
+    ss_assert(ss_rcstring_len(s) == 7);
+    ss_assert(strcmp(ss_rcstring_as_cstring(s), "shared") == 0);
+
+    ss_rcstring_release(&s);
+    ss_assert(s == NULL);
+}
+
+void create_rcstring_from_string_takes_buffer() {
+    struct ss_string *str = ss_string_create_from_cstring("abc");
+    ss_string_append_cstring(str, "def");
+    const char *buf = ss_string_as_cstring(str);
+
+    struct ss_rcstring *s = ss_rcstring_create_from_string(&str);
+    ss_assert(str == NULL);
+    ss_assert(ss_rcstring_as_cstring(s) == buf);
+    ss_assert(ss_rcstring_len(s) == 7);
+    ss_assert(strcmp(ss_rcstring_as_cstring(s), "abcdef") == 0);
+
+    ss_rcstring_release(&s);
+
+    str = ss_string_create();
+    s = ss_rcstring_create_from_string(&str);
+    ss_assert(str == NULL);
+    ss_assert(strcmp(ss_rcstring_as_cstring(s), "") == 0);
+    ss_rcstring_release(&s);
+}
+
+void retain_and_release_rcstring() {
+    struct ss_rcstring *s = ss_rcstring_create_from_cstring("abc");
+    struct ss_rcstring *s2 = ss_rcstring_retain(s);
+    struct ss_rcstring *s3 = ss_rcstring_retain(s);
+    ss_assert(s2 == s && s3 == s);
+
+    ss_rcstring_release(&s);
+    ss_rcstring_release(&s2);
+    ss_assert(strcmp(ss_rcstring_as_cstring(s3), "abc") == 0);
+    ss_rcstring_release(&s3);
+}
+
+void compare_rcstrings() {
+    struct ss_rcstring *s1 = ss_rcstring_create_from_cstring("ab");
+    struct ss_rcstring *s2 = ss_rcstring_create_from_data("abc", 2);
+    struct ss_rcstring *s3 = ss_rcstring_create_from_cstring("ac");
+
+    ss_assert(ss_rcstring_cmp(s1, s2) == 0);
+    ss_assert(ss_rcstring_cmp(s1, s3) != 0);
+    ss_assert(ss_rcstring_cmp(s1, NULL) == -1);
+
+    struct ss_string *copy = ss_rcstring_to_string(s3);
+    ss_assert(strcmp(ss_string_as_cstring(copy), "ac") == 0);
+
+    ss_string_free(&copy);
+    ss_rcstring_release(&s1);
+    ss_rcstring_release(&s2);
+    ss_rcstring_release(&s3);
+}
+
+#endif
@@ -0,0 +1,200 @@
+#ifndef SS_LIB_TEST_ROPE
+#define SS_LIB_TEST_ROPE
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ss_assert.h"
+#include "ss_rope.h"
+#include "ss_string.h"
+
+// Compare the rope's contents with a C string.
+static bool rope_equals(const struct ss_rope *rope, const char *expected) {
+    size_t len = strlen(expected);
+    if (ss_rope_len(rope) != len) return false;
+
+    for (size_t i = 0; i < len; ++i) {
+        if (ss_rope_char_at(rope, i) != expected[i]) return false;
+    }
+    return true;
+}
+
+void default_rope_is_empty() {
+    struct ss_rope *rope = ss_rope_create();
+    ss_assert(rope != NULL);
+    ss_assert(ss_rope_len(rope) == 0);
+    ss_assert(ss_rope_char_at(rope, 0) == '\0');
+
+    ss_rope_free(&rope);
+    ss_assert(rope == NULL);
+}
+
+void insert_into_rope() {
+    struct ss_rope *rope = ss_rope_create_from_cstring("helld");
+    ss_assert(ss_rope_insert(rope, 3, "lo wor", 6));
+    ss_assert(rope_equals(rope, "hello world"));
+
+    ss_assert(ss_rope_insert(rope, 0, ">", 1));
+    ss_assert(ss_rope_append(rope, "!", 1));
+    ss_assert(rope_equals(rope, ">hello world!"));
+
+    ss_assert(! ss_rope_insert(rope, 100, "x", 1));
+    ss_assert(! ss_rope_insert(rope, 0, "x", 0));
+    ss_assert(rope_equals(rope, ">hello world!"));
+
+    ss_rope_free(&rope);
+}
+
+void delete_from_rope() {
+    struct ss_rope *rope = ss_rope_create_from_cstring("hello");
+    ss_rope_append(rope, " big", 4);
+    ss_rope_append(rope, " world", 6);
+
+    ss_assert(ss_rope_delete(rope, 3, 6));
+    ss_assert(rope_equals(rope, "hel world"));
+
+    ss_assert(ss_rope_delete(rope, 4, 100));
+    ss_assert(rope_equals(rope, "hel "));
+
+    ss_assert(! ss_rope_delete(rope, 5, 1));
+
+    ss_rope_free(&rope);
+}
+
+void rope_substring() {
+    struct ss_rope *rope = ss_rope_create_from_cstring("abc");
+    ss_rope_append(rope, "defg", 4);
+    ss_rope_append(rope, "hij", 3);
+
+    struct ss_rope *sub = ss_rope_substr(rope, 2, 6);
+    ss_assert(rope_equals(sub, "cdefgh"));
+
+    // The substring shares buffers but is edited independently.
+    ss_rope_delete(rope, 0, 5);
+    ss_assert(rope_equals(rope, "fghij"));
+    ss_assert(rope_equals(sub, "cdefgh"));
+
+    ss_rope_free(&rope);
+    ss_assert(rope_equals(sub, "cdefgh"));
+    ss_rope_free(&sub);
+}
+
+void concat_ropes() {
+    struct ss_rope *a = ss_rope_create_from_cstring("abc");
+    struct ss_rope *b = ss_rope_create_from_cstring("def");
+
+    ss_assert(ss_rope_concat(a, &b));
+    ss_assert(b == NULL);
+    ss_assert(rope_equals(a, "abcdef"));
+    ss_assert(! ss_rope_concat(a, &a));
+
+    ss_rope_free(&a);
+}
+
+// Each rope draws its own priorities, so joining many small ropes keeps the
+// tree balanced.
+void concat_many_small_ropes() {
+    char expected[10001] = { 0 };
+    struct ss_rope *rope = ss_rope_create();
+
+    for (size_t i = 0; i < 10000; ++i) {
+        char c = (char) ('a' + i % 26);
+        expected[i] = c;
+
+        struct ss_rope *piece = ss_rope_create_from_data(&c, 1);
+        ss_assert(ss_rope_concat(rope, &piece));
+    }
+
+    ss_assert(rope_equals(rope, expected));
+    // About 30 on average; a list would be 10000 deep.
+    ss_assert(ss_rope_depth(rope) < 100);
+
+    // A substring of many pieces is built balanced as well.
+    struct ss_rope *sub = ss_rope_substr(rope, 1234, 5000);
+    ss_assert(ss_rope_len(sub) == 5000);
+    ss_assert(ss_rope_depth(sub) < 100);
+
+    expected[6234] = '\0';
+    ss_assert(rope_equals(sub, expected + 1234));
+
+    ss_assert(ss_rope_concat(rope, &sub));
+    ss_assert(ss_rope_len(rope) == 15000);
+    ss_assert(ss_rope_depth(rope) < 100);
+
+    ss_rope_free(&rope);
+}
+
+void iterate_rope_chunks() {
+    struct ss_rope *rope = ss_rope_create_from_cstring("ab");
+    ss_rope_append(rope, "cde", 3);
+    ss_rope_insert(rope, 1, "XY", 2);
+
+    struct ss_rope_iter iter = ss_rope_iter_create(rope);
+    const char *chunk = NULL;
+    size_t len = 0;
+    char buf[16] = { 0 };
+    size_t total = 0;
+    size_t num_chunks = 0;
+
+    while (ss_rope_iter_next(&iter, &chunk, &len)) {
+        memcpy(buf + total, chunk, len);
+        total += len;
+        num_chunks += 1;
+    }
+
+    ss_assert(total == 7);
+    ss_assert(num_chunks == 4);
+    ss_assert(strcmp(buf, "aXYbcde") == 0);
+
+    ss_rope_free(&rope);
+}
+
+void flatten_rope_to_string() {
+    struct ss_rope *rope = ss_rope_create_from_cstring("hello");
+    ss_rope_append(rope, " world", 6);
+
+    struct ss_string *s = ss_rope_to_string(rope);
+    ss_assert(strcmp(ss_string_as_cstring(s), "hello world") == 0);
+    ss_assert(ss_string_len(s) == 12);
+
+    ss_string_free(&s);
+    ss_rope_free(&rope);
+}
+
+void many_rope_edits_match_flat_buffer() {
+    char expected[4096] = { 0 };
+    size_t len = 0;
+    struct ss_rope *rope = ss_rope_create();
+    uint32_t r = 12345;
+
+    for (size_t i = 0; i < 2000; ++i) {
+        r = r * 1103515245u + 12345u;
+        size_t pos = len == 0 ? 0 : (r >> 8) % (len + 1);
+
+        if (len < 3000 && (r & 3) != 0) {
+            char c[3] = { (char) ('a' + (r >> 4) % 26), 'x', 'y' };
+            size_t n = 1 + (r >> 12) % 3;
+
+            memmove(expected + pos + n, expected + pos, len - pos);
+            memcpy(expected + pos, c, n);
+            len += n;
+            ss_assert(ss_rope_insert(rope, pos, c, n));
+        } else {
+            size_t n = (r >> 12) % 8;
+            if (n > len - pos) { n = len - pos; }
+
+            memmove(expected + pos, expected + pos + n, len - pos - n);
+            len -= n;
+            expected[len] = '\0';
+            ss_assert(ss_rope_delete(rope, pos, n));
+        }
+    }
+
+    expected[len] = '\0';
+    ss_assert(rope_equals(rope, expected));
+
+    ss_rope_free(&rope);
+}
+
+#endif
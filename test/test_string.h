@@ -58,6 +58,49 @@ void clearing_string_leaves_buffer_valid() {
     ss_string_free(&s);
 }
 
+void secure_clear_zeroes_string_buffer() {
+    struct ss_string *s = ss_string_create_from_cstring("secret value");
+    size_t cap = s->capacity;
+
+    ss_string_secure_clear(s);
+    ss_assert(s->len == 0);
+    ss_assert(s->capacity == cap);
+    ss_assert(ss_string_is_empty(s));
+
+    for (size_t i = 0; i < cap; ++i) { ss_assert(s->str[i] == '\0'); }
+
+    // The buffer is reused.
+    ss_assert(ss_string_append_cstring(s, "new"));
+    ss_assert(strcmp(ss_string_as_cstring(s), "new") == 0);
+
+    ss_string_free(&s);
+}
+
+void append_after_clear_reuses_buffer() {
+    struct ss_string *s = ss_string_create_from_cstring("test string");
+    char *buf = s->str;
+
+    ss_string_clear(s);
+    ss_assert(ss_string_append_char(s, 'h'));
+    ss_assert(ss_string_append_char(s, 'i'));
+    ss_assert(strcmp(s->str, "hi") == 0);
+    ss_assert(s->len == 3);
+
+    ss_string_clear(s);
+    ss_assert(ss_string_append_data(s, "abc", 3));
+    ss_assert(strcmp(s->str, "abc") == 0);
+    ss_assert(s->len == 4);
+
+    ss_string_secure_clear(s);
+    ss_assert(ss_string_append_char(s, 'x'));
+    ss_assert(ss_string_append_data(s, "yz", 2));
+    ss_assert(strcmp(s->str, "xyz") == 0);
+    ss_assert(s->len == 4);
+
+    ss_assert(s->str == buf);
+    ss_string_free(&s);
+}
+
 void append_cstring() {
     struct ss_string *s = ss_string_create_from_cstring("a");
     ss_string_append_cstring(s, "bcd");
@@ -193,4 +236,160 @@ void compare_strings() {
     ss_string_free(&s3);
 }
 
+void join_strings() {
+    struct ss_string *a = ss_string_create_from_cstring("usr");
+    struct ss_string *b = ss_string_create();
+    struct ss_string *c = ss_string_create_from_cstring("bin");
+    const struct ss_string *parts[] = { a, b, c };
+
+    struct ss_string *s = ss_string_join("/", parts, 3);
+    ss_assert_msg(strcmp(s->str, "usr//bin") == 0, "str is '%s'", s->str);
+    ss_assert_msg(s->len == 9, "len is %li", s->len);
+    ss_string_free(&s);
+
+    s = ss_string_join(NULL, parts, 3);
+    ss_assert_msg(strcmp(s->str, "usrbin") == 0, "str is '%s'", s->str);
+    ss_string_free(&s);
+
+    s = ss_string_join(", ", parts, 0);
+    ss_assert(s != NULL && ss_string_is_empty(s));
+    ss_string_free(&s);
+
+    ss_string_free(&a);
+    ss_string_free(&b);
+    ss_string_free(&c);
+}
+
+void join_cstrings() {
+    const char *parts[] = { "a", "bc", NULL, "d" };
+
+    struct ss_string *s = ss_string_join_cstrings(", ", parts, 4);
+    ss_assert_msg(strcmp(s->str, "a, bc, , d") == 0, "str is '%s'", s->str);
+    ss_assert_msg(s->len == 11, "len is %li", s->len);
+    ss_assert(s->capacity >= s->len);
+
+    ss_string_free(&s);
+}
+
+void concat_cstrings() {
+    struct ss_string *s = ss_string_concat("/tmp", "/", "file", ".txt", NULL);
+    ss_assert_msg(strcmp(s->str, "/tmp/file.txt") == 0, "str is '%s'", s->str);
+    ss_assert_msg(s->len == 14, "len is %li", s->len);
+    ss_string_free(&s);
+
+    s = ss_string_concat(NULL);
+    ss_assert(s != NULL && ss_string_is_empty(s));
+    ss_string_free(&s);
+}
+
+void concat_strings() {
+    struct ss_string *a = ss_string_create_from_cstring("ab");
+    struct ss_string *b = ss_string_create_from_cstring("");
+    struct ss_string *c = ss_string_create_from_cstring("cd");
+
+    struct ss_string *s = ss_string_concat_strings(a, b, c, a, NULL);
+    ss_assert_msg(strcmp(s->str, "abcdab") == 0, "str is '%s'", s->str);
+    ss_assert_msg(s->len == 7, "len is %li", s->len);
+
+    ss_string_free(&s);
+    ss_string_free(&a);
+    ss_string_free(&b);
+    ss_string_free(&c);
+}
+
+void dissolve_string() {
+    struct ss_string *s = ss_string_create_from_cstring("abc");
+    char *buf = NULL;
+
+    ss_assert(ss_string_dissolve(&s, &buf) == 4);
+    ss_assert(s == NULL);
+    ss_assert(strcmp(buf, "abc") == 0);
+    free(buf);
+
+    s = ss_string_create();
+    buf = NULL;
+    ss_assert(ss_string_dissolve(&s, &buf) == 0);
+    ss_assert(s == NULL && buf == NULL);
+}
+
+void adopt_string_buffer() {
+    char *buf = (char*) malloc(16);
+    memcpy(buf, "abc", 4);
+
+    struct ss_string *s = ss_string_adopt(buf, 4, 16);
+    ss_assert(s != NULL);
+    ss_assert(ss_string_as_cstring(s) == buf);
+    ss_assert(ss_string_len(s) == 4);
+
+    // Appending within the adopted capacity does not reallocate.
+    ss_assert(ss_string_append_cstring(s, "def"));
+    ss_assert(ss_string_as_cstring(s) == buf);
+    ss_assert(strcmp(ss_string_as_cstring(s), "abcdef") == 0);
+
+    // Hand the buffer back and forth.
+    char *out = NULL;
+    size_t len = ss_string_dissolve(&s, &out);
+    s = ss_string_adopt(out, len, len);
+    ss_assert(strcmp(ss_string_as_cstring(s), "abcdef") == 0);
+    ss_string_free(&s);
+
+    buf = (char*) malloc(4);
+    memcpy(buf, "abcd", 4);
+    ss_assert(ss_string_adopt(buf, 4, 4) == NULL);
+    ss_assert(ss_string_adopt(buf, 5, 4) == NULL);
+    free(buf);
+
+    s = ss_string_adopt(NULL, 0, 0);
+    ss_assert(s != NULL && ss_string_len(s) == 0);
+    ss_string_free(&s);
+}
+
+void reserve_and_commit_spare_capacity() {
+    struct ss_string *s = ss_string_create();
+    size_t avail = 0;
+
+    ss_assert(ss_string_spare(s, &avail) == NULL);
+    ss_assert(ss_string_reserve(s, 5));
+    ss_assert(s->capacity >= 6);
+
+    char *spare = ss_string_spare(s, &avail);
+    ss_assert(spare == s->str && avail >= 5);
+    memcpy(spare, "abc", 3);
+    ss_assert(ss_string_commit(s, 3));
+
+    ss_assert_msg(s->len == 4, "len is %li", s->len);
+    ss_assert(strcmp(s->str, "abc") == 0);
+
+    spare = ss_string_spare(s, &avail);
+    ss_assert(spare == s->str + 3);
+    ss_assert(! ss_string_commit(s, avail + 1));
+
+    ss_string_free(&s);
+}
+
+void hash_strings() {
+    const char *text = "a longer string to hash";
+    struct ss_string *a = ss_string_create_from_cstring(text);
+    struct ss_string *b = ss_string_create_from_cstring(text);
+    struct ss_string *empty = ss_string_create();
+
+    ss_assert(ss_string_hash(a) == ss_string_hash(b));
+    ss_assert(ss_string_hash(a) == ss_string_hash_data(text, strlen(text)));
+    ss_assert(ss_string_hash(empty) == ss_string_hash_data(NULL, 0));
+    ss_assert(ss_string_hash(NULL) == ss_string_hash_data("", 0));
+
+    // Every prefix hashes differently, including those ending mid-word.
+    for (size_t i = 0; i < strlen(text); ++i) {
+        ss_assert(ss_string_hash_data(text, i)
+            != ss_string_hash_data(text, i + 1));
+    }
+
+    ss_string_append_char(b, '!');
+    ss_assert(ss_string_hash(a) != ss_string_hash(b));
+
+    ss_string_free(&a);
+    ss_string_free(&b);
+    ss_string_free(&empty);
+}
+
 #endif
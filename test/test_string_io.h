@@ -0,0 +1,131 @@
+#ifndef SS_LIB_TEST_STRING_IO
+#define SS_LIB_TEST_STRING_IO
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "ss_assert.h"
+#include "ss_string.h"
+#include "ss_string_io.h"
+
+// Write `contents` to a new temporary file, storing its path in `path`.
+static void write_temp_file(char *path, const char *contents, size_t len) {
+    strcpy(path, "/tmp/ss_string_io_XXXXXX");
+    int fd = mkstemp(path);
+    ss_assert(fd >= 0);
+
+    size_t written = 0;
+    while (written < len) {
+        ssize_t n = write(fd, contents + written, len - written);
+        ss_assert(n > 0);
+        written += (size_t) n;
+    }
+
+    close(fd);
+}
+
+void read_file_into_string() {
+    char path[32];
+    write_temp_file(path, "line one\nline two\n", 18);
+
+    struct ss_string *s = ss_string_read_file(path);
+    ss_assert(s != NULL);
+    ss_assert_msg(ss_string_len(s) == 19, "len is %li", ss_string_len(s));
+    ss_assert(strcmp(ss_string_as_cstring(s), "line one\nline two\n") == 0);
+
+    ss_string_free(&s);
+    unlink(path);
+
+    ss_assert(ss_string_read_file("/nonexistent/ss_string_io") == NULL);
+}
+
+void read_fd_appends_to_string() {
+    // Larger than one read chunk, so the string has to grow.
+    size_t len = 10000;
+    char *data = (char*) malloc(len);
+    for (size_t i = 0; i < len; ++i) {
+        data[i] = (char) ('a' + i % 26);
+    }
+
+    char path[32];
+    write_temp_file(path, data, len);
+
+    struct ss_string *s = ss_string_create_from_cstring(">");
+    FILE *f = fopen(path, "r");
+    ss_assert(ss_string_read_fd(s, fileno(f)));
+    fclose(f);
+
+    ss_assert(ss_string_len(s) == len + 2);
+    ss_assert(ss_string_as_cstring(s)[0] == '>');
+    ss_assert(memcmp(ss_string_as_cstring(s) + 1, data, len) == 0);
+
+    ss_string_free(&s);
+    free(data);
+    unlink(path);
+}
+
+void map_file_view() {
+    char path[32];
+    write_temp_file(path, "mapped", 6);
+
+    struct ss_file_view *view = ss_file_view_open(path);
+    ss_assert(view != NULL);
+    ss_assert(ss_file_view_len(view) == 6);
+    ss_assert(memcmp(ss_file_view_data(view), "mapped", 6) == 0);
+
+    ss_file_view_close(&view);
+    ss_assert(view == NULL);
+    unlink(path);
+
+    write_temp_file(path, "", 0);
+    view = ss_file_view_open(path);
+    ss_assert(view != NULL && ss_file_view_len(view) == 0);
+    ss_file_view_close(&view);
+    unlink(path);
+}
+
+void read_lines_from_fd() {
+    char path[32];
+    const char *contents = "first\n\na much longer third line\nlast";
+    write_temp_file(path, contents, strlen(contents));
+
+    FILE *f = fopen(path, "r");
+    // A tiny buffer forces the reader to refill and grow.
+    struct ss_line_reader *reader = ss_line_reader_create(fileno(f), 4);
+
+    const char *expected[] = { "first", "", "a much longer third line", "last" };
+    const char *line = NULL;
+    size_t len = 0;
+    size_t i = 0;
+
+    while (ss_line_reader_next(reader, &line, &len)) {
+        ss_assert(i < 4);
+        ss_assert(len == strlen(expected[i]));
+        ss_assert(memcmp(line, expected[i], len) == 0);
+        i += 1;
+    }
+
+    ss_assert(i == 4);
+    ss_assert(! ss_line_reader_failed(reader));
+
+    ss_line_reader_free(&reader);
+    fclose(f);
+    unlink(path);
+}
+
+void iterate_lines_of_buffer() {
+    const char *data = "a\nbc\n";
+    struct ss_line_iter iter = ss_line_iter_create(data, strlen(data));
+    const char *line = NULL;
+    size_t len = 0;
+
+    ss_assert(ss_line_iter_next(&iter, &line, &len));
+    ss_assert(len == 1 && line == data);
+    ss_assert(ss_line_iter_next(&iter, &line, &len));
+    ss_assert(len == 2 && line == data + 2);
+    ss_assert(! ss_line_iter_next(&iter, &line, &len));
+}
+
+#endif
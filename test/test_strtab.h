@@ -0,0 +1,104 @@
+#ifndef SS_LIB_TEST_STRTAB
+#define SS_LIB_TEST_STRTAB
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "ss_assert.h"
+#include "ss_strtab.h"
+#include "ss_string.h"
+
+void default_strtab_is_empty() {
+    struct ss_strtab *tab = ss_strtab_create();
+    ss_assert(tab != NULL);
+    ss_assert(ss_strtab_len(tab) == 0);
+    ss_assert(ss_strtab_data_len(tab) == 0);
+    ss_assert(ss_strtab_get(tab, 0).data == NULL);
+    ss_assert(ss_strtab_cstring(tab, 0) == NULL);
+
+    ss_strtab_free(&tab);
+    ss_assert(tab == NULL);
+}
+
+void append_to_strtab() {
+    struct ss_strtab *tab = ss_strtab_create_with_size(2, 8);
+    struct ss_string *s = ss_string_create_from_cstring("string");
+
+    ss_assert(ss_strtab_append_cstring(tab, "first"));
+    ss_assert(ss_strtab_append(tab, "a\0b", 3));
+    ss_assert(ss_strtab_append_cstring(tab, ""));
+    ss_assert(ss_strtab_append_string(tab, s));
+    ss_assert(! ss_strtab_append(tab, NULL, 1));
+
+    ss_assert(ss_strtab_len(tab) == 4);
+    ss_assert(ss_strtab_data_len(tab) == 6 + 4 + 1 + 7);
+
+    ss_assert(strcmp(ss_strtab_cstring(tab, 0), "first") == 0);
+    ss_assert(strcmp(ss_strtab_cstring(tab, 2), "") == 0);
+    ss_assert(strcmp(ss_strtab_cstring(tab, 3), "string") == 0);
+
+    struct ss_strtab_view view = ss_strtab_get(tab, 1);
+    ss_assert(view.len == 3);
+    ss_assert(memcmp(view.data, "a\0b", 3) == 0);
+
+    // Strings are stored back to back.
+    ss_assert(ss_strtab_cstring(tab, 1) == ss_strtab_cstring(tab, 0) + 6);
+
+    ss_strtab_clear(tab);
+    ss_assert(ss_strtab_len(tab) == 0);
+    ss_assert(ss_strtab_append_cstring(tab, "again"));
+    ss_assert(strcmp(ss_strtab_cstring(tab, 0), "again") == 0);
+
+    ss_string_free(&s);
+    ss_strtab_free(&tab);
+}
+
+void sort_strtab() {
+    struct ss_strtab *tab = ss_strtab_create();
+    const char *input[] = { "pear", "apple", "", "app", "banana", "apple" };
+    const char *sorted[] = { "", "app", "apple", "apple", "banana", "pear" };
+
+    for (size_t i = 0; i < 6; ++i) {
+        ss_assert(ss_strtab_append_cstring(tab, input[i]));
+    }
+
+    ss_assert(ss_strtab_sort(tab));
+    ss_assert(ss_strtab_len(tab) == 6);
+
+    for (size_t i = 0; i < 6; ++i) {
+        ss_assert_msg(strcmp(ss_strtab_cstring(tab, i), sorted[i]) == 0,
+            "%zu: '%s'\n", i, ss_strtab_cstring(tab, i));
+    }
+
+    ss_strtab_free(&tab);
+}
+
+void dedup_strtab() {
+    struct ss_strtab *tab = ss_strtab_create();
+    char buf[16];
+
+    // 1000 strings with 100 distinct values
+    for (size_t i = 0; i < 1000; ++i) {
+        snprintf(buf, sizeof(buf), "key%zu", (i * 37) % 100);
+        ss_assert(ss_strtab_append_cstring(tab, buf));
+    }
+
+    ss_assert(ss_strtab_dedup(tab));
+    ss_assert(ss_strtab_len(tab) == 100);
+
+    size_t total = 0;
+    for (size_t i = 0; i < 100; ++i) {
+        struct ss_strtab_view view = ss_strtab_get(tab, i);
+        total += view.len + 1;
+
+        if (i > 0) {
+            ss_assert(strcmp(ss_strtab_cstring(tab, i - 1), view.data) < 0);
+        }
+    }
+    ss_assert(ss_strtab_data_len(tab) == total);
+
+    ss_strtab_free(&tab);
+}
+
+#endif
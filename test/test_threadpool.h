@@ -0,0 +1,181 @@
+#ifndef SS_LIB_TEST_THREADPOOL
+#define SS_LIB_TEST_THREADPOOL
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "ss_assert.h"
+#include "ss_threadpool.h"
+
+void create_threadpool() {
+    struct ss_threadpool *pool = ss_threadpool_create(3);
+    ss_assert(pool != NULL);
+    ss_assert(ss_threadpool_num_threads(pool) == 3);
+
+    ss_threadpool_free(&pool);
+    ss_assert(pool == NULL);
+
+    pool = ss_threadpool_create(0);
+    ss_assert(pool != NULL);
+    ss_assert(ss_threadpool_num_threads(pool) == ss_threadpool_num_cpus());
+
+    // Waiting with nothing submitted returns immediately.
+    ss_threadpool_wait(pool);
+    ss_threadpool_free(&pool);
+
+    ss_assert(! ss_threadpool_submit(NULL, NULL, NULL));
+    ss_assert(ss_threadpool_num_threads(NULL) == 0);
+}
+
+static void add_one_task(void *ctx) {
+    atomic_fetch_add((atomic_size_t*) ctx, 1);
+}
+
+struct spawning_task {
+    struct ss_threadpool *pool;
+    atomic_size_t *count;
+};
+
+// Submit more tasks from within a task.
+static void spawn_tasks(void *ctx) {
+    struct spawning_task *spawn = (struct spawning_task*) ctx;
+
+    for (size_t i = 0; i < 10; ++i) {
+        ss_assert(ss_threadpool_submit(spawn->pool, &add_one_task,
+            spawn->count));
+    }
+}
+
+void submit_tasks_and_wait() {
+    struct ss_threadpool *pool = ss_threadpool_create(4);
+    atomic_size_t count;
+    atomic_init(&count, 0);
+
+    for (size_t i = 0; i < 1000; ++i) {
+        ss_assert(ss_threadpool_submit(pool, &add_one_task, &count));
+    }
+    ss_assert(! ss_threadpool_submit(pool, NULL, &count));
+
+    ss_threadpool_wait(pool);
+    ss_assert(atomic_load(&count) == 1000);
+
+    struct spawning_task spawn = { .pool = pool, .count = &count };
+    for (size_t i = 0; i < 100; ++i) {
+        ss_assert(ss_threadpool_submit(pool, &spawn_tasks, &spawn));
+    }
+
+    ss_threadpool_wait(pool);
+    ss_assert(atomic_load(&count) == 2000);
+
+    // Freeing the pool waits for outstanding tasks.
+    for (size_t i = 0; i < 100; ++i) {
+        ss_assert(ss_threadpool_submit(pool, &add_one_task, &count));
+    }
+    ss_threadpool_free(&pool);
+    ss_assert(atomic_load(&count) == 2100);
+}
+
+struct visit_counts {
+    atomic_uchar *visits;
+    size_t grain;
+    atomic_size_t calls;
+};
+
+static void visit_range(size_t begin, size_t end, void *ctx) {
+    struct visit_counts *counts = (struct visit_counts*) ctx;
+    ss_assert(begin < end);
+    ss_assert(end - begin <= counts->grain);
+
+    for (size_t i = begin; i < end; ++i) {
+        atomic_fetch_add(&counts->visits[i], 1);
+    }
+    atomic_fetch_add(&counts->calls, 1);
+}
+
+void parallel_for_covers_range() {
+    struct ss_threadpool *pool = ss_threadpool_create(4);
+    size_t len = 100003;
+    size_t grains[] = { 1, 7, 1000, 200000 };
+
+    atomic_uchar *visits = (atomic_uchar*) malloc(len * sizeof(atomic_uchar));
+
+    for (size_t g = 0; g < 4; ++g) {
+        for (size_t i = 0; i < len; ++i) { atomic_init(&visits[i], 0); }
+
+        struct visit_counts counts = { .visits = visits, .grain = grains[g] };
+        atomic_init(&counts.calls, 0);
+
+        ss_parallel_for(pool, 3, len, grains[g], &visit_range, &counts);
+
+        for (size_t i = 0; i < len; ++i) {
+            ss_assert_msg(atomic_load(&visits[i]) == (i < 3 ? 0 : 1),
+                "grain %zu, pos %zu\n", grains[g], i);
+        }
+        ss_assert(atomic_load(&counts.calls) >= (len - 3) / grains[g]);
+    }
+
+    // An empty range calls nothing.
+    struct visit_counts counts = { .visits = visits, .grain = 1 };
+    atomic_init(&counts.calls, 0);
+    ss_parallel_for(pool, 5, 5, 1, &visit_range, &counts);
+    ss_assert(atomic_load(&counts.calls) == 0);
+
+    free(visits);
+    ss_threadpool_free(&pool);
+}
+
+void parallel_for_without_pool() {
+    atomic_uchar visits[100];
+    for (size_t i = 0; i < 100; ++i) { atomic_init(&visits[i], 0); }
+
+    struct visit_counts counts = { .visits = visits, .grain = 100 };
+    atomic_init(&counts.calls, 0);
+
+    ss_parallel_for(NULL, 0, 100, 1, &visit_range, &counts);
+
+    ss_assert(atomic_load(&counts.calls) == 1);
+    for (size_t i = 0; i < 100; ++i) {
+        ss_assert(atomic_load(&visits[i]) == 1);
+    }
+}
+
+struct nested_loop {
+    struct ss_threadpool *pool;
+    atomic_size_t sum;
+};
+
+static void sum_inner_range(size_t begin, size_t end, void *ctx) {
+    struct nested_loop *loop = (struct nested_loop*) ctx;
+
+    for (size_t i = begin; i < end; ++i) {
+        atomic_fetch_add(&loop->sum, i);
+    }
+}
+
+// Run an inner loop per outer index, with uneven amounts of work.
+static void run_inner_loops(size_t begin, size_t end, void *ctx) {
+    struct nested_loop *loop = (struct nested_loop*) ctx;
+
+    for (size_t i = begin; i < end; ++i) {
+        ss_parallel_for(loop->pool, 0, i * 10, 16, &sum_inner_range, loop);
+    }
+}
+
+void nested_parallel_for() {
+    struct ss_threadpool *pool = ss_threadpool_create(4);
+    struct nested_loop loop = { .pool = pool };
+    atomic_init(&loop.sum, 0);
+
+    ss_parallel_for(pool, 0, 200, 1, &run_inner_loops, &loop);
+
+    size_t expected = 0;
+    for (size_t i = 0; i < 200; ++i) {
+        for (size_t j = 0; j < i * 10; ++j) { expected += j; }
+    }
+    ss_assert(atomic_load(&loop.sum) == expected);
+
+    ss_threadpool_free(&pool);
+}
+
+#endif
@@ -0,0 +1,119 @@
+#ifndef SS_LIB_TEST_UTF8
+#define SS_LIB_TEST_UTF8
+
+#include <stdint.h>
+#include <string.h>
+
+#include "ss_assert.h"
+#include "ss_string.h"
+#include "ss_utf8.h"
+
+struct utf8_sample { const char *bytes; bool valid; };
+
+static const struct utf8_sample utf8_samples[] = {
+    { "a", true },
+    { "\xC2\xA9", true },                  // U+00A9
+    { "\xE2\x82\xAC", true },              // U+20AC
+    { "\xED\x9F\xBF", true },              // U+D7FF
+    { "\xEF\xBF\xBD", true },              // U+FFFD
+    { "\xF0\x9F\x98\x80", true },          // U+1F600
+    { "\xF4\x8F\xBF\xBF", true },          // U+10FFFF
+    { "\x80", false },                     // Lone continuation
+    { "\xC0\xAF", false },                 // Overlong 2-byte
+    { "\xC2", false },                     // Truncated
+    { "\xC2\x41", false },                 // Missing continuation
+    { "\xE0\x9F\xBF", false },             // Overlong 3-byte
+    { "\xED\xA0\x80", false },             // Surrogate
+    { "\xE2\x82", false },                 // Truncated
+    { "\xF0\x8F\xBF\xBF", false },         // Overlong 4-byte
+    { "\xF4\x90\x80\x80", false },         // Above U+10FFFF
+    { "\xF8\x88\x80\x80\x80", false },     // 5-byte form
+    { "\xFF", false },
+    { "\xC2\xA9\xA9", false },             // Extra continuation
+};
+
+void validate_utf8_samples_at_every_offset() {
+    char buf[160];
+    size_t num_samples = sizeof(utf8_samples) / sizeof(utf8_samples[0]);
+
+    for (size_t i = 0; i < num_samples; ++i) {
+        size_t n = strlen(utf8_samples[i].bytes);
+
+        for (size_t offset = 0; offset < 80; ++offset) {
+            // Surround the sample with ASCII, and also test it at the very end
+            // of the input.
+            memset(buf, 'x', sizeof(buf));
+            memcpy(buf + offset, utf8_samples[i].bytes, n);
+
+            ss_assert_msg(
+                ss_utf8_validate(buf, 100) == utf8_samples[i].valid,
+                "sample %li at offset %li\n", i, offset
+            );
+            ss_assert_msg(
+                ss_utf8_validate(buf, offset + n) == utf8_samples[i].valid,
+                "sample %li at end, offset %li\n", i, offset
+            );
+        }
+    }
+
+    ss_assert(ss_utf8_validate("", 0));
+    ss_assert(ss_utf8_validate(NULL, 0));
+}
+
+void validate_long_multibyte_utf8() {
+    // Multibyte sequences crossing every block boundary.
+    char buf[4 * 100 + 1] = { 0 };
+    for (size_t i = 0; i < 100; ++i) {
+        memcpy(buf + i * 4, "\xF0\x9F\x98\x80", 4);
+    }
+    ss_assert(ss_utf8_validate(buf, 400));
+    ss_assert(ss_utf8_len(buf, 400) == 100);
+
+    // Truncating the input in the middle of a sequence is an error.
+    ss_assert(! ss_utf8_validate(buf, 399));
+
+    buf[201] = 'x';
+    ss_assert(! ss_utf8_validate(buf, 400));
+}
+
+void count_utf8_code_points() {
+    const char *s = "a\xC2\xA9\xE2\x82\xAC\xF0\x9F\x98\x80" "bcdefghijklmnopq";
+    ss_assert(ss_utf8_len(s, strlen(s)) == 20);
+
+    struct ss_string *str = ss_string_create_from_cstring(s);
+    ss_assert(ss_string_utf8_validate(str));
+    ss_assert(ss_string_utf8_len(str) == 20);
+    ss_string_free(&str);
+
+    str = ss_string_create();
+    ss_assert(ss_string_utf8_validate(str));
+    ss_assert(ss_string_utf8_len(str) == 0);
+    ss_string_free(&str);
+}
+
+void iterate_utf8_code_points() {
+    struct ss_string *s =
+        ss_string_create_from_cstring("a\xC2\xA9\xE2\x82\xAC\xF0\x9F\x98\x80");
+    uint32_t expected[] = { 0x61, 0xA9, 0x20AC, 0x1F600 };
+
+    struct ss_utf8_iter iter = ss_string_utf8_iter(s);
+    uint32_t cp = 0;
+    size_t i = 0;
+
+    while (ss_utf8_iter_next(&iter, &cp)) {
+        ss_assert(i < 4);
+        ss_assert_msg(cp == expected[i], "cp %i is %x", i, cp);
+        i += 1;
+    }
+    ss_assert(i == 4);
+    ss_string_free(&s);
+
+    const char *bad = "\xE2\x82z";
+    iter = ss_utf8_iter_create(bad, 3);
+    ss_assert(ss_utf8_iter_next(&iter, &cp) && cp == SS_UTF8_REPLACEMENT_CHAR);
+    ss_assert(ss_utf8_iter_next(&iter, &cp) && cp == SS_UTF8_REPLACEMENT_CHAR);
+    ss_assert(ss_utf8_iter_next(&iter, &cp) && cp == 'z');
+    ss_assert(! ss_utf8_iter_next(&iter, &cp));
+}
+
+#endif
@@ -20,6 +20,7 @@ target("ss_utils")
     add_includedirs("include", {public = true})
     add_headerfiles("include/*.h")
     add_files("src/*.c")
+    add_syslinks("pthread", "m", {public = true})
 
 
 target("test")
@@ -44,3 +45,4 @@ target("test")
     add_ldflags("-rdynamic")
     add_includedirs("test", "include")
     add_files("src/*.c", "test/*.c")
+    add_syslinks("pthread", "m")